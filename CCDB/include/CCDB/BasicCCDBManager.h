@@ -17,10 +17,14 @@
 
 #include "CCDB/CcdbApi.h"
 #include "CCDB/CCDBTimeStampUtils.h"
+#include <cstdlib>
 #include <string>
 #include <map>
 #include <unordered_map>
 #include <memory>
+#include <mutex>
+#include <future>
+#include <vector>
 
 // #include <FairLogger.h>
 
@@ -36,6 +40,11 @@ namespace o2::ccdb
 ///
 /// In cases where caching is not needed or just 1 instance of the manager is enough, one case use
 /// a singleton version BasicCCDBManager
+///
+/// Optionally, the retrieved objects are also kept in a local directory (by default taken from the
+/// ALICEO2_CCDB_SHAREDCACHE environment variable) which can be shared by all processes on a node.
+/// Files in this cache are named after the validity interval and the ETag of the object, so that
+/// an object covering the requested timestamp is served without any query to the server.
 
 class CCDBManagerInstance
 {
@@ -51,8 +60,13 @@ class CCDBManagerInstance
   CCDBManagerInstance(std::string const& path) : mCCDBAccessor{}
   {
     mCCDBAccessor.init(path);
+    if (auto cachedir = getenv("ALICEO2_CCDB_SHAREDCACHE")) {
+      setLocalCacheDir(cachedir);
+    }
   }
 
+  ~CCDBManagerInstance() { waitForPrefetch(); }
+
   /// set a URL to query from
   void setURL(const std::string& url);
 
@@ -135,7 +149,42 @@ class CCDBManagerInstance
   /// reset the object upper validity limit
   void resetCreatedNotBefore() { mCreatedNotBefore = 0; }
 
+  /// set the directory of the local object cache shared between processes, empty string disables it
+  void setLocalCacheDir(std::string const& dir);
+
+  /// get the directory of the local object cache
+  std::string const& getLocalCacheDir() const { return mLocalCacheDir; }
+
+  /// check if the local object cache is enabled
+  bool isLocalCacheEnabled() const { return !mLocalCacheDir.empty(); }
+
+  /// get the directory of the local cache holding the objects stored under path for the current URL and query metadata
+  std::string getLocalCachePath(std::string const& path, std::map<std::string, std::string> const& metaData = {}) const;
+
+  /// asynchronously download to the local cache the objects stored under paths for the given timestamp
+  /// (the timestamp member if negative), later queries for these paths wait for the download to finish
+  void prefetch(std::vector<std::string> const& paths, long timestamp = -1);
+
+  /// wait until all pending prefetch requests are finished
+  void waitForPrefetch();
+
  private:
+  struct LocalCacheEntry {
+    std::string filename;
+    std::string etag;
+    long startvalidity = 0;
+    long endvalidity = 0;
+  };
+
+  /// find or download the file of the local cache holding the object under path valid for timestamp
+  bool getFromLocalCache(std::string const& path, long timestamp, LocalCacheEntry& entry);
+
+  /// look up a file covering timestamp in a directory of the local cache
+  static bool findInLocalCache(std::string const& cachePath, long timestamp, LocalCacheEntry& entry);
+
+  /// download the object under path and timestamp and move it to its place in the local cache
+  bool downloadToLocalCache(std::string const& path, std::map<std::string, std::string> const& metaData, long timestamp, LocalCacheEntry& entry) const;
+
   // we access the CCDB via the CURL based C++ API
   o2::ccdb::CcdbApi mCCDBAccessor;
   std::unordered_map<std::string, CachedObject> mCache; //! map for {path, CachedObject} associations
@@ -147,6 +196,9 @@ class CCDBManagerInstance
   bool mCheckObjValidityEnabled = false;                // wether the validity of cached object is checked before proceeding to a CCDB API query
   long mCreatedNotAfter = 0;                            // upper limit for object creation timestamp (TimeMachine mode) - If-Not-After HTTP header
   long mCreatedNotBefore = 0;                           // lower limit for object creation timestamp (TimeMachine mode) - If-Not-Before HTTP header
+  std::string mLocalCacheDir;                           // directory of the local object cache (disabled if empty)
+  std::mutex mPrefetchMutex;                            //! protects mPrefetches
+  std::unordered_map<std::string, std::shared_future<void>> mPrefetches; //! pending prefetch requests per path
 };
 
 template <typename T>
@@ -162,6 +214,27 @@ T* CCDBManagerInstance::getForTimeStamp(std::string const& path, long timestamp)
     return reinterpret_cast<T*>(cached.objPtr.get());
   }
 
+  // the local cache does not know about the TimeMachine mode, such queries always go to the server
+  LocalCacheEntry entry;
+  if (isLocalCacheEnabled() && !mCreatedNotAfter && !mCreatedNotBefore && getFromLocalCache(path, timestamp, entry)) {
+    T* ptr = nullptr;
+    if (cached.objPtr && cached.uuid == entry.etag) { // same object as the one in memory
+      ptr = reinterpret_cast<T*>(cached.objPtr.get());
+    } else {
+      ptr = mCCDBAccessor.extractFromLocalFileAny<T>(entry.filename);
+    }
+    if (ptr) {
+      if (ptr != cached.objPtr.get()) {
+        cached.objPtr.reset(ptr);
+      }
+      cached.uuid = entry.etag;
+      cached.startvalidity = entry.startvalidity;
+      cached.endvalidity = entry.endvalidity;
+      mMetaData.clear();
+      return ptr;
+    }
+  }
+
   T* ptr = mCCDBAccessor.retrieveFromTFileAny<T>(path, mMetaData, timestamp, &mHeaders, cached.uuid,
                                                  mCreatedNotAfter ? std::to_string(mCreatedNotAfter) : "",
                                                  mCreatedNotBefore ? std::to_string(mCreatedNotBefore) : "");
@@ -221,8 +221,10 @@ class CcdbApi //: public DatabaseInterface
   /**
   *  Simple function to retrieve the blob corresponding to some path and timestamp.
   *  Saves the blob locally to a binary file. The final path (including filename) is given by targetdir.
+  *  The headers of the download are stored with the blob and, if headers is given, returned.
   */
-  void retrieveBlob(std::string const& path, std::string const& targetdir, std::map<std::string, std::string> const& metadata, long timestamp) const;
+  void retrieveBlob(std::string const& path, std::string const& targetdir, std::map<std::string, std::string> const& metadata, long timestamp,
+                    std::map<std::string, std::string>* headers = nullptr) const;
 
   /**
    * Retrieve the headers of a CCDB entry, if it exists.
@@ -233,6 +235,25 @@ class CcdbApi //: public DatabaseInterface
    */
   std::map<std::string, std::string> retrieveHeaders(std::string const& path, std::map<std::string, std::string> const& metadata, long timestamp = -1) const;
 
+  /**
+   * Retrieve the headers stored in a local file created by retrieveBlob.
+   * @param filename The local file.
+   * @return A map containing the headers. The map is empty if the file or the headers cannot be found.
+   */
+  std::map<std::string, std::string> retrieveHeadersFromLocalFile(std::string const& filename) const;
+
+  /**
+   * Retrieve an object of type T from a local file created by retrieveBlob.
+   * @param filename The local file.
+   * @param headers Map to be populated with the headers stored in the file, if it is not null.
+   * @return the object, or nullptr if the file does not exist or type does not match serialized type.
+   */
+  template <typename T>
+  T* extractFromLocalFileAny(std::string const& filename, std::map<std::string, std::string>* headers = nullptr) const
+  {
+    return static_cast<T*>(extractFromLocalFile(filename, typeid(T), headers));
+  }
+
   /**
    * A helper function to extract an object from an existing in-memory TFile
    * @param file a TFile instance
@@ -13,17 +13,192 @@
 // Created by Sandro Wenzel on 2019-08-14.
 //
 #include "CCDB/BasicCCDBManager.h"
+#include <FairLogger.h>
+#include <atomic>
+#include <filesystem>
+#include <functional>
+#include <regex>
 #include <string>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
 
 namespace o2
 {
 namespace ccdb
 {
 
+namespace
+{
+// keep only the characters which are safe to use in a file name
+std::string sanitizeETag(std::string const& etag)
+{
+  std::string result;
+  for (auto c : etag) {
+    if (std::isalnum(c) || c == '-') {
+      result += c;
+    }
+  }
+  return result;
+}
+
+// files of the local cache are named <Valid-From>_<Valid-Until>_<ETag>.root
+std::string getLocalCacheFileName(long startvalidity, long endvalidity, std::string const& etag)
+{
+  return std::to_string(startvalidity) + "_" + std::to_string(endvalidity) + "_" + etag + ".root";
+}
+} // namespace
+
 void CCDBManagerInstance::setURL(std::string const& url)
 {
+  waitForPrefetch();
   mCCDBAccessor.init(url);
 }
 
+void CCDBManagerInstance::setLocalCacheDir(std::string const& dir)
+{
+  waitForPrefetch();
+  mLocalCacheDir = dir;
+  if (!dir.empty() && !fs::exists(dir) && !fs::create_directories(dir)) {
+    LOG(ERROR) << "Could not create local CCDB cache directory " << dir << ", local cache disabled";
+    mLocalCacheDir.clear();
+  }
+}
+
+std::string CCDBManagerInstance::getLocalCachePath(std::string const& path, std::map<std::string, std::string> const& metaData) const
+{
+  // different servers or metadata filters may give different objects for the same path and timestamp
+  std::string query = mCCDBAccessor.getURL();
+  for (auto& [key, value] : metaData) {
+    query += ";" + key + "=" + value;
+  }
+  return mLocalCacheDir + "/" + path + "/" + std::to_string(std::hash<std::string>{}(query));
+}
+
+bool CCDBManagerInstance::findInLocalCache(std::string const& cachePath, long timestamp, LocalCacheEntry& entry)
+{
+  std::error_code ec;
+  if (!fs::is_directory(cachePath, ec)) {
+    return false;
+  }
+  const std::regex fileRegex("(-?[0-9]+)_(-?[0-9]+)_([A-Za-z0-9-]*)\\.root");
+  bool found = false;
+  for (auto const& file : fs::directory_iterator(cachePath, ec)) {
+    std::smatch match;
+    auto name = file.path().filename().string();
+    if (!std::regex_match(name, match, fileRegex)) {
+      continue;
+    }
+    long start = std::stol(match[1].str());
+    long end = std::stol(match[2].str());
+    // in case of several candidates take the most specific one, i.e. the one starting last
+    if (start <= timestamp && timestamp < end && (!found || start > entry.startvalidity)) {
+      entry.filename = file.path().string();
+      entry.startvalidity = start;
+      entry.endvalidity = end;
+      entry.etag = match[3].str();
+      found = true;
+    }
+  }
+  return found;
+}
+
+bool CCDBManagerInstance::downloadToLocalCache(std::string const& path, std::map<std::string, std::string> const& metaData, long timestamp, LocalCacheEntry& entry) const
+{
+  static std::atomic<int> downloadCounter{0};
+  // download to a private directory first, so that other processes never see partial files
+  auto tmpDir = mLocalCacheDir + "/.download_" + std::to_string(getpid()) + "_" + std::to_string(downloadCounter++);
+  auto tmpFile = tmpDir + "/" + path + "/snapshot.root";
+  // validity and ETag come from the response which delivered the file
+  std::map<std::string, std::string> headers;
+  mCCDBAccessor.retrieveBlob(path, tmpDir, metaData, timestamp, &headers);
+
+  bool success = false;
+  if (headers.count("Valid-From") && headers.count("Valid-Until")) {
+    entry.startvalidity = std::stol(headers["Valid-From"]);
+    entry.endvalidity = std::stol(headers["Valid-Until"]);
+    entry.etag = sanitizeETag(headers["ETag"]);
+    auto cachePath = getLocalCachePath(path, metaData);
+    entry.filename = cachePath + "/" + getLocalCacheFileName(entry.startvalidity, entry.endvalidity, entry.etag);
+    std::error_code ec;
+    fs::create_directories(cachePath, ec);
+    // rename is atomic, if another process was faster we keep its (identical) file
+    if (fs::exists(entry.filename)) {
+      success = true;
+    } else {
+      fs::rename(tmpFile, entry.filename, ec);
+      success = !ec || fs::exists(entry.filename);
+    }
+    if (!success) {
+      LOG(ERROR) << "Could not move " << tmpFile << " to the local CCDB cache: " << ec.message();
+    }
+  }
+  std::error_code ec;
+  fs::remove_all(tmpDir, ec);
+  return success;
+}
+
+bool CCDBManagerInstance::getFromLocalCache(std::string const& path, long timestamp, LocalCacheEntry& entry)
+{
+  if (timestamp < 0) {
+    timestamp = o2::ccdb::getCurrentTimestamp();
+  }
+  // let a pending prefetch request for this path finish first
+  std::shared_future<void> pending;
+  {
+    std::lock_guard<std::mutex> lock(mPrefetchMutex);
+    auto it = mPrefetches.find(path);
+    if (it != mPrefetches.end()) {
+      pending = it->second;
+      mPrefetches.erase(it);
+    }
+  }
+  if (pending.valid()) {
+    pending.wait();
+  }
+
+  if (findInLocalCache(getLocalCachePath(path, mMetaData), timestamp, entry)) {
+    LOG(DEBUG) << "Serving " << path << " for timestamp " << timestamp << " from local cache " << entry.filename;
+    return true;
+  }
+  return downloadToLocalCache(path, mMetaData, timestamp, entry);
+}
+
+void CCDBManagerInstance::prefetch(std::vector<std::string> const& paths, long timestamp)
+{
+  if (!isLocalCacheEnabled()) {
+    LOG(WARNING) << "CCDB prefetch requires the local cache to be enabled, ignoring request";
+    return;
+  }
+  if (timestamp < 0) {
+    timestamp = mTimestamp;
+  }
+  std::lock_guard<std::mutex> lock(mPrefetchMutex);
+  for (auto const& path : paths) {
+    if (mPrefetches.count(path)) {
+      continue;
+    }
+    auto metaData = mMetaData;
+    mPrefetches[path] = std::async(std::launch::async, [this, path, metaData, timestamp]() {
+                          LocalCacheEntry entry;
+                          if (!findInLocalCache(getLocalCachePath(path, metaData), timestamp, entry) && !downloadToLocalCache(path, metaData, timestamp, entry)) {
+                            LOG(WARNING) << "Prefetching " << path << " for timestamp " << timestamp << " failed";
+                          }
+                        }).share();
+  }
+}
+
+void CCDBManagerInstance::waitForPrefetch()
+{
+  std::unordered_map<std::string, std::shared_future<void>> pending;
+  {
+    std::lock_guard<std::mutex> lock(mPrefetchMutex);
+    pending.swap(mPrefetches);
+  }
+  for (auto& [path, request] : pending) {
+    request.wait();
+  }
+}
+
 } // namespace ccdb
 } // namespace o2
@@ -335,7 +335,8 @@ size_t header_map_callback(char* buffer, size_t size, size_t nitems, void* userd
 }
 } // namespace
 
-void CcdbApi::retrieveBlob(std::string const& path, std::string const& targetdir, std::map<std::string, std::string> const& metadata, long timestamp) const
+void CcdbApi::retrieveBlob(std::string const& path, std::string const& targetdir, std::map<std::string, std::string> const& metadata, long timestamp,
+                           std::map<std::string, std::string>* headers) const
 {
 
   // we setup the target path for this blob
@@ -372,6 +373,11 @@ void CcdbApi::retrieveBlob(std::string const& path, std::string const& targetdir
   /* we pass our file handle to the callback function */
   curl_easy_setopt(curl_handle, CURLOPT_WRITEDATA, (void*)fp);
 
+  /* keep the headers of this very download, the first response (from the CCDB server) takes precedence over the redirections */
+  std::map<std::string, std::string> responseHeaders;
+  curl_easy_setopt(curl_handle, CURLOPT_HEADERFUNCTION, header_map_callback<>);
+  curl_easy_setopt(curl_handle, CURLOPT_HEADERDATA, (void*)&responseHeaders);
+
   /* some servers don't like requests that are made without a user-agent
          field, so we provide one */
   curl_easy_setopt(curl_handle, CURLOPT_USERAGENT, "libcurl-agent/1.0");
@@ -406,13 +412,14 @@ void CcdbApi::retrieveBlob(std::string const& path, std::string const& targetdir
     // trying to append metadata to the file so that it can be inspected WHERE/HOW/WHAT IT corresponds to
     // Just a demonstrator for the moment
     CCDBQuery querysummary(path, metadata, timestamp);
-    // retrieveHeaders
-    auto headers = retrieveHeaders(path, metadata, timestamp);
     std::lock_guard<std::mutex> guard(gIOMutex);
     TFile snapshotfile(targetpath.c_str(), "UPDATE");
     snapshotfile.WriteObjectAny(&querysummary, TClass::GetClass(typeid(querysummary)), CCDBQUERY_ENTRY);
-    snapshotfile.WriteObjectAny(&headers, TClass::GetClass(typeid(metadata)), CCDBMETA_ENTRY);
+    snapshotfile.WriteObjectAny(&responseHeaders, TClass::GetClass(typeid(metadata)), CCDBMETA_ENTRY);
     snapshotfile.Close();
+    if (headers) {
+      *headers = responseHeaders;
+    }
   }
 }
 
@@ -946,6 +953,25 @@ std::map<std::string, std::string> CcdbApi::retrieveHeaders(std::string const& p
   return headers;
 }
 
+std::map<std::string, std::string> CcdbApi::retrieveHeadersFromLocalFile(std::string const& filename) const
+{
+  std::map<std::string, std::string> headers;
+  if (!std::filesystem::exists(filename)) {
+    return headers;
+  }
+  std::lock_guard<std::mutex> guard(gIOMutex);
+  TFile f(filename.c_str(), "READ");
+  if (f.IsZombie()) {
+    return headers;
+  }
+  auto storedmeta = retrieveMetaInfo(f);
+  if (storedmeta) {
+    headers = *storedmeta;
+    delete storedmeta;
+  }
+  return headers;
+}
+
 bool CcdbApi::getCCDBEntryHeaders(std::string const& url, std::string const& etag, std::vector<std::string>& headers)
 {
   auto curl = curl_easy_init();
@@ -23,6 +23,10 @@
 #include "CCDB/BasicCCDBManager.h"
 #include "Framework/Logger.h"
 #include <boost/test/unit_test.hpp>
+#include <TClass.h>
+#include <TFile.h>
+#include <filesystem>
+#include <unistd.h>
 
 using namespace o2::ccdb;
 
@@ -122,3 +126,81 @@ BOOST_AUTO_TEST_CASE(TestBasicCCDBManager)
   LOG(INFO) << "Reading A again, it should not be cached: " << *objA;
   BOOST_CHECK(objA && (*objA) != hack); // make sure correct object is loaded
 }
+
+// write a file to the local cache as it would be downloaded from the server
+void writeLocalCacheFile(std::string const& filename, std::string const& obj, long start, long stop)
+{
+  std::map<std::string, std::string> headers{{"Valid-From", std::to_string(start)}, {"Valid-Until", std::to_string(stop)}};
+  TFile f(filename.c_str(), "RECREATE");
+  f.WriteObjectAny(&obj, TClass::GetClass(typeid(std::string)), CcdbApi::CCDBOBJECT_ENTRY);
+  f.WriteObjectAny(&headers, TClass::GetClass(typeid(headers)), CcdbApi::CCDBMETA_ENTRY);
+  f.Close();
+}
+
+BOOST_AUTO_TEST_CASE(TestBasicCCDBManagerLocalCache)
+{
+  // nothing listens on this port: every object must be served by the local cache
+  CCDBManagerInstance cdb("http://localhost:1");
+  auto cacheDir = std::filesystem::temp_directory_path() / ("ccdbcache_" + std::to_string(getpid()));
+  cdb.setLocalCacheDir(cacheDir.string());
+  BOOST_REQUIRE(cdb.isLocalCacheEnabled());
+
+  std::string path = "Test/LocalCache";
+  auto cachePath = cdb.getLocalCachePath(path);
+  std::filesystem::create_directories(cachePath);
+  writeLocalCacheFile(cachePath + "/1000_2000_aaaa-1111.root", "objectO", 1000, 2000);
+  writeLocalCacheFile(cachePath + "/2000_3000_bbbb-2222.root", "objectN", 2000, 3000);
+
+  auto* obj = cdb.getForTimeStamp<std::string>(path, 1500);
+  BOOST_REQUIRE(obj);
+  BOOST_CHECK_EQUAL(*obj, "objectO");
+  // served from memory while valid
+  (*obj) = "Cached";
+  obj = cdb.getForTimeStamp<std::string>(path, 1700);
+  BOOST_REQUIRE(obj);
+  BOOST_CHECK_EQUAL(*obj, "Cached");
+  // the validity interval selects the file
+  obj = cdb.getForTimeStamp<std::string>(path, 2500);
+  BOOST_REQUIRE(obj);
+  BOOST_CHECK_EQUAL(*obj, "objectN");
+  // not covered by the cache, the server query fails
+  obj = cdb.getForTimeStamp<std::string>(path, 5000);
+  BOOST_CHECK(obj == nullptr);
+
+  // other metadata filters use a different part of the cache
+  BOOST_CHECK(cdb.getLocalCachePath(path, {{"key", "value"}}) != cachePath);
+
+  std::filesystem::remove_all(cacheDir);
+}
+
+BOOST_AUTO_TEST_CASE(TestBasicCCDBManagerPrefetch)
+{
+  CcdbApi api;
+  const std::string uri = "http://ccdb-test.cern.ch:8080";
+  api.init(uri);
+  if (!api.isHostReachable()) {
+    LOG(WARNING) << "Host " << uri << " is not reacheable, abandoning the test";
+    return;
+  }
+  std::string pathA = "Test/PrefetchA";
+  std::string pathB = "Test/PrefetchB";
+  std::string ccdbObj = "testObject";
+  std::map<std::string, std::string> md;
+  long start = 1000, stop = 2000;
+  api.storeAsTFileAny(&ccdbObj, pathA, md, start, stop);
+  api.storeAsTFileAny(&ccdbObj, pathB, md, start, stop);
+
+  CCDBManagerInstance cdb(uri);
+  auto cacheDir = std::filesystem::temp_directory_path() / ("ccdbprefetch_" + std::to_string(getpid()));
+  cdb.setLocalCacheDir(cacheDir.string());
+  cdb.setTimestamp((start + stop) / 2);
+  cdb.prefetch({pathA, pathB});
+  cdb.waitForPrefetch();
+  BOOST_CHECK(!std::filesystem::is_empty(cdb.getLocalCachePath(pathA)));
+  BOOST_CHECK(!std::filesystem::is_empty(cdb.getLocalCachePath(pathB)));
+
+  auto* objA = cdb.get<std::string>(pathA);
+  BOOST_CHECK(objA && (*objA) == ccdbObj);
+
+  std::filesystem::remove_all(cacheDir);
+}
@@ -308,10 +308,11 @@ MagneticField& MagneticField::operator=(const MagneticField& src)
    */
 
   if (this != &src) {
-    if (src.mMeasuredMap) {
-      mMeasuredMap.reset(new MagneticWrapperChebyshev(*src.getMeasuredMap()));
-    }
+    mMeasuredMap.reset(src.mMeasuredMap ? new MagneticWrapperChebyshev(*src.getMeasuredMap()) : nullptr);
     SetName(src.GetName());
+    SetTitle(src.GetTitle());
+    fType = src.fType;
+    mMapType = src.mMapType;
     mSolenoid = src.mSolenoid;
     mBeamType = src.mBeamType;
     mBeamEnergy = src.mBeamEnergy;
@@ -321,6 +322,11 @@ MagneticField& MagneticField::operator=(const MagneticField& src)
     mMultipicativeFactorDipole = src.mMultipicativeFactorDipole;
     mMaxField = src.mMaxField;
     mDipoleOnOffFlag = src.mDipoleOnOffFlag;
+    mQuadrupoleGradient = src.mQuadrupoleGradient;
+    mDipoleField = src.mDipoleField;
+    mCompensatorField2C = src.mCompensatorField2C;
+    mCompensatorField1A = src.mCompensatorField1A;
+    mCompensatorField2A = src.mCompensatorField2A;
     mParameterNames = src.mParameterNames;
     mFastField.reset(src.mFastField ? new MagFieldFast(*src.getFastField()) : nullptr);
   }
@@ -31,6 +31,7 @@
 #define ALICEO2_ITSMFT_TOPOLOGYDICTIONARY_H
 #include "DataFormatsITSMFT/ClusterPattern.h"
 #include "Framework/Logger.h"
+#include <cstdint>
 #include <fstream>
 #include <string>
 #include <unordered_map>
@@ -160,6 +161,35 @@ class TopologyDictionary
   ///Returns the local position of a compact cluster
   static math_utils::Point3D<float> getClusterCoordinates(const CompCluster& cl, const ClusterPattern& patt, bool isGroup = true);
 
+  /// Builds the perfect hash of the common topologies and the direct index of the groups from mCommonMap and mGroupMap.
+  /// Called when the dictionary is read from a binary file or finalised; for a dictionary filled in any other way
+  /// (e.g. read through its ROOT streamer) the lookups fall back to the maps until it is called.
+  void buildPerfectHash();
+  /// Returns true if the perfect hash and the direct index of the groups are in sync with the maps
+  bool isPerfectHashBuilt() const { return mPHBuilt; }
+  /// Returns the position in mVectorOfIDs of the common topology with the complete hash @a hash, -1 if not found
+  inline int findCommonID(unsigned long hash) const
+  {
+    if (!mPHBuilt) {
+      auto ret = mCommonMap.find(hash);
+      return ret != mCommonMap.end() ? ret->second : -1;
+    }
+    if (mPHSlots.empty()) {
+      return -1;
+    }
+    const auto& slot = mPHSlots[getPHSlot(hash, mPHDisplacements[getPHBucket(hash)])];
+    return slot.mHash == hash ? slot.mID : -1;
+  }
+  /// Returns the position in mVectorOfIDs of the group of rare topologies with index @a groupIndex, -1 if not found
+  inline int findGroupEntry(int groupIndex) const
+  {
+    if (!mPHBuilt) {
+      auto ret = mGroupMap.find(groupIndex);
+      return ret != mGroupMap.end() ? ret->second : -1;
+    }
+    return (groupIndex >= 0 && groupIndex < NumberOfRareGroups) ? mGroupLUT[groupIndex] : -1;
+  }
+
   friend BuildTopologyDictionary;
   friend LookUp;
   friend TopologyFastSimulation;
@@ -170,6 +200,38 @@ class TopologyDictionary
   int mSmallTopologiesLUT[8 * 255 + 1];              ///< Look-Up Table for the topologies with 1-byte linearised matrix
   std::vector<GroupStruct> mVectorOfIDs;             ///< Vector of topologies and groups
 
+  /// Slot of the perfect hash of the common topologies
+  struct PHSlot {
+    unsigned long mHash = 0; ///< complete hash of the topology
+    int mID = -1;            ///< position in mVectorOfIDs, -1 for empty slots
+  };
+  static constexpr int PHBucketSize = 4;    ///< average number of keys per bucket of the perfect hash
+  static constexpr int PHMaxGrowths = 4;    ///< times the number of slots may be doubled when a bucket cannot be placed
+
+  /// clears the maps and the lookup tables built from them
+  void clearMaps();
+  /// tries to place all the common topologies in nSlots slots, false if a bucket cannot be placed
+  bool fillPerfectHash(size_t nSlots);
+
+  /// mixes the bits of the complete hash, the upper half of which only encodes the bounding box
+  static inline uint64_t mixPHKey(uint64_t key, uint64_t seed)
+  {
+    key ^= seed;
+    key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+    return key ^ (key >> 31);
+  }
+  inline uint32_t getPHBucket(unsigned long hash) const { return mixPHKey(hash, 0) % mPHDisplacements.size(); }
+  inline uint32_t getPHSlot(unsigned long hash, uint32_t displacement) const
+  {
+    return mixPHKey(hash, 0x9e3779b97f4a7c15ULL * (displacement + 1)) & (mPHSlots.size() - 1);
+  }
+
+  std::vector<uint32_t> mPHDisplacements; //! displacement of each bucket of the perfect hash
+  std::vector<PHSlot> mPHSlots;           //! slots of the perfect hash, power of 2 in size
+  int mGroupLUT[NumberOfRareGroups];      //! direct index of the groups of rare topologies
+  bool mPHBuilt = false;                  //! true if the lookup tables above are in sync with the maps
+
   ClassDefNV(TopologyDictionary, 4);
 }; // namespace itsmft
 } // namespace itsmft
@@ -16,6 +16,7 @@
 
 #include "DataFormatsITSMFT/TopologyDictionary.h"
 #include "DataFormatsITSMFT/ClusterTopology.h"
+#include <algorithm>
 #include <iostream>
 #include "ITSMFTBase/SegmentationAlpide.h"
 
@@ -32,9 +33,13 @@ namespace o2
 namespace itsmft
 {
 
-TopologyDictionary::TopologyDictionary() : mSmallTopologiesLUT{-1} {}
+TopologyDictionary::TopologyDictionary()
+{
+  std::fill(std::begin(mSmallTopologiesLUT), std::end(mSmallTopologiesLUT), -1);
+  std::fill(std::begin(mGroupLUT), std::end(mGroupLUT), -1);
+}
 
-TopologyDictionary::TopologyDictionary(std::string fileName)
+TopologyDictionary::TopologyDictionary(std::string fileName) : TopologyDictionary()
 {
   readBinaryFile(fileName);
 }
@@ -74,7 +79,7 @@ void TopologyDictionary::writeBinaryFile(string outputfile)
 int TopologyDictionary::readBinaryFile(string fname)
 {
   mVectorOfIDs.clear();
-  mCommonMap.clear();
+  clearMaps();
   for (auto& p : mSmallTopologiesLUT) {
     p = -1;
   }
@@ -109,9 +114,101 @@ int TopologyDictionary::readBinaryFile(string fname)
     }
   }
   in.close();
+  buildPerfectHash();
   return 0;
 }
 
+void TopologyDictionary::clearMaps()
+{
+  mCommonMap.clear();
+  mGroupMap.clear();
+  mPHSlots.clear();
+  mPHDisplacements.clear();
+  mPHBuilt = false;
+}
+
+void TopologyDictionary::buildPerfectHash()
+{
+  std::fill(std::begin(mGroupLUT), std::end(mGroupLUT), -1);
+  for (const auto& gr : mGroupMap) {
+    if (gr.first >= 0 && gr.first < NumberOfRareGroups) {
+      mGroupLUT[gr.first] = gr.second;
+    }
+  }
+  mPHSlots.clear();
+  mPHDisplacements.clear();
+  if (mCommonMap.empty()) {
+    mPHBuilt = true;
+    return;
+  }
+  size_t nSlots = 1;
+  while (nSlots < mCommonMap.size() + mCommonMap.size() / 4) { // load factor <= 0.8
+    nSlots <<= 1;
+  }
+  for (int iGrowth = 0; iGrowth <= PHMaxGrowths; iGrowth++, nSlots <<= 1) {
+    if (fillPerfectHash(nSlots)) {
+      mPHBuilt = true;
+      return;
+    }
+  }
+  // practically impossible with a decent mixing of the keys, the maps remain usable
+  LOG(WARNING) << "Could not build the perfect hash of " << mCommonMap.size() << " topologies, using the maps for the lookup";
+  mPHSlots.clear();
+  mPHDisplacements.clear();
+  mPHBuilt = false;
+}
+
+bool TopologyDictionary::fillPerfectHash(size_t nSlots)
+{
+  // Hash and displace: the keys are distributed in buckets of ~PHBucketSize elements, then, starting from the
+  // most populated bucket, for each bucket the smallest displacement mapping all its keys to free slots is searched.
+  // The lookup costs two hash evaluations and a single comparison, with no probing.
+  mPHSlots.assign(nSlots, PHSlot{});
+  mPHDisplacements.assign(1 + mCommonMap.size() / PHBucketSize, 0);
+
+  std::vector<std::vector<std::pair<unsigned long, int>>> buckets(mPHDisplacements.size());
+  for (const auto& key : mCommonMap) {
+    buckets[getPHBucket(key.first)].push_back(key);
+  }
+  std::vector<uint32_t> order(buckets.size());
+  for (uint32_t i = 0; i < order.size(); i++) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [&buckets](uint32_t a, uint32_t b) { return buckets[a].size() > buckets[b].size(); });
+
+  std::vector<uint32_t> trial;
+  for (auto ib : order) {
+    const auto& bucket = buckets[ib];
+    if (bucket.empty()) {
+      break;
+    }
+    bool ok = false;
+    for (uint32_t disp = 0; disp < nSlots && !ok; disp++) { // each displacement is a new pseudo-random placement
+      trial.clear();
+      ok = true;
+      for (const auto& key : bucket) {
+        auto slot = getPHSlot(key.first, disp);
+        if (mPHSlots[slot].mID >= 0 || std::find(trial.begin(), trial.end(), slot) != trial.end()) {
+          ok = false;
+          break;
+        }
+        trial.push_back(slot);
+      }
+      if (ok) {
+        mPHDisplacements[ib] = disp;
+        for (size_t ik = 0; ik < bucket.size(); ik++) {
+          mPHSlots[trial[ik]].mHash = bucket[ik].first;
+          mPHSlots[trial[ik]].mID = bucket[ik].second;
+        }
+      }
+    }
+    if (!ok) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void TopologyDictionary::getTopologyDistribution(const TopologyDictionary& dict, TH1F*& histo, const char* histName)
 {
   int dictSize = (int)dict.getSize();
@@ -0,0 +1,121 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test TopologyDictionary
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "DataFormatsITSMFT/TopologyDictionary.h"
+#include <TFile.h>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <unordered_set>
+
+namespace o2::itsmft
+{
+
+// write a dictionary file with nCommon common topologies with random hashes followed by the groups
+void writeDictionary(const std::string& fname, int nCommon, std::vector<unsigned long>& hashes)
+{
+  std::mt19937_64 gen(12345);
+  std::unordered_set<unsigned long> used;
+  std::ofstream out(fname, std::ios::out | std::ios::binary);
+  auto write = [&out](unsigned long hash, bool isGroup) {
+    float f = 0.f;
+    int npix = 1;
+    double freq = 0.;
+    unsigned char bitmap[ClusterPattern::kExtendedPatternBytes] = {4, 4};
+    out.write(reinterpret_cast<char*>(&hash), sizeof(unsigned long));
+    for (int i = 0; i < 6; i++) {
+      out.write(reinterpret_cast<char*>(&f), sizeof(float));
+    }
+    out.write(reinterpret_cast<char*>(&npix), sizeof(int));
+    out.write(reinterpret_cast<char*>(&freq), sizeof(double));
+    out.write(reinterpret_cast<char*>(&isGroup), sizeof(bool));
+    out.write(reinterpret_cast<char*>(bitmap), sizeof(bitmap));
+  };
+  while ((int)hashes.size() < nCommon) {
+    auto hash = gen();
+    if (used.insert(hash).second) {
+      hashes.push_back(hash);
+      write(hash, false);
+    }
+  }
+  for (int ig = 0; ig < TopologyDictionary::NumberOfRareGroups; ig++) {
+    write(((unsigned long)ig) << 32, true);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TopologyDictionary_perfectHash)
+{
+  const std::string fname = "test_TopologyDictionary.bin";
+  for (int nCommon : {0, 1, 7, 5000}) {
+    std::vector<unsigned long> hashes;
+    writeDictionary(fname, nCommon, hashes);
+    TopologyDictionary dict(fname);
+    BOOST_REQUIRE_EQUAL(dict.getSize(), nCommon + TopologyDictionary::NumberOfRareGroups);
+    for (int id = 0; id < nCommon; id++) {
+      BOOST_CHECK_EQUAL(dict.findCommonID(hashes[id]), id);
+    }
+    // hashes not in the dictionary must not be found
+    std::mt19937_64 gen(54321);
+    std::unordered_set<unsigned long> known(hashes.begin(), hashes.end());
+    for (int i = 0; i < 1000; i++) {
+      auto hash = gen();
+      if (!known.count(hash)) {
+        BOOST_CHECK_EQUAL(dict.findCommonID(hash), -1);
+      }
+    }
+    for (int ig = 0; ig < TopologyDictionary::NumberOfRareGroups; ig++) {
+      BOOST_CHECK_EQUAL(dict.findGroupEntry(ig), nCommon + ig);
+    }
+    BOOST_CHECK_EQUAL(dict.findGroupEntry(TopologyDictionary::NumberOfRareGroups), -1);
+  }
+  std::remove(fname.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(TopologyDictionary_streamer)
+{
+  // a dictionary read through its ROOT streamer has no lookup tables until they are rebuilt
+  const std::string fname = "test_TopologyDictionary_streamer.bin", rootName = "test_TopologyDictionary.root";
+  const int nCommon = 1000;
+  std::vector<unsigned long> hashes;
+  writeDictionary(fname, nCommon, hashes);
+  TopologyDictionary dict(fname);
+  BOOST_CHECK(dict.isPerfectHashBuilt());
+  {
+    TFile flOut(rootName.c_str(), "recreate");
+    flOut.WriteObjectAny(&dict, "o2::itsmft::TopologyDictionary", "dict");
+  }
+  TFile flIn(rootName.c_str());
+  std::unique_ptr<TopologyDictionary> dictIn(flIn.Get<TopologyDictionary>("dict"));
+  BOOST_REQUIRE(dictIn);
+  BOOST_REQUIRE_EQUAL(dictIn->getSize(), dict.getSize());
+  for (bool build : {false, true}) {
+    if (build) {
+      dictIn->buildPerfectHash();
+    }
+    BOOST_CHECK_EQUAL(dictIn->isPerfectHashBuilt(), build);
+    for (int id = 0; id < nCommon; id++) {
+      BOOST_CHECK_EQUAL(dictIn->findCommonID(hashes[id]), id);
+    }
+    BOOST_CHECK_EQUAL(dictIn->findCommonID(hashes[0] + 1), dict.findCommonID(hashes[0] + 1));
+    for (int ig = 0; ig <= TopologyDictionary::NumberOfRareGroups; ig++) {
+      BOOST_CHECK_EQUAL(dictIn->findGroupEntry(ig), dict.findGroupEntry(ig));
+    }
+  }
+  std::remove(fname.c_str());
+  std::remove(rootName.c_str());
+}
+
+} // namespace o2::itsmft
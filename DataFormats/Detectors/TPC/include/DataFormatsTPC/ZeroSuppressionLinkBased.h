@@ -123,6 +123,18 @@ struct Data {
     return float(getADCValue(pos)) * FloatConversion;
   }
 
+  /// get all ADC values of the word in float
+  /// \param values output array of at least ChannelsPerWord entries
+  void getADCValuesFloat(float* values) const
+  {
+    for (uint32_t word = 0; word < 2; ++word) {
+      const uint64_t adc = adcValues[word];
+      for (uint32_t pos = 0; pos < ChannelsPerHalfWord; ++pos) {
+        values[word * ChannelsPerHalfWord + pos] = float((adc >> (pos * DataBitSize)) & BitMask) * FloatConversion;
+      }
+    }
+  }
+
   /// reset all ADC values
   void reset()
   {
@@ -0,0 +1,80 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   testZeroSuppressionLinkBased.cxx
+/// @brief  Unit test for the TPC link based zero suppression data format
+
+#define BOOST_TEST_MODULE Test TPC DataFormats
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include "DataFormatsTPC/ZeroSuppressionLinkBased.h"
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+namespace o2
+{
+namespace tpc
+{
+using namespace zerosupp_link_based;
+
+template <uint32_t DataBitSize, uint32_t SignificantBits>
+void checkUnpacking()
+{
+  using DataType = Data<DataBitSize, SignificantBits>;
+  DataType data;
+  for (uint32_t pos = 0; pos < DataType::ChannelsPerWord; ++pos) {
+    data.setADCValue(pos, (pos * 397 + 11) & DataType::BitMask);
+  }
+
+  float values[DataType::ChannelsPerWord];
+  data.getADCValuesFloat(values);
+  for (uint32_t pos = 0; pos < DataType::ChannelsPerWord; ++pos) {
+    BOOST_CHECK_EQUAL(values[pos], data.getADCValueFloat(pos));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ZeroSuppressionLinkBased_unpacking)
+{
+  // zero suppressed 12bit and decoded 10bit data
+  checkUnpacking<12, 2>();
+  checkUnpacking<10, 0>();
+}
+
+BOOST_AUTO_TEST_CASE(ZeroSuppressionLinkBased_container)
+{
+  std::vector<uint64_t> buffer(2 * 9, 0);
+  auto* container = (ContainerZS*)buffer.data();
+  auto& header = container->cont.header;
+  header.bitMaskLow = 0xffffffffffffffff;
+  header.bitMaskHigh = 0xffff;
+  header.numWordsPayload = 8;
+  header.bunchCrossing = 123;
+
+  for (uint32_t i = 0; i < 80; ++i) {
+    container->setADCValueFloat(i, 0.25f * i);
+  }
+
+  BOOST_CHECK_EQUAL(container->getChannelBits().count(), 80);
+  BOOST_CHECK_EQUAL(container->getBunchCrossing(), 123);
+  BOOST_CHECK_EQUAL(container->getTotalSizeBytes(), buffer.size() * sizeof(uint64_t));
+  BOOST_CHECK_EQUAL((void*)container->next(), (void*)(buffer.data() + buffer.size()));
+
+  float values[ContainerZS::ChannelsPerWord];
+  for (uint32_t iword = 0; iword < header.numWordsPayload; ++iword) {
+    container->cont.data[iword].getADCValuesFloat(values);
+    for (uint32_t i = 0; i < ContainerZS::ChannelsPerWord; ++i) {
+      BOOST_CHECK_EQUAL(values[i], 0.25f * (iword * ContainerZS::ChannelsPerWord + i));
+    }
+  }
+}
+
+} // namespace tpc
+} // namespace o2
@@ -0,0 +1,130 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef EMCALRAWFITTERBATCH_H_
+#define EMCALRAWFITTERBATCH_H_
+
+#include <cstdint>
+#include <vector>
+#include <gsl/span>
+#include "DataFormatsEMCAL/Constants.h"
+#include "EMCALReconstruction/Bunch.h"
+#include "EMCALReconstruction/CaloFitResults.h"
+#include "EMCALReconstruction/CaloRawFitterGamma2.h"
+
+namespace o2
+{
+
+namespace emcal
+{
+
+/// \class CaloRawFitterBatch
+/// \brief Gamma-2 raw fitter for all channels of a timeframe
+/// \ingroup EMCALreconstruction
+///
+/// Batch version of CaloRawFitterGamma2. The channels are added one by one,
+/// the bunch selection and the peak finding are done when adding the channel
+/// and the selected samples are stored in structure-of-arrays form. The
+/// Gamma-2 fit is then performed for all channels at once, where LANES
+/// channels are fitted together in single precision.
+/// The blocks can be processed by several threads.
+///
+/// The results agree with the ones of CaloRawFitterGamma2 within the
+/// precision of the single precision fit.
+class CaloRawFitterBatch
+{
+ public:
+  static constexpr int LANES = 8; ///< Number of channels fitted together
+
+  /// \brief Constructor
+  CaloRawFitterBatch();
+
+  /// \brief Destructor
+  ~CaloRawFitterBatch() = default;
+
+  void setAmpCut(float cut)
+  {
+    mAmpCut = cut;
+    mSelector.setAmpCut(cut);
+  }
+  void setNsamplePed(int i) { mSelector.setNsamplePed(i); }
+  void setL1Phase(double phase) { mL1Phase = phase; }
+  void setTimeConstraint(int min, int max) { mSelector.setTimeConstraint(min, max); }
+  void setNiterationsMax(int n) { mNiterationsMax = n; }
+
+  float getAmpCut() const { return mAmpCut; }
+  int getNiterationsMax() const { return mNiterationsMax; }
+
+  /// \brief Remove all channels of the previous timeframe
+  void clear();
+
+  /// \brief Select the samples of a channel to be fitted
+  /// \param bunchvector ALTRO bunches for the current channel
+  /// \param isZeroSuppressed Whether the data of the channel is zero suppressed
+  /// \return Index of the channel in the batch
+  int addChannel(const gsl::span<const Bunch> bunchvector, bool isZeroSuppressed);
+
+  /// \brief Fit all channels added since the last clear
+  /// \param nthreads Number of threads used for the fit
+  void fit(int nthreads = 1);
+
+  /// \brief Get the number of channels in the batch
+  /// \return Number of channels
+  int getNumberOfChannels() const { return mStatus.size(); }
+
+  /// \brief Get the fit results of a channel, to be called after fit
+  /// \param channel Index of the channel in the batch
+  /// \return Container with the fit results (amp, time, chi2, ...)
+  /// \throw RawFitterError_t in case the bunch selection or the fit failed
+  CaloFitResults getResult(int channel) const;
+
+ private:
+  /// \enum ChannelStatus_t
+  /// \brief Processing state of a channel in the batch
+  enum class ChannelStatus_t : uint8_t {
+    SELECTION_ERROR, ///< Bunch selection failed, error code stored
+    NO_FIT,          ///< Signal not suited for a fit, estimates used
+    FIT,             ///< Samples to be fitted
+    FIT_DONE,        ///< Fit converged
+    FIT_FAILED       ///< Fit did not converge, estimates used
+  };
+
+  /// \brief Fit one block of up to LANES channels
+  /// \param first Index of the first channel of the block
+  void fitBlock(int first);
+
+  CaloRawFitterGamma2 mSelector; ///< Scalar fitter used for the bunch selection and peak finding
+
+  float mAmpCut = 4;        ///< Max ADC - pedestal must be higher than this befor attemting to extract the amplitude
+  double mL1Phase = 0;      ///< Phase of the ADC sampling clock relative to the LHC clock
+  int mNiterationsMax = 15; ///< Max number of iterations of the fit
+  float mJitter = 0;        ///< Amplitude jitter for channels without fit, as in CaloRawFitterGamma2
+
+  std::vector<int> mFitChannels; ///< Indices of the channels to be fitted
+
+  // per channel information, structure of arrays
+  std::vector<ChannelStatus_t> mStatus;                ///< Processing state
+  std::vector<CaloRawFitter::RawFitterError_t> mError; ///< Error of the bunch selection
+  std::vector<float> mSamples;                         ///< Reversed and pedestal subtracted samples, EMCAL_MAXTIMEBINS per channel
+  std::vector<uint8_t> mNSamples;                      ///< Number of samples used in the fit
+  std::vector<short> mMaxADC;                          ///< Maximum ADC value
+  std::vector<short> mTimeEstimate;                    ///< Peak position estimate, in time bins of the reversed samples
+  std::vector<int> mTimeOffset;                        ///< First time bin of the selected bunch
+  std::vector<float> mAmpEstimate;                     ///< Amplitude estimate
+  std::vector<float> mPedestal;                        ///< Pedestal
+  std::vector<float> mAmp;                             ///< Fitted amplitude
+  std::vector<float> mTime;                            ///< Fitted time, in time bins
+  std::vector<float> mChi2;                            ///< Chi2 of the fit
+};
+
+} // namespace emcal
+
+} // namespace o2
+#endif
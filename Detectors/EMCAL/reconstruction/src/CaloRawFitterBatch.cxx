@@ -0,0 +1,251 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file CaloRawFitterBatch.cxx
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <random>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
+#include "EMCALReconstruction/CaloRawFitterBatch.h"
+
+using namespace o2::emcal;
+
+CaloRawFitterBatch::CaloRawFitterBatch()
+{
+  mSelector.setAmpCut(mAmpCut);
+  // CaloRawFitterGamma2 smears the amplitude of channels without fit with the first number
+  // of a freshly constructed generator, which is hence the same for all channels
+  std::default_random_engine generator;
+  std::uniform_real_distribution<float> distribution(0.0, 1.0);
+  mJitter = 0.5 - distribution(generator);
+}
+
+void CaloRawFitterBatch::clear()
+{
+  mFitChannels.clear();
+  mStatus.clear();
+  mError.clear();
+  mSamples.clear();
+  mNSamples.clear();
+  mMaxADC.clear();
+  mTimeEstimate.clear();
+  mTimeOffset.clear();
+  mAmpEstimate.clear();
+  mPedestal.clear();
+  mAmp.clear();
+  mTime.clear();
+  mChi2.clear();
+}
+
+int CaloRawFitterBatch::addChannel(const gsl::span<const Bunch> bunchvector, bool isZeroSuppressed)
+{
+  int channel = mStatus.size();
+  mStatus.emplace_back(ChannelStatus_t::NO_FIT);
+  mError.emplace_back(CaloRawFitter::RawFitterError_t::FIT_ERROR);
+  mSamples.resize(mSamples.size() + constants::EMCAL_MAXTIMEBINS, 0.f);
+  mNSamples.emplace_back(0);
+  mMaxADC.emplace_back(0);
+  mTimeEstimate.emplace_back(0);
+  mTimeOffset.emplace_back(0);
+  mAmpEstimate.emplace_back(0.f);
+  mPedestal.emplace_back(0.f);
+  mAmp.emplace_back(0.f);
+  mTime.emplace_back(0.f);
+  mChi2.emplace_back(0.f);
+
+  mSelector.setIsZeroSuppressed(isZeroSuppressed);
+  try {
+    auto [nsamples, bunchIndex, ampEstimate,
+          maxADC, timeEstimate, pedEstimate, first, last] = mSelector.preFitEvaluateSamples(bunchvector, {}, {}, mAmpCut);
+    mMaxADC[channel] = maxADC;
+    mPedestal[channel] = pedEstimate;
+    if (bunchIndex >= 0 && ampEstimate >= mAmpCut) {
+      mAmpEstimate[channel] = ampEstimate;
+      mTimeEstimate[channel] = timeEstimate;
+      mAmp[channel] = ampEstimate;
+      mTime[channel] = timeEstimate;
+      mTimeOffset[channel] = bunchvector[bunchIndex].getStartTime() - (bunchvector[bunchIndex].getBunchLength() - 1);
+      if (nsamples > 2 && maxADC < constants::OVERFLOWCUT) {
+        int length = std::min<int>(bunchvector[bunchIndex].getBunchLength(), constants::EMCAL_MAXTIMEBINS);
+        float* samples = &mSamples[channel * constants::EMCAL_MAXTIMEBINS];
+        for (int i = 0; i < length; i++) {
+          samples[i] = mSelector.getReversed(i);
+        }
+        mNSamples[channel] = std::min(nsamples, constants::EMCAL_MAXTIMEBINS);
+        mStatus[channel] = ChannelStatus_t::FIT;
+        mFitChannels.emplace_back(channel);
+      }
+    }
+  } catch (CaloRawFitter::RawFitterError_t& e) {
+    mStatus[channel] = ChannelStatus_t::SELECTION_ERROR;
+    mError[channel] = e;
+  }
+  return channel;
+}
+
+void CaloRawFitterBatch::fit(int nthreads)
+{
+  int nblocks = (mFitChannels.size() + LANES - 1) / LANES;
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+#endif
+  for (int iblock = 0; iblock < nblocks; iblock++) {
+    fitBlock(iblock * LANES);
+  }
+}
+
+void CaloRawFitterBatch::fitBlock(int first)
+{
+  // Same Newton iterations as CaloRawFitterGamma2::doFit_1peak, for all lanes of the block in parallel.
+  // Lanes which converged or failed are masked, the block is done when no lane is active anymore.
+  constexpr float tau = constants::TAU;
+  int nlanes = std::min<int>(LANES, mFitChannels.size() - first);
+
+  std::array<float, LANES> ampl{}, time{}, chi2{};
+  std::array<int, LANES> nsamples{};
+  std::array<bool, LANES> active{};
+  std::array<std::array<float, LANES>, constants::EMCAL_MAXTIMEBINS> samples{};
+
+  for (int lane = 0; lane < nlanes; lane++) {
+    int channel = mFitChannels[first + lane];
+    const float* channelSamples = &mSamples[channel * constants::EMCAL_MAXTIMEBINS];
+    for (int itbin = 0; itbin < constants::EMCAL_MAXTIMEBINS; itbin++) {
+      samples[itbin][lane] = channelSamples[itbin];
+    }
+    nsamples[lane] = mNSamples[channel];
+    active[lane] = true;
+
+    // start values from the parabola through the maximum and its neighbours (as CaloRawFitterGamma2::doParabolaFit)
+    int maxTimeBin = std::clamp(mTimeEstimate[channel] - 1, 0, constants::EMCAL_MAXTIMEBINS - 3);
+    double y0 = channelSamples[maxTimeBin], y1 = channelSamples[maxTimeBin + 1], y2 = channelSamples[maxTimeBin + 2];
+    double a = (y2 + y0 - 2. * y1) / 2.;
+    if (std::abs(a) < std::numeric_limits<double>::epsilon()) {
+      ampl[lane] = y1;
+      time[lane] = maxTimeBin + 1;
+    } else {
+      double b = y1 - y0 - a * (2. * maxTimeBin + 1);
+      double c = y0 - b * maxTimeBin - a * maxTimeBin * maxTimeBin;
+      time[lane] = -b / 2. / a;
+      ampl[lane] = a * time[lane] * time[lane] + b * time[lane] + c;
+    }
+  }
+
+  std::array<bool, LANES> converged{};
+  for (int iter = 0; iter <= mNiterationsMax; iter++) {
+    if (std::none_of(active.begin(), active.begin() + nlanes, [](bool isActive) { return isActive; })) {
+      break;
+    }
+    std::array<float, LANES> c11{}, c12{}, c21{}, c22{}, d1{}, d2{}, sumChi2{};
+    for (int itbin = 0; itbin < constants::EMCAL_MAXTIMEBINS; itbin++) {
+      for (int lane = 0; lane < LANES; lane++) {
+        float ti = (itbin - time[lane]) / tau;
+        // masked lanes contribute 0, the argument of exp is limited to stay finite for them
+        float weight = (active[lane] && itbin < nsamples[lane] && (ti + 1) >= 0) ? 1.f : 0.f;
+        ti = std::max(ti, -1.f);
+        float expo = std::exp(-2 * ti);
+        float g_1i = (ti + 1) * expo;
+        float g_i = (ti + 1) * g_1i;
+        float gp_i = 2 * (g_i - g_1i);
+        float q1_i = (2 * ti + 1) * expo;
+        float q2_i = g_1i * g_1i * (4 * ti + 1);
+        float y = samples[itbin][lane];
+        float delta = ampl[lane] * g_i - y;
+        c11[lane] += weight * (y - ampl[lane] * 2 * g_i) * gp_i;
+        c12[lane] += weight * g_i * g_i;
+        c21[lane] += weight * (y * q1_i - ampl[lane] * q2_i);
+        c22[lane] += weight * g_i * g_1i;
+        d1[lane] += weight * delta * g_i;
+        d2[lane] += weight * delta * g_1i;
+        sumChi2[lane] += weight * delta * delta;
+      }
+    }
+    for (int lane = 0; lane < nlanes; lane++) {
+      if (!active[lane]) {
+        continue;
+      }
+      float D = c11[lane] * c22[lane] - c12[lane] * c21[lane];
+      if (std::abs(D) < std::numeric_limits<float>::min()) {
+        active[lane] = false; // singular system, fit failed
+        continue;
+      }
+      float dt = (d1[lane] * c22[lane] - d2[lane] * c12[lane]) / D * tau;
+      float dA = (d1[lane] * c21[lane] - d2[lane] * c11[lane]) / D;
+      time[lane] += dt;
+      ampl[lane] += dA;
+      chi2[lane] = sumChi2[lane];
+      if (!(std::abs(dA) > 1 || std::abs(dt) > 0.01)) {
+        active[lane] = false;
+        converged[lane] = true;
+      }
+    }
+  }
+
+  for (int lane = 0; lane < nlanes; lane++) {
+    int channel = mFitChannels[first + lane];
+    if (converged[lane]) {
+      mStatus[channel] = ChannelStatus_t::FIT_DONE;
+      mAmp[channel] = ampl[lane];
+      mTime[channel] = time[lane];
+      mChi2[channel] = chi2[lane];
+    } else {
+      mStatus[channel] = ChannelStatus_t::FIT_FAILED;
+      mChi2[channel] = 1.e9;
+    }
+  }
+}
+
+CaloFitResults CaloRawFitterBatch::getResult(int channel) const
+{
+  // Same selection of the final values as CaloRawFitterGamma2::evaluate
+  auto status = mStatus[channel];
+  if (status == ChannelStatus_t::SELECTION_ERROR) {
+    throw mError[channel];
+  }
+
+  float amp = mAmp[channel];
+  float time = mTime[channel];
+  float chi2 = 0;
+  int ndf = 0;
+  bool fitDone = status == ChannelStatus_t::FIT_DONE;
+  float timeEstimate = mTimeEstimate[channel];
+  if (status == ChannelStatus_t::FIT_DONE || status == ChannelStatus_t::FIT_FAILED) {
+    chi2 = mChi2[channel];
+    time += mTimeOffset[channel];
+    timeEstimate += mTimeOffset[channel];
+    ndf = mNSamples[channel] - 2;
+  }
+
+  if (fitDone) {
+    float ampAsymm = (amp - mAmpEstimate[channel]) / (amp + mAmpEstimate[channel]);
+    float timeDiff = time - timeEstimate;
+    if ((std::abs(ampAsymm) > 0.1) || (std::abs(timeDiff) > 2)) {
+      amp = mAmpEstimate[channel];
+      time = timeEstimate;
+      fitDone = false;
+    }
+  }
+  if (amp >= mAmpCut) {
+    if (!fitDone) {
+      amp += mJitter;
+    }
+    time = time * constants::EMCAL_TIMESAMPLE;
+    time -= mL1Phase;
+    return CaloFitResults(mMaxADC[channel], mPedestal[channel], FitAlgorithm::Gamma2, amp, time, (int)time, chi2, ndf);
+  }
+  throw CaloRawFitter::RawFitterError_t::FIT_ERROR;
+}
@@ -18,6 +18,7 @@
 #include "EMCALBase/Geometry.h"
 #include "EMCALBase/Mapper.h"
 #include "EMCALReconstruction/CaloRawFitter.h"
+#include "EMCALReconstruction/CaloRawFitterBatch.h"
 
 namespace o2
 {
@@ -54,6 +55,9 @@ class RawToCellConverterSpec : public framework::Task
   /// Input RawData: {"ROUT", "RAWDATA", 0, Lifetime::Timeframe}
   /// Output cells: {"EMC", "CELLS", 0, Lifetime::Timeframe}
   /// Output cells trigger record: {"EMC", "CELLSTR", 0, Lifetime::Timeframe}
+  ///
+  /// With the fit method gamma2batch the channels of all links are collected first
+  /// and fitted together by the batch raw fitter, using fitter-threads threads.
   void run(framework::ProcessingContext& ctx) final;
 
   /// \brief Set max number of error messages printed
@@ -66,6 +70,11 @@ class RawToCellConverterSpec : public framework::Task
   int getNoiseThreshold() { return mNoiseThreshold; }
 
  private:
+  /// \brief Count the raw fitter error and print it unless the max. number of messages is reached
+  /// \param feeID FEE ID of the link the channel belongs to
+  /// \param fiterror Error of the raw fitter
+  void handleFitError(int feeID, CaloRawFitter::RawFitterError_t fiterror);
+
   int mNoiseThreshold = 0;                                      ///< Noise threshold in raw fit
   int mNumErrorMessages = 0;                                    ///< Current number of error messages
   int mErrorMessagesSuppressed = 0;                             ///< Counter of suppressed error messages
@@ -73,6 +82,8 @@ class RawToCellConverterSpec : public framework::Task
   o2::emcal::Geometry* mGeometry = nullptr;                     ///!<! Geometry pointer
   std::unique_ptr<o2::emcal::MappingHandler> mMapper = nullptr; ///!<! Mapper
   std::unique_ptr<o2::emcal::CaloRawFitter> mRawFitter;         ///!<! Raw fitter
+  std::unique_ptr<o2::emcal::CaloRawFitterBatch> mBatchFitter;  ///!<! Batch raw fitter, fitting all channels of the timeframe together
+  int mNumFitterThreads = 1;                                    ///< Number of threads used by the batch raw fitter
   std::vector<o2::emcal::Cell> mOutputCells;                    ///< Container with output cells
   std::vector<o2::emcal::TriggerRecord> mOutputTriggerRecords;  ///< Container with output cells
   std::vector<ErrorTypeFEE> mOutputDecoderErrors;               ///< Container with decoder errors
@@ -64,6 +64,13 @@ void RawToCellConverterSpec::init(framework::InitContext& ctx)
     mRawFitter = std::unique_ptr<CaloRawFitter>(new o2::emcal::CaloRawFitterStandard);
   } else if (fitmethod == "gamma2") {
     mRawFitter = std::unique_ptr<CaloRawFitter>(new o2::emcal::CaloRawFitterGamma2);
+  } else if (fitmethod == "gamma2batch") {
+    mNumFitterThreads = ctx.options().get<int>("fitter-threads");
+    LOG(INFO) << "Using batch gamma2 raw fitter with " << mNumFitterThreads << " threads";
+    mRawFitter = std::unique_ptr<CaloRawFitter>(new o2::emcal::CaloRawFitterGamma2);
+    mBatchFitter = std::make_unique<o2::emcal::CaloRawFitterBatch>();
+    mBatchFitter->setAmpCut(mNoiseThreshold);
+    mBatchFitter->setL1Phase(0.);
   }
 
   mMaxErrorMessages = ctx.options().get<int>("maxmessage");
@@ -84,6 +91,19 @@ void RawToCellConverterSpec::run(framework::ProcessingContext& ctx)
 
   mOutputDecoderErrors.clear();
 
+  // channels waiting for the batch fit, with the index of the channel in the batch
+  struct PendingCell {
+    std::shared_ptr<std::vector<Cell>> mContainer;
+    int mCellID;
+    ChannelType_t mChannelType;
+    int mFeeID;
+    int mBatchIndex;
+  };
+  std::vector<PendingCell> pendingCells;
+  if (mBatchFitter) {
+    mBatchFitter->clear();
+  }
+
   int firstEntry = 0;
   for (const auto& rawData : framework::InputRecordWalker(ctx.inputs())) {
 
@@ -202,6 +222,13 @@ void RawToCellConverterSpec::run(framework::ProcessingContext& ctx)
         auto [phishift, etashift] = mGeometry->ShiftOnlineToOfflineCellIndexes(iSM, iRow, iCol);
         int CellID = mGeometry->GetAbsCellIdFromCellIndexes(iSM, phishift, etashift);
 
+        if (mBatchFitter) {
+          // only select the samples, the fit is done for all channels of the timeframe together
+          int batchIndex = mBatchFitter->addChannel(chan.getBunches(), decoder.getRCUTrailer().hasZeroSuppression());
+          pendingCells.push_back({currentCellContainer, CellID, chantype, static_cast<int>(feeID), batchIndex});
+          continue;
+        }
+
         // define the conatiner for the fit results, and perform the raw fitting using the stadnard raw fitter
         CaloFitResults fitResults;
         try {
@@ -214,22 +241,33 @@ void RawToCellConverterSpec::run(framework::ProcessingContext& ctx)
             fitResults.setTime(0.);
           }
         } catch (CaloRawFitter::RawFitterError_t& fiterror) {
-          if (mNumErrorMessages < mMaxErrorMessages) {
-            LOG(ERROR) << "Failure in raw fitting: " << CaloRawFitter::createErrorMessage(fiterror);
-            mNumErrorMessages++;
-            if (mNumErrorMessages == mMaxErrorMessages) {
-              LOG(ERROR) << "Max. amount of error messages (" << mMaxErrorMessages << " reached, further messages will be suppressed";
-            }
-          } else {
-            mErrorMessagesSuppressed++;
-          }
-          mOutputDecoderErrors.emplace_back(feeID, -1, CaloRawFitter::getErrorNumber(fiterror));
+          handleFitError(feeID, fiterror);
         }
         currentCellContainer->emplace_back(CellID, fitResults.getAmp() * CONVADCGEV, fitResults.getTime(), chantype);
       }
     }
   }
 
+  if (mBatchFitter) {
+    mBatchFitter->fit(mNumFitterThreads);
+    // cells are added in the order of the channels, as for the channel-by-channel fit
+    for (auto& pending : pendingCells) {
+      CaloFitResults fitResults;
+      try {
+        fitResults = mBatchFitter->getResult(pending.mBatchIndex);
+        if (fitResults.getAmp() < 0) {
+          fitResults.setAmp(0.);
+        }
+        if (fitResults.getTime() < 0) {
+          fitResults.setTime(0.);
+        }
+      } catch (CaloRawFitter::RawFitterError_t& fiterror) {
+        handleFitError(pending.mFeeID, fiterror);
+      }
+      pending.mContainer->emplace_back(pending.mCellID, fitResults.getAmp() * CONVADCGEV, fitResults.getTime(), pending.mChannelType);
+    }
+  }
+
   // Loop over BCs, sort cells with increasing tower ID and write to output containers
   mOutputCells.clear();
   mOutputTriggerRecords.clear();
@@ -250,6 +288,20 @@ void RawToCellConverterSpec::run(framework::ProcessingContext& ctx)
   ctx.outputs().snapshot(framework::Output{"EMC", "DECODERERR", 0, framework::Lifetime::Timeframe}, mOutputDecoderErrors);
 }
 
+void RawToCellConverterSpec::handleFitError(int feeID, CaloRawFitter::RawFitterError_t fiterror)
+{
+  if (mNumErrorMessages < mMaxErrorMessages) {
+    LOG(ERROR) << "Failure in raw fitting: " << CaloRawFitter::createErrorMessage(fiterror);
+    mNumErrorMessages++;
+    if (mNumErrorMessages == mMaxErrorMessages) {
+      LOG(ERROR) << "Max. amount of error messages (" << mMaxErrorMessages << " reached, further messages will be suppressed";
+    }
+  } else {
+    mErrorMessagesSuppressed++;
+  }
+  mOutputDecoderErrors.emplace_back(feeID, -1, CaloRawFitter::getErrorNumber(fiterror));
+}
+
 o2::framework::DataProcessorSpec o2::emcal::reco_workflow::getRawToCellConverterSpec()
 {
   std::vector<o2::framework::InputSpec> inputs;
@@ -264,6 +316,7 @@ o2::framework::DataProcessorSpec o2::emcal::reco_workflow::getRawToCellConverter
                                           outputs,
                                           o2::framework::adaptFromTask<o2::emcal::reco_workflow::RawToCellConverterSpec>(),
                                           o2::framework::Options{
-                                            {"fitmethod", o2::framework::VariantType::String, "gamma2", {"Fit method (standard or gamma2)"}},
+                                            {"fitmethod", o2::framework::VariantType::String, "gamma2", {"Fit method (standard, gamma2 or gamma2batch)"}},
+                                            {"fitter-threads", o2::framework::VariantType::Int, 1, {"Number of threads of the batch raw fitter (fit method gamma2batch)"}},
                                             {"maxmessage", o2::framework::VariantType::Int, 100, {"Max. amout of error messages to be displayed"}}}};
 }
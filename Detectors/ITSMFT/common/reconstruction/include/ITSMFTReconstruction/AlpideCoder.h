@@ -13,6 +13,7 @@
 #define ALICEO2_ITSMFT_ALPIDE_CODER_H
 
 #include <Rtypes.h>
+#include <array>
 #include <cstdio>
 #include <cstdint>
 #include <vector>
@@ -79,6 +80,11 @@ class AlpideCoder
   static constexpr int NDColInReg = NCols / NRegions / 2;
   static constexpr int HitMapSize = 7;
 
+  struct HitMapEntry { // decoded DATALONG hit map: number of extra hits and their address offsets
+    uint8_t nHits = 0;
+    uint8_t offsets[HitMapSize] = {0};
+  };
+
   // masks for records components
   static constexpr uint32_t MaskEncoder = 0x3c00;                 // encoder (double column) ID takes 4 bit max (0:15)
   static constexpr uint32_t MaskPixID = 0x3ff;                    // pixel ID within encoder (double column) takes 10 bit max (0:1023)
@@ -137,11 +143,12 @@ class AlpideCoder
 
     while (buffer.next(dataC)) {
       //
-      // ---------- chip info ?
-      uint8_t dataCM = dataC & (~MaskChipID);
+      // the flags table tells which of the expected records this byte can be, checked in order of priority
+      uint32_t match = mRecordFlags[dataC] & expectInp;
       //
-      if ((expectInp & ExpectChipEmpty) && dataCM == CHIPEMPTY) { // empty chip was expected
-        chipData.setChipID(cidGetter(dataC & MaskChipID));        // here we set the global chip ID
+      // ---------- chip info ?
+      if (match & ExpectChipEmpty) {                       // empty chip was expected
+        chipData.setChipID(cidGetter(dataC & MaskChipID)); // here we set the global chip ID
         if (!buffer.next(timestamp)) {
 #ifdef ALPIDE_DECODING_STAT
           chipData.setError(ChipStat::TruncatedChipEmpty);
@@ -152,8 +159,8 @@ class AlpideCoder
         continue;
       }
 
-      if ((expectInp & ExpectChipHeader) && dataCM == CHIPHEADER) { // chip header was expected
-        chipData.setChipID(cidGetter(dataC & MaskChipID));          // here we set the global chip ID
+      if (match & ExpectChipHeader) {                      // chip header was expected
+        chipData.setChipID(cidGetter(dataC & MaskChipID)); // here we set the global chip ID
         if (!buffer.next(timestamp)) {
 #ifdef ALPIDE_DECODING_STAT
           chipData.setError(ChipStat::TruncatedChipHeader);
@@ -165,13 +172,13 @@ class AlpideCoder
       }
 
       // region info ?
-      if ((expectInp & ExpectRegion) && (dataC & REGION) == REGION) { // chip header was seen, or hit data read
+      if (match & ExpectRegion) { // chip header was seen, or hit data read
         region = dataC & MaskRegion;
         expectInp = ExpectData;
         continue;
       }
 
-      if ((expectInp & ExpectChipTrailer) && dataCM == CHIPTRAILER) { // chip trailer was expected
+      if (match & ExpectChipTrailer) { // chip trailer was expected
         expectInp = ExpectChipHeader | ExpectChipEmpty;
         chipData.setROFlags(dataC & MaskROFlags);
 #ifdef ALPIDE_DECODING_STAT
@@ -204,8 +211,8 @@ class AlpideCoder
 
       // hit info ?
       if ((expectInp & ExpectData)) {
-        if (isData(dataC)) { // region header was seen, expect data
-                             // note that here we are checking on the byte rather than the short, need complete to ushort
+        if (match & ExpectData) { // region header was seen, expect data
+                                  // note that here we are checking on the byte rather than the short, need complete to ushort
           dataS = dataC << 8;
           if (!buffer.next(dataC)) {
 #ifdef ALPIDE_DECODING_STAT
@@ -233,7 +240,7 @@ class AlpideCoder
             nRightCHits = 0; // reset the buffer
           }
 
-          bool rightC = (row & 0x1) ? !(pixID & 0x1) : (pixID & 0x1); // true for right column / lalse for left
+          bool rightC = (row ^ pixID) & 0x1; // true for right column / lalse for left
 
           // we want to have hits sorted in column/row, so the hits in right column of given double column
           // are first collected in the temporary buffer
@@ -257,16 +264,16 @@ class AlpideCoder
               chipData.setError(ChipStat::WrongDataLongPattern);
             }
 #endif
-            for (int ip = 0; ip < HitMapSize; ip++) {
-              if (hitsPattern & (0x1 << ip)) {
-                uint16_t addr = pixID + ip + 1, rowE = addr >> 1;
-                rightC = ((rowE & 0x1) ? !(addr & 0x1) : (addr & 0x1)); // true for right column / lalse for left
-                // the real columnt is int colE = colD + rightC;
-                if (rightC) { // same as above
-                  rightColHits[nRightCHits++] = rowE;
-                } else {
-                  addHit(chipData, rowE, colD + rightC); // left column hits are added directly to the container
-                }
+            // the positions of the extra hits are taken from the hit map table instead of testing every bit
+            const auto& hitMap = mHitMapLUT[hitsPattern & MaskHitMap];
+            for (int ih = 0; ih < hitMap.nHits; ih++) {
+              uint16_t addr = pixID + hitMap.offsets[ih], rowE = addr >> 1;
+              rightC = (rowE ^ addr) & 0x1; // true for right column / lalse for left
+              // the real columnt is int colE = colD + rightC;
+              if (rightC) { // same as above
+                rightColHits[nRightCHits++] = rowE;
+              } else {
+                addHit(chipData, rowE, colD); // left column hits are added directly to the container
               }
             }
           }
@@ -426,6 +433,9 @@ class AlpideCoder
 
   static const NoiseMap* mNoisyPixels;
 
+  static const std::array<uint8_t, 256> mRecordFlags;   // Expect... flags of the records a byte may represent
+  static const std::array<HitMapEntry, 128> mHitMapLUT; // decoded DATALONG hit maps
+
   // cluster map used for the ENCODING only
   std::vector<int> mFirstInRow;     //! entry of 1st pixel of each non-empty row in the mPix2Encode
   std::vector<PixLink> mPix2Encode; //! pool of links: fired pixel + index of the next one in the row
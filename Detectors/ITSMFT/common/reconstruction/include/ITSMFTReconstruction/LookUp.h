@@ -36,13 +36,16 @@ class LookUp
   LookUp();
   LookUp(std::string fileName);
   static int groupFinder(int nRow, int nCol);
-  int findGroupID(int nRow, int nCol, const unsigned char patt[ClusterPattern::MaxPatternBytes]);
+  /// thread safe, without perfect hash (e.g. if it could not be built) the maps of the dictionary are used
+  int findGroupID(int nRow, int nCol, const unsigned char patt[ClusterPattern::MaxPatternBytes]) const;
   int getTopologiesOverThreshold() { return mTopologiesOverThreshold; }
   void loadDictionary(std::string fileName);
   bool isGroup(int id) const;
   int size() const { return mDictionary.getSize(); }
 
  private:
+  int findGroupEntry(int nRow, int nCol) const;
+
   TopologyDictionary mDictionary;
   int mTopologiesOverThreshold;
 
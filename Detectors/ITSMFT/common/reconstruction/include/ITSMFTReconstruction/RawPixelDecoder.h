@@ -97,6 +97,7 @@ class RawPixelDecoder final : public PixelReader
   uint32_t getNPixelsFiredROF() const { return mNPixelsFiredROF; }
   size_t getNChipsFired() const { return mNChipsFired; }
   size_t getNPixelsFired() const { return mNPixelsFired; }
+  size_t getNBytesRaw() const { return mNBytesRaw; }
 
   struct LinkEntry {
     int entry = -1;
@@ -133,6 +134,7 @@ class RawPixelDecoder final : public PixelReader
   uint32_t mNLinksDone = 0;                       // number of links reached end of data
   size_t mNChipsFired = 0;                        // global counter
   size_t mNPixelsFired = 0;                       // global counter
+  size_t mNBytesRaw = 0;                          // global counter of raw data bytes fed to the decoder
   TStopwatch mTimerTFStart;
   TStopwatch mTimerDecode;
   TStopwatch mTimerFetchData;
@@ -18,6 +18,46 @@ using namespace o2::itsmft;
 
 const NoiseMap* AlpideCoder::mNoisyPixels = nullptr;
 
+//_____________________________________
+// for every byte value the Expect... flags of the records it may start
+const std::array<uint8_t, 256> AlpideCoder::mRecordFlags = []() {
+  std::array<uint8_t, 256> flags{};
+  for (int b = 0; b < 256; b++) {
+    uint8_t v = b, vm = v & (~MaskChipID);
+    if (vm == CHIPEMPTY) {
+      flags[b] |= ExpectChipEmpty;
+    }
+    if (vm == CHIPHEADER) {
+      flags[b] |= ExpectChipHeader;
+    }
+    if ((v & REGION) == REGION) {
+      flags[b] |= ExpectRegion;
+    }
+    if (vm == CHIPTRAILER) {
+      flags[b] |= ExpectChipTrailer;
+    }
+    if (isData(v)) {
+      flags[b] |= ExpectData;
+    }
+  }
+  return flags;
+}();
+
+//_____________________________________
+// for every DATALONG hit map the offsets of the extra hits wrt the address of the 1st hit
+const std::array<AlpideCoder::HitMapEntry, 128> AlpideCoder::mHitMapLUT = []() {
+  std::array<HitMapEntry, 128> lut{};
+  for (int map = 0; map < 128; map++) {
+    auto& entry = lut[map];
+    for (int ip = 0; ip < HitMapSize; ip++) {
+      if (map & (0x1 << ip)) {
+        entry.offsets[entry.nHits++] = ip + 1;
+      }
+    }
+  }
+  return lut;
+}();
+
 //_____________________________________
 void AlpideCoder::print() const
 {
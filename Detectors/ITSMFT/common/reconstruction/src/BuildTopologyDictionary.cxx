@@ -80,8 +80,7 @@ void BuildTopologyDictionary::setThreshold(double thr)
             [](const std::pair<unsigned long, unsigned long>& couple1,
                const std::pair<unsigned long, unsigned long>& couple2) { return (couple1.first > couple2.first); });
   mNCommonTopologies = 0;
-  mDictionary.mCommonMap.clear();
-  mDictionary.mGroupMap.clear();
+  mDictionary.clearMaps();
   mFrequencyThreshold = thr;
   for (auto& q : mTopologyFrequency) {
     if (((double)q.first) / mTotClusters > thr) {
@@ -102,8 +101,7 @@ void BuildTopologyDictionary::setNCommon(unsigned int nCommon)
             [](const std::pair<unsigned long, unsigned long>& couple1,
                const std::pair<unsigned long, unsigned long>& couple2) { return (couple1.first > couple2.first); });
   mNCommonTopologies = nCommon;
-  mDictionary.mCommonMap.clear();
-  mDictionary.mGroupMap.clear();
+  mDictionary.clearMaps();
   mFrequencyThreshold = ((double)mTopologyFrequency[mNCommonTopologies - 1].first) / mTotClusters;
 }
 
@@ -121,8 +119,7 @@ void BuildTopologyDictionary::setThresholdCumulative(double cumulative)
             [](const std::pair<unsigned long, unsigned long>& couple1,
                const std::pair<unsigned long, unsigned long>& couple2) { return (couple1.first > couple2.first); });
   mNCommonTopologies = 0;
-  mDictionary.mCommonMap.clear();
-  mDictionary.mGroupMap.clear();
+  mDictionary.clearMaps();
   for (auto& q : mTopologyFrequency) {
     totFreq += ((double)(q.first)) / mTotClusters;
     if (totFreq < cumulative) {
@@ -241,6 +238,7 @@ void BuildTopologyDictionary::groupRareTopologies()
       mDictionary.mGroupMap.insert(std::make_pair((int)(gr.mHash >> 32) & 0x00000000ffffffff, iKey));
     }
   }
+  mDictionary.buildPerfectHash();
   std::cout << "Dictionay finalised" << std::endl;
   std::cout << "Number of keys: " << mDictionary.getSize() << std::endl;
   std::cout << "Number of common topologies: " << mDictionary.mCommonMap.size() << std::endl;
@@ -34,6 +34,8 @@ LookUp::LookUp(std::string fileName)
 
 void LookUp::loadDictionary(std::string fileName)
 {
+  // the perfect hash is built once here by readBinaryFile: findGroupID is called concurrently
+  // by the clusterization threads and must not modify the dictionary
   mDictionary.readBinaryFile(fileName);
   mTopologiesOverThreshold = mDictionary.mCommonMap.size();
 }
@@ -57,27 +59,32 @@ int LookUp::groupFinder(int nRow, int nCol)
   return grNum;
 }
 
-int LookUp::findGroupID(int nRow, int nCol, const unsigned char patt[ClusterPattern::MaxPatternBytes])
+int LookUp::findGroupEntry(int nRow, int nCol) const
+{
+  // a group missing from the dictionary maps to the first entry, as the former mGroupMap[index] did
+  int ID = mDictionary.findGroupEntry(groupFinder(nRow, nCol));
+  return ID >= 0 ? ID : 0;
+}
+
+int LookUp::findGroupID(int nRow, int nCol, const unsigned char patt[ClusterPattern::MaxPatternBytes]) const
 {
   int nBits = nRow * nCol;
-  // Small topology
+  // Small topology: direct index
   if (nBits < 9) {
     int ID = mDictionary.mSmallTopologiesLUT[(nCol - 1) * 255 + (int)patt[0]];
     if (ID >= 0) {
       return ID;
     } else { //small rare topology (inside groups)
-      int index = groupFinder(nRow, nCol);
-      return mDictionary.mGroupMap[index];
+      return findGroupEntry(nRow, nCol);
     }
   }
-  // Big topology
+  // Big topology: perfect hash
   unsigned long hash = ClusterTopology::getCompleteHash(nRow, nCol, patt);
-  auto ret = mDictionary.mCommonMap.find(hash);
-  if (ret != mDictionary.mCommonMap.end()) {
-    return ret->second;
+  int ID = mDictionary.findCommonID(hash);
+  if (ID >= 0) {
+    return ID;
   } else { // Big rare topology (inside groups)
-    int index = groupFinder(nRow, nCol);
-    return mDictionary.mGroupMap[index];
+    return findGroupEntry(nRow, nCol);
   }
 }
 
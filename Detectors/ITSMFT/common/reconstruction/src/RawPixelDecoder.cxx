@@ -59,6 +59,11 @@ void RawPixelDecoder<Mapping>::printReport(bool decstat, bool skipNoErr) const
   real += tmrF.RealTime();
   LOGF(INFO, "%s Timing Total:     CPU = %.3e Real = %.3e in %d slots in %s mode", mSelfName, cpu, real, tmrS.Counter() - 1,
        mDecodeNextAuto ? "AutoDecode" : "ExternalCall");
+  if (tmrD.RealTime() > 0.) {
+    double gb = mNBytesRaw / double(1 << 30);
+    LOGF(INFO, "%s Throughput: %.3f GB of raw data, %.3f GB/s (Decode real time), %.3f GB/s (Decode CPU time)", mSelfName,
+         gb, gb / tmrD.RealTime(), tmrD.CpuTime() > 0. ? gb / tmrD.CpuTime() : 0.);
+  }
 
   if (decstat) {
     LOG(INFO) << "GBT Links decoding statistics" << (skipNoErr ? " (only links with errors are reported)" : "");
@@ -211,6 +216,7 @@ void RawPixelDecoder<Mapping>::setupLinks(InputRecord& inputs)
       currSSpec = dh->subSpecification;
     }
     link.cacheData(it.raw(), RDHUtils::getMemorySize(rdh));
+    mNBytesRaw += RDHUtils::getMemorySize(rdh);
   }
 
   if (linksAdded) { // new links were added, update link<->RU mapping, usually is done for 1st TF only
@@ -0,0 +1,127 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test AlpideCoder
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+#include "ITSMFTReconstruction/AlpideCoder.h"
+#include "ITSMFTReconstruction/PayLoadCont.h"
+#include "ITSMFTReconstruction/PixelData.h"
+
+using namespace o2::itsmft;
+
+using Hits = std::vector<std::pair<uint16_t, uint16_t>>; // column, row
+
+/// fill the chip with the hits, sorted in row/col as expected by the encoder
+void fillChip(ChipPixelData& chip, std::set<std::pair<uint16_t, uint16_t>> const& rowCol)
+{
+  chip.clear();
+  for (auto [row, col] : rowCol) {
+    chip.getData().emplace_back(row, col);
+  }
+}
+
+/// hits of the chip sorted in column/row
+Hits getHits(ChipPixelData const& chip)
+{
+  Hits hits;
+  for (auto const& pix : chip.getData()) {
+    hits.emplace_back(pix.getCol(), pix.getRow());
+  }
+  std::sort(hits.begin(), hits.end());
+  return hits;
+}
+
+BOOST_AUTO_TEST_CASE(AlpideCoder_roundTrip)
+{
+  // clusters of adjacent pixels produce DATALONG records with hit maps,
+  // isolated pixels DATASHORT records
+  std::mt19937 rng(1234);
+  std::uniform_int_distribution<int> rowDist(0, AlpideCoder::NRows - 4);
+  std::uniform_int_distribution<int> colDist(0, AlpideCoder::NCols - 4);
+  std::uniform_int_distribution<int> sizeDist(1, 3);
+
+  constexpr int NChips = 9;
+  std::vector<std::set<std::pair<uint16_t, uint16_t>>> chipHits(NChips);
+  for (int ichip = 0; ichip < NChips; ichip++) {
+    int nClusters = ichip == 4 ? 0 : 1 << ichip; // chip 4 is left empty
+    for (int icl = 0; icl < nClusters; icl++) {
+      int row0 = rowDist(rng), col0 = colDist(rng), nRows = sizeDist(rng), nCols = sizeDist(rng);
+      for (int row = row0; row < row0 + nRows; row++) {
+        for (int col = col0; col < col0 + nCols; col++) {
+          chipHits[ichip].emplace(row, col);
+        }
+      }
+    }
+  }
+  // a full double column and a full row
+  for (int row = 0; row < AlpideCoder::NRows; row++) {
+    chipHits[8].emplace(row, 100);
+    chipHits[8].emplace(row, 101);
+  }
+  for (int col = 0; col < AlpideCoder::NCols; col++) {
+    chipHits[8].emplace(300, col);
+  }
+
+  AlpideCoder coder;
+  PayLoadCont buffer(1 << 20);
+  ChipPixelData chip;
+  const uint16_t bc = 0x3a8;
+  for (int ichip = 0; ichip < NChips; ichip++) {
+    fillChip(chip, chipHits[ichip]);
+    coder.encodeChip(buffer, chip, ichip, bc, ichip & 0xf);
+  }
+
+  ChipPixelData decoded;
+  int nDecoded = 0;
+  for (int ichip = 0; ichip < NChips; ichip++) {
+    if (chipHits[ichip].empty()) { // empty chips are skipped by the decoder
+      continue;
+    }
+    fillChip(chip, chipHits[ichip]);
+    int ret = AlpideCoder::decodeChip(decoded, buffer, [](uint16_t id) { return id + 1000; });
+    BOOST_REQUIRE_EQUAL(ret, int(chipHits[ichip].size()));
+    BOOST_CHECK_EQUAL(decoded.getChipID(), ichip + 1000);
+    BOOST_CHECK_EQUAL(decoded.getROFlags(), ichip & 0xf);
+    auto expected = getHits(chip), found = getHits(decoded);
+    BOOST_CHECK(expected == found);
+    // the hits come out sorted in column/row
+    for (size_t ih = 1; ih < decoded.getData().size(); ih++) {
+      auto const& prev = decoded.getData()[ih - 1];
+      auto const& cur = decoded.getData()[ih];
+      BOOST_CHECK(prev.getCol() < cur.getCol() || (prev.getCol() == cur.getCol() && prev.getRow() < cur.getRow()));
+    }
+    nDecoded++;
+  }
+  BOOST_CHECK_EQUAL(nDecoded, NChips - 1);
+  BOOST_CHECK_EQUAL(AlpideCoder::decodeChip(decoded, buffer, [](uint16_t id) { return id; }), 0);
+}
+
+BOOST_AUTO_TEST_CASE(AlpideCoder_truncated)
+{
+  ChipPixelData chip;
+  chip.getData().emplace_back(10, 20);
+  chip.getData().emplace_back(11, 20);
+  AlpideCoder coder;
+  PayLoadCont buffer(1024);
+  coder.encodeChip(buffer, chip, 3, 0);
+  // drop the chip trailer and the hit map of the DATALONG record
+  PayLoadCont truncated(1024);
+  truncated.add(buffer.getPtr(), buffer.getSize() - 2);
+  ChipPixelData decoded;
+  BOOST_CHECK_EQUAL(AlpideCoder::decodeChip(decoded, truncated, [](uint16_t id) { return id; }), AlpideCoder::Error);
+}
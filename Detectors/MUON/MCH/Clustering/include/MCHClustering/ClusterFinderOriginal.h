@@ -25,13 +25,13 @@
 
 #include <gsl/span>
 
-#include <TH2D.h>
-
 #include "DataFormatsMCH/Digit.h"
 #include "MCHBase/ClusterBlock.h"
 #include "MCHMappingInterface/Segmentation.h"
 #include "MCHPreClustering/PreClusterFinder.h"
 
+class TRandom;
+
 namespace o2
 {
 namespace mch
@@ -40,6 +40,7 @@ namespace mch
 class PadOriginal;
 class ClusterOriginal;
 class MathiesonOriginal;
+class PixelGridOriginal;
 
 class ClusterFinderOriginal
 {
@@ -56,6 +57,8 @@ class ClusterFinderOriginal
   void deinit();
   void reset();
 
+  void setRandomSeed(uint32_t seed);
+
   void findClusters(gsl::span<const Digit> digits);
 
   /// return the list of reconstructed clusters
@@ -74,18 +77,18 @@ class ClusterFinderOriginal
   void processPreCluster();
 
   void buildPixArray();
-  void ProjectPadOverPixels(const PadOriginal& pad, TH2D& hCharges, TH2I& hEntries) const;
+  void ProjectPadOverPixels(const PadOriginal& pad, PixelGridOriginal& charges, PixelGridOriginal& entries) const;
 
-  void findLocalMaxima(std::unique_ptr<TH2D>& histAnode, std::multimap<double, std::pair<int, int>, std::greater<>>& localMaxima);
-  void flagLocalMaxima(const TH2D& histAnode, int i0, int j0, std::vector<std::vector<int>>& isLocalMax) const;
-  void restrictPreCluster(const TH2D& histAnode, int i0, int j0);
+  void findLocalMaxima(std::multimap<double, std::pair<int, int>, std::greater<>>& localMaxima);
+  void flagLocalMaxima(const PixelGridOriginal& histAnode, int i0, int j0, std::vector<std::vector<int>>& isLocalMax) const;
+  void restrictPreCluster(int i0, int j0);
 
   void processSimple();
   void process();
   void addVirtualPad();
   void computeCoefficients(std::vector<double>& coef, std::vector<double>& prob) const;
   double mlem(const std::vector<double>& coef, const std::vector<double>& prob, int nIter);
-  void findCOG(const TH2D& histMLEM, double xy[2]) const;
+  void findCOG(const PixelGridOriginal& histMLEM, double xy[2]) const;
   void refinePixelArray(const double xyCOG[2], size_t nPixMax, double& xMin, double& xMax, double& yMin, double& yMax);
   void cleanPixelArray(double threshold, std::vector<double>& prob);
 
@@ -96,8 +99,8 @@ class ClusterFinderOriginal
   void param2ChargeFraction(const double param[SNFitParamMax], int nParamUsed, double fraction[SNFitClustersMax]) const;
   float chargeIntegration(double x, double y, const PadOriginal& pad) const;
 
-  void split(const TH2D& histMLEM, const std::vector<double>& coef);
-  void addPixel(const TH2D& histMLEM, int i0, int j0, std::vector<int>& pixels, std::vector<std::vector<bool>>& isUsed);
+  void split(const PixelGridOriginal& histMLEM, const std::vector<double>& coef);
+  void addPixel(const PixelGridOriginal& histMLEM, int i0, int j0, std::vector<int>& pixels, std::vector<std::vector<bool>>& isUsed);
   void addCluster(int iCluster, std::vector<int>& coupledClusters, std::vector<bool>& isClUsed,
                   const std::vector<std::vector<double>>& couplingClCl) const;
   void extractLeastCoupledClusters(std::vector<int>& coupledClusters, std::vector<int>& clustersForFit,
@@ -123,6 +126,13 @@ class ClusterFinderOriginal
   std::unique_ptr<ClusterOriginal> mPreCluster; ///< precluster currently processed
   std::vector<PadOriginal> mPixels;             ///< list of pixels for the current precluster
 
+  std::unique_ptr<PixelGridOriginal> mPixelCharges; ///< pixel charges projected from the pads
+  std::unique_ptr<PixelGridOriginal> mPixelEntries; ///< pixel entries projected from the pads
+  std::unique_ptr<PixelGridOriginal> mHistAnode;    ///< pixel grid used to find the local maxima
+  std::unique_ptr<PixelGridOriginal> mHistMLEM;     ///< pixel grid used by the MLEM algorithm
+
+  std::unique_ptr<TRandom> mRandom; ///< random generator owned by this cluster finder (gRandom if not set)
+
   const mapping::Segmentation* mSegmentation = nullptr; ///< pointer to the DE segmentation for the current precluster
 
   std::vector<ClusterStruct> mClusters{}; ///< list of reconstructed clusters
@@ -0,0 +1,115 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file PixelGridOriginal.h
+/// \brief Definition of the pixel grid used by the original cluster finder algorithm
+
+#ifndef ALICEO2_MCH_PIXELGRIDORIGINAL_H_
+#define ALICEO2_MCH_PIXELGRIDORIGINAL_H_
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace o2
+{
+namespace mch
+{
+
+/// dense 2D grid of pixel charges for internal use, replacing the TH2 histograms of the original algorithm
+/// the binning follows the conventions of ROOT (bins 1 to n, 0 and n+1 for underflow and overflow)
+/// such that the results are identical, but the memory is kept from one precluster to the next
+class PixelGridOriginal
+{
+ public:
+  PixelGridOriginal() = default;
+  ~PixelGridOriginal() = default;
+
+  PixelGridOriginal(const PixelGridOriginal&) = delete;
+  PixelGridOriginal& operator=(const PixelGridOriginal&) = delete;
+  PixelGridOriginal(PixelGridOriginal&&) = delete;
+  PixelGridOriginal& operator=(PixelGridOriginal&&) = delete;
+
+  /// set the binning and reset the content
+  void reset(int nBinsX, double xMin, double xMax, int nBinsY, double yMin, double yMax)
+  {
+    mNBins[0] = nBinsX;
+    mNBins[1] = nBinsY;
+    mMin[0] = xMin;
+    mMin[1] = yMin;
+    mMax[0] = xMax;
+    mMax[1] = yMax;
+    mContent.assign((nBinsX + 2) * (nBinsY + 2), 0.);
+  }
+
+  /// return the number of bins in x or y
+  int nBins(int ixy) const { return mNBins[ixy]; }
+  /// return the lower edge of the grid in x or y
+  double min(int ixy) const { return mMin[ixy]; }
+  /// return the upper edge of the grid in x or y
+  double max(int ixy) const { return mMax[ixy]; }
+  /// return the bin width in x or y
+  double binWidth(int ixy) const { return (mMax[ixy] - mMin[ixy]) / mNBins[ixy]; }
+  /// return the center of bin i in x or y
+  double binCenter(int ixy, int i) const
+  {
+    double width = binWidth(ixy);
+    return mMin[ixy] + (i - 1) * width + 0.5 * width;
+  }
+  /// return the bin containing the position xy in x or y, 0 (n+1) if below (above) the grid
+  int findBin(int ixy, double xy) const
+  {
+    if (xy < mMin[ixy]) {
+      return 0;
+    } else if (!(xy < mMax[ixy])) {
+      return mNBins[ixy] + 1;
+    }
+    return 1 + static_cast<int>(mNBins[ixy] * (xy - mMin[ixy]) / (mMax[ixy] - mMin[ixy]));
+  }
+
+  /// return the content of bin (i,j)
+  double content(int i, int j) const { return mContent[index(i, j)]; }
+  /// set the content of bin (i,j)
+  void setContent(int i, int j, double content) { mContent[index(i, j)] = content; }
+  /// add the charge to the bin containing the position (x,y)
+  void fill(double x, double y, double charge) { mContent[index(findBin(0, x), findBin(1, y))] += charge; }
+
+  /// return the maximum content of the bins in the grid and their indices (first bin found)
+  double maximum(int& iMax, int& jMax) const
+  {
+    double maxContent = -std::numeric_limits<float>::max();
+    iMax = jMax = 0;
+    for (int j = 1; j <= mNBins[1]; ++j) {
+      for (int i = 1; i <= mNBins[0]; ++i) {
+        if (content(i, j) > maxContent) {
+          maxContent = content(i, j);
+          iMax = i;
+          jMax = j;
+        }
+      }
+    }
+    return maxContent;
+  }
+
+ private:
+  /// return the index of bin (i,j) in the array of bins
+  int index(int i, int j) const { return j * (mNBins[0] + 2) + i; }
+
+  int mNBins[2] = {0, 0};         ///< number of bins in x and y
+  double mMin[2] = {0., 0.};      ///< lower edges of the grid
+  double mMax[2] = {0., 0.};      ///< upper edges of the grid
+  std::vector<double> mContent{}; ///< content of the bins, including underflows and overflows
+};
+
+} // namespace mch
+} // namespace o2
+
+#endif // ALICEO2_MCH_PIXELGRIDORIGINAL_H_
@@ -0,0 +1,110 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file SimulatedDigits.h
+/// \brief Simple generation of MCH digits from Mathieson clusters, for the clustering tests and benchmarks
+
+#ifndef ALICEO2_MCH_SIMULATEDDIGITS_H_
+#define ALICEO2_MCH_SIMULATEDDIGITS_H_
+
+#include <map>
+#include <random>
+#include <vector>
+
+#include "DataFormatsMCH/Digit.h"
+#include "MCHClustering/ClusterizerParam.h"
+#include "MCHMappingInterface/Segmentation.h"
+#include "MathiesonOriginal.h"
+
+namespace o2
+{
+namespace mch
+{
+namespace test
+{
+
+/// position of a simulated hit
+struct SimulatedHit {
+  double x;
+  double y;
+};
+
+/// generate the digits of nHits clusters at random positions on the detection element deId
+/// the charge of each hit follows an exponential distribution and is spread over the pads with the Mathieson
+/// function used by the clustering, the digits are sorted by pad index
+/// if margin > 0, the hits are at least at this distance (cm) from the edges of both cathodes
+inline std::vector<Digit> simulateDigits(int deId, int nHits, std::mt19937& gen, std::vector<SimulatedHit>* hits = nullptr,
+                                         double margin = 0.)
+{
+  const auto& segmentation = o2::mch::mapping::segmentation(deId);
+  const auto& param = ClusterizerParam::Instance();
+  MathiesonOriginal mathieson;
+  if (deId < 300) {
+    mathieson.setPitch(param.pitchSt1);
+    mathieson.setSqrtKx3AndDeriveKx2Kx4(param.mathiesonSqrtKx3St1);
+    mathieson.setSqrtKy3AndDeriveKy2Ky4(param.mathiesonSqrtKy3St1);
+  } else {
+    mathieson.setPitch(param.pitchSt2345);
+    mathieson.setSqrtKx3AndDeriveKx2Kx4(param.mathiesonSqrtKx3St2345);
+    mathieson.setSqrtKy3AndDeriveKy2Ky4(param.mathiesonSqrtKy3St2345);
+  }
+
+  std::uniform_int_distribution<int> padDist(0, segmentation.nofPads() - 1);
+  std::uniform_real_distribution<double> offsetDist(-0.5, 0.5);
+  std::exponential_distribution<double> chargeDist(1. / 500.);
+
+  std::map<int, double> padCharges{};
+  for (int iHit = 0; iHit < nHits; ++iHit) {
+    // pick the hit position inside a random pad so that it lies on the detection element
+    double x(0.), y(0.);
+    bool accepted = false;
+    while (!accepted) {
+      int padId = padDist(gen);
+      x = segmentation.padPositionX(padId) + offsetDist(gen) * segmentation.padSizeX(padId);
+      y = segmentation.padPositionY(padId) + offsetDist(gen) * segmentation.padSizeY(padId);
+      accepted = true;
+      if (margin > 0.) {
+        int bPad(0), nbPad(0);
+        for (double dx : {-margin, margin}) {
+          for (double dy : {-margin, margin}) {
+            segmentation.findPadPairByPosition(x + dx, y + dy, bPad, nbPad);
+            accepted = accepted && segmentation.isValid(bPad) && segmentation.isValid(nbPad);
+          }
+        }
+      }
+    }
+    if (hits) {
+      hits->push_back({x, y});
+    }
+    double charge = 50. + chargeDist(gen);
+    segmentation.forEachPadInArea(x - 3., y - 3., x + 3., y + 3., [&](int iPad) {
+      double dx = segmentation.padSizeX(iPad) / 2.;
+      double dy = segmentation.padSizeY(iPad) / 2.;
+      double xPad = segmentation.padPositionX(iPad) - x;
+      double yPad = segmentation.padPositionY(iPad) - y;
+      padCharges[iPad] += charge * mathieson.integrate(xPad - dx, yPad - dy, xPad + dx, yPad + dy);
+    });
+  }
+
+  std::vector<Digit> digits{};
+  for (const auto& [padId, charge] : padCharges) {
+    if (charge > param.lowestPadCharge) {
+      digits.emplace_back(deId, padId, static_cast<uint32_t>(charge), 0);
+    }
+  }
+  return digits;
+}
+
+} // namespace test
+} // namespace mch
+} // namespace o2
+
+#endif // ALICEO2_MCH_SIMULATEDDIGITS_H_
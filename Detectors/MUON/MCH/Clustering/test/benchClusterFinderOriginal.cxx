@@ -0,0 +1,68 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file benchClusterFinderOriginal.cxx
+/// \brief Benchmark of the original cluster finder on simulated events
+///
+/// The number of hits per detection element is the benchmark argument: ~10 for pp,
+/// up to ~200 on the most central detection elements of station 1 in central Pb-Pb collisions
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include "MCHBase/PreCluster.h"
+#include "MCHClustering/ClusterFinderOriginal.h"
+#include "MCHPreClustering/PreClusterFinder.h"
+#include "SimulatedDigits.h"
+
+using namespace o2::mch;
+
+static void BM_ClusterFinderOriginal(benchmark::State& state)
+{
+  // one event per station, the clustering of the preclusters only is timed
+  std::mt19937 gen(42);
+  std::vector<Digit> digits{};
+  for (int deId : {100, 300, 500, 700, 1000}) {
+    auto deDigits = test::simulateDigits(deId, state.range(0), gen);
+    digits.insert(digits.end(), deDigits.begin(), deDigits.end());
+  }
+  PreClusterFinder preClusterFinder;
+  preClusterFinder.init();
+  preClusterFinder.loadDigits(digits);
+  preClusterFinder.run();
+  std::vector<PreCluster> preClusters{};
+  std::vector<Digit> preClusterDigits{};
+  preClusterFinder.getPreClusters(preClusters, preClusterDigits);
+  preClusterFinder.deinit();
+
+  ClusterFinderOriginal clusterFinder;
+  clusterFinder.init(false);
+  clusterFinder.setRandomSeed(1);
+  size_t nClusters(0);
+  for (auto _ : state) {
+    clusterFinder.reset();
+    for (const auto& preCluster : preClusters) {
+      clusterFinder.findClusters({&preClusterDigits[preCluster.firstDigit], preCluster.nDigits});
+    }
+    nClusters += clusterFinder.getClusters().size();
+  }
+  clusterFinder.deinit();
+
+  state.counters["preclusters"] = preClusters.size();
+  state.counters["clusters/s"] = benchmark::Counter(nClusters, benchmark::Counter::kIsRate);
+  state.counters["preclusters/s"] = benchmark::Counter(state.iterations() * preClusters.size(), benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(BM_ClusterFinderOriginal)->Arg(10)->Arg(50)->Arg(200)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
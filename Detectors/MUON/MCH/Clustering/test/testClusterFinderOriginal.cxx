@@ -0,0 +1,110 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file testClusterFinderOriginal.cxx
+/// \brief Closure test of the original cluster finder on simulated digits
+
+#define BOOST_TEST_MODULE Test MCHClustering ClusterFinderOriginal
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "MCHBase/PreCluster.h"
+#include "MCHClustering/ClusterFinderOriginal.h"
+#include "MCHPreClustering/PreClusterFinder.h"
+#include "SimulatedDigits.h"
+
+using namespace o2::mch;
+
+namespace
+{
+const std::vector<int> deIds{100, 300, 500, 819, 1025};
+
+/// run the preclustering then the clustering of every precluster of the digits
+std::vector<ClusterStruct> findClusters(const std::vector<Digit>& digits, ClusterFinderOriginal& clusterFinder)
+{
+  static auto preClusterFinder = []() {
+    auto finder = std::make_unique<PreClusterFinder>();
+    finder->init();
+    return finder;
+  }();
+  std::vector<PreCluster> preClusters{};
+  std::vector<Digit> preClusterDigits{};
+  preClusterFinder->reset();
+  preClusterFinder->loadDigits(digits);
+  preClusterFinder->run();
+  preClusterFinder->getPreClusters(preClusters, preClusterDigits);
+  clusterFinder.reset();
+  for (const auto& preCluster : preClusters) {
+    clusterFinder.findClusters({&preClusterDigits[preCluster.firstDigit], preCluster.nDigits});
+  }
+  return clusterFinder.getClusters();
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(ClustersAreFoundAtTheHits)
+{
+  ClusterFinderOriginal clusterFinder;
+  clusterFinder.init(false);
+  std::mt19937 gen(1);
+  for (int deId : deIds) {
+    for (int iEvent = 0; iEvent < 20; ++iEvent) {
+      std::vector<test::SimulatedHit> hits{};
+      auto digits = test::simulateDigits(deId, 1, gen, &hits, 1.);
+      auto clusters = findClusters(digits, clusterFinder);
+      BOOST_REQUIRE_EQUAL(clusters.size(), 1);
+      BOOST_CHECK_EQUAL(clusters[0].getDEId(), deId);
+      BOOST_CHECK_SMALL(clusters[0].x - hits[0].x, 0.2);
+      BOOST_CHECK_SMALL(clusters[0].y - hits[0].y, 0.2);
+    }
+  }
+  clusterFinder.deinit();
+}
+
+BOOST_AUTO_TEST_CASE(ReusedClusterFinderGivesIdenticalClusters)
+{
+  // the pixel grids and the other buffers are kept from one precluster to the next:
+  // clustering the same events again must give exactly the same clusters, whatever was clustered before
+  ClusterFinderOriginal clusterFinder;
+  clusterFinder.init(false);
+  std::mt19937 gen(2);
+  std::vector<std::vector<Digit>> events{};
+  for (int deId : deIds) {
+    events.emplace_back(test::simulateDigits(deId, 30, gen));
+  }
+  std::vector<std::vector<ClusterStruct>> clusters[2]{};
+  for (int iPass = 0; iPass < 2; ++iPass) {
+    clusterFinder.setRandomSeed(7);
+    for (const auto& digits : events) {
+      clusters[iPass].emplace_back(findClusters(digits, clusterFinder));
+    }
+  }
+  for (size_t iEvent = 0; iEvent < events.size(); ++iEvent) {
+    BOOST_CHECK_GT(clusters[0][iEvent].size(), 0);
+    BOOST_REQUIRE_EQUAL(clusters[0][iEvent].size(), clusters[1][iEvent].size());
+    for (size_t i = 0; i < clusters[0][iEvent].size(); ++i) {
+      const auto& cl0 = clusters[0][iEvent][i];
+      const auto& cl1 = clusters[1][iEvent][i];
+      BOOST_CHECK_EQUAL(cl0.x, cl1.x);
+      BOOST_CHECK_EQUAL(cl0.y, cl1.y);
+      BOOST_CHECK_EQUAL(cl0.ex, cl1.ex);
+      BOOST_CHECK_EQUAL(cl0.ey, cl1.ey);
+      BOOST_CHECK_EQUAL(cl0.uid, cl1.uid);
+      BOOST_CHECK_EQUAL(cl0.nDigits, cl1.nDigits);
+    }
+  }
+  clusterFinder.deinit();
+}
@@ -0,0 +1,173 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file testPixelGridOriginal.cxx
+/// \brief Check that the pixel grid of the original cluster finder reproduces the TH2 histograms it replaces
+
+#define BOOST_TEST_MODULE Test MCHClustering PixelGridOriginal
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include <TAxis.h>
+#include <TH2D.h>
+#include <TH2I.h>
+
+#include "PixelGridOriginal.h"
+
+using namespace o2::mch;
+
+/// compare the binning and the content of the grid with the ones of the histogram
+void compare(const PixelGridOriginal& grid, const TH2& hist)
+{
+  const TAxis* axis[2] = {hist.GetXaxis(), hist.GetYaxis()};
+  for (int ixy = 0; ixy < 2; ++ixy) {
+    BOOST_REQUIRE_EQUAL(grid.nBins(ixy), axis[ixy]->GetNbins());
+    BOOST_CHECK_EQUAL(grid.min(ixy), axis[ixy]->GetXmin());
+    BOOST_CHECK_EQUAL(grid.max(ixy), axis[ixy]->GetXmax());
+    BOOST_CHECK_EQUAL(grid.binWidth(ixy), axis[ixy]->GetBinWidth(1));
+    for (int i = 1; i <= grid.nBins(ixy); ++i) {
+      BOOST_CHECK_EQUAL(grid.binCenter(ixy, i), axis[ixy]->GetBinCenter(i));
+    }
+  }
+  for (int j = 1; j <= grid.nBins(1); ++j) {
+    for (int i = 1; i <= grid.nBins(0); ++i) {
+      BOOST_CHECK_EQUAL(grid.content(i, j), hist.GetBinContent(i, j));
+    }
+  }
+  int iMax(0), jMax(0), ix0(0), iy0(0), iz0(0);
+  double maximum = grid.maximum(iMax, jMax);
+  hist.GetMaximumBin(ix0, iy0, iz0);
+  BOOST_CHECK_EQUAL(iMax, ix0);
+  BOOST_CHECK_EQUAL(jMax, iy0);
+  BOOST_CHECK_EQUAL(maximum, hist.GetMaximum());
+}
+
+BOOST_AUTO_TEST_CASE(FindBinIsTAxisFindBin)
+{
+  // pixel grids as booked by the cluster finder: 2 pixels per pad width, pixel edges aligned on the pad edges
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> posDist(-100., 100.);
+  std::uniform_int_distribution<int> nBinsDist(1, 40);
+  PixelGridOriginal grid;
+  for (double width : {0.0315, 0.0375, 0.21, 0.25, 0.5, 0.714285714, 2.5}) {
+    for (int iGrid = 0; iGrid < 20; ++iGrid) {
+      int nBins = nBinsDist(gen);
+      double xMin = posDist(gen);
+      double xMax = xMin + nBins * width * 2.;
+      grid.reset(nBins, xMin, xMax, nBins, xMin, xMax);
+      TAxis axis(nBins, xMin, xMax);
+      for (int i = 0; i <= nBins + 1; ++i) {
+        // bin edges, the positions around them as tested by the cluster finder, and the centers
+        double edge = xMin + i * width * 2.;
+        for (double x : {edge, edge - 1.e-3, edge + 1.e-3, std::nextafter(edge, -1.e9), std::nextafter(edge, 1.e9), edge + width}) {
+          BOOST_CHECK_EQUAL(grid.findBin(0, x), axis.FindBin(x));
+        }
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(PixelGridIsTH2)
+{
+  // reproduce the sequences of operations of the cluster finder on both the grids and the histograms
+  std::mt19937 gen(1234);
+  std::uniform_real_distribution<double> uniform(0., 1.);
+  std::uniform_int_distribution<int> nBinsDist(1, 30);
+  PixelGridOriginal charges, entries, anode;
+  for (int iTest = 0; iTest < 100; ++iTest) {
+    int nBinsX = nBinsDist(gen);
+    int nBinsY = nBinsDist(gen);
+    double dx = 0.05 + uniform(gen), dy = 0.05 + uniform(gen);
+    double xMin = -50. + 100. * uniform(gen), yMin = -50. + 100. * uniform(gen);
+    double xMax = xMin + nBinsX * dx * 2., yMax = yMin + nBinsY * dy * 2.;
+
+    // projection of the pads over the pixels (ProjectPadOverPixels)
+    charges.reset(nBinsX, xMin, xMax, nBinsY, yMin, yMax);
+    entries.reset(nBinsX, xMin, xMax, nBinsY, yMin, yMax);
+    TH2D hCharges("Charges", "", nBinsX, xMin, xMax, nBinsY, yMin, yMax);
+    TH2I hEntries("Entries", "", nBinsX, xMin, xMax, nBinsY, yMin, yMax);
+    for (int iPad = 0; iPad < 20; ++iPad) {
+      double x = xMin + (xMax - xMin) * uniform(gen), y = yMin + (yMax - yMin) * uniform(gen);
+      double padDX = dx * (1 + static_cast<int>(4 * uniform(gen))), padDY = dy * (1 + static_cast<int>(4 * uniform(gen)));
+      double charge = 1000. * uniform(gen);
+      int entry = 1 + (iPad % 2) * 999;
+      int iMin = std::max(1, charges.findBin(0, x - padDX + 1.e-3));
+      int iMax = std::min(charges.nBins(0), charges.findBin(0, x + padDX - 1.e-3));
+      int jMin = std::max(1, charges.findBin(1, y - padDY + 1.e-3));
+      int jMax = std::min(charges.nBins(1), charges.findBin(1, y + padDY - 1.e-3));
+      BOOST_CHECK_EQUAL(iMin, std::max(1, hCharges.GetXaxis()->FindBin(x - padDX + 1.e-3)));
+      BOOST_CHECK_EQUAL(iMax, std::min(hCharges.GetNbinsX(), hCharges.GetXaxis()->FindBin(x + padDX - 1.e-3)));
+      BOOST_CHECK_EQUAL(jMin, std::max(1, hCharges.GetYaxis()->FindBin(y - padDY + 1.e-3)));
+      BOOST_CHECK_EQUAL(jMax, std::min(hCharges.GetNbinsY(), hCharges.GetYaxis()->FindBin(y + padDY - 1.e-3)));
+      for (int j = jMin; j <= jMax; ++j) {
+        for (int i = iMin; i <= iMax; ++i) {
+          double nEntries = entries.content(i, j);
+          charges.setContent(i, j, (nEntries > 0) ? std::min(charges.content(i, j), charge) : charge);
+          entries.setContent(i, j, nEntries + entry);
+          int hEntry = hEntries.GetBinContent(i, j);
+          hCharges.SetBinContent(i, j, (hEntry > 0) ? std::min(hCharges.GetBinContent(i, j), charge) : charge);
+          hEntries.SetBinContent(i, j, hEntry + entry);
+        }
+      }
+    }
+    compare(charges, hCharges);
+    compare(entries, hEntries);
+
+    // filling of the pixels at their centers (findLocalMaxima, process), with equal charges to test the maximum search
+    anode.reset(nBinsX, xMin - dx, xMax + dx, nBinsY, yMin - dy, yMax + dy);
+    TH2D hAnode("anode", "anode", nBinsX, xMin - dx, xMax + dx, nBinsY, yMin - dy, yMax + dy);
+    for (int i = 1; i <= nBinsX; ++i) {
+      for (int j = 1; j <= nBinsY; ++j) {
+        double charge = charges.content(i, j);
+        if (entries.content(i, j) > 0) {
+          anode.fill(charges.binCenter(0, i), charges.binCenter(1, j), charge);
+          hAnode.Fill(charges.binCenter(0, i), charges.binCenter(1, j), charge);
+        }
+      }
+    }
+    compare(anode, hAnode);
+
+    // update of the content of the pixels (process)
+    for (int i = 0; i < 10; ++i) {
+      double x = anode.min(0) + (anode.max(0) - anode.min(0)) * uniform(gen);
+      double y = anode.min(1) + (anode.max(1) - anode.min(1)) * uniform(gen);
+      double charge = std::round(10. * uniform(gen));
+      anode.setContent(anode.findBin(0, x), anode.findBin(1, y), charge);
+      hAnode.SetBinContent(hAnode.GetXaxis()->FindBin(x), hAnode.GetYaxis()->FindBin(y), charge);
+    }
+    compare(anode, hAnode);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ResetClearsTheGrid)
+{
+  // the grids are reused from one precluster to the next
+  PixelGridOriginal grid;
+  grid.reset(10, 0., 10., 10, 0., 10.);
+  grid.fill(5.5, 5.5, 100.);
+  grid.fill(-1., 20., 100.);
+  grid.reset(3, 0., 3., 2, 0., 2.);
+  int iMax(0), jMax(0);
+  BOOST_CHECK_EQUAL(grid.maximum(iMax, jMax), 0.);
+  BOOST_CHECK_EQUAL(iMax, 1);
+  BOOST_CHECK_EQUAL(jMax, 1);
+  for (int j = 0; j <= 3; ++j) {
+    for (int i = 0; i <= 4; ++i) {
+      BOOST_CHECK_EQUAL(grid.content(i, j), 0.);
+    }
+  }
+}
@@ -47,6 +47,14 @@ int mchCathodeSegmentationFindPadByPosition(MchCathodeSegmentationHandle segHand
   return segHandle->impl->findPadByPosition(x, y);
 }
 
+O2MCHMAPPINGIMPL3_EXPORT
+void mchCathodeSegmentationFindPadsByPositions(MchCathodeSegmentationHandle segHandle, int npoints, const double* x, const double* y, int* catPadIndices)
+{
+  for (int i = 0; i < npoints; ++i) {
+    catPadIndices[i] = segHandle->impl->findPadByPosition(x[i], y[i]);
+  }
+}
+
 O2MCHMAPPINGIMPL3_EXPORT
 int mchCathodeSegmentationFindPadByFEE(MchCathodeSegmentationHandle segHandle, int dualSampaId, int dualSampaChannel)
 {
@@ -55,6 +55,13 @@ O2MCHMAPPINGIMPL4_EXPORT int mchCathodeSegmentationFindPadByPosition(
   return segHandle->impl->findPadByPosition(x, y);
 }
 
+O2MCHMAPPINGIMPL4_EXPORT void mchCathodeSegmentationFindPadsByPositions(
+  MchCathodeSegmentationHandle segHandle, int npoints, const double* x,
+  const double* y, int* catPadIndices)
+{
+  segHandle->impl->findPadsByPositions(npoints, x, y, catPadIndices);
+}
+
 O2MCHMAPPINGIMPL4_EXPORT int mchCathodeSegmentationFindPadByFEE(
   MchCathodeSegmentationHandle segHandle, int dualSampaId, int dualSampaChannel)
 {
@@ -169,7 +176,7 @@ O2MCHMAPPINGIMPL4_EXPORT void mchCathodeSegmentationForEachNeighbouringPad(
   MchCathodeSegmentationHandle segHandle, int catPadIndex,
   MchPadHandler handler, void* userData)
 {
-  for (auto p : segHandle->impl->getNeighbouringCatPadIndexs(catPadIndex)) {
+  for (auto p : segHandle->impl->neighbouringCatPadIndexs(catPadIndex)) {
     handler(userData, p);
   }
 }
@@ -20,8 +20,11 @@
 #include "PadSize.h"
 #include "MCHMappingInterface/CathodeSegmentation.h"
 #include "CathodeSegmentationCreator.h"
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <memory>
 #include <set>
@@ -61,6 +64,10 @@ void CathodeSegmentation::fillRtree()
     mPadGroupIndex2CatPadIndexIndex.push_back(catPadIndex);
     auto& pg = mPadGroups[padGroupIndex];
     auto& pgt = mPadGroupTypes[pg.mPadGroupTypeId];
+    int fastIndexOffset = mFastIndex2CatPadIndex.size();
+    mPadGroupIndex2FastIndexOffset.push_back(fastIndexOffset);
+    mFastIndex2CatPadIndex.resize(
+      fastIndexOffset + pgt.getNofPadsX() * pgt.getNofPadsY(), -1);
     double dx{mPadSizes[pg.mPadSizeId].first};
     double dy{mPadSizes[pg.mPadSizeId].second};
     for (int ix = 0; ix < pgt.getNofPadsX(); ++ix) {
@@ -79,6 +86,8 @@ void CathodeSegmentation::fillRtree()
 
           mCatPadIndex2PadGroupIndex.push_back(padGroupIndex);
           mCatPadIndex2PadGroupTypeFastIndex.push_back(pgt.fastIndex(ix, iy));
+          mFastIndex2CatPadIndex[fastIndexOffset + pgt.fastIndex(ix, iy)] =
+            catPadIndex;
           ++catPadIndex;
         }
       }
@@ -86,6 +95,87 @@ void CathodeSegmentation::fillRtree()
   }
 }
 
+void CathodeSegmentation::fillPadGroupGrid()
+{
+  // the pad groups are enlarged by more than the tolerance used in
+  // findPadByPosition, such that all the pad groups which can contain
+  // the pad found for a position are attached to the cell of that position
+  const double margin{1E-3};
+
+  if (mPadGroups.empty()) {
+    return;
+  }
+
+  std::vector<std::array<double, 4>> boxes;
+  mGridXMin = mGridYMin = std::numeric_limits<double>::max();
+  mGridXMax = mGridYMax = std::numeric_limits<double>::lowest();
+  for (auto& pg : mPadGroups) {
+    auto& pgt = mPadGroupTypes[pg.mPadGroupTypeId];
+    double dx{mPadSizes[pg.mPadSizeId].first};
+    double dy{mPadSizes[pg.mPadSizeId].second};
+    boxes.push_back({pg.mX - margin, pg.mY - margin,
+                     pg.mX + pgt.getNofPadsX() * dx + margin,
+                     pg.mY + pgt.getNofPadsY() * dy + margin});
+    mGridXMin = std::min(mGridXMin, boxes.back()[0]);
+    mGridYMin = std::min(mGridYMin, boxes.back()[1]);
+    mGridXMax = std::max(mGridXMax, boxes.back()[2]);
+    mGridYMax = std::max(mGridYMax, boxes.back()[3]);
+  }
+
+  // about 4 cells per pad group, with square cells
+  double cellSize = std::sqrt((mGridXMax - mGridXMin) *
+                              (mGridYMax - mGridYMin) / (4 * boxes.size()));
+  mGridNofCellsX = std::max(
+    1, static_cast<int>(std::ceil((mGridXMax - mGridXMin) / cellSize)));
+  mGridNofCellsY = std::max(
+    1, static_cast<int>(std::ceil((mGridYMax - mGridYMin) / cellSize)));
+  mGridCellSizeX = (mGridXMax - mGridXMin) / mGridNofCellsX;
+  mGridCellSizeY = (mGridYMax - mGridYMin) / mGridNofCellsY;
+
+  // count, then fill, the pad groups of each cell
+  mGridCellOffsets.assign(mGridNofCellsX * mGridNofCellsY + 1, 0);
+  for (int pass = 0; pass < 2; ++pass) {
+    std::vector<int> n(mGridNofCellsX * mGridNofCellsY, 0);
+    for (auto padGroupIndex = 0; padGroupIndex < boxes.size();
+         ++padGroupIndex) {
+      auto& box = boxes[padGroupIndex];
+      int first = padGroupGridCell(box[0], box[1]);
+      int last = padGroupGridCell(box[2], box[3]);
+      for (int iy = first / mGridNofCellsX; iy <= last / mGridNofCellsX;
+           ++iy) {
+        for (int ix = first % mGridNofCellsX; ix <= last % mGridNofCellsX;
+             ++ix) {
+          int cell = ix + iy * mGridNofCellsX;
+          if (pass == 1) {
+            mGridPadGroupIndexs[mGridCellOffsets[cell] + n[cell]] =
+              padGroupIndex;
+          }
+          ++n[cell];
+        }
+      }
+    }
+    if (pass == 0) {
+      for (int cell = 0; cell < n.size(); ++cell) {
+        mGridCellOffsets[cell + 1] = mGridCellOffsets[cell] + n[cell];
+      }
+      mGridPadGroupIndexs.resize(mGridCellOffsets.back());
+    }
+  }
+}
+
+int CathodeSegmentation::padGroupGridCell(double x, double y) const
+{
+  if (mGridCellOffsets.empty() || !(x >= mGridXMin && x <= mGridXMax &&
+                                     y >= mGridYMin && y <= mGridYMax)) {
+    return -1;
+  }
+  int ix = std::min(mGridNofCellsX - 1,
+                    static_cast<int>((x - mGridXMin) / mGridCellSizeX));
+  int iy = std::min(mGridNofCellsY - 1,
+                    static_cast<int>((y - mGridYMin) / mGridCellSizeY));
+  return ix + iy * mGridNofCellsX;
+}
+
 std::set<int> getUnique(const std::vector<PadGroup>& padGroups)
 {
   // extract from padGroup vector the unique integer values given by func
@@ -123,6 +213,7 @@ CathodeSegmentation::CathodeSegmentation(
     mPadGroupIndex2CatPadIndexIndex{}
 {
   fillRtree();
+  fillPadGroupGrid();
 }
 
 std::vector<int> CathodeSegmentation::getCatPadIndexs(int dualSampaId) const
@@ -174,39 +265,105 @@ std::vector<int> CathodeSegmentation::getNeighbouringCatPadIndexs(
   return pads;
 }
 
-bool CathodeSegmentation::isValid(int catPadIndex) const
+void CathodeSegmentation::fillNeighbours() const
 {
-  return catPadIndex >= 0 && catPadIndex < static_cast<int>(mCatPadIndex2PadGroupIndex.size());
+  int nofPads = mCatPadIndex2PadGroupIndex.size();
+  mNeighbourOffsets.reserve(nofPads + 1);
+  mNeighbourOffsets.push_back(0);
+  for (auto catPadIndex = 0; catPadIndex < nofPads; ++catPadIndex) {
+    auto pads = getNeighbouringCatPadIndexs(catPadIndex);
+    mNeighbours.insert(mNeighbours.end(), pads.begin(), pads.end());
+    mNeighbourOffsets.push_back(mNeighbours.size());
+  }
 }
 
-double CathodeSegmentation::squaredDistance(int catPadIndex, double x,
-                                            double y) const
+gsl::span<const int> CathodeSegmentation::neighbouringCatPadIndexs(
+  int catPadIndex) const
 {
-  double px = padPositionX(catPadIndex) - x;
-  double py = padPositionY(catPadIndex) - y;
-  return px * px + py * py;
+  std::call_once(mNeighboursFlag, [this]() { fillNeighbours(); });
+  int first = mNeighbourOffsets[catPadIndex];
+  return {mNeighbours.data() + first,
+          static_cast<std::size_t>(mNeighbourOffsets[catPadIndex + 1] - first)};
+}
+
+bool CathodeSegmentation::isValid(int catPadIndex) const
+{
+  return catPadIndex >= 0 && catPadIndex < static_cast<int>(mCatPadIndex2PadGroupIndex.size());
 }
 
 int CathodeSegmentation::findPadByPosition(double x, double y) const
 {
+  // the candidate pads are the ones intersecting the box of half-size
+  // epsilon around (x,y), among which the closest one is selected (lowest
+  // catPadIndex in case of tie). They are looked for only in the pad groups
+  // of the grid cell containing (x,y)
   const double epsilon{1E-4};
-  auto pads =
-    getCatPadIndexs(x - epsilon, y - epsilon, x + epsilon, y + epsilon);
+
+  int cell = padGroupGridCell(x, y);
+  if (cell < 0) {
+    return InvalidCatPadIndex;
+  }
 
   double dmin{std::numeric_limits<double>::max()};
   int catPadIndex{InvalidCatPadIndex};
 
-  for (auto i = 0; i < pads.size(); ++i) {
-    double d{squaredDistance(pads[i], x, y)};
-    if (d < dmin) {
-      catPadIndex = pads[i];
-      dmin = d;
+  for (auto i = mGridCellOffsets[cell]; i < mGridCellOffsets[cell + 1]; ++i) {
+    int padGroupIndex = mGridPadGroupIndexs[i];
+    auto& pg = mPadGroups[padGroupIndex];
+    auto& pgt = mPadGroupTypes[pg.mPadGroupTypeId];
+    double dx{mPadSizes[pg.mPadSizeId].first};
+    double dy{mPadSizes[pg.mPadSizeId].second};
+    // one more pad on each side so the exact test below decides
+    int ixmin = std::max(
+      0, static_cast<int>(std::floor((x - epsilon - pg.mX) / dx)) - 1);
+    int ixmax = std::min(
+      pgt.getNofPadsX() - 1,
+      static_cast<int>(std::floor((x + epsilon - pg.mX) / dx)) + 1);
+    int iymin = std::max(
+      0, static_cast<int>(std::floor((y - epsilon - pg.mY) / dy)) - 1);
+    int iymax = std::min(
+      pgt.getNofPadsY() - 1,
+      static_cast<int>(std::floor((y + epsilon - pg.mY) / dy)) + 1);
+    int fastIndexOffset = mPadGroupIndex2FastIndexOffset[padGroupIndex];
+    for (int ix = ixmin; ix <= ixmax; ++ix) {
+      for (int iy = iymin; iy <= iymax; ++iy) {
+        int p = mFastIndex2CatPadIndex[fastIndexOffset + pgt.fastIndex(ix, iy)];
+        if (p < 0) {
+          continue;
+        }
+        // same pad box as in the rtree
+        double xmin = ix * dx + pg.mX;
+        double xmax = (ix + 1) * dx + pg.mX;
+        double ymin = iy * dy + pg.mY;
+        double ymax = (iy + 1) * dy + pg.mY;
+        if (xmin > x + epsilon || xmax < x - epsilon || ymin > y + epsilon ||
+            ymax < y - epsilon) {
+          continue;
+        }
+        // same pad position as padPositionX,Y
+        double px = pg.mX + (ix + 0.5) * dx - x;
+        double py = pg.mY + (iy + 0.5) * dy - y;
+        double d{px * px + py * py};
+        if (d < dmin || (d == dmin && p < catPadIndex)) {
+          catPadIndex = p;
+          dmin = d;
+        }
+      }
     }
   }
 
   return catPadIndex;
 }
 
+void CathodeSegmentation::findPadsByPositions(int npoints, const double* x,
+                                              const double* y,
+                                              int* catPadIndexs) const
+{
+  for (auto i = 0; i < npoints; ++i) {
+    catPadIndexs[i] = findPadByPosition(x[i], y[i]);
+  }
+}
+
 const PadGroup& CathodeSegmentation::padGroup(int catPadIndex) const
 {
   return gsl::at(mPadGroups, mCatPadIndex2PadGroupIndex[catPadIndex]);
@@ -19,8 +19,10 @@
 #include "PadGroupType.h"
 #include <vector>
 #include <set>
+#include <mutex>
 #include <ostream>
 #include <boost/geometry/index/rtree.hpp>
+#include <gsl/span>
 
 namespace o2
 {
@@ -58,10 +60,19 @@ class CathodeSegmentation
   /// catPadIndex
   std::vector<int> getNeighbouringCatPadIndexs(int catPadIndex) const;
 
+  /// Same as getNeighbouringCatPadIndexs but without allocation : the
+  /// neighbours of all the pads are computed once, at the first call.
+  gsl::span<const int> neighbouringCatPadIndexs(int catPadIndex) const;
+
   std::set<int> dualSampaIds() const { return mDualSampaIds; }
 
   int findPadByPosition(double x, double y) const;
 
+  /// Find the pads at the npoints positions (x[i],y[i]) and store them
+  /// in catPadIndexs[i].
+  void findPadsByPositions(int npoints, const double* x, const double* y,
+                           int* catPadIndexs) const;
+
   int findPadByFEE(int dualSampaId, int dualSampaChannel) const;
 
   bool hasPadByPosition(double x, double y) const
@@ -96,14 +107,18 @@ class CathodeSegmentation
 
   void fillRtree();
 
+  void fillPadGroupGrid();
+
+  int padGroupGridCell(double x, double y) const;
+
+  void fillNeighbours() const;
+
   std::ostream& showPad(std::ostream& out, int index) const;
 
   const PadGroup& padGroup(int catPadIndex) const;
 
   const PadGroupType& padGroupType(int catPadIndex) const;
 
-  double squaredDistance(int catPadIndex, double x, double y) const;
-
  private:
   int mSegType;
   bool mIsBendingPlane;
@@ -116,6 +131,27 @@ class CathodeSegmentation
   std::vector<int> mCatPadIndex2PadGroupIndex;
   std::vector<int> mCatPadIndex2PadGroupTypeFastIndex;
   std::vector<int> mPadGroupIndex2CatPadIndexIndex;
+  // catPadIndex of the pad (or -1) for each fastIndex of each pad group,
+  // starting at mPadGroupIndex2FastIndexOffset[padGroupIndex]
+  std::vector<int> mPadGroupIndex2FastIndexOffset;
+  std::vector<int> mFastIndex2CatPadIndex;
+  // uniform grid covering the pad groups : the pad groups overlapping cell i
+  // are mGridPadGroupIndexs[mGridCellOffsets[i]..mGridCellOffsets[i+1]-1]
+  double mGridXMin{0};
+  double mGridYMin{0};
+  double mGridXMax{0};
+  double mGridYMax{0};
+  double mGridCellSizeX{1};
+  double mGridCellSizeY{1};
+  int mGridNofCellsX{0};
+  int mGridNofCellsY{0};
+  std::vector<int> mGridCellOffsets;
+  std::vector<int> mGridPadGroupIndexs;
+  // neighbours of catPadIndex are mNeighbours[mNeighbourOffsets[catPadIndex]]
+  // to mNeighbours[mNeighbourOffsets[catPadIndex + 1] - 1]
+  mutable std::once_flag mNeighboursFlag;
+  mutable std::vector<int> mNeighbourOffsets;
+  mutable std::vector<int> mNeighbours;
 };
 
 CathodeSegmentation* createCathodeSegmentation(int detElemId,
@@ -146,6 +146,13 @@ class CathodeSegmentation
   /** Find the pad at position (x,y) (in cm). */
   int findPadByPosition(double x, double y) const { return mchCathodeSegmentationFindPadByPosition(mImpl, x, y); }
 
+  /** Find the pads at the npoints positions (x[i],y[i]) (in cm) and store them in catPadIndices[i].
+   * Same as calling findPadByPosition for each position, but with a single call to the implementation. */
+  void findPadsByPositions(int npoints, const double* x, const double* y, int* catPadIndices) const
+  {
+    mchCathodeSegmentationFindPadsByPositions(mImpl, npoints, x, y, catPadIndices);
+  }
+
   /** Find the pad connected to the given channel of the given dual sampa. */
   int findPadByFEE(int dualSampaId, int dualSampaChannel) const
   {
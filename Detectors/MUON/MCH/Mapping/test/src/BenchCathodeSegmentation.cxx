@@ -14,6 +14,7 @@
 
 #include <algorithm>
 #include <random>
+#include <vector>
 #include "benchmark/benchmark.h"
 #include "MCHMappingInterface/CathodeSegmentation.h"
 #include "MCHMappingSegContour/CathodeSegmentationContours.h"
@@ -107,12 +108,60 @@ BENCHMARK_DEFINE_F(BenchO2, findPadByPosition)
     }
   }
   state.counters["ntp"] = ntp;
+  state.counters["queries"] = benchmark::Counter(ntp, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK_DEFINE_F(BenchO2, findPadsByPositions)
+(benchmark::State& state)
+{
+  int detElemId = state.range(0);
+  bool isBendingPlane = state.range(1);
+  o2::mch::mapping::CathodeSegmentation seg{detElemId, isBendingPlane};
+  auto bbox = o2::mch::mapping::getBBox(seg);
+
+  const int n = 100000;
+  auto testpoints = generateUniformTestPoints(n, bbox.xmin(), bbox.ymin(), bbox.xmax(), bbox.ymax());
+  std::vector<double> x, y;
+  for (auto& tp : testpoints) {
+    x.push_back(tp.x);
+    y.push_back(tp.y);
+  }
+  std::vector<int> catPadIndices(n);
+
+  for (auto _ : state) {
+    seg.findPadsByPositions(n, x.data(), y.data(), catPadIndices.data());
+    benchmark::DoNotOptimize(catPadIndices.data());
+  }
+  state.counters["ntp"] = n;
+  state.counters["queries"] = benchmark::Counter(n, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK_DEFINE_F(BenchO2, forEachNeighbouringPad)
+(benchmark::State& state)
+{
+  int detElemId = state.range(0);
+  bool isBendingPlane = state.range(1);
+  o2::mch::mapping::CathodeSegmentation seg{detElemId, isBendingPlane};
+
+  int nneighbours{0};
+  for (auto _ : state) {
+    nneighbours = 0;
+    seg.forEachPad([&seg, &nneighbours](int catPadIndex) {
+      seg.forEachNeighbouringPad(catPadIndex, [&nneighbours](int) { ++nneighbours; });
+    });
+  }
+  state.counters["npads"] = seg.nofPads();
+  state.counters["queries"] = benchmark::Counter(seg.nofPads(), benchmark::Counter::kIsIterationInvariantRate);
 }
 
 BENCHMARK(benchCathodeSegmentationConstructionAll)->Unit(benchmark::kMillisecond);
 
 BENCHMARK_REGISTER_F(BenchO2, findPadByPosition)->Apply(segmentationList)->Unit(benchmark::kMillisecond);
 
+BENCHMARK_REGISTER_F(BenchO2, findPadsByPositions)->Apply(segmentationList)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_REGISTER_F(BenchO2, forEachNeighbouringPad)->Apply(segmentationList)->Unit(benchmark::kMillisecond);
+
 BENCHMARK_REGISTER_F(BenchO2, ctor)->Apply(segmentationList)->Unit(benchmark::kMicrosecond);
 
 BENCHMARK_MAIN();
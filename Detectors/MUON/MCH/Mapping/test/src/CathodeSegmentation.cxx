@@ -27,8 +27,10 @@
 #include <boost/test/data/monomorphic/generators/xrange.hpp>
 #include <boost/test/data/test_case.hpp>
 #include <limits>
+#include <random>
 #include <fstream>
 #include <iostream>
+#include <vector>
 #include "TestParameters.h"
 #include <fmt/format.h>
 
@@ -335,6 +337,71 @@ BOOST_AUTO_TEST_CASE(HasPadByPosition)
   BOOST_CHECK_EQUAL(seg.isValid(seg.findPadByPosition(40.0, 30.0)), true);
 }
 
+/// reference pad lookup using the pad area search (rtree based in Impl4) :
+/// the closest pad among the ones within 1E-4 cm of (x,y), lowest catPadIndex in case of tie
+int findPadByPositionInArea(const CathodeSegmentation& seg, double x, double y)
+{
+  const double epsilon{1E-4};
+  double dmin{std::numeric_limits<double>::max()};
+  int catPadIndex{-1};
+  seg.forEachPadInArea(x - epsilon, y - epsilon, x + epsilon, y + epsilon, [&](int p) {
+    double dx = seg.padPositionX(p) - x;
+    double dy = seg.padPositionY(p) - y;
+    double d = dx * dx + dy * dy;
+    if (d < dmin || (d == dmin && p < catPadIndex)) {
+      catPadIndex = p;
+      dmin = d;
+    }
+  });
+  return catPadIndex;
+}
+
+BOOST_AUTO_TEST_CASE(FindPadsByPositionsIsFindPadInAreaForAllDetectionElements)
+{
+  std::mt19937 gen(42);
+  forEachDetectionElement([&gen](int detElemId) {
+    for (auto plane : {true, false}) {
+      CathodeSegmentation seg{detElemId, plane};
+      BOOST_TEST_INFO_SCOPE(fmt::format("DeId {} Bending {}", detElemId, plane));
+      // centers, corners and edges of the pads, random positions within
+      // the cathode and positions outside the cathode
+      std::vector<double> x{-1000.0, 1000.0};
+      std::vector<double> y{-1000.0, 1000.0};
+      seg.forEachPad([&seg, &x, &y](int catPadIndex) {
+        for (auto f : {-0.5, 0.0, 0.5}) {
+          x.push_back(seg.padPositionX(catPadIndex) + f * seg.padSizeX(catPadIndex));
+          y.push_back(seg.padPositionY(catPadIndex) + f * seg.padSizeY(catPadIndex));
+        }
+        x.push_back(seg.padPositionX(catPadIndex) + 0.5 * seg.padSizeX(catPadIndex));
+        y.push_back(seg.padPositionY(catPadIndex));
+      });
+      auto bbox = getBBox(seg);
+      std::uniform_real_distribution<double> distX(bbox.xmin() - 1.0, bbox.xmax() + 1.0);
+      std::uniform_real_distribution<double> distY(bbox.ymin() - 1.0, bbox.ymax() + 1.0);
+      for (auto i = 0; i < 1000; ++i) {
+        x.push_back(distX(gen));
+        y.push_back(distY(gen));
+      }
+      std::vector<int> catPadIndices(x.size());
+      seg.findPadsByPositions(x.size(), x.data(), y.data(), catPadIndices.data());
+      int nbad{0};
+      for (auto i = 0; i < x.size(); ++i) {
+        int expected = findPadByPositionInArea(seg, x[i], y[i]);
+        if (seg.isValid(catPadIndices[i]) != seg.isValid(expected) ||
+            (seg.isValid(expected) && catPadIndices[i] != expected)) {
+          ++nbad;
+        }
+        if (catPadIndices[i] != seg.findPadByPosition(x[i], y[i])) {
+          ++nbad;
+        }
+      }
+      BOOST_CHECK_EQUAL(nbad, 0);
+      BOOST_CHECK_EQUAL(seg.isValid(catPadIndices[0]), false);
+      BOOST_CHECK_EQUAL(seg.isValid(catPadIndices[1]), false);
+    }
+  });
+}
+
 BOOST_AUTO_TEST_CASE(CheckPositionOfOnePadInDE100Bending)
 {
   TestParameters params;
@@ -20,6 +20,8 @@
 #define O2_MCH_DATADECODER_H_
 
 #include <gsl/span>
+#include <map>
+#include <memory>
 #include <unordered_set>
 #include <unordered_map>
 
@@ -134,6 +136,13 @@ class DataDecoder
   void reset();
   void decodeBuffer(gsl::span<const std::byte> buf);
 
+  /// Set the number of threads used to decode the pages. With more than one thread (and no debug output),
+  /// decodeBuffer() only dispatches the pages to the links they belong to, and the pages of the different
+  /// links are decoded in parallel by computeDigitsTime(), which then merges the digits of all the links.
+  /// The optional SAMPA channel handler is then called concurrently from several threads.
+  void setNofThreads(int n);
+  int getNofThreads() const { return mNofThreads; }
+
   void setFirstOrbitInRun(uint32_t orbit) { mFirstOrbitInRun = orbit; }
   std::optional<uint32_t> getFirstOrbitInRun() { return mFirstOrbitInRun; }
   void setFirstOrbitInTF(uint32_t orbit);
@@ -143,10 +152,7 @@ class DataDecoder
 
   static int32_t digitsTimeDiff(uint32_t orbit1, uint32_t bc1, uint32_t orbit2, uint32_t bc2);
   static void computeDigitsTime(RawDigitVector& digits, SampaTimeFrameStart& sampaTimeFrameStart, bool debug);
-  void computeDigitsTime()
-  {
-    computeDigitsTime(mDigits, mSampaTimeFrameStart, mDebug);
-  }
+  void computeDigitsTime();
 
   const RawDigitVector& getDigits() const { return mDigits; }
   const std::unordered_set<OrbitInfo, OrbitInfoHash>& getOrbits() const { return mOrbits; }
@@ -156,12 +162,24 @@ class DataDecoder
   void initFee2SolarMapper(std::string filename);
   void init();
   void decodePage(gsl::span<const std::byte> page);
+  void dispatchPage(gsl::span<const std::byte> page);
+  void decodeLinks();
   void dumpDigits();
+  static void computeDigitTime(RawDigit& digit, const SampaTimeFrameStart& sampaTimeFrameStart, bool debug);
+  void decodeChannel(RawDigitVector& digits, uint32_t orbit, DsElecId dsElecId, DualSampaChannelId channel, o2::mch::raw::SampaCluster sc);
   bool getPadMapping(const DsElecId& dsElecId, DualSampaChannelId channel, int& deId, int& dsIddet, int& padId);
-  bool addDigit(const DsElecId& dsElecId, DualSampaChannelId channel, const o2::mch::raw::SampaCluster& sc);
+  bool addDigit(RawDigitVector& digits, uint32_t orbit, const DsElecId& dsElecId, DualSampaChannelId channel, const o2::mch::raw::SampaCluster& sc);
   int32_t getMergerChannelId(const DsElecId& dsElecId, DualSampaChannelId channel);
-  void updateMergerRecord(uint32_t mergerChannelId, uint32_t digitId);
-  bool mergeDigits(uint32_t mergerChannelId, o2::mch::raw::SampaCluster& sc);
+  void updateMergerRecord(const RawDigitVector& digits, uint32_t mergerChannelId, uint32_t digitId);
+  bool mergeDigits(RawDigitVector& digits, uint32_t mergerChannelId, o2::mch::raw::SampaCluster& sc);
+
+  // decoding state of one link (a SOLAR board for bare data, a CRU end-point for UL data) in multi-threaded mode
+  struct LinkDecoder {
+    o2::mch::raw::PageDecoder decoder; ///< page decoder of this link, keeping its state from one page to the next
+    std::vector<Page> pages;           ///< pages of this link in the current TF, in order of arrival
+    RawDigitVector digits;             ///< digits decoded from the pages of this link
+    uint32_t orbit{0};                 ///< orbit of the page being decoded
+  };
 
   // structure that stores the index of the last decoded digit for a given readout channel,
   // as well as the time stamp of the last ADC sample of the digit
@@ -182,6 +200,9 @@ class DataDecoder
 
   o2::mch::raw::PageDecoder mDecoder; ///< CRU page decoder
 
+  int mNofThreads{1};                                              ///< number of threads decoding the links
+  std::map<FeeLinkId, std::unique_ptr<LinkDecoder>> mLinkDecoders; ///< per link decoders used with several threads
+
   RawDigitVector mDigits;                               ///< vector of decoded digits
   std::unordered_set<OrbitInfo, OrbitInfoHash> mOrbits; ///< list of orbits in the processed buffer
 
@@ -18,11 +18,14 @@
 
 #include "MCHRawDecoder/DataDecoder.h"
 
+#include <algorithm>
+#include <exception>
 #include <fstream>
 #include <FairMQLogger.h>
 #include "Headers/RAWDataHeader.h"
 #include "CommonConstants/LHCConstants.h"
 #include "DetectorsRaw/RDHUtils.h"
+#include "MCHRawCommon/DataFormats.h"
 #include "MCHMappingInterface/Segmentation.h"
 #include "Framework/Logger.h"
 
@@ -160,6 +163,19 @@ DataDecoder::DataDecoder(SampaChannelHandler channelHandler, RdhHandler rdhHandl
 
 //_________________________________________________________________________________________________
 
+void DataDecoder::setNofThreads(int n)
+{
+  mNofThreads = std::max(1, n);
+#ifndef WITH_OPENMP
+  if (mNofThreads > 1) {
+    LOGP(warning, "[setNofThreads] compiled without OpenMP: decoding with 1 thread");
+    mNofThreads = 1;
+  }
+#endif
+}
+
+//_________________________________________________________________________________________________
+
 void DataDecoder::setFirstOrbitInTF(uint32_t orbit)
 {
   constexpr int BCINORBIT = o2::constants::lhc::LHCMaxBunches;
@@ -209,7 +225,11 @@ void DataDecoder::decodeBuffer(gsl::span<const std::byte> buf)
     auto pageSize = o2::raw::RDHUtils::getOffsetToNext(rdh);
 
     gsl::span<const std::byte> page(reinterpret_cast<const std::byte*>(rdh), pageSize);
-    decodePage(page);
+    if (mNofThreads > 1 && !mDebug) {
+      dispatchPage(page);
+    } else {
+      decodePage(page);
+    }
 
     pageStart += pageSize;
   }
@@ -272,7 +292,7 @@ int32_t DataDecoder::getMergerChannelId(const DsElecId& dsElecId, DualSampaChann
 
 //_________________________________________________________________________________________________
 
-bool DataDecoder::mergeDigits(uint32_t mergerChannelId, o2::mch::raw::SampaCluster& sc)
+bool DataDecoder::mergeDigits(RawDigitVector& digits, uint32_t mergerChannelId, o2::mch::raw::SampaCluster& sc)
 {
   static constexpr uint32_t BCROLLOVER = (1 << 20);
   static constexpr uint32_t ONEADCCLOCK = 4;
@@ -305,7 +325,7 @@ bool DataDecoder::mergeDigits(uint32_t mergerChannelId, o2::mch::raw::SampaClust
   }
 
   // add total charge and number of samples to existing digit
-  auto& digit = mDigits[mergerCh.digitId].digit;
+  auto& digit = digits[mergerCh.digitId].digit;
   digit.setADC(digit.getADC() + sc.sum());
   uint32_t newNofSamples = digit.getNofSamples() + sc.nofSamples();
   if (newNofSamples > MAXNOFSAMPLES) {
@@ -321,10 +341,10 @@ bool DataDecoder::mergeDigits(uint32_t mergerChannelId, o2::mch::raw::SampaClust
 
 //_________________________________________________________________________________________________
 
-void DataDecoder::updateMergerRecord(uint32_t mergerChannelId, uint32_t digitId)
+void DataDecoder::updateMergerRecord(const RawDigitVector& digits, uint32_t mergerChannelId, uint32_t digitId)
 {
   auto& mergerCh = mMergerRecords[mergerChannelId];
-  auto& digit = mDigits[digitId];
+  auto& digit = digits[digitId];
   mergerCh.digitId = digitId;
   mergerCh.bcEnd = digit.info.bunchCrossing + (digit.info.sampaTime + digit.digit.getNofSamples() - 1) * 4;
 }
@@ -365,7 +385,7 @@ bool DataDecoder::getPadMapping(const DsElecId& dsElecId, DualSampaChannelId cha
 
 //_________________________________________________________________________________________________
 
-bool DataDecoder::addDigit(const DsElecId& dsElecId, DualSampaChannelId channel, const o2::mch::raw::SampaCluster& sc)
+bool DataDecoder::addDigit(RawDigitVector& digits, uint32_t orbit, const DsElecId& dsElecId, DualSampaChannelId channel, const o2::mch::raw::SampaCluster& sc)
 {
   int deId, dsIddet, padId;
   if (!getPadMapping(dsElecId, channel, deId, dsIddet, padId)) {
@@ -379,7 +399,7 @@ bool DataDecoder::addDigit(const DsElecId& dsElecId, DualSampaChannelId channel,
     auto ch = fmt::format("{}-CH{:02d}", s, channel);
     std::cout << ch << "  "
               << fmt::format("PAD ({:04d} {:04d} {:04d})\tADC {:06d}  TIME ({} {} {:02d})  SIZE {}  END {}",
-                             deId, dsIddet, padId, digitadc, mOrbit, sc.bunchCrossing, sc.sampaTime, sc.nofSamples(), (sc.sampaTime + sc.nofSamples() - 1))
+                             deId, dsIddet, padId, digitadc, orbit, sc.bunchCrossing, sc.sampaTime, sc.nofSamples(), (sc.sampaTime + sc.nofSamples() - 1))
               << (((sc.sampaTime + sc.nofSamples() - 1) >= 98) ? " *" : "") << std::endl;
   }
 
@@ -396,14 +416,14 @@ bool DataDecoder::addDigit(const DsElecId& dsElecId, DualSampaChannelId channel,
   digit.info.solar = dsElecId.solarId();
   digit.info.sampaTime = sc.sampaTime;
   digit.info.bunchCrossing = sc.bunchCrossing;
-  digit.info.orbit = mOrbit;
+  digit.info.orbit = orbit;
 
-  mDigits.emplace_back(digit);
+  digits.emplace_back(digit);
 
   if (mDebug) {
-    RawDigit& lastDigit = mDigits.back();
+    RawDigit& lastDigit = digits.back();
     LOGP(info, "DIGIT STORED: ORBIT {} ADC {} DE {} PADID {} TIME {} BXCOUNT {}",
-         mOrbit, lastDigit.getADC(), lastDigit.getDetID(), lastDigit.getPadID(),
+         orbit, lastDigit.getADC(), lastDigit.getDetID(), lastDigit.getPadID(),
          lastDigit.getSampaTime(), lastDigit.getBunchCrossing());
   }
   return true;
@@ -438,30 +458,7 @@ void DataDecoder::decodePage(gsl::span<const std::byte> page)
 
   auto channelHandler = [&](DsElecId dsElecId, DualSampaChannelId channel,
                             o2::mch::raw::SampaCluster sc) {
-    if (mChannelHandler) {
-      mChannelHandler(dsElecId, channel, sc);
-    }
-
-    if (mDs2manu) {
-      LOGP(error, "using ds2manu");
-      channel = ds2manu(int(channel));
-    }
-
-    int32_t mergerChannelId = getMergerChannelId(dsElecId, channel);
-    if (mergerChannelId < 0) {
-      LOGP(error, "dsElecId={} is out-of-bounds", asString(dsElecId));
-      return;
-    }
-
-    if (mergeDigits(mergerChannelId, sc)) {
-      return;
-    }
-
-    if (!addDigit(dsElecId, channel, sc)) {
-      return;
-    }
-
-    updateMergerRecord(mergerChannelId, mDigits.size() - 1);
+    decodeChannel(mDigits, mOrbit, dsElecId, channel, sc);
   };
 
   patchPage(page, mDebug);
@@ -492,6 +489,107 @@ void DataDecoder::decodePage(gsl::span<const std::byte> page)
 
 //_________________________________________________________________________________________________
 
+void DataDecoder::decodeChannel(RawDigitVector& digits, uint32_t orbit, DsElecId dsElecId, DualSampaChannelId channel,
+                                o2::mch::raw::SampaCluster sc)
+{
+  if (mChannelHandler) {
+    mChannelHandler(dsElecId, channel, sc);
+  }
+
+  if (mDs2manu) {
+    LOGP(error, "using ds2manu");
+    channel = ds2manu(int(channel));
+  }
+
+  int32_t mergerChannelId = getMergerChannelId(dsElecId, channel);
+  if (mergerChannelId < 0) {
+    LOGP(error, "dsElecId={} is out-of-bounds", asString(dsElecId));
+    return;
+  }
+
+  if (mergeDigits(digits, mergerChannelId, sc)) {
+    return;
+  }
+
+  if (!addDigit(digits, orbit, dsElecId, channel, sc)) {
+    return;
+  }
+
+  updateMergerRecord(digits, mergerChannelId, digits.size() - 1);
+}
+
+//_________________________________________________________________________________________________
+
+void DataDecoder::dispatchPage(gsl::span<const std::byte> page)
+{
+  // the RDH handler is called and the orbits are collected here, in the order of the pages,
+  // while the payloads are only attached to the decoder of their link
+  patchPage(page, mDebug);
+
+  auto& rdhAny = *reinterpret_cast<RDH*>(const_cast<std::byte*>(&(page[0])));
+  if (mRdhHandler) {
+    mRdhHandler(&rdhAny);
+  }
+
+  mOrbits.emplace(page);
+
+  FEEID feeId{o2::raw::RDHUtils::getFEEID(rdhAny)};
+  FeeLinkId feeLinkId(feeId.id, o2::raw::RDHUtils::getLinkID(rdhAny));
+  auto& link = mLinkDecoders[feeLinkId];
+  if (!link) {
+    link = std::make_unique<LinkDecoder>();
+    auto* linkPtr = link.get();
+    DecodedDataHandlers handlers;
+    handlers.sampaChannelHandler = [this, linkPtr](DsElecId dsElecId, DualSampaChannelId channel,
+                                                   o2::mch::raw::SampaCluster sc) {
+      decodeChannel(linkPtr->digits, linkPtr->orbit, dsElecId, channel, sc);
+    };
+    link->decoder = mFee2Solar ? o2::mch::raw::createPageDecoder(page, handlers, mFee2Solar)
+                               : o2::mch::raw::createPageDecoder(page, handlers);
+  }
+  link->pages.emplace_back(page);
+}
+
+//_________________________________________________________________________________________________
+
+void DataDecoder::decodeLinks()
+{
+  // each link is decoded by a single thread, in the order of its pages. The readout channels,
+  // hence the merger records, of different links are distinct, and the digits of each link
+  // are stored in its own vector
+  std::vector<LinkDecoder*> links;
+  for (auto& link : mLinkDecoders) {
+    if (!link.second->pages.empty()) {
+      links.emplace_back(link.second.get());
+    }
+  }
+
+  std::vector<std::exception_ptr> errors(links.size());
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNofThreads)
+#endif
+  for (int i = 0; i < links.size(); ++i) {
+    auto& link = *links[i];
+    try {
+      for (auto page : link.pages) {
+        link.orbit = o2::raw::RDHUtils::getHeartBeatOrbit(reinterpret_cast<const void*>(page.data()));
+        link.decoder(page);
+      }
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+    link.pages.clear();
+  }
+
+  for (auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+//_________________________________________________________________________________________________
+
 int32_t DataDecoder::digitsTimeDiff(uint32_t orbit1, uint32_t bc1, uint32_t orbit2, uint32_t bc2)
 {
   // bunch crossings are stored with 20 bits
@@ -528,39 +626,67 @@ int32_t DataDecoder::digitsTimeDiff(uint32_t orbit1, uint32_t bc1, uint32_t orbi
 //_________________________________________________________________________________________________
 
 void DataDecoder::computeDigitsTime(RawDigitVector& digits, SampaTimeFrameStart& sampaTimeFrameStart, bool debug)
+{
+  for (size_t di = 0; di < digits.size(); di++) {
+    computeDigitTime(digits[di], sampaTimeFrameStart, debug);
+  }
+}
+
+//_________________________________________________________________________________________________
+
+void DataDecoder::computeDigitTime(RawDigit& digit, const SampaTimeFrameStart& sampaTimeFrameStart, bool debug)
 {
   constexpr int32_t bcInTF = 256 * o2::constants::lhc::LHCMaxBunches;
-  constexpr int32_t timeInvalid = DataDecoder::tfTimeInvalid;
-  auto setDigitTime = [&](Digit& d, int32_t tfTime) {
-    d.setTime(tfTime);
-    if (debug) {
-      std::cout << "[computeDigitsTime] hit time set to " << d.getTime() << std::endl;
-    }
-  };
+  Digit& d = digit.digit;
+  SampaInfo& info = digit.info;
 
-  for (size_t di = 0; di < digits.size(); di++) {
-    Digit& d = digits[di].digit;
-    SampaInfo& info = digits[di].info;
-
-    int32_t tfTime = 0;
-    uint32_t bc = sampaTimeFrameStart.mBunchCrossing;
-    uint32_t orbit = sampaTimeFrameStart.mOrbit;
-    tfTime = DataDecoder::digitsTimeDiff(orbit, bc, info.orbit, info.getBXTime());
-    if (tfTime >= bcInTF) {
-      LOGP(warning, "DE {} PAD {}: time {} exceeds TF length", d.getDetID(), d.getPadID(), tfTime);
-    }
-    if (debug) {
-      std::cout << "\n[computeDigitsTime] hit " << info.orbit << "," << info.getBXTime()
-                << "    tfTime(1) " << orbit << "," << bc << "    diff " << tfTime << std::endl;
-    }
-    setDigitTime(d, tfTime);
-    info.tfTime = tfTime;
+  int32_t tfTime = 0;
+  uint32_t bc = sampaTimeFrameStart.mBunchCrossing;
+  uint32_t orbit = sampaTimeFrameStart.mOrbit;
+  tfTime = DataDecoder::digitsTimeDiff(orbit, bc, info.orbit, info.getBXTime());
+  if (tfTime >= bcInTF) {
+    LOGP(warning, "DE {} PAD {}: time {} exceeds TF length", d.getDetID(), d.getPadID(), tfTime);
+  }
+  if (debug) {
+    std::cout << "\n[computeDigitsTime] hit " << info.orbit << "," << info.getBXTime()
+              << "    tfTime(1) " << orbit << "," << bc << "    diff " << tfTime << std::endl;
+  }
+  d.setTime(tfTime);
+  if (debug) {
+    std::cout << "[computeDigitsTime] hit time set to " << d.getTime() << std::endl;
+  }
+  info.tfTime = tfTime;
 
-    if (debug) {
-      std::cout << "                     solar " << info.solar << "  ds " << info.ds << "  chip " << info.chip << std::endl;
-      std::cout << "                     pad " << d.getDetID() << "," << d.getPadID() << " "
-                << info.orbit << " " << info.tfTime << " " << info.getBXTime() << std::endl;
+  if (debug) {
+    std::cout << "                     solar " << info.solar << "  ds " << info.ds << "  chip " << info.chip << std::endl;
+    std::cout << "                     pad " << d.getDetID() << "," << d.getPadID() << " "
+              << info.orbit << " " << info.tfTime << " " << info.getBXTime() << std::endl;
+  }
+}
+
+//_________________________________________________________________________________________________
+
+void DataDecoder::computeDigitsTime()
+{
+  if (mLinkDecoders.empty()) {
+    computeDigitsTime(mDigits, mSampaTimeFrameStart, mDebug);
+    return;
+  }
+
+  decodeLinks();
+
+  // merge the digits of all the links, computing their time on the way
+  size_t nDigits = mDigits.size();
+  for (auto& link : mLinkDecoders) {
+    nDigits += link.second->digits.size();
+  }
+  mDigits.reserve(nDigits);
+  for (auto& link : mLinkDecoders) {
+    for (auto& digit : link.second->digits) {
+      mDigits.emplace_back(digit);
+      computeDigitTime(mDigits.back(), mSampaTimeFrameStart, mDebug);
     }
+    link.second->digits.clear();
   }
 }
 
@@ -638,6 +764,10 @@ void DataDecoder::reset()
 {
   mDigits.clear();
   mOrbits.clear();
+  for (auto& link : mLinkDecoders) {
+    link.second->pages.clear();
+    link.second->digits.clear();
+  }
   for (auto& mergerCh : mMergerRecords) {
     mergerCh.digitId = -1;
     mergerCh.bcEnd = -1;
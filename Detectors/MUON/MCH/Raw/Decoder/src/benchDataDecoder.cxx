@@ -0,0 +1,70 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+// Decoding of recorded MCH raw data (a file of RDH+payload pages, e.g. produced
+// by the raw file writer) with 1 to 8 threads. The file is given by the
+// O2_MCH_RAW_BENCH_FILE environment variable.
+
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#include "DetectorsRaw/RDHUtils.h"
+#include "MCHRawDecoder/DataDecoder.h"
+
+using namespace o2::mch::raw;
+
+static const std::vector<std::byte>& recordedData()
+{
+  static std::vector<std::byte> buffer = []() {
+    std::vector<std::byte> b;
+    const char* filename = std::getenv("O2_MCH_RAW_BENCH_FILE");
+    if (filename) {
+      std::ifstream in(filename, std::ios::binary);
+      std::vector<char> content{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+      b.resize(content.size());
+      std::memcpy(b.data(), content.data(), content.size());
+    }
+    return b;
+  }();
+  return buffer;
+}
+
+static void BM_DecodeRecordedData(benchmark::State& state)
+{
+  auto& buffer = recordedData();
+  if (buffer.empty()) {
+    state.SkipWithError("no input: set O2_MCH_RAW_BENCH_FILE to a MCH raw data file");
+    return;
+  }
+
+  DataDecoder decoder(SampaChannelHandler{}, RdhHandler{}, 0, "", "", false, false, false);
+  decoder.setNofThreads(state.range(0));
+  uint32_t firstOrbit = o2::raw::RDHUtils::getHeartBeatOrbit(reinterpret_cast<const void*>(buffer.data()));
+  decoder.setFirstOrbitInRun(firstOrbit);
+  decoder.setFirstOrbitInTF(firstOrbit);
+
+  size_t nDigits{0};
+  for (auto _ : state) {
+    decoder.reset();
+    decoder.decodeBuffer(buffer);
+    decoder.computeDigitsTime();
+    nDigits = decoder.getDigits().size();
+  }
+  state.counters["digits"] = nDigits;
+  state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+
+BENCHMARK(BM_DecodeRecordedData)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
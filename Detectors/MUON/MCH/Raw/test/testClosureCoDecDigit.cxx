@@ -191,3 +191,30 @@ BOOST_AUTO_TEST_CASE(WrittenAndReadBackDigitsShouldBeTheSame)
     }
   }
 }
+
+std::vector<DataDecoder::RawDigit> decodeDigits(int nThreads)
+{
+  DataDecoder dd(nullptr, nullptr, 0, "", "", false, false, true);
+  dd.setNofThreads(nThreads);
+  dd.setFirstOrbitInRun(0);
+  dd.setFirstOrbitInTF(0);
+
+  auto buffer = getBuffer("mch.raw");
+  dd.decodeBuffer(buffer);
+  dd.computeDigitsTime();
+  return dd.getDigits();
+}
+
+BOOST_AUTO_TEST_CASE(DigitsDecodedWithSeveralThreadsShouldBeTheSame)
+{
+  o2::conf::ConfigurableParam::setValue("MCHCoDecParam", "sampaBcOffset", 0);
+  writeDigits(true);
+  auto expected = decodeDigits(1);
+  auto result = decodeDigits(4);
+
+  BOOST_CHECK_EQUAL(expected.size(), 3);
+  BOOST_CHECK_EQUAL(result.size(), expected.size());
+  if (result.size() == expected.size()) {
+    BOOST_CHECK_EQUAL(std::is_permutation(begin(result), end(result), begin(expected)), true);
+  }
+}
@@ -17,7 +17,9 @@
 #ifndef ALICEO2_MCH_TRACKEXTRAP_H_
 #define ALICEO2_MCH_TRACKEXTRAP_H_
 
+#include <atomic>
 #include <cstddef>
+#include <thread>
 
 #include <TMatrixD.h>
 
@@ -115,6 +117,8 @@ class TrackExtrap
   static bool extrapToZRungekuttaV2(TrackParam* trackParam, double zEnd);
   static bool extrapOneStepRungekutta(double charge, double step, const double* vect, double* vout);
 
+  static void getField(const double* x, double* b);
+
   static constexpr double SMuMass = 0.105658;                         ///< Muon mass (GeV/c2)
   static constexpr double SAbsZBeg = -90.;                            ///< Position of the begining of the absorber (cm)
   static constexpr double SAbsZEnd = -505.;                           ///< Position of the end of the absorber (cm)
@@ -132,8 +136,10 @@ class TrackExtrap
   static double sSimpleBValue; ///< Magnetic field value at the centre
   static bool sFieldON;        ///< true if the field is switched ON
 
-  static std::size_t sNCallExtrapToZCov; ///< number of times the method extrapToZCov(...) is called
-  static std::size_t sNCallField;        ///< number of times the method Field(...) is called
+  static std::atomic<std::size_t> sNCallExtrapToZCov; ///< number of times the method extrapToZCov(...) is called
+  static std::atomic<std::size_t> sNCallField;        ///< number of times the method Field(...) is called
+  static std::thread::id sFieldThreadId;              ///< thread which set the field, using it directly
+  static std::atomic<int> sFieldVersion;              ///< incremented when the field is set, to update the copies of the other threads
 };
 
 } // namespace mch
@@ -22,6 +22,7 @@
 #include <unordered_set>
 #include <list>
 #include <array>
+#include <memory>
 #include <vector>
 #include <utility>
 
@@ -48,7 +49,7 @@ class TrackFinder
 
   void init(float l3Current, float dipoleCurrent);
 
-  const std::list<Track>& findTracks(const std::unordered_map<int, std::list<Cluster>>& clusters);
+  const std::list<Track>& findTracks(const std::unordered_map<int, std::vector<Cluster>>& clusters);
 
   /// set the debug level defining the verbosity
   void debug(int debugLevel) { mDebugLevel = debugLevel; }
@@ -57,10 +58,19 @@ class TrackFinder
   void printTimers() const;
 
  private:
+  /// clusters of a DE sorted in the bending direction, to search for the ones within a range of y
+  struct SortedClusters {
+    std::vector<std::pair<double, uint32_t>> yAndIndex{}; ///< y position and index of the clusters, sorted in y
+    double zMin = 0.;                                     ///< minimum z of the clusters
+    double zMax = 0.;                                     ///< maximum z of the clusters
+  };
+
   void findTrackCandidates();
   void findTrackCandidatesInSt5();
   void findTrackCandidatesInSt4();
   void findMoreTrackCandidates();
+  void followTrackCandidates();
+  void followTrackCandidatesInParallel();
   std::list<Track>::iterator findTrackCandidates(int plane1, int plane2, bool skipUsedPairs, const std::list<Track>::iterator& itFirstTrack);
 
   std::list<Track>::iterator followTrackInOverlapDE(const std::list<Track>::iterator& itTrack, int currentDE, int plane);
@@ -82,6 +92,8 @@ class TrackFinder
 
   void finalize();
 
+  void initWorker(const TrackFinder& trackFinder);
+
   void createTrack(const Cluster& cl1, const Cluster& cl2);
 
   bool isAcceptable(const TrackParam& param) const;
@@ -97,6 +109,8 @@ class TrackFinder
                                           const std::list<Track>::iterator& itEndTrack);
   void moveClusters(std::unordered_map<int, std::unordered_set<uint32_t>>& source, std::unordered_map<int, std::unordered_set<uint32_t>>& destination);
 
+  void sortClusters(const std::vector<Cluster>& clusters, SortedClusters& sortedClusters) const;
+  void selectClusters(const TrackParam& param, int deId, std::vector<uint32_t>& clusterIndices) const;
   bool isCompatible(const TrackParam& param, const Cluster& cluster, TrackParam& paramAtCluster);
   bool tryOneClusterFast(const TrackParam& param, const Cluster& cluster);
   double tryOneCluster(const TrackParam& param, const Cluster& cluster, TrackParam& paramAtCluster);
@@ -117,6 +131,8 @@ class TrackFinder
   static constexpr double SMaxNonBendingDistanceToTrack = 1.;
   ///< maximum distance to the track to search for compatible cluster(s) in bending direction
   static constexpr double SMaxBendingDistanceToTrack = 1.;
+  ///< margin (cm) added to the range of y searched for compatible cluster(s), to be safe against rounding
+  static constexpr double SBendingRangeMargin = 1.e-4;
   static constexpr double SMinBendingMomentum = 0.8; ///< minimum value (GeV/c) of momentum in bending plane
   /// z position of the chambers
   static constexpr double SDefaultChamberZ[10] = {-526.16, -545.24, -676.4, -695.4, -967.5,
@@ -128,7 +144,8 @@ class TrackFinder
 
   TrackFitter mTrackFitter{}; /// track fitter
 
-  std::array<std::vector<std::pair<const int, const std::list<Cluster>*>>, 32> mClusters{}; ///< array of pointers to the lists of clusters per DE
+  std::array<std::vector<std::pair<const int, const std::vector<Cluster>*>>, 32> mClusters{}; ///< array of pointers to the arrays of clusters per DE
+  std::shared_ptr<std::unordered_map<int, SortedClusters>> mSortedClusters{};             ///< sorted clusters per DE, shared with the workers
 
   std::list<Track> mTracks{}; ///< list of reconstructed tracks
 
@@ -142,6 +159,8 @@ class TrackFinder
 
   int mDebugLevel = 0; ///< debug level defining the verbosity
 
+  std::vector<std::unique_ptr<TrackFinder>> mWorkers{}; ///< track finders used to follow the candidates in parallel
+
   std::size_t mNCandidates = 0;            ///< counter
   std::size_t mNCallTryOneCluster = 0;     ///< counter
   std::size_t mNCallTryOneClusterFast = 0; ///< counter
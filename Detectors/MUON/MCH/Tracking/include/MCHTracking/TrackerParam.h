@@ -42,6 +42,8 @@ struct TrackerParam : public o2::conf::ConfigurableParamHelper<TrackerParam> {
   bool moreCandidates = false; ///< find more track candidates starting from 1 cluster in each of station (1..) 4 and 5
   bool refineTracks = true;    ///< refine the tracks in the end using cluster resolution
 
+  int nThreads = 1; ///< number of threads used to follow the track candidates
+
   O2ParamDef(TrackerParam, "MCHTracking");
 };
 
@@ -16,6 +16,8 @@
 
 #include "MCHTracking/TrackExtrap.h"
 
+#include <memory>
+
 #include <TGeoGlobalMagField.h>
 #include <TGeoManager.h>
 #include <TGeoMaterial.h>
@@ -23,6 +25,7 @@
 #include <TGeoShape.h>
 #include <TMath.h>
 
+#include "Field/MagneticField.h"
 #include "Framework/Logger.h"
 
 #include "MCHTracking/TrackParam.h"
@@ -35,8 +38,10 @@ namespace mch
 bool TrackExtrap::sExtrapV2 = false;
 double TrackExtrap::sSimpleBValue = 0.;
 bool TrackExtrap::sFieldON = false;
-std::size_t TrackExtrap::sNCallExtrapToZCov = 0;
-std::size_t TrackExtrap::sNCallField = 0;
+std::atomic<std::size_t> TrackExtrap::sNCallExtrapToZCov{0};
+std::atomic<std::size_t> TrackExtrap::sNCallField{0};
+std::thread::id TrackExtrap::sFieldThreadId{};
+std::atomic<int> TrackExtrap::sFieldVersion{0};
 
 //__________________________________________________________________________
 void TrackExtrap::setField()
@@ -48,9 +53,39 @@ void TrackExtrap::setField()
   TGeoGlobalMagField::Instance()->Field(x, b);
   sSimpleBValue = b[0];
   sFieldON = (TMath::Abs(sSimpleBValue) > 1.e-10) ? true : false;
+  sFieldThreadId = std::this_thread::get_id();
+  ++sFieldVersion;
   LOG(INFO) << "Track extrapolation with magnetic field " << (sFieldON ? "ON" : "OFF");
 }
 
+//__________________________________________________________________________
+void TrackExtrap::getField(const double* x, double* b)
+{
+  /// Get the magnetic field at position x
+  /// The evaluation of the Chebyshev parameterization of the field uses internal buffers, so the threads
+  /// other than the one which set the field use their own copy of it, made at their first call after setField()
+  TVirtualMagField* field = TGeoGlobalMagField::Instance()->GetField();
+  if (std::this_thread::get_id() != sFieldThreadId) {
+    thread_local std::unique_ptr<o2::field::MagneticField> threadField{};
+    thread_local int threadFieldVersion = -1;
+    if (threadFieldVersion != sFieldVersion) {
+      auto o2Field = dynamic_cast<const o2::field::MagneticField*>(field);
+      if (o2Field) {
+        threadField = std::make_unique<o2::field::MagneticField>();
+        *threadField = *o2Field;
+      } else {
+        threadField.reset();
+      }
+      threadFieldVersion = sFieldVersion;
+    }
+    if (threadField) {
+      field = threadField.get();
+    }
+  }
+  field->Field(x, b);
+  ++sNCallField;
+}
+
 //__________________________________________________________________________
 double TrackExtrap::getImpactParamFromBendingMomentum(double bendingMomentum)
 {
@@ -1040,8 +1075,7 @@ bool TrackExtrap::extrapOneStepRungekutta(double charge, double step, const doub
       h = rest;
     }
     // cmodif: call gufld(vout,f) changed into:
-    TGeoGlobalMagField::Instance()->Field(vout, f);
-    ++sNCallField;
+    getField(vout, f);
 
     // *
     // *             start of integration
@@ -1089,8 +1123,7 @@ bool TrackExtrap::extrapOneStepRungekutta(double charge, double step, const doub
     xyzt[2] = zt;
 
     // cmodif: call gufld(xyzt,f) changed into:
-    TGeoGlobalMagField::Instance()->Field(xyzt, f);
-    ++sNCallField;
+    getField(xyzt, f);
 
     at = a + secxs[0];
     bt = b + secys[0];
@@ -1129,8 +1162,7 @@ bool TrackExtrap::extrapOneStepRungekutta(double charge, double step, const doub
     xyzt[2] = zt;
 
     // cmodif: call gufld(xyzt,f) changed into:
-    TGeoGlobalMagField::Instance()->Field(xyzt, f);
-    ++sNCallField;
+    getField(xyzt, f);
 
     z = z + (c + (seczs[0] + seczs[1] + seczs[2]) * kthird) * h;
     y = y + (b + (secys[0] + secys[1] + secys[2]) * kthird) * h;
@@ -1233,8 +1265,8 @@ bool TrackExtrap::extrapOneStepRungekutta(double charge, double step, const doub
 void TrackExtrap::printNCalls()
 {
   /// Print the number of times some methods are called
-  LOG(INFO) << "number of times extrapToZCov() is called = " << sNCallExtrapToZCov;
-  LOG(INFO) << "number of times Field() is called = " << sNCallField;
+  LOG(INFO) << "number of times extrapToZCov() is called = " << sNCallExtrapToZCov.load();
+  LOG(INFO) << "number of times Field() is called = " << sNCallField.load();
 }
 
 } // namespace mch
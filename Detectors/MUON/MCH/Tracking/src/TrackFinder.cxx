@@ -16,10 +16,17 @@
 
 #include "MCHTracking/TrackFinder.h"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <stdexcept>
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 #include <TGeoGlobalMagField.h>
 #include <TMatrixD.h>
 #include <TMath.h>
@@ -137,23 +144,82 @@ void TrackFinder::init(float l3Current, float dipoleCurrent)
     mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 17, nullptr);
     mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 19, nullptr);
   }
+
+  // prepare the sorted clusters of every DE, so that the map is not modified while tracking
+  mSortedClusters = std::make_shared<std::unordered_map<int, SortedClusters>>();
+  for (const auto& plane : mClusters) {
+    for (const auto& de : plane) {
+      (*mSortedClusters)[de.first];
+    }
+  }
+
+  // prepare the track finders used to follow the candidates in parallel if requested
+  mWorkers.clear();
+  int nThreads = trackerParam.nThreads;
+#ifndef WITH_OPENMP
+  if (nThreads > 1) {
+    LOG(WARNING) << "compiled without OpenMP: track candidates followed with 1 thread";
+    nThreads = 1;
+  }
+#endif
+  if (nThreads > 1) {
+    for (int i = 0; i < nThreads; ++i) {
+      mWorkers.emplace_back(std::make_unique<TrackFinder>());
+      mWorkers.back()->initWorker(*this);
+    }
+  }
 }
 
 //_________________________________________________________________________________________________
-const std::list<Track>& TrackFinder::findTracks(const std::unordered_map<int, std::list<Cluster>>& clusters)
+void TrackFinder::initWorker(const TrackFinder& trackFinder)
+{
+  /// Prepare this track finder to follow track candidates on behalf of the given one, with the same parameters
+
+  const auto& trackerParam = TrackerParam::Instance();
+  mTrackFitter.setBendingVertexDispersion(trackerParam.bendingVertexDispersion);
+  mTrackFitter.setChamberResolution(trackerParam.chamberResolutionX, trackerParam.chamberResolutionY);
+  mTrackFitter.smoothTracks(true);
+  mTrackFitter.useChamberResolution();
+
+  mChamberResolutionX2 = trackFinder.mChamberResolutionX2;
+  mChamberResolutionY2 = trackFinder.mChamberResolutionY2;
+  mBendingVertexDispersion2 = trackFinder.mBendingVertexDispersion2;
+  mMaxChi2ForTracking = trackFinder.mMaxChi2ForTracking;
+  mMaxChi2ForImprovement = trackFinder.mMaxChi2ForImprovement;
+  std::copy(std::begin(trackFinder.mMaxMCSAngle2), std::end(trackFinder.mMaxMCSAngle2), std::begin(mMaxMCSAngle2));
+
+  // same grouping of DEs in z-planes, the pointers to the clusters being set for each event, and same sorted clusters
+  mSortedClusters = trackFinder.mSortedClusters;
+  for (int iPlane = 0; iPlane < 32; ++iPlane) {
+    mClusters[iPlane].clear();
+    mClusters[iPlane].reserve(trackFinder.mClusters[iPlane].size());
+    for (const auto& de : trackFinder.mClusters[iPlane]) {
+      mClusters[iPlane].emplace_back(de.first, nullptr);
+    }
+  }
+}
+
+//_________________________________________________________________________________________________
+const std::list<Track>& TrackFinder::findTracks(const std::unordered_map<int, std::vector<Cluster>>& clusters)
 {
   /// Run the track finder algorithm
+  /// The clusters must not be modified until the returned tracks, which point to them, are no longer needed
 
   mTracks.clear();
 
-  // fill the internal array of pointers to the list of clusters per DE
-  for (auto& plane : mClusters) {
-    for (auto& de : plane) {
+  // fill the internal array of pointers to the array of clusters per DE
+  for (int iPlane = 0; iPlane < 32; ++iPlane) {
+    for (int iDE = 0; iDE < mClusters[iPlane].size(); ++iDE) {
+      auto& de = mClusters[iPlane][iDE];
       auto itDE = clusters.find(de.first);
       if (itDE == clusters.end()) {
         de.second = nullptr;
       } else {
         de.second = &(itDE->second);
+        sortClusters(itDE->second, mSortedClusters->at(de.first));
+      }
+      for (auto& worker : mWorkers) {
+        worker->mClusters[iPlane][iDE].second = de.second;
       }
     }
   }
@@ -178,11 +244,10 @@ const std::list<Track>& TrackFinder::findTracks(const std::unordered_map<int, st
 
   // track each candidate down to chamber 1 and remove it
   tStart = std::chrono::high_resolution_clock::now();
-  for (auto itTrack = mTracks.begin(); itTrack != mTracks.end();) {
-    std::unordered_map<int, std::unordered_set<uint32_t>> excludedClusters{};
-    followTrackInChamber(itTrack, 5, 0, false, excludedClusters);
-    print("findTracks: removing candidate at position #", getTrackIndex(itTrack));
-    itTrack = mTracks.erase(itTrack);
+  if (mWorkers.empty() || mDebugLevel > 0) {
+    followTrackCandidates();
+  } else {
+    followTrackCandidatesInParallel();
   }
   tEnd = std::chrono::high_resolution_clock::now();
   mTimeFollowTracks += tEnd - tStart;
@@ -599,6 +664,56 @@ void TrackFinder::findMoreTrackCandidates()
   }
 }
 
+//_________________________________________________________________________________________________
+void TrackFinder::followTrackCandidates()
+{
+  /// Track each candidate down to chamber 1 and remove it
+  /// The new tracks found starting from a candidate take its place in the list of tracks
+
+  for (auto itTrack = mTracks.begin(); itTrack != mTracks.end();) {
+    std::unordered_map<int, std::unordered_set<uint32_t>> excludedClusters{};
+    followTrackInChamber(itTrack, 5, 0, false, excludedClusters);
+    print("followTrackCandidates: removing candidate at position #", getTrackIndex(itTrack));
+    itTrack = mTracks.erase(itTrack);
+  }
+}
+
+//_________________________________________________________________________________________________
+void TrackFinder::followTrackCandidatesInParallel()
+{
+  /// Track each candidate down to chamber 1 and remove it, as followTrackCandidates() but using the workers
+  /// The candidates are followed independently of each other, so the list of tracks is split into groups
+  /// of consecutive candidates followed in parallel, then merged back in the same order. This gives the
+  /// same tracks in the same order as followTrackCandidates(). Only the lists nodes are moved, not the tracks
+
+  // several groups per worker, to balance the load
+  int nCandidates = mTracks.size();
+  int nGroups = std::min(nCandidates, 4 * static_cast<int>(mWorkers.size()));
+  std::vector<std::list<Track>> groups(nGroups);
+  for (int iGroup = 0; iGroup < nGroups; ++iGroup) {
+    auto itEnd = std::next(mTracks.begin(), nCandidates * (iGroup + 1) / nGroups - nCandidates * iGroup / nGroups);
+    groups[iGroup].splice(groups[iGroup].end(), mTracks, mTracks.begin(), itEnd);
+  }
+
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mWorkers.size())
+#endif
+  for (int iGroup = 0; iGroup < nGroups; ++iGroup) {
+#ifdef WITH_OPENMP
+    auto& worker = *mWorkers[omp_get_thread_num()];
+#else
+    auto& worker = *mWorkers.front();
+#endif
+    worker.mTracks.swap(groups[iGroup]);
+    worker.followTrackCandidates();
+    worker.mTracks.swap(groups[iGroup]);
+  }
+
+  for (auto& group : groups) {
+    mTracks.splice(mTracks.end(), group);
+  }
+}
+
 //_________________________________________________________________________________________________
 std::list<Track>::iterator TrackFinder::findTrackCandidates(int plane1, int plane2, bool skipUsedPairs, const std::list<Track>::iterator& itFirstTrack)
 {
@@ -707,6 +822,7 @@ std::list<Track>::iterator TrackFinder::followTrackInOverlapDE(const std::list<T
 
   // loop over all DEs of plane
   TrackParam paramAtCluster{};
+  std::vector<uint32_t> clusterIndices{};
   for (auto& de : mClusters[plane]) {
 
     // skip DE without cluster
@@ -720,7 +836,9 @@ std::list<Track>::iterator TrackFinder::followTrackInOverlapDE(const std::list<T
     }
 
     // look for cluster candidate in this DE
-    for (const auto& cluster : *de.second) {
+    selectClusters(currentParam, de.first, clusterIndices);
+    for (auto iCluster : clusterIndices) {
+      const auto& cluster = (*de.second)[iCluster];
 
       // try to add the current cluster
       if (!isCompatible(currentParam, cluster, paramAtCluster)) {
@@ -888,6 +1006,8 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
   TrackParam paramAtCluster1{};
   TrackParam currentParamAtCluster1{};
   TrackParam paramAtCluster2{};
+  std::vector<uint32_t> clusterIndices1{};
+  std::vector<uint32_t> clusterIndices2{};
   std::unordered_map<int, std::unordered_set<uint32_t>> newExcludedClusters{};
   for (auto& de1 : mClusters[plane1]) {
 
@@ -901,7 +1021,9 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
     bool hasExcludedClusters = (itExcludedClusters != excludedClusters.end());
 
     // look for cluster candidate in this DE
-    for (const auto& cluster1 : *de1.second) {
+    selectClusters(paramAtChamber, de1.first, clusterIndices1);
+    for (auto iCluster1 : clusterIndices1) {
+      const auto& cluster1 = (*de1.second)[iCluster1];
 
       // skip excluded clusters
       if (hasExcludedClusters && itExcludedClusters->second.count(cluster1.getUniqueId()) > 0) {
@@ -939,7 +1061,9 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
         }
 
         // look for cluster candidate in this DE
-        for (const auto& cluster2 : *de2.second) {
+        selectClusters(currentParamAtCluster1, de2.first, clusterIndices2);
+        for (auto iCluster2 : clusterIndices2) {
+          const auto& cluster2 = (*de2.second)[iCluster2];
 
           // try to add the current cluster
           if (!isCompatible(currentParamAtCluster1, cluster2, paramAtCluster2)) {
@@ -994,7 +1118,9 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
     bool hasExcludedClusters = (itExcludedClusters != excludedClusters.end());
 
     // look for cluster candidate in this DE
-    for (const auto& cluster2 : *de2.second) {
+    selectClusters(paramAtChamber, de2.first, clusterIndices2);
+    for (auto iCluster2 : clusterIndices2) {
+      const auto& cluster2 = (*de2.second)[iCluster2];
 
       // skip excluded clusters (in particular the ones already attached together with a cluster on plane1)
       if (hasExcludedClusters && itExcludedClusters->second.count(cluster2.getUniqueId()) > 0) {
@@ -1484,6 +1610,66 @@ void TrackFinder::moveClusters(std::unordered_map<int, std::unordered_set<uint32
   source.clear();
 }
 
+//_________________________________________________________________________________________________
+void TrackFinder::sortClusters(const std::vector<Cluster>& clusters, SortedClusters& sortedClusters) const
+{
+  /// Sort the clusters of a DE in the bending direction and store their z range
+
+  sortedClusters.yAndIndex.clear();
+  sortedClusters.yAndIndex.reserve(clusters.size());
+  sortedClusters.zMin = std::numeric_limits<double>::max();
+  sortedClusters.zMax = std::numeric_limits<double>::lowest();
+  for (uint32_t iCluster = 0; iCluster < clusters.size(); ++iCluster) {
+    sortedClusters.yAndIndex.emplace_back(clusters[iCluster].getY(), iCluster);
+    sortedClusters.zMin = std::min(sortedClusters.zMin, clusters[iCluster].getZ());
+    sortedClusters.zMax = std::max(sortedClusters.zMax, clusters[iCluster].getZ());
+  }
+  std::sort(sortedClusters.yAndIndex.begin(), sortedClusters.yAndIndex.end());
+}
+
+//_________________________________________________________________________________________________
+void TrackFinder::selectClusters(const TrackParam& param, int deId, std::vector<uint32_t>& clusterIndices) const
+{
+  /// Fill clusterIndices with the indices of the clusters of the DE that can pass tryOneClusterFast,
+  /// in the order of the clusters in the DE so that the tracks are found in the same order as when
+  /// testing all the clusters.
+  /// The range of y is the union of the windows of tryOneClusterFast at the minimum and maximum z of the clusters:
+  /// the extrapolated position is linear in z and its uncertainty is convex, so this range contains the window at
+  /// any z in between.
+
+  const auto& sortedClusters = mSortedClusters->at(deId);
+  const TMatrixD& paramCov = param.getCovariances();
+  double yMin(std::numeric_limits<double>::max()), yMax(std::numeric_limits<double>::lowest());
+  bool validRange(true);
+  for (double z : {sortedClusters.zMin, sortedClusters.zMax}) {
+    double dZ = z - param.getZ();
+    double y = param.getBendingCoor() + param.getBendingSlope() * dZ;
+    double errY2 = paramCov(2, 2) + dZ * dZ * paramCov(3, 3) + 2. * dZ * paramCov(2, 3) + mChamberResolutionY2;
+    double dYmax = TrackerParam::Instance().sigmaCutForTracking * TMath::Sqrt(2. * errY2) + SMaxBendingDistanceToTrack + SBendingRangeMargin;
+    validRange = validRange && (y - dYmax <= y + dYmax);
+    yMin = std::min(yMin, y - dYmax);
+    yMax = std::max(yMax, y + dYmax);
+  }
+
+  clusterIndices.clear();
+  const auto& yAndIndex = sortedClusters.yAndIndex;
+  if (!validRange) {
+    // NaN in the window: test all the clusters, as tryOneClusterFast does not reject them
+    for (const auto& cluster : yAndIndex) {
+      clusterIndices.push_back(cluster.second);
+    }
+  } else {
+    auto itFirst = std::lower_bound(yAndIndex.begin(), yAndIndex.end(), yMin,
+                                    [](const std::pair<double, uint32_t>& cluster, double y) { return cluster.first < y; });
+    auto itLast = std::upper_bound(itFirst, yAndIndex.end(), yMax,
+                                   [](double y, const std::pair<double, uint32_t>& cluster) { return y < cluster.first; });
+    for (auto itCluster = itFirst; itCluster != itLast; ++itCluster) {
+      clusterIndices.push_back(itCluster->second);
+    }
+  }
+  std::sort(clusterIndices.begin(), clusterIndices.end());
+}
+
 //_________________________________________________________________________________________________
 bool TrackFinder::isCompatible(const TrackParam& param, const Cluster& cluster, TrackParam& paramAtCluster)
 {
@@ -1659,10 +1845,16 @@ void TrackFinder::print(Args... args) const
 void TrackFinder::printStats() const
 {
   /// print the timers
+  std::size_t nCallTryOneClusterFast = mNCallTryOneClusterFast;
+  std::size_t nCallTryOneCluster = mNCallTryOneCluster;
+  for (const auto& worker : mWorkers) {
+    nCallTryOneClusterFast += worker->mNCallTryOneClusterFast;
+    nCallTryOneCluster += worker->mNCallTryOneCluster;
+  }
   LOG(INFO) << "number of candidates tracked = " << mNCandidates;
   TrackExtrap::printNCalls();
-  LOG(INFO) << "number of times tryOneClusterFast() is called = " << mNCallTryOneClusterFast;
-  LOG(INFO) << "number of times tryOneCluster() is called = " << mNCallTryOneCluster;
+  LOG(INFO) << "number of times tryOneClusterFast() is called = " << nCallTryOneClusterFast;
+  LOG(INFO) << "number of times tryOneCluster() is called = " << nCallTryOneCluster;
 }
 
 //_________________________________________________________________________________________________
@@ -0,0 +1,108 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file SimulatedClusters.h
+/// \brief Simple generation of MCH clusters from muons propagated through the magnetic field, for the tracking test and benchmark
+
+#ifndef ALICEO2_MCH_SIMULATEDCLUSTERS_H_
+#define ALICEO2_MCH_SIMULATEDCLUSTERS_H_
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "MCHBase/ClusterBlock.h"
+#include "MCHTracking/Cluster.h"
+#include "MCHTracking/TrackExtrap.h"
+#include "MCHTracking/TrackParam.h"
+
+namespace o2
+{
+namespace mch
+{
+namespace test
+{
+
+constexpr double ChamberZ[10] = {-526.16, -545.24, -676.4, -695.4, -967.5, -998.5, -1276.5, -1307.5, -1406.6, -1437.6};
+constexpr int NDE[10] = {4, 4, 4, 4, 18, 18, 26, 26, 26, 26};
+
+/// return the index of the DE of chamber iCh covering the position (x,y)
+/// quadrants for stations 1 and 2, rows of 40 cm high slats for stations 3 to 5
+inline int getDEIndex(int iCh, double x, double y)
+{
+  if (iCh < 4) {
+    return (y > 0.) ? ((x > 0.) ? 0 : 1) : ((x > 0.) ? 3 : 2);
+  }
+  int nRowsPerSide = NDE[iCh] / 4;
+  int row = std::max(-nRowsPerSide, std::min(nRowsPerSide, static_cast<int>(std::lround(y / 40.))));
+  if (x > 0.) {
+    return (row >= 0) ? row : NDE[iCh] + row;
+  }
+  return NDE[iCh] / 2 - row;
+}
+
+/// add a cluster at position (x,y) of chamber iCh
+inline void addCluster(std::unordered_map<int, std::vector<Cluster>>& clusters, int iCh, double x, double y)
+{
+  int deId = 100 * (iCh + 1) + getDEIndex(iCh, x, y);
+  auto& deClusters = clusters[deId];
+  ClusterStruct cluster{};
+  cluster.x = x;
+  cluster.y = y;
+  cluster.z = ChamberZ[iCh];
+  cluster.ex = 0.2;
+  cluster.ey = 0.2;
+  cluster.uid = ClusterStruct::buildUniqueId(iCh, deId, deClusters.size());
+  deClusters.emplace_back(cluster);
+}
+
+/// simulate an event with nMuons muons coming from the vertex, propagated through the real magnetic field,
+/// and nBackground clusters per chamber
+inline std::unordered_map<int, std::vector<Cluster>> simulateEvent(int nMuons, int nBackground, std::mt19937& gen)
+{
+  std::uniform_real_distribution<double> thetaDist(2. * M_PI / 180., 9. * M_PI / 180.);
+  std::uniform_real_distribution<double> phiDist(0., 2. * M_PI);
+  std::uniform_real_distribution<double> pDist(4., 40.);
+  std::normal_distribution<double> smearing(0., 0.01);
+
+  std::unordered_map<int, std::vector<Cluster>> clusters{};
+  for (int iMuon = 0; iMuon < nMuons; ++iMuon) {
+    double theta = thetaDist(gen);
+    double phi = phiDist(gen);
+    TrackParam param{};
+    param.setZ(0.);
+    param.setNonBendingSlope(std::tan(theta) * std::cos(phi));
+    param.setBendingSlope(std::tan(theta) * std::sin(phi));
+    param.setInverseBendingMomentum(((iMuon % 2) ? 1. : -1.) / pDist(gen));
+    for (int iCh = 0; iCh < 10; ++iCh) {
+      if (!TrackExtrap::extrapToZ(&param, ChamberZ[iCh])) {
+        break;
+      }
+      addCluster(clusters, iCh, param.getNonBendingCoor() + smearing(gen), param.getBendingCoor() + smearing(gen));
+    }
+  }
+  for (int iCh = 0; iCh < 10; ++iCh) {
+    for (int i = 0; i < nBackground; ++i) {
+      double r = -ChamberZ[iCh] * std::tan(thetaDist(gen));
+      double phi = phiDist(gen);
+      addCluster(clusters, iCh, r * std::cos(phi), r * std::sin(phi));
+    }
+  }
+  return clusters;
+}
+
+} // namespace test
+} // namespace mch
+} // namespace o2
+
+#endif // ALICEO2_MCH_SIMULATEDCLUSTERS_H_
@@ -0,0 +1,62 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file benchTrackFinder.cxx
+/// \brief Benchmark of the MCH track finder on simulated events
+///
+/// The benchmark arguments are the number of threads used to follow the track candidates
+/// and the number of muons per event. The field map is read from $O2_ROOT/share/Common/maps
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "CommonUtils/ConfigurableParam.h"
+#include "MCHTracking/Cluster.h"
+#include "MCHTracking/TrackFinder.h"
+#include "SimulatedClusters.h"
+
+using namespace o2::mch;
+
+static void BM_TrackFinder(benchmark::State& state)
+{
+  // the track finder reads the number of threads when initialized
+  o2::conf::ConfigurableParam::setValue("MCHTracking.nThreads", std::to_string(state.range(0)));
+  TrackFinder trackFinder{};
+  trackFinder.init(-30000., -6000.);
+
+  std::mt19937 gen(42);
+  std::vector<std::unordered_map<int, std::vector<Cluster>>> events{};
+  for (int iEvent = 0; iEvent < 10; ++iEvent) {
+    events.emplace_back(test::simulateEvent(state.range(1), 2 * state.range(1), gen));
+  }
+
+  for (auto _ : state) {
+    for (const auto& clusters : events) {
+      benchmark::DoNotOptimize(trackFinder.findTracks(clusters).size());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * events.size());
+}
+
+BENCHMARK(BM_TrackFinder)
+  ->Args({1, 10})
+  ->Args({1, 50})
+  ->Args({2, 50})
+  ->Args({4, 50})
+  ->Args({8, 50})
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,62 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file testTrackFinder.cxx
+/// \brief Check that the tracks found by the MCH track finder do not depend on the number of threads
+
+#define BOOST_TEST_MODULE Test MCHTracking TrackFinder
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <list>
+#include <random>
+
+#include "CommonUtils/ConfigurableParam.h"
+#include "MCHTracking/Track.h"
+#include "MCHTracking/TrackExtrap.h"
+#include "MCHTracking/TrackFinder.h"
+#include "SimulatedClusters.h"
+
+using namespace o2::mch;
+
+BOOST_AUTO_TEST_CASE(TracksDoNotDependOnTheNumberOfThreads)
+{
+  // the track finders read the number of threads when initialized
+  TrackFinder trackFinder1{}, trackFinderN{};
+  o2::conf::ConfigurableParam::setValue("MCHTracking.nThreads", "1");
+  trackFinder1.init(-30000., -6000.);
+  o2::conf::ConfigurableParam::setValue("MCHTracking.nThreads", "4");
+  trackFinderN.init(-30000., -6000.);
+  o2::conf::ConfigurableParam::setValue("MCHTracking.nThreads", "1");
+  BOOST_REQUIRE(TrackExtrap::isFieldON());
+
+  std::mt19937 gen(1);
+  for (int iEvent = 0; iEvent < 5; ++iEvent) {
+    auto clusters = test::simulateEvent(20, 10, gen);
+    const auto& tracks1 = trackFinder1.findTracks(clusters);
+    const auto& tracksN = trackFinderN.findTracks(clusters);
+    BOOST_CHECK_GT(tracks1.size(), 0);
+    BOOST_REQUIRE_EQUAL(tracks1.size(), tracksN.size());
+    for (auto itTrack1 = tracks1.begin(), itTrackN = tracksN.begin(); itTrack1 != tracks1.end(); ++itTrack1, ++itTrackN) {
+      BOOST_REQUIRE_EQUAL(itTrack1->getNClusters(), itTrackN->getNClusters());
+      for (auto itParam1 = itTrack1->begin(), itParamN = itTrackN->begin(); itParam1 != itTrack1->end(); ++itParam1, ++itParamN) {
+        BOOST_CHECK_EQUAL(itParam1->getClusterPtr(), itParamN->getClusterPtr());
+        BOOST_CHECK_EQUAL(itParam1->getZ(), itParamN->getZ());
+        for (int i = 0; i < 5; ++i) {
+          BOOST_CHECK_EQUAL(itParam1->getParameters()(i, 0), itParamN->getParameters()(i, 0));
+        }
+        BOOST_CHECK_EQUAL(itParam1->getTrackChi2(), itParamN->getTrackChi2());
+      }
+    }
+  }
+}
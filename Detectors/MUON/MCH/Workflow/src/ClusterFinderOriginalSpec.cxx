@@ -16,9 +16,11 @@
 
 #include "MCHWorkflow/ClusterFinderOriginalSpec.h"
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <chrono>
+#include <memory>
 #include <vector>
 #include <stdexcept>
 #include <string>
@@ -63,12 +65,30 @@ class ClusterFinderOriginalTask
       o2::conf::ConfigurableParam::updateFromFile(config, "MCHClustering", true);
     }
     bool run2Config = ic.options().get<bool>("run2-config");
-    mClusterFinder.init(run2Config);
 
-    /// Print the timer and clear the clusterizer when the processing is over
+    // one clusterizer per thread, each processing a contiguous range of preclusters
+    mNThreads = std::max(1, ic.options().get<int>("threads"));
+#ifndef WITH_OPENMP
+    if (mNThreads > 1) {
+      LOG(WARNING) << "compiled without OpenMP: clustering with 1 thread";
+      mNThreads = 1;
+    }
+#endif
+    for (int i = 0; i < mNThreads; ++i) {
+      mClusterFinders.emplace_back(std::make_unique<ClusterFinderOriginal>());
+      mClusterFinders.back()->init(run2Config);
+      if (mNThreads > 1) {
+        // gRandom cannot be shared between threads
+        mClusterFinders.back()->setRandomSeed(i + 1);
+      }
+    }
+
+    /// Print the timer and clear the clusterizers when the processing is over
     ic.services().get<CallbackService>().set(CallbackService::Id::Stop, [this]() {
       LOG(INFO) << "cluster finder duration = " << mTimeClusterFinder.count() << " s";
-      this->mClusterFinder.deinit();
+      for (auto& clusterFinder : this->mClusterFinders) {
+        clusterFinder->deinit();
+      }
     });
   }
 
@@ -96,40 +116,59 @@ class ClusterFinderOriginalTask
 
       // clusterize every preclusters
       auto tStart = std::chrono::high_resolution_clock::now();
-      mClusterFinder.reset();
-      for (const auto& preCluster : preClusters.subspan(preClusterROF.getFirstIdx(), preClusterROF.getNEntries())) {
-        mClusterFinder.findClusters(digits.subspan(preCluster.firstDigit, preCluster.nDigits));
+      auto rofPreClusters = preClusters.subspan(preClusterROF.getFirstIdx(), preClusterROF.getNEntries());
+      int nPreClusters = rofPreClusters.size();
+      int nThreads = std::max(1, std::min(mNThreads, nPreClusters));
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(static) num_threads(nThreads)
+#endif
+      for (int iThread = 0; iThread < nThreads; ++iThread) {
+        auto& clusterFinder = *mClusterFinders[iThread];
+        clusterFinder.reset();
+        for (int i = nPreClusters * iThread / nThreads; i < nPreClusters * (iThread + 1) / nThreads; ++i) {
+          clusterFinder.findClusters(digits.subspan(rofPreClusters[i].firstDigit, rofPreClusters[i].nDigits));
+        }
       }
       auto tEnd = std::chrono::high_resolution_clock::now();
       mTimeClusterFinder += tEnd - tStart;
 
-      // fill the ouput messages
-      clusterROFs.emplace_back(preClusterROF.getBCData(), clusters.size(), mClusterFinder.getClusters().size());
-      writeClusters(clusters, usedDigits);
+      // fill the ouput messages, in the order of the preclusters
+      auto clusterOffset = clusters.size();
+      for (int iThread = 0; iThread < nThreads; ++iThread) {
+        writeClusters(*mClusterFinders[iThread], clusterOffset, clusters, usedDigits);
+      }
+      clusterROFs.emplace_back(preClusterROF.getBCData(), clusterOffset, clusters.size() - clusterOffset);
     }
   }
 
  private:
   //_________________________________________________________________________________________________
-  void writeClusters(std::vector<ClusterStruct, o2::pmr::polymorphic_allocator<ClusterStruct>>& clusters,
+  void writeClusters(const ClusterFinderOriginal& clusterFinder, size_t rofOffset,
+                     std::vector<ClusterStruct, o2::pmr::polymorphic_allocator<ClusterStruct>>& clusters,
                      std::vector<Digit, o2::pmr::polymorphic_allocator<Digit>>& usedDigits) const
   {
-    /// fill the output messages with clusters and attached digits of the current event
+    /// fill the output messages with clusters and attached digits found by this clusterizer in the current event
     /// modify the references to the attached digits according to their position in the global vector
+    /// and the cluster indices according to their position in the current event
 
     auto clusterOffset = clusters.size();
-    clusters.insert(clusters.end(), mClusterFinder.getClusters().begin(), mClusterFinder.getClusters().end());
+    clusters.insert(clusters.end(), clusterFinder.getClusters().begin(), clusterFinder.getClusters().end());
 
     auto digitOffset = usedDigits.size();
-    usedDigits.insert(usedDigits.end(), mClusterFinder.getUsedDigits().begin(), mClusterFinder.getUsedDigits().end());
+    usedDigits.insert(usedDigits.end(), clusterFinder.getUsedDigits().begin(), clusterFinder.getUsedDigits().end());
 
     for (auto itCluster = clusters.begin() + clusterOffset; itCluster < clusters.end(); ++itCluster) {
       itCluster->firstDigit += digitOffset;
+      if (clusterOffset > rofOffset) {
+        itCluster->uid = ClusterStruct::buildUniqueId(itCluster->getChamberId(), itCluster->getDEId(),
+                                                      itCluster - clusters.begin() - rofOffset);
+      }
     }
   }
 
-  ClusterFinderOriginal mClusterFinder{};             ///< clusterizer
-  std::chrono::duration<double> mTimeClusterFinder{}; ///< timer
+  int mNThreads = 1;                                                     ///< number of threads
+  std::vector<std::unique_ptr<ClusterFinderOriginal>> mClusterFinders{}; ///< clusterizers, one per thread
+  std::chrono::duration<double> mTimeClusterFinder{};                    ///< timer
 };
 
 //_________________________________________________________________________________________________
@@ -145,7 +184,8 @@ o2::framework::DataProcessorSpec getClusterFinderOriginalSpec(const char* name)
             OutputSpec{{"clusterdigits"}, "MCH", "CLUSTERDIGITS", 0, Lifetime::Timeframe}},
     AlgorithmSpec{adaptFromTask<ClusterFinderOriginalTask>()},
     Options{{"config", VariantType::String, "", {"JSON or INI file with clustering parameters"}},
-            {"run2-config", VariantType::Bool, false, {"setup for run2 data"}}}};
+            {"run2-config", VariantType::Bool, false, {"setup for run2 data"}},
+            {"threads", VariantType::Int, 1, {"number of threads clusterizing the preclusters of an event in parallel"}}}};
 }
 
 } // end namespace mch
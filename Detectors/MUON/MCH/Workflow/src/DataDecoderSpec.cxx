@@ -86,6 +86,7 @@ class DataDecoderTask
     auto useDummyElecMap = ic.options().get<bool>("dummy-elecmap");
     mDecoder = new DataDecoder(channelHandler, rdhHandler, sampaBcOffset, mapCRUfile, mapFECfile, ds2manu, mDebug,
                                useDummyElecMap);
+    mDecoder->setNofThreads(ic.options().get<int>("threads"));
 
     auto stop = [this]() {
       LOG(INFO) << "decoding duration = " << mTimeDecoding.count() * 1000 / mTFcount << " us / TF";
@@ -333,7 +334,8 @@ o2::framework::DataProcessorSpec getDecodingSpec(std::string inputSpec,
             {"dummy-elecmap", VariantType::Bool, false, {"use dummy electronic mapping (for debug, temporary)"}},
             {"ds2manu", VariantType::Bool, false, {"convert channel numbering from Run3 to Run1-2 order"}},
             {"check-rofs", VariantType::Bool, false, {"perform consistency checks on the output ROFs"}},
-            {"dummy-rofs", VariantType::Bool, false, {"disable the ROFs finding algorithm"}}}};
+            {"dummy-rofs", VariantType::Bool, false, {"disable the ROFs finding algorithm"}},
+            {"threads", VariantType::Int, 1, {"number of threads decoding the links of a TF in parallel"}}}};
 }
 
 } // namespace raw
@@ -19,6 +19,7 @@
 #include <chrono>
 #include <unordered_map>
 #include <list>
+#include <vector>
 #include <stdexcept>
 #include <string>
 #include <filesystem>
@@ -118,7 +119,7 @@ class TrackFinderTask
       //LOG(INFO) << "processing interaction: " << clusterROF.getBCData() << "...";
 
       // get the input clusters of the current event
-      std::unordered_map<int, std::list<Cluster>> clusters{};
+      std::unordered_map<int, std::vector<Cluster>> clusters{};
       for (const auto& cluster : clustersIn.subspan(clusterROF.getFirstIdx(), clusterROF.getNEntries())) {
         clusters[cluster.getDEId()].emplace_back(cluster);
       }
@@ -20,7 +20,6 @@
 #include <TOFBase/Digit.h>
 #include <TObject.h>
 #include <exception>
-#include <map>
 #include <sstream>
 #include <vector>
 #include "MathUtils/Cartesian.h"
@@ -55,9 +54,9 @@ class Strip
   /// @param ref Reference for the copy
   Strip(const Strip& ref) = default;
 
-  /// Empties the point container
+  /// Empties the point container, keeping the allocated memory
   /// @param option unused
-  void clear() { mDigits.clear(); }
+  void clear();
 
   /// Change the chip index
   /// @param index New chip index
@@ -87,17 +86,41 @@ class Strip
   static int mDigitMerged;
 
  protected:
-  Int_t mStripIndex = -1;                      ///< Strip ID
-  std::map<ULong64_t, o2::tof::Digit> mDigits; ///< Map of fired digits, possibly in multiple frames
+  static constexpr size_t MinSlots = 16; ///< initial size of the open addressing index
 
-  ClassDefNV(Strip, 1);
+  Int_t mStripIndex = -1;              ///< Strip ID
+  std::vector<o2::tof::Digit> mDigits; ///< Fired digits, possibly in multiple frames, in insertion order
+  std::vector<ULong64_t> mKeys;        //! ordering keys of mDigits
+  std::vector<int> mSlots;             //! open addressing index (linear probing) of mKeys: position in mDigits or -1
+  std::vector<int> mOrder;             //! buffer to sort the digits by key when flushing
+
+  /// returns the slot of mSlots holding key or, if absent, the empty slot where it would be inserted
+  size_t findSlot(ULong64_t key) const;
+  /// resizes the index to nslots (power of 2) and reinserts the keys
+  void rehash(size_t nslots);
+
+  ClassDefNV(Strip, 2);
 };
 
+inline size_t Strip::findSlot(ULong64_t key) const
+{
+  // Fibonacci hashing: the high bits of the product mix both the channel and the BC of the key
+  const size_t mask = mSlots.size() - 1;
+  size_t slot = ((key * 0x9e3779b97f4a7c15ULL) >> 32) & mask;
+  while (mSlots[slot] >= 0 && mKeys[mSlots[slot]] != key) {
+    slot = (slot + 1) & mask;
+  }
+  return slot;
+}
+
 inline o2::tof::Digit* Strip::findDigit(ULong64_t key)
 {
   // finds the digit corresponding to global key
-  auto digitentry = mDigits.find(key);
-  return digitentry != mDigits.end() ? &(digitentry->second) : nullptr;
+  if (mDigits.empty()) {
+    return nullptr;
+  }
+  int pos = mSlots[findSlot(key)];
+  return pos >= 0 ? &mDigits[pos] : nullptr;
 }
 
 } // namespace tof
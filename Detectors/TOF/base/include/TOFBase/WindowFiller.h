@@ -108,6 +108,8 @@ class WindowFiller
   std::vector<Strip> mStrips[MAXWINDOWS];
   std::vector<Strip>* mStripsCurrent = &(mStrips[0]);
   std::vector<Strip>* mStripsNext[MAXWINDOWS - 1];
+  // strips with digits in each readout window, flushed in bulk by fillOutputContainer
+  std::vector<int> mFiredStrips[MAXWINDOWS];
 
   // arrays with digit and MCLabels out of the current readout windows (stored to fill future readout window)
   std::vector<Digit> mFutureDigits;
@@ -121,6 +123,16 @@ class WindowFiller
   DigitHeader mDigitHeader;
 
   void fillDigitsInStrip(std::vector<Strip>* strips, int channel, int tdc, int tot, uint64_t nbc, UInt_t istrip, uint32_t triggerorbit = 0, uint16_t triggerbunch = 0);
+
+  /// register the strip istrip of the readout window strips as fired if it is still empty: to be called before adding a digit
+  void markFiredStrip(std::vector<Strip>* strips, UInt_t istrip)
+  {
+    if (!(*strips)[istrip].getNumberOfDigits()) {
+      mFiredStrips[strips - mStrips].push_back(istrip);
+    }
+  }
+  /// move the digits of the fired strips of the current readout window to digits, in strip order
+  void flushFiredStrips(std::vector<Digit>& digits);
   //  void fillDigitsInStrip(std::vector<Strip>* strips, o2::dataformats::MCTruthContainer<o2::tof::MCLabel>* mcTruthContainer, int channel, int tdc, int tot, int nbc, UInt_t istrip, Int_t trackID, Int_t eventID, Int_t sourceID);
 
   void checkIfReuseFutureDigits();
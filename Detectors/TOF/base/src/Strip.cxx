@@ -14,6 +14,7 @@
 // for clusterization purposes
 //  ALICEO2
 //
+#include <algorithm>
 #include <cstring>
 #include <tuple>
 
@@ -34,6 +35,23 @@ Strip::Strip(Int_t index)
 {
 }
 //_______________________________________________________________________
+void Strip::clear()
+{
+  if (!mDigits.empty()) {
+    std::fill(mSlots.begin(), mSlots.end(), -1);
+  }
+  mDigits.clear();
+  mKeys.clear();
+}
+//_______________________________________________________________________
+void Strip::rehash(size_t nslots)
+{
+  mSlots.assign(nslots, -1);
+  for (int pos = 0; pos < (int)mKeys.size(); pos++) {
+    mSlots[findSlot(mKeys[pos])] = pos;
+  }
+}
+//_______________________________________________________________________
 Int_t Strip::addDigit(Int_t channel, Int_t tdc, Int_t tot, uint64_t bc, Int_t lbl, uint32_t triggerorbit, uint16_t triggerbunch)
 {
 
@@ -41,13 +59,19 @@ Int_t Strip::addDigit(Int_t channel, Int_t tdc, Int_t tot, uint64_t bc, Int_t lb
   // case the digit was merged
 
   auto key = Digit::getOrderingKey(channel, bc, tdc); // the digits are ordered first per channel, then inside the channel per BC, then per time
-  auto dig = findDigit(key);
-  if (dig) {
+  if (2 * (mDigits.size() + 1) > mSlots.size()) {     // keep the load factor of the index below 0.5
+    rehash(std::max(MinSlots, 2 * mSlots.size()));
+  }
+  auto slot = findSlot(key);
+  if (mSlots[slot] >= 0) {
+    auto dig = &mDigits[mSlots[slot]];
     lbl = dig->getLabel(); // getting the label from the already existing digit
     dig->merge(tdc, tot);  // merging to the existing digit
     mDigitMerged++;
   } else {
-    mDigits.emplace(std::make_pair(key, Digit(channel, tdc, tot, bc, lbl, triggerorbit, triggerbunch)));
+    mSlots[slot] = mDigits.size();
+    mKeys.push_back(key);
+    mDigits.emplace_back(channel, tdc, tot, bc, lbl, triggerorbit, triggerbunch);
   }
 
   return lbl;
@@ -58,18 +82,18 @@ void Strip::fillOutputContainer(std::vector<Digit>& digits)
 {
   // transfer digits that belong to the strip to the output array of digits
   // we assume that the Strip has stored inside only digits from one readout
-  // window --> we flush them all
+  // window --> we flush them all, ordered by key
 
   if (mDigits.empty()) {
     return;
   }
-  auto itBeg = mDigits.begin();
-  auto iter = itBeg;
-  for (; iter != mDigits.end(); ++iter) {
-    Digit& dig = iter->second;
-    digits.emplace_back(dig);
+  mOrder.resize(mDigits.size());
+  for (int pos = 0; pos < (int)mOrder.size(); pos++) {
+    mOrder[pos] = pos;
   }
-
-  //  if (iter!=mDigits.end()) iter--;
-  mDigits.erase(itBeg, iter);
+  std::sort(mOrder.begin(), mOrder.end(), [this](int a, int b) { return mKeys[a] < mKeys[b]; });
+  for (auto pos : mOrder) {
+    digits.emplace_back(mDigits[pos]);
+  }
+  clear();
 }
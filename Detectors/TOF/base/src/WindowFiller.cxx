@@ -90,6 +90,9 @@ void WindowFiller::reset()
       mStrips[i][j].clear();
     }
   }
+  for (Int_t i = 0; i < MAXWINDOWS; i++) {
+    mFiredStrips[i].clear();
+  }
   mFutureDigits.clear();
 
   mStripsCurrent = &(mStrips[0]);
@@ -108,9 +111,28 @@ void WindowFiller::reset()
 //______________________________________________________________________
 void WindowFiller::fillDigitsInStrip(std::vector<Strip>* strips, int channel, int tdc, int tot, uint64_t nbc, UInt_t istrip, uint32_t triggerorbit, uint16_t triggerbunch)
 {
+  markFiredStrip(strips, istrip);
   (*strips)[istrip].addDigit(channel, tdc, tot, nbc, 0, triggerorbit, triggerbunch);
 }
 //______________________________________________________________________
+void WindowFiller::flushFiredStrips(std::vector<Digit>& digits)
+{
+  auto& fired = mFiredStrips[mIcurrentReadoutWindow];
+  if (fired.empty()) {
+    return;
+  }
+  std::sort(fired.begin(), fired.end()); // keep the output ordered by strip as when looping over all of them
+  size_t ndigits = digits.size();
+  for (auto istrip : fired) {
+    ndigits += (*mStripsCurrent)[istrip].getNumberOfDigits();
+  }
+  digits.reserve(ndigits);
+  for (auto istrip : fired) {
+    (*mStripsCurrent)[istrip].fillOutputContainer(digits);
+  }
+  fired.clear();
+}
+//______________________________________________________________________
 void WindowFiller::addCrateHeaderData(unsigned long orbit, int crate, int32_t bc, uint32_t eventCounter)
 {
   if (orbit < mFirstIR.orbit) {
@@ -135,10 +157,8 @@ void WindowFiller::fillOutputContainer(std::vector<Digit>& digits)
     digits.clear();
   }
 
-  // filling the digit container doing a loop on all strips
-  for (auto& strip : *mStripsCurrent) {
-    strip.fillOutputContainer(digits);
-  }
+  // filling the digit container with the strips fired in the current readout window
+  flushFiredStrips(digits);
 
   if (mContinuous) {
     int first = mDigitsPerTimeFrame.size();
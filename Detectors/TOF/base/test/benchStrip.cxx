@@ -0,0 +1,110 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file   benchStrip.cxx
+/// \brief  Benchmark of the TOF strip digit buffers with high-rate Pb-Pb-like occupancy
+
+#include "benchmark/benchmark.h"
+#include "TOFBase/Geo.h"
+#include "TOFBase/Strip.h"
+#include <map>
+#include <random>
+#include <vector>
+
+using o2::tof::Digit;
+using o2::tof::Geo;
+using o2::tof::Strip;
+
+struct Hit {
+  int channel;
+  int tdc;
+  int tot;
+  uint64_t bc;
+};
+
+// hits of one readout window: a fraction of the channels fired, with ~10% of the hits in an
+// already fired channel and BC which have to be merged
+std::vector<Hit> createHits(int nhits)
+{
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> channel(0, Geo::NCHANNELS - 1);
+  std::uniform_int_distribution<int> bc(0, Geo::BC_IN_WINDOW - 1);
+  std::uniform_int_distribution<int> tdc(0, 1023);
+  std::uniform_int_distribution<int> tot(1, 2000);
+  std::vector<Hit> hits;
+  hits.reserve(nhits);
+  for (int i = 0; i < nhits; i++) {
+    if (i > 10 && i % 10 == 0) {
+      auto h = hits[i / 2];
+      h.tdc = tdc(gen);
+      hits.push_back(h);
+    } else {
+      hits.push_back(Hit{channel(gen), tdc(gen), tot(gen), (uint64_t)bc(gen)});
+    }
+  }
+  return hits;
+}
+
+// flat strips as used by WindowFiller
+static void BM_StripFlat(benchmark::State& state)
+{
+  auto hits = createHits(state.range(0));
+  std::vector<Strip> strips;
+  for (int i = 0; i < Geo::NSTRIPS; i++) {
+    strips.emplace_back(i);
+  }
+  std::vector<Digit> digits;
+  for (auto _ : state) {
+    digits.clear();
+    for (const auto& h : hits) {
+      strips[h.channel / Geo::NPADS].addDigit(h.channel, h.tdc, h.tot, h.bc);
+    }
+    for (auto& strip : strips) {
+      strip.fillOutputContainer(digits);
+    }
+    benchmark::DoNotOptimize(digits.data());
+  }
+  state.SetItemsProcessed(state.iterations() * hits.size());
+}
+
+// reference: per strip std::map of digits, as used before the flat buffers
+static void BM_StripMap(benchmark::State& state)
+{
+  auto hits = createHits(state.range(0));
+  std::vector<std::map<ULong64_t, Digit>> strips(Geo::NSTRIPS);
+  std::vector<Digit> digits;
+  for (auto _ : state) {
+    digits.clear();
+    for (const auto& h : hits) {
+      auto& strip = strips[h.channel / Geo::NPADS];
+      auto key = Digit::getOrderingKey(h.channel, h.bc, h.tdc);
+      auto dig = strip.find(key);
+      if (dig != strip.end()) {
+        dig->second.merge(h.tdc, h.tot);
+      } else {
+        strip.emplace(std::make_pair(key, Digit(h.channel, h.tdc, h.tot, h.bc, 0)));
+      }
+    }
+    for (auto& strip : strips) {
+      for (auto& dig : strip) {
+        digits.emplace_back(dig.second);
+      }
+      strip.clear();
+    }
+    benchmark::DoNotOptimize(digits.data());
+  }
+  state.SetItemsProcessed(state.iterations() * hits.size());
+}
+
+BENCHMARK(BM_StripFlat)->Arg(1000)->Arg(10000)->Arg(50000);
+BENCHMARK(BM_StripMap)->Arg(1000)->Arg(10000)->Arg(50000);
+
+BENCHMARK_MAIN();
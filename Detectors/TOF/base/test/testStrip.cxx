@@ -0,0 +1,61 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test TOFStrip
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include "TOFBase/Geo.h"
+#include "TOFBase/Strip.h"
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <random>
+
+using namespace o2::tof;
+
+BOOST_AUTO_TEST_CASE(testStripOrderAndMerge)
+{
+  Strip strip(3);
+  std::mt19937 gen(1);
+  std::uniform_int_distribution<int> pad(0, Geo::NPADS - 1);
+  std::uniform_int_distribution<int> bc(0, 1000);
+  std::vector<ULong64_t> keys;
+  int merged = Strip::mDigitMerged;
+  for (int i = 0; i < 500; i++) { // enough to grow the index several times
+    int channel = 3 * Geo::NPADS + pad(gen);
+    uint64_t ibc = bc(gen);
+    int lbl = strip.addDigit(channel, 100, 10, ibc, i);
+    auto key = Digit::getOrderingKey(channel, ibc, 100);
+    BOOST_CHECK(strip.findDigit(key) != nullptr);
+    if (std::find(keys.begin(), keys.end(), key) == keys.end()) {
+      BOOST_CHECK_EQUAL(lbl, i);
+      keys.push_back(key);
+    } else {
+      BOOST_CHECK_EQUAL(lbl, strip.findDigit(key)->getLabel()); // merged to the existing digit
+    }
+  }
+  BOOST_CHECK_EQUAL(strip.getNumberOfDigits(), (int)keys.size());
+  BOOST_CHECK_EQUAL(Strip::mDigitMerged - merged, 500 - (int)keys.size());
+
+  std::vector<Digit> digits;
+  strip.fillOutputContainer(digits);
+  BOOST_CHECK_EQUAL(strip.getNumberOfDigits(), 0);
+  BOOST_REQUIRE_EQUAL(digits.size(), keys.size());
+  std::sort(keys.begin(), keys.end());
+  for (size_t i = 0; i < digits.size(); i++) {
+    BOOST_CHECK_EQUAL(digits[i].getOrderingKey(), keys[i]);
+  }
+  BOOST_CHECK(strip.findDigit(keys[0]) == nullptr);
+
+  // the strip is reusable after the flush
+  strip.addDigit(3 * Geo::NPADS, 100, 10, 5);
+  BOOST_CHECK_EQUAL(strip.getNumberOfDigits(), 1);
+  BOOST_CHECK(strip.findDigit(Digit::getOrderingKey(3 * Geo::NPADS, 5, 100)) != nullptr);
+}
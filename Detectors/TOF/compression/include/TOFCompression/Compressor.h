@@ -68,6 +68,7 @@ class Compressor
 
   void checkSummary();
   void resetCounters();
+  void mergeCounters(const Compressor& other);
 
   void setDecoderCONET(bool val)
   {
@@ -821,15 +821,13 @@ void Compressor<RDH, verbose, paranoid>::encoderSpider(int itrm)
         }
 
         auto iframe = hitTime >> 13;
-        auto phit = mSpiderSummary.nFramePackedHits[iframe];
+        auto phit = mSpiderSummary.nFramePackedHits[iframe]++;
 
-        mSpiderSummary.FramePackedHit[iframe][phit] = 0x00000000;
-        mSpiderSummary.FramePackedHit[iframe][phit] |= (totWidth & 0x7FF) << 0;
-        mSpiderSummary.FramePackedHit[iframe][phit] |= (hitTime & 0x1FFF) << 11;
-        mSpiderSummary.FramePackedHit[iframe][phit] |= chan << 24;
-        mSpiderSummary.FramePackedHit[iframe][phit] |= itdc << 27;
-        mSpiderSummary.FramePackedHit[iframe][phit] |= ichain << 31;
-        mSpiderSummary.nFramePackedHits[iframe]++;
+        mSpiderSummary.FramePackedHit[iframe][phit] = ((totWidth & 0x7FF) << 0) |
+                                                      ((hitTime & 0x1FFF) << 11) |
+                                                      (chan << 24) |
+                                                      (itdc << 27) |
+                                                      (ichain << 31);
 
         if (iframe < firstFilledFrame) {
           firstFilledFrame = iframe;
@@ -865,7 +863,13 @@ void Compressor<RDH, verbose, paranoid>::encoderSpider(int itrm)
     }
     encoderNext();
 
-    // packed hits
+    // packed hits: the frame buckets are already in encoding order, copy them in one go
+    if (!(verbose && mEncoderVerbose)) {
+      std::memcpy(mEncoderPointer, mSpiderSummary.FramePackedHit[iframe], mSpiderSummary.nFramePackedHits[iframe] * sizeof(uint32_t));
+      mEncoderPointer += mSpiderSummary.nFramePackedHits[iframe];
+      mSpiderSummary.nFramePackedHits[iframe] = 0;
+      continue;
+    }
     for (int ihit = 0; ihit < mSpiderSummary.nFramePackedHits[iframe]; ++ihit) {
       *mEncoderPointer = mSpiderSummary.FramePackedHit[iframe][ihit];
       if (verbose && mEncoderVerbose) {
@@ -1338,6 +1342,36 @@ void Compressor<RDH, verbose, paranoid>::resetCounters()
   }
 }
 
+template <typename RDH, bool verbose, bool paranoid>
+void Compressor<RDH, verbose, paranoid>::mergeCounters(const Compressor& other)
+{
+  /** add the counters of a compressor which processed other links of the same data **/
+  mEventCounter += other.mEventCounter;
+  mFatalCounter += other.mFatalCounter;
+  mErrorCounter += other.mErrorCounter;
+  mDRMCounters.Headers += other.mDRMCounters.Headers;
+  mDRMCounters.EventWordsMismatch += other.mDRMCounters.EventWordsMismatch;
+  mDRMCounters.clockStatus += other.mDRMCounters.clockStatus;
+  mDRMCounters.Fault += other.mDRMCounters.Fault;
+  mDRMCounters.RTOBit += other.mDRMCounters.RTOBit;
+  for (int itrm = 0; itrm < 10; ++itrm) {
+    mTRMCounters[itrm].Headers += other.mTRMCounters[itrm].Headers;
+    mTRMCounters[itrm].Empty += other.mTRMCounters[itrm].Empty;
+    mTRMCounters[itrm].EventCounterMismatch += other.mTRMCounters[itrm].EventCounterMismatch;
+    mTRMCounters[itrm].EventWordsMismatch += other.mTRMCounters[itrm].EventWordsMismatch;
+    mTRMCounters[itrm].EBit += other.mTRMCounters[itrm].EBit;
+    for (int ichain = 0; ichain < 2; ++ichain) {
+      mTRMChainCounters[itrm][ichain].Headers += other.mTRMChainCounters[itrm][ichain].Headers;
+      mTRMChainCounters[itrm][ichain].EventCounterMismatch += other.mTRMChainCounters[itrm][ichain].EventCounterMismatch;
+      mTRMChainCounters[itrm][ichain].BadStatus += other.mTRMChainCounters[itrm][ichain].BadStatus;
+      mTRMChainCounters[itrm][ichain].BunchIDMismatch += other.mTRMChainCounters[itrm][ichain].BunchIDMismatch;
+      mTRMChainCounters[itrm][ichain].TDCerror += other.mTRMChainCounters[itrm][ichain].TDCerror;
+    }
+  }
+  mIntegratedBytes += other.mIntegratedBytes;
+  mIntegratedTime += other.mIntegratedTime;
+}
+
 template <typename RDH, bool verbose, bool paranoid>
 void Compressor<RDH, verbose, paranoid>::checkSummary()
 {
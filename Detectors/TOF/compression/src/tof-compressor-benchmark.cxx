@@ -0,0 +1,137 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   tof-compressor-benchmark.cxx
+/// @brief  Throughput of the TOF raw data compressor on a raw data file, vs number of threads
+
+#include "TOFCompression/Compressor.h"
+#include "DetectorsRaw/RDHUtils.h"
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <vector>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace bpo = boost::program_options;
+using RDHUtils = o2::raw::RDHUtils;
+using Compressor = o2::tof::Compressor<o2::header::RAWDataHeaderV6, false, false>;
+
+int main(int argc, char** argv)
+{
+  bpo::variables_map vm;
+  bpo::options_description opt_general("Usage:\n  " + std::string(argv[0]) +
+                                       " <raw file>\n"
+                                       "Measure the throughput of the TOF compressor, the links of the file are compressed concurrently\n");
+  bpo::options_description opt_hidden("");
+  bpo::options_description opt_all;
+  bpo::positional_options_description opt_pos;
+
+  try {
+    auto add_option = opt_general.add_options();
+    add_option("help,h", "Print this help message");
+    add_option("threads,t", bpo::value<int>()->default_value(8), "maximum number of threads, measured in powers of 2");
+    add_option("repetitions,r", bpo::value<int>()->default_value(10), "number of times the file is compressed for each number of threads");
+    opt_hidden.add_options()("input", bpo::value<std::string>(), "raw data file");
+    opt_all.add(opt_general).add(opt_hidden);
+    opt_pos.add("input", 1);
+    bpo::store(bpo::command_line_parser(argc, argv).options(opt_all).positional(opt_pos).run(), vm);
+
+    if (vm.count("help") || !vm.count("input")) {
+      std::cout << opt_general << std::endl;
+      exit(0);
+    }
+
+    bpo::notify(vm);
+  } catch (bpo::error& e) {
+    std::cerr << "ERROR: " << e.what() << std::endl
+              << std::endl;
+    std::cerr << opt_general << std::endl;
+    exit(1);
+  }
+
+  /** read the file and split the pages per link, as they are received by the compressor device **/
+  std::ifstream file(vm["input"].as<std::string>(), std::ios::binary | std::ios::ate);
+  if (!file.good()) {
+    std::cerr << "ERROR: cannot open " << vm["input"].as<std::string>() << std::endl;
+    exit(1);
+  }
+  std::vector<char> raw(file.tellg());
+  file.seekg(0);
+  file.read(raw.data(), raw.size());
+
+  std::map<uint16_t, std::vector<char>> linkBuffers;
+  for (size_t offset = 0; offset < raw.size();) {
+    const auto* rdh = raw.data() + offset;
+    auto pageSize = RDHUtils::getOffsetToNext(rdh);
+    if (!pageSize || offset + pageSize > raw.size()) {
+      std::cerr << "ERROR: corrupted RDH at offset " << offset << std::endl;
+      exit(1);
+    }
+    auto& buffer = linkBuffers[RDHUtils::getFEEID(rdh)];
+    buffer.insert(buffer.end(), rdh, rdh + pageSize);
+    offset += pageSize;
+  }
+  std::vector<std::vector<char>*> inputs;
+  std::vector<std::vector<char>> outputs;
+  for (auto& link : linkBuffers) {
+    inputs.push_back(&link.second);
+    outputs.emplace_back(link.second.size() + 1024 * 1024);
+  }
+  int nLinks = inputs.size();
+  std::cout << "Read " << raw.size() << " bytes in " << nLinks << " links" << std::endl;
+
+  int maxThreads = std::max(1, vm["threads"].as<int>());
+#ifndef WITH_OPENMP
+  maxThreads = 1;
+#endif
+  int repetitions = std::max(1, vm["repetitions"].as<int>());
+  std::vector<std::unique_ptr<Compressor>> compressors;
+  for (int ith = 0; ith < maxThreads; ++ith) {
+    compressors.emplace_back(std::make_unique<Compressor>());
+    compressors.back()->resetCounters();
+  }
+
+  for (int nThreads = 1; nThreads <= maxThreads; nThreads *= 2) {
+    size_t outBytes = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int irep = 0; irep < repetitions; ++irep) {
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nThreads) reduction(+ \
+                                                                         : outBytes)
+#endif
+      for (int ilink = 0; ilink < nLinks; ++ilink) {
+#ifdef WITH_OPENMP
+        auto& compressor = *compressors[omp_get_thread_num()];
+#else
+        auto& compressor = *compressors[0];
+#endif
+        compressor.setDecoderBuffer(inputs[ilink]->data());
+        compressor.setDecoderBufferSize(inputs[ilink]->size());
+        compressor.setEncoderBuffer(outputs[ilink].data());
+        compressor.setEncoderBufferSize(outputs[ilink].size());
+        compressor.run();
+        outBytes += compressor.getEncoderByteCounter();
+      }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+    double inGB = double(raw.size()) * repetitions / 1.e9;
+    std::cout << nThreads << " thread(s): " << inGB / elapsed.count() << " GB/s input, "
+              << "compression factor " << double(raw.size()) * repetitions / std::max<size_t>(outBytes, 1) << std::endl;
+  }
+
+  return 0;
+}
@@ -110,6 +110,7 @@ WorkflowSpec defineDataProcessing(ConfigContext const& cfgc)
       algoSpec,
       Options{
         {"tof-compressor-output-buffer-size", VariantType::Int, 0, {"Encoder output buffer size (in bytes). Zero = automatic (careful)."}},
+        {"tof-compressor-threads", VariantType::Int, 1, {"Number of threads compressing the links (subspecs) of a TF concurrently"}},
         {"tof-compressor-conet-mode", VariantType::Bool, false, {"Decoder CONET flag"}},
         {"tof-compressor-decoder-verbose", VariantType::Bool, false, {"Decoder verbose flag"}},
         {"tof-compressor-encoder-verbose", VariantType::Bool, false, {"Encoder verbose flag"}},
@@ -384,6 +384,7 @@ void Digitizer::fillDigitsInStrip(std::vector<Strip>* strips, o2::dataformats::M
     lblCurrent = mcTruthContainer->getIndexedSize(); // this is the size of mHeaderArray;
   }
 
+  markFiredStrip(strips, istrip);
   Int_t lbl = (*strips)[istrip].addDigit(channel, tdc, tot * Geo::NTOTBIN_PER_NS, nbc, lblCurrent);
 
   if (mcTruthContainer) {
@@ -800,13 +801,8 @@ void Digitizer::fillOutputContainer(std::vector<Digit>& digits)
   }
 
   //  printf("TOF fill output container\n");
-  // filling the digit container doing a loop on all strips
-  for (auto& strip : *mStripsCurrent) {
-    strip.fillOutputContainer(digits);
-    if (strip.getNumberOfDigits()) {
-      LOG(INFO) << "strip size = " << strip.getNumberOfDigits() << " - digit size = " << digits.size() << "\n";
-    }
-  }
+  // filling the digit container with the strips fired in the current readout window
+  flushFiredStrips(digits);
 
   if (mContinuous) {
     //printf("%i) # TOF digits = %lu (%p)\n", mIcurrentReadoutWindow, digits.size(), mStripsCurrent);
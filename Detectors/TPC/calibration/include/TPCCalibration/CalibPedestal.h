@@ -43,7 +43,7 @@ namespace tpc
 class CalibPedestal : public CalibRawBase
 {
  public:
-  using vectorType = std::vector<float>;
+  using vectorType = std::vector<uint32_t>;
 
   //enum class StatisticsType {
   //GausFit,   ///< Use Gaus fit for pedestal and noise
@@ -69,10 +69,31 @@ class CalibPedestal : public CalibRawBase
   Int_t updateROC(const Int_t roc, const Int_t row, const Int_t pad,
                   const Int_t timeBin, const Float_t signal) final;
 
+  /// update function called once per pad with all its time bins
+  ///
+  /// \param roc readout chamber
+  /// \param row row in roc
+  /// \param pad pad in row
+  /// \param firstTimeBin time bin of the first ADC value
+  /// \param data ADC values
+  /// \param stride distance between the ADC values of consecutive time bins in data
+  Int_t updateROCPad(const Int_t roc, const Int_t row, const Int_t pad,
+                     const Int_t firstTimeBin, const gsl::span<const uint32_t> data, const int stride) final;
+
   /// not used
   Int_t updateCRU(const CRU& cru, const Int_t row, const Int_t pad,
                   const Int_t timeBin, const Float_t signal) final { return 0; }
 
+  /// not used
+  Int_t updateCRUPad(const CRU& cru, const Int_t row, const Int_t pad,
+                     const Int_t firstTimeBin, const gsl::span<const uint32_t> data, const int stride) final { return 0; }
+
+  /// create the ADC histograms of all ROCs in the sectors upfront
+  ///
+  /// This is required if pads of the same ROC are filled from several threads
+  /// \param sectors sectors to create the histograms for, all if empty
+  void createROCs(const std::vector<int>& sectors = {});
+
   /// Reset pedestal data
   void resetData();
 
@@ -131,7 +152,7 @@ class CalibPedestal : public CalibRawBase
   CalPad mPedestal;               ///< CalDet object with pedestal information
   CalPad mNoise;                  ///< CalDet object with noise
 
-  std::vector<std::unique_ptr<vectorType>> mADCdata; //!< ADC data to calculate noise and pedestal
+  std::vector<std::unique_ptr<vectorType>> mADCdata; //!< histograms of the ADC values per pad to calculate noise and pedestal
 
   /// return the value vector for a readout chamber
   ///
@@ -84,6 +84,31 @@ class CalibRawBase
   virtual Int_t updateCRU(const CRU& cru, const Int_t row, const Int_t pad,
                           const Int_t timeBin, const Float_t signal) = 0;
 
+  /// update function called once per pad with all its time bins
+  ///
+  /// The default implementation calls updateROC for each time bin. Calibrations
+  /// can override it to do the per pad lookups only once.
+  /// \param roc readout chamber
+  /// \param row row in roc
+  /// \param pad pad in row
+  /// \param firstTimeBin time bin of the first ADC value
+  /// \param data ADC values
+  /// \param stride distance between the ADC values of consecutive time bins in data
+  virtual Int_t updateROCPad(const Int_t roc, const Int_t row, const Int_t pad,
+                             const Int_t firstTimeBin, const gsl::span<const uint32_t> data, const int stride);
+
+  /// update function called once per pad with all its time bins
+  ///
+  /// The default implementation calls updateCRU for each time bin.
+  /// \param cru CRU
+  /// \param row row in CRU
+  /// \param pad pad in row
+  /// \param firstTimeBin time bin of the first ADC value
+  /// \param data ADC values
+  /// \param stride distance between the ADC values of consecutive time bins in data
+  virtual Int_t updateCRUPad(const CRU& cru, const Int_t row, const Int_t pad,
+                             const Int_t firstTimeBin, const gsl::span<const uint32_t> data, const int stride);
+
   Int_t update(const PadROCPos& padROCPos, const CRU& cru, const gsl::span<const uint32_t> data);
 
   /// add GBT frame container to process
@@ -614,18 +639,35 @@ inline Int_t CalibRawBase::update(const PadROCPos& padROCPos, const CRU& cru, co
 
   //const FECInfo& fecInfo = mMapper.getFECInfo(padROCPos);
   const int roc = padROCPos.getROC();
-  int timeBin = 0;
-  //for (const auto& signalI : data) {
   //for the moment data of all 16 channels are passed, starting with the present channel
-  for (int i = 0; i < data.size(); i += 16) {
-    const float signal = float(data[i]);
-    //printf("Call update: %d, %d (%d), %d, %d, %.3f -- cru: %03d, reg: %02d -- FEC: %02d, Chip: %02d, Chn: %02d\n", roc, row, rowOffset, pad, timeBin, signal, cru.number(), cru.region(), fecInfo.getIndex(), fecInfo.getSampaChip(), fecInfo.getSampaChannel());
-    // TODO: To be implemented
-    updateCRU(cru, rowInRegion, pad, timeBin, signal);
-    updateROC(roc, row + rowOffset, pad, timeBin, signal);
+  const int stride = 16;
+  updateCRUPad(cru, rowInRegion, pad, 0, data, stride);
+  updateROCPad(roc, row + rowOffset, pad, 0, data, stride);
+  return (data.size() + stride - 1) / stride;
+}
+
+//______________________________________________________________________________
+inline Int_t CalibRawBase::updateROCPad(const Int_t roc, const Int_t row, const Int_t pad,
+                                        const Int_t firstTimeBin, const gsl::span<const uint32_t> data, const int stride)
+{
+  int timeBin = firstTimeBin;
+  for (size_t i = 0; i < data.size(); i += stride) {
+    updateROC(roc, row, pad, timeBin, float(data[i]));
+    ++timeBin;
+  }
+  return 0;
+}
+
+//______________________________________________________________________________
+inline Int_t CalibRawBase::updateCRUPad(const CRU& cru, const Int_t row, const Int_t pad,
+                                        const Int_t firstTimeBin, const gsl::span<const uint32_t> data, const int stride)
+{
+  int timeBin = firstTimeBin;
+  for (size_t i = 0; i < data.size(); i += stride) {
+    updateCRU(cru, row, pad, timeBin, float(data[i]));
     ++timeBin;
   }
-  return timeBin;
+  return 0;
 }
 
 } // namespace tpc
@@ -153,11 +153,11 @@ class IDCFactorization : public IDCGroupHelperSector
   /// \return returns the number of threads used for some of the calculations
   static int getNThreads() { return sNThreads; }
 
-  /// set the IDC data
+  /// set the IDC data and update the running sums used for I_0
   /// \param idcs vector containing the IDCs
   /// \param cru CRU
   /// \param timeframe time frame of the IDCs
-  void setIDCs(std::vector<float>&& idcs, const unsigned int cru, const unsigned int timeframe) { mIDCs[cru][timeframe] = std::move(idcs); }
+  void setIDCs(std::vector<float>&& idcs, const unsigned int cru, const unsigned int timeframe);
 
   /// set the number of threads used for some of the calculations
   /// \param nThreads number of threads
@@ -223,17 +223,33 @@ class IDCFactorization : public IDCGroupHelperSector
   IDCZero mIDCZero{};                                               ///< I_0(r,\phi) = <I(r,\phi,t)>_t
   IDCOne mIDCOne{};                                                 ///< I_1(t) = <I(r,\phi,t) / I_0(r,\phi)>_{r,\phi}
   std::vector<IDCDelta<float>> mIDCDelta{};                         ///< uncompressed: chunk -> Delta IDC: \Delta I(r,\phi,t) = I(r,\phi,t) / ( I_0(r,\phi) * I_1(t) )
+  std::array<std::vector<double>, SIDES> mIDCZeroSum{};             //! running sum of the IDCs per pad, updated when IDCs are set
+  bool mIDCZeroSumValid{false};                                     //! the running sums match mIDCs, they are rebuilt when first needed otherwise (e.g. object read from file)
   inline static int sNThreads{1};                                   ///< number of threads which are used during the calculations
 
+  /// add the IDCs of one CRU and TF to the running sums used for I_0
+  /// \param cru CRU
+  /// \param idcs IDCs of the CRU for one TF
+  /// \param weight weight of the IDCs (-1 for removing previously added IDCs)
+  void fillIDCZeroSum(const unsigned int cru, const std::vector<float>& idcs, const float weight);
+
+  /// rebuild the running sums used for I_0 from the stored IDCs if they are not in sync with them (e.g. object read from file)
+  void buildIDCZeroSum();
+
   /// calculate I_0(r,\phi) = <I(r,\phi,t)>_t
   void calcIDCZero();
 
   /// calculate I_1(t) = <I(r,\phi,t) / I_0(r,\phi)>_{r,\phi}
+  /// the integration intervals are the ones of CRU 0, a CRU missing an integration interval is left out of its average
   void calcIDCOne();
 
   /// calculate \Delta I(r,\phi,t) = I(r,\phi,t) / ( I_0(r,\phi) * I_1(t) )
   void calcIDCDelta();
 
+  /// \return first integration interval of each TF
+  /// \param intervalsPerTF number of integration intervals of each TF
+  std::vector<unsigned int> getFirstIntegrationIntervalPerTF(const std::vector<unsigned int>& intervalsPerTF) const;
+
   /// draw IDCs for one sector for one integration interval
   /// \param sector sector which will be drawn
   /// \param integrationInterval which will be drawn
@@ -54,6 +54,11 @@ class IDCFourierTransform
   /// \param nThreads set the number of threads used for calculation of the fourier coefficients
   static void setNThreads(const int nThreads) { sNThreads = nThreads; }
 
+  /// the coefficients of consecutive intervals are obtained by shifting the window of 1D-IDCs of the previous interval (sliding DFT).
+  /// To limit the accumulation of rounding errors the coefficients are calculated from scratch for the first interval of each block of intervals
+  /// \param nIntervals number of intervals per block (1: no sliding DFT)
+  static void setSlidingWindowBlock(const int nIntervals) { sSlidingWindowBlock = nIntervals; }
+
   /// calculate fourier coefficients
   void calcFourierCoefficients() { sFftw ? calcFourierCoefficientsFFTW3() : calcFourierCoefficientsNaive(); }
 
@@ -91,6 +96,9 @@ class IDCFourierTransform
   /// get the number of threads used for calculation of the fourier coefficients
   static int getNThreads() { return sNThreads; }
 
+  /// get the number of intervals per block for which the sliding DFT is used
+  static int getSlidingWindowBlock() { return sSlidingWindowBlock; }
+
   /// dump object to disc
   /// \param outFileName name of the output file
   /// \param outName name of the object in the output file
@@ -109,6 +117,7 @@ class IDCFourierTransform
   bool mBufferIndex{true};                                                 ///< index for the buffer
   inline static int sFftw{1};                                              ///< using fftw or naive approach for calculation of fourier coefficients
   inline static int sNThreads{1};                                          ///< number of threads which are used during the calculation of the fourier coefficients
+  inline static int sSlidingWindowBlock{16};                               ///< number of intervals per block for which the coefficients are obtained with the sliding DFT
 
   /// calculate fourier coefficients
   void calcFourierCoefficientsNaive();
@@ -12,6 +12,7 @@
 /// \file   CalibPedestal.cxx
 /// \author Jens Wiechula, Jens.Wiechula@ikf.uni-frankfurt.de
 
+#include <algorithm>
 #include <fmt/format.h>
 
 #include "TH2F.h"
@@ -72,7 +73,32 @@ Int_t CalibPedestal::updateROC(const Int_t roc, const Int_t row, const Int_t pad
   vectorType& adcVec = *getVector(ROC(roc), kTRUE);
   ++(adcVec[bin]);
 
-  //printf("bin: %5d, val: %.2f\n", bin, adcVec[bin]);
+  //printf("bin: %5d, val: %d\n", bin, adcVec[bin]);
+
+  return 0;
+}
+
+//______________________________________________________________________________
+Int_t CalibPedestal::updateROCPad(const Int_t roc, const Int_t row, const Int_t pad,
+                                  const Int_t firstTimeBin, const gsl::span<const uint32_t> data, const int stride)
+{
+  // restrict to the time bin range used in the analysis
+  const int nTimeBins = (data.size() + stride - 1) / stride;
+  const int first = std::max(mFirstTimeBin - firstTimeBin, 0);
+  const int last = std::min(mLastTimeBin - firstTimeBin, nTimeBins - 1);
+  if (first > last) {
+    return 0;
+  }
+
+  const GlobalPadNumber padInROC = mMapper.getPadNumberInROC(PadROCPos(roc, row, pad));
+  uint32_t* adcHist = getVector(ROC(roc), kTRUE)->data() + padInROC * mNumberOfADCs;
+
+  for (size_t i = size_t(first) * stride; i <= size_t(last) * stride; i += stride) {
+    const uint32_t adcBin = uint32_t(Int_t(data[i]) - mADCMin); // negative values wrap around and are rejected below
+    if (adcBin < uint32_t(mNumberOfADCs)) {
+      ++adcHist[adcBin];
+    }
+  }
 
   return 0;
 }
@@ -95,12 +121,25 @@ CalibPedestal::vectorType* CalibPedestal::getVector(ROC roc, bool create /*=kFAL
   return vec;
 }
 
+//______________________________________________________________________________
+void CalibPedestal::createROCs(const std::vector<int>& sectors)
+{
+  for (int iroc = 0; iroc < ROC::MaxROC; ++iroc) {
+    const ROC roc(iroc);
+    if (sectors.size() && (std::find(sectors.begin(), sectors.end(), int(roc.getSector().getSector())) == sectors.end())) {
+      continue;
+    }
+    getVector(roc, kTRUE);
+  }
+}
+
 //______________________________________________________________________________
 void CalibPedestal::analyse()
 {
   ROC roc;
 
   std::vector<float> fitValues;
+  std::vector<float> adcHist(mNumberOfADCs);
 
   for (auto& vecPtr : mADCdata) {
     auto vec = vecPtr.get();
@@ -112,8 +151,6 @@ void CalibPedestal::analyse()
     CalROC& calROCPedestal = mPedestal.getCalArray(roc);
     CalROC& calROCNoise = mNoise.getCalArray(roc);
 
-    float* array = vec->data();
-
     const size_t numberOfPads = (roc.rocType() == RocType::IROC) ? mMapper.getPadsInIROC() : mMapper.getPadsInOROC();
 
     float pedestal{};
@@ -124,16 +161,18 @@ void CalibPedestal::analyse()
 
     for (Int_t ichannel = 0; ichannel < numberOfPads; ++ichannel) {
       size_t offset = ichannel * mNumberOfADCs;
+      std::copy(vec->begin() + offset, vec->begin() + offset + mNumberOfADCs, adcHist.begin());
+      float* array = adcHist.data();
       if (mStatisticsType == StatisticsType::GausFit) {
-        fit(mNumberOfADCs, array + offset, float(mADCMin) - 0.5f, float(mADCMax + 1) - 0.5f, fg); // -0.5 since ADC values are discrete
+        fit(mNumberOfADCs, array, float(mADCMin) - 0.5f, float(mADCMax + 1) - 0.5f, fg); // -0.5 since ADC values are discrete
         pedestal = fg.GetParameter(1);
         noise = fg.GetParameter(2);
       } else if (mStatisticsType == StatisticsType::GausFitFast) {
-        fitGaus(mNumberOfADCs, array + offset, float(mADCMin) - 0.5f, float(mADCMax + 1) - 0.5f, fitValues); // -0.5 since ADC values are discrete
+        fitGaus(mNumberOfADCs, array, float(mADCMin) - 0.5f, float(mADCMax + 1) - 0.5f, fitValues); // -0.5 since ADC values are discrete
         pedestal = fitValues[1];
         noise = fitValues[2];
       } else if (mStatisticsType == StatisticsType::MeanStdDev) {
-        StatisticsData data = getStatisticsData(array + offset, mNumberOfADCs, double(mADCMin) - 0.5, double(mADCMax) - 0.5); // -0.5 since ADC values are discrete
+        StatisticsData data = getStatisticsData(array, mNumberOfADCs, double(mADCMin) - 0.5, double(mADCMax) - 0.5); // -0.5 since ADC values are discrete
         pedestal = data.mCOG;
         noise = data.mStdDev;
       }
@@ -157,7 +196,7 @@ void CalibPedestal::resetData()
     if (!vec) {
       continue;
     }
-    vec->clear();
+    std::fill(vec->begin(), vec->end(), 0);
   }
 }
 
@@ -22,6 +22,7 @@
 #include "TLatex.h"
 #include "TKey.h"
 #include "Framework/Logger.h"
+#include <algorithm>
 
 #if (defined(WITH_OPENMP) || defined(_OPENMP)) && !defined(__CLING__)
 #include <omp.h>
@@ -29,43 +30,56 @@
 
 void o2::tpc::IDCAverageGroup::processIDCs()
 {
-#pragma omp parallel for num_threads(sNThreads)
-  for (unsigned int integrationInterval = 0; integrationInterval < getNIntegrationIntervals(); ++integrationInterval) {
-    const unsigned int lastRow = mIDCsGrouped.getLastRow();
-    unsigned int rowGrouped = 0;
-    for (unsigned int iRow = 0; iRow <= lastRow; iRow += mIDCsGrouped.getGroupRows()) {
-      // the sectors is divide in to two parts around ylocal=0 to get the same simmetric grouping around ylocal=0
-      for (int iYLocalSide = 0; iYLocalSide < 2; ++iYLocalSide) {
-        const unsigned int region = mIDCsGrouped.getRegion();
-        const unsigned int nPads = Mapper::PADSPERROW[region][iRow] / 2;
-        const unsigned int endPads = mIDCsGrouped.getLastPad(iRow) + nPads;
-
-        const unsigned int halfPadsInRow = mIDCsGrouped.getPadsPerRow(rowGrouped) / 2;
-        unsigned int padGrouped = iYLocalSide ? halfPadsInRow : halfPadsInRow - 1;
-        for (unsigned int ipad = nPads; ipad <= endPads; ipad += mIDCsGrouped.getGroupPads()) {
-          const unsigned int endRows = (iRow == lastRow) ? (Mapper::ROWSPERREGION[region] - iRow) : mIDCsGrouped.getGroupRows();
-
-          // TODO Mapper::ADDITIONALPADSPERROW[region].back() factor is to large, but doesnt really matter
-          const unsigned int maxGoup = (mIDCsGrouped.getGroupRows() + mIDCsGrouped.getGroupLastRowsThreshold()) * (mIDCsGrouped.getGroupPads() + mIDCsGrouped.getGroupLastPadsThreshold() + Mapper::ADDITIONALPADSPERROW[region].back());
-          RobustAverage robustAverage(maxGoup);
-
-          for (unsigned int iRowMerge = 0; iRowMerge < endRows; ++iRowMerge) {
-            const unsigned int iRowTmp = iRow + iRowMerge;
-            const auto offs = Mapper::ADDITIONALPADSPERROW[region][iRowTmp] - Mapper::ADDITIONALPADSPERROW[region][iRow];
-            const auto padStart = (ipad == 0) ? 0 : offs;
-            const unsigned int endPadsTmp = (ipad == endPads) ? (Mapper::PADSPERROW[region][iRowTmp] - ipad) : mIDCsGrouped.getGroupPads() + offs;
-            for (unsigned int ipadMerge = padStart; ipadMerge < endPadsTmp; ++ipadMerge) {
-              const unsigned int iPadTmp = ipad + ipadMerge;
-              const unsigned int iPadSide = iYLocalSide ? iPadTmp : Mapper::PADSPERROW[region][iRowTmp] - iPadTmp - 1;
-              const unsigned int indexIDC = integrationInterval * Mapper::PADSPERREGION[region] + Mapper::OFFSETCRULOCAL[region][iRowTmp] + iPadSide;
-              robustAverage.addValue(mIDCsUngrouped[indexIDC] * Mapper::PADAREA[region]);
-            }
+  // the grouping is the same for all integration intervals: get the grouped pad and the local pad indices of each group once
+  const unsigned int region = mIDCsGrouped.getRegion();
+  std::vector<std::pair<unsigned int, unsigned int>> groupedPads; // grouped row and pad of each group
+  std::vector<unsigned int> groupOffsets{0};                      // first index in padIndices of each group
+  std::vector<unsigned int> padIndices;                           // local pad indices of the IDCs of all groups
+  padIndices.reserve(Mapper::PADSPERREGION[region]);
+  unsigned int maxGroup = 0;
+
+  const unsigned int lastRow = mIDCsGrouped.getLastRow();
+  unsigned int rowGrouped = 0;
+  for (unsigned int iRow = 0; iRow <= lastRow; iRow += mIDCsGrouped.getGroupRows()) {
+    // the sectors is divide in to two parts around ylocal=0 to get the same simmetric grouping around ylocal=0
+    for (int iYLocalSide = 0; iYLocalSide < 2; ++iYLocalSide) {
+      const unsigned int nPads = Mapper::PADSPERROW[region][iRow] / 2;
+      const unsigned int endPads = mIDCsGrouped.getLastPad(iRow) + nPads;
+
+      const unsigned int halfPadsInRow = mIDCsGrouped.getPadsPerRow(rowGrouped) / 2;
+      unsigned int padGrouped = iYLocalSide ? halfPadsInRow : halfPadsInRow - 1;
+      for (unsigned int ipad = nPads; ipad <= endPads; ipad += mIDCsGrouped.getGroupPads()) {
+        const unsigned int endRows = (iRow == lastRow) ? (Mapper::ROWSPERREGION[region] - iRow) : mIDCsGrouped.getGroupRows();
+        for (unsigned int iRowMerge = 0; iRowMerge < endRows; ++iRowMerge) {
+          const unsigned int iRowTmp = iRow + iRowMerge;
+          const auto offs = Mapper::ADDITIONALPADSPERROW[region][iRowTmp] - Mapper::ADDITIONALPADSPERROW[region][iRow];
+          const auto padStart = (ipad == 0) ? 0 : offs;
+          const unsigned int endPadsTmp = (ipad == endPads) ? (Mapper::PADSPERROW[region][iRowTmp] - ipad) : mIDCsGrouped.getGroupPads() + offs;
+          for (unsigned int ipadMerge = padStart; ipadMerge < endPadsTmp; ++ipadMerge) {
+            const unsigned int iPadTmp = ipad + ipadMerge;
+            const unsigned int iPadSide = iYLocalSide ? iPadTmp : Mapper::PADSPERROW[region][iRowTmp] - iPadTmp - 1;
+            padIndices.emplace_back(Mapper::OFFSETCRULOCAL[region][iRowTmp] + iPadSide);
           }
-          mIDCsGrouped(rowGrouped, padGrouped, integrationInterval) = robustAverage.getFilteredAverage();
-          iYLocalSide ? ++padGrouped : --padGrouped;
         }
+        groupedPads.emplace_back(rowGrouped, padGrouped);
+        groupOffsets.emplace_back(padIndices.size());
+        maxGroup = std::max(maxGroup, groupOffsets.back() - groupOffsets[groupOffsets.size() - 2]);
+        iYLocalSide ? ++padGrouped : --padGrouped;
+      }
+    }
+    ++rowGrouped;
+  }
+
+#pragma omp parallel for num_threads(sNThreads)
+  for (unsigned int integrationInterval = 0; integrationInterval < getNIntegrationIntervals(); ++integrationInterval) {
+    RobustAverage robustAverage(maxGroup);
+    const float* idcs = mIDCsUngrouped.data() + integrationInterval * Mapper::PADSPERREGION[region];
+    for (unsigned int group = 0; group < groupedPads.size(); ++group) {
+      robustAverage.clear();
+      for (unsigned int i = groupOffsets[group]; i < groupOffsets[group + 1]; ++i) {
+        robustAverage.addValue(idcs[padIndices[i]] * Mapper::PADAREA[region]);
       }
-      ++rowGrouped;
+      mIDCsGrouped(groupedPads[group].first, groupedPads[group].second, integrationInterval) = robustAverage.getFilteredAverage();
     }
   }
 }
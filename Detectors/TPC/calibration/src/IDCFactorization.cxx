@@ -18,6 +18,8 @@
 #include "TCanvas.h"
 #include "TLatex.h"
 #include <functional>
+#include <algorithm>
+#include <atomic>
 
 o2::tpc::IDCFactorization::IDCFactorization(const std::array<unsigned char, Mapper::NREGIONS>& groupPads, const std::array<unsigned char, Mapper::NREGIONS>& groupRows, const std::array<unsigned char, Mapper::NREGIONS>& groupLastRowsThreshold, const std::array<unsigned char, Mapper::NREGIONS>& groupLastPadsThreshold, const unsigned int timeFrames, const unsigned int timeframesDeltaIDC)
   : IDCGroupHelperSector{groupPads, groupRows, groupLastRowsThreshold, groupLastPadsThreshold}, mTimeFrames{timeFrames}, mTimeFramesDeltaIDC{timeframesDeltaIDC}, mIDCDelta{timeFrames / timeframesDeltaIDC + (timeFrames % timeframesDeltaIDC != 0)}
@@ -306,49 +308,128 @@ void o2::tpc::IDCFactorization::dumpToTree(int integrationIntervals) const
   pcstream.Close();
 }
 
-void o2::tpc::IDCFactorization::calcIDCZero()
+void o2::tpc::IDCFactorization::setIDCs(std::vector<float>&& idcs, const unsigned int cru, const unsigned int timeframe)
+{
+  buildIDCZeroSum();
+  fillIDCZeroSum(cru, mIDCs[cru][timeframe], -1); // remove IDCs which were set before for this CRU and TF
+  mIDCs[cru][timeframe] = std::move(idcs);
+  fillIDCZeroSum(cru, mIDCs[cru][timeframe], 1);
+}
+
+void o2::tpc::IDCFactorization::fillIDCZeroSum(const unsigned int cru, const std::vector<float>& idcs, const float weight)
 {
+  if (idcs.empty()) {
+    return;
+  }
   const unsigned int nIDCsSide = mNIDCsPerSector * o2::tpc::SECTORSPERSIDE;
-  mIDCZero.mIDCZero[Side::A].resize(nIDCsSide);
-  mIDCZero.mIDCZero[Side::C].resize(nIDCsSide);
+  const o2::tpc::CRU cruTmp(cru);
+  const unsigned int region = cruTmp.region();
+  auto& idcZeroSum = mIDCZeroSum[cruTmp.side()];
+  if (idcZeroSum.empty()) {
+    idcZeroSum.resize(nIDCsSide);
+  }
+  double* sum = idcZeroSum.data() + (mRegionOffs[region] + mNIDCsPerSector * cruTmp.sector()) % nIDCsSide;
+  const unsigned int nIDCs = mNIDCsPerCRU[region];
+  for (unsigned int offs = 0; offs + nIDCs <= idcs.size(); offs += nIDCs) {
+    const float* idcsInterval = idcs.data() + offs;
+    for (unsigned int i = 0; i < nIDCs; ++i) {
+      sum[i] += weight * idcsInterval[i];
+    }
+  }
+}
 
-#pragma omp parallel for num_threads(sNThreads)
+void o2::tpc::IDCFactorization::buildIDCZeroSum()
+{
+  if (mIDCZeroSumValid) {
+    return;
+  }
+  // the running sums are not streamed
+  for (auto& idcZeroSum : mIDCZeroSum) {
+    std::fill(idcZeroSum.begin(), idcZeroSum.end(), 0);
+  }
   for (unsigned int cru = 0; cru < mIDCs.size(); ++cru) {
-    const o2::tpc::CRU cruTmp(cru);
-    const unsigned int region = cruTmp.region();
-    for (unsigned int timeframe = 0; timeframe < mTimeFrames; ++timeframe) {
-      for (unsigned int idcs = 0; idcs < mIDCs[cru][timeframe].size(); ++idcs) {
-        const unsigned int indexGlob = (idcs % mNIDCsPerCRU[region]) + mRegionOffs[region] + mNIDCsPerSector * cruTmp.sector();
-        mIDCZero.fillValueIDCZero(mIDCs[cru][timeframe][idcs], cruTmp.side(), indexGlob % nIDCsSide);
-      }
+    for (const auto& idcs : mIDCs[cru]) {
+      fillIDCZeroSum(cru, idcs, 1);
     }
   }
-  std::transform(mIDCZero.mIDCZero[Side::A].begin(), mIDCZero.mIDCZero[Side::A].end(), mIDCZero.mIDCZero[Side::A].begin(), [norm = getNIntegrationIntervals()](auto& val) { return val / norm; });
-  std::transform(mIDCZero.mIDCZero[Side::C].begin(), mIDCZero.mIDCZero[Side::C].end(), mIDCZero.mIDCZero[Side::C].begin(), [norm = getNIntegrationIntervals()](auto& val) { return val / norm; });
+  mIDCZeroSumValid = true;
+}
+
+void o2::tpc::IDCFactorization::calcIDCZero()
+{
+  // the IDCs are summed up when they are set, only the normalization is left
+  buildIDCZeroSum();
+
+  const unsigned int nIDCsSide = mNIDCsPerSector * o2::tpc::SECTORSPERSIDE;
+  const auto norm = getNIntegrationIntervals();
+  for (const auto side : {Side::A, Side::C}) {
+    mIDCZeroSum[side].resize(nIDCsSide);
+    mIDCZero.mIDCZero[side].resize(nIDCsSide);
+    std::transform(mIDCZeroSum[side].begin(), mIDCZeroSum[side].end(), mIDCZero.mIDCZero[side].begin(), [norm](const auto val) { return static_cast<float>(val / norm); });
+  }
 }
 
 void o2::tpc::IDCFactorization::calcIDCOne()
 {
   const unsigned int nIDCsSide = mNIDCsPerSector * SECTORSPERSIDE;
   const unsigned int integrationIntervals = getNIntegrationIntervals();
-  mIDCOne.mIDCOne[Side::A].resize(integrationIntervals);
-  mIDCOne.mIDCOne[Side::C].resize(integrationIntervals);
-  const unsigned int crusPerSide = Mapper::NREGIONS * SECTORSPERSIDE;
+  mIDCOne.mIDCOne[Side::A].assign(integrationIntervals, 0);
+  mIDCOne.mIDCOne[Side::C].assign(integrationIntervals, 0);
+
+  // the integration intervals are the ones of CRU 0: a CRU with fewer intervals in a TF is left out of the average of the missing ones,
+  // additional intervals of a CRU are ignored
+  std::array<std::vector<unsigned int>, SIDES> nCRUs;
+  nCRUs[Side::A].assign(integrationIntervals, 0);
+  nCRUs[Side::C].assign(integrationIntervals, 0);
+  const auto intervalsPerTF = getIntegrationIntervalsPerTF();
+  const auto firstInterval = getFirstIntegrationIntervalPerTF(intervalsPerTF);
+  std::atomic<unsigned int> nMismatches{0};
+
+  // different TFs fill different integration intervals: parallelize over TFs and not over CRUs, which would sum up to the same I_1(t)
 #pragma omp parallel for num_threads(sNThreads)
-  for (unsigned int cru = 0; cru < mIDCs.size(); ++cru) {
-    const o2::tpc::CRU cruTmp(cru);
-    const unsigned int region = cruTmp.region();
-    unsigned int integrationIntervallast = 0;
-    for (unsigned int timeframe = 0; timeframe < mTimeFrames; ++timeframe) {
-      for (unsigned int idcs = 0; idcs < mIDCs[cru][timeframe].size(); ++idcs) {
-        const unsigned int integrationInterval = idcs / mNIDCsPerCRU[region] + integrationIntervallast;
-        const auto side = cruTmp.side();
-        const unsigned int indexGlob = (idcs % mNIDCsPerCRU[region]) + mRegionOffs[region] + mNIDCsPerSector * cruTmp.sector();
-        mIDCOne.mIDCOne[side][integrationInterval] += mIDCs[cru][timeframe][idcs] / (crusPerSide * mNIDCsPerCRU[region] * mIDCZero.mIDCZero[side][indexGlob % nIDCsSide]);
+  for (unsigned int timeframe = 0; timeframe < mTimeFrames; ++timeframe) {
+    for (unsigned int cru = 0; cru < mIDCs.size(); ++cru) {
+      const o2::tpc::CRU cruTmp(cru);
+      const unsigned int region = cruTmp.region();
+      const auto side = cruTmp.side();
+      const float* idcZero = mIDCZero.mIDCZero[side].data() + (mRegionOffs[region] + mNIDCsPerSector * cruTmp.sector()) % nIDCsSide;
+      const unsigned int nIDCs = mNIDCsPerCRU[region];
+      const auto& idcs = mIDCs[cru][timeframe];
+      if (idcs.size() != intervalsPerTF[timeframe] * nIDCs) {
+        ++nMismatches;
+      }
+      const unsigned int intervals = std::min<unsigned int>(idcs.size() / nIDCs, intervalsPerTF[timeframe]);
+      for (unsigned int interval = 0; interval < intervals; ++interval) {
+        const float* idcsInterval = idcs.data() + interval * nIDCs;
+        float sum = 0;
+        for (unsigned int i = 0; i < nIDCs; ++i) {
+          sum += idcsInterval[i] / (nIDCs * idcZero[i]);
+        }
+        mIDCOne.mIDCOne[side][firstInterval[timeframe] + interval] += sum;
+        ++nCRUs[side][firstInterval[timeframe] + interval];
+      }
+    }
+  }
+
+  for (const auto side : {Side::A, Side::C}) {
+    for (unsigned int interval = 0; interval < integrationIntervals; ++interval) {
+      if (nCRUs[side][interval]) {
+        mIDCOne.mIDCOne[side][interval] /= nCRUs[side][interval];
       }
-      integrationIntervallast += mIDCs[cru][timeframe].size() / mNIDCsPerCRU[region];
     }
   }
+  if (nMismatches) {
+    LOGP(warning, "{} IDC sets of a CRU and TF have a number of integration intervals different from CRU 0", nMismatches.load());
+  }
+}
+
+std::vector<unsigned int> o2::tpc::IDCFactorization::getFirstIntegrationIntervalPerTF(const std::vector<unsigned int>& intervalsPerTF) const
+{
+  std::vector<unsigned int> firstInterval(intervalsPerTF.size());
+  for (unsigned int timeframe = 1; timeframe < intervalsPerTF.size(); ++timeframe) {
+    firstInterval[timeframe] = firstInterval[timeframe - 1] + intervalsPerTF[timeframe - 1];
+  }
+  return firstInterval;
 }
 
 void o2::tpc::IDCFactorization::calcIDCDelta()
@@ -359,6 +440,7 @@ void o2::tpc::IDCFactorization::calcIDCDelta()
     mIDCDelta[i].getIDCDelta(Side::A).resize(idcsSide);
     mIDCDelta[i].getIDCDelta(Side::C).resize(idcsSide);
   }
+  const auto intervalsPerTF = getIntegrationIntervalsPerTF();
 
 #pragma omp parallel for num_threads(sNThreads)
   for (unsigned int cru = 0; cru < mIDCs.size(); ++cru) {
@@ -374,7 +456,9 @@ void o2::tpc::IDCFactorization::calcIDCDelta()
         integrationIntervallastLocal = 0;
       }
 
-      for (unsigned int idcs = 0; idcs < mIDCs[cru][timeframe].size(); ++idcs) {
+      // as for I_1, only the integration intervals of CRU 0 are used
+      const unsigned int nIDCs = std::min<unsigned int>(mIDCs[cru][timeframe].size(), intervalsPerTF[timeframe] * mNIDCsPerCRU[region]);
+      for (unsigned int idcs = 0; idcs < nIDCs; ++idcs) {
         const unsigned int intervallocal = idcs / mNIDCsPerCRU[region];
         const unsigned int integrationIntervalGlobal = intervallocal + integrationIntervallast;
         const unsigned int integrationIntervalLocal = intervallocal + integrationIntervallastLocal;
@@ -388,7 +472,7 @@ void o2::tpc::IDCFactorization::calcIDCDelta()
         mIDCDelta[chunk].getIDCDelta(side)[indexGlobMod + integrationIntervalLocal * nIDCsSide] = val - 1;
       }
 
-      const unsigned int intervals = mIDCs[cru][timeframe].size() / mNIDCsPerCRU[region];
+      const unsigned int intervals = intervalsPerTF[timeframe];
       integrationIntervallast += intervals;
       integrationIntervallastLocal += intervals;
       lastChunk = chunk;
@@ -493,4 +577,8 @@ void o2::tpc::IDCFactorization::reset()
       idcs.clear();
     }
   }
+  for (auto& idcZeroSum : mIDCZeroSum) {
+    std::fill(idcZeroSum.begin(), idcZeroSum.end(), 0);
+  }
+  mIDCZeroSumValid = true;
 }
@@ -15,6 +15,7 @@
 #include "Framework/Logger.h"
 #include "TFile.h"
 #include <cmath>
+#include <algorithm>
 // #include <fftw3.h>
 
 #if (defined(WITH_OPENMP) || defined(_OPENMP)) && !defined(__CLING__)
@@ -57,18 +58,69 @@ void o2::tpc::IDCFourierTransform::calcFourierCoefficientsFFTW3()
 void o2::tpc::IDCFourierTransform::calcFourierCoefficientsNaive(const o2::tpc::Side side, const std::vector<unsigned int>& offsetIndex)
 {
   // see: https://en.wikipedia.org/wiki/Discrete_Fourier_transform#Definitiona
+  const auto idcOneExpanded = getExpandedIDCOne(side);
+  const unsigned int nCoeff = mFourierCoefficients.getNCoefficientsPerTF() / 2;
+
+  // cos(2 pi k n / N) and sin(2 pi k n / N) only depend on k * n % N
+  std::vector<double> cosTerm(mRangeIDC);
+  std::vector<double> sinTerm(mRangeIDC);
+  for (unsigned int index = 0; index < mRangeIDC; ++index) {
+    const double term = o2::constants::math::TwoPI * index / mRangeIDC;
+    cosTerm[index] = std::cos(term);
+    sinTerm[index] = std::sin(term);
+  }
+
+  auto& coefficients = mFourierCoefficients.mFourierCoefficients[side];
+  std::fill(coefficients.begin(), coefficients.end(), 0);
+
+  // the window of 1D-IDCs of an interval is shifted by the integration intervals of one TF with respect to the previous interval:
+  // X_k(o + s) = exp(i 2 pi k s / N) * (X_k(o) + sum_{j<s} (x[o + N + j] - x[o + j]) * exp(-i 2 pi k j / N)).
+  // The intervals are split in blocks which are processed in parallel, the coefficients of the first interval of each block are calculated from scratch.
+  const unsigned int blockSize = std::max(sSlidingWindowBlock, 1);
+  const unsigned int nBlocks = (getNIntervals() + blockSize - 1) / blockSize;
 #pragma omp parallel for num_threads(sNThreads)
-  for (unsigned int interval = 0; interval < getNIntervals(); ++interval) {
-    const auto idcOneExpanded = getExpandedIDCOne(side);
-    for (unsigned int coeff = 0; coeff < mFourierCoefficients.getNCoefficientsPerTF() / 2; ++coeff) {
-      const unsigned int indexDataReal = mFourierCoefficients.getIndex(interval, 2 * coeff); // index for storing real fourier coefficient
-      const unsigned int indexDataImag = indexDataReal + 1;                                  // index for storing complex fourier coefficient
-      const float term0 = o2::constants::math::TwoPI * coeff / mRangeIDC;
-      for (unsigned int index = 0; index < mRangeIDC; ++index) {
-        const float term = term0 * index;
-        const float idc0 = idcOneExpanded[index + offsetIndex[interval]];
-        mFourierCoefficients(side, indexDataReal) += idc0 * std::cos(term);
-        mFourierCoefficients(side, indexDataImag) -= idc0 * std::sin(term);
+  for (unsigned int block = 0; block < nBlocks; ++block) {
+    std::vector<double> real(nCoeff);
+    std::vector<double> imag(nCoeff);
+    const unsigned int lastInterval = std::min((block + 1) * blockSize, getNIntervals());
+    for (unsigned int interval = block * blockSize; interval < lastInterval; ++interval) {
+      const float* idcs = idcOneExpanded.data() + offsetIndex[interval];
+      const bool slide = (interval != block * blockSize) && (offsetIndex[interval] >= offsetIndex[interval - 1]) && (offsetIndex[interval] - offsetIndex[interval - 1] < mRangeIDC);
+      if (slide) {
+        const unsigned int shift = offsetIndex[interval] - offsetIndex[interval - 1];
+        const float* idcsLast = idcs - shift;
+        for (unsigned int coeff = 0; coeff < nCoeff; ++coeff) {
+          double re = real[coeff];
+          double im = imag[coeff];
+          for (unsigned int index = 0; index < shift; ++index) {
+            const unsigned int term = (coeff * index) % mRangeIDC;
+            const double diff = idcsLast[index + mRangeIDC] - idcsLast[index];
+            re += diff * cosTerm[term];
+            im -= diff * sinTerm[term];
+          }
+          const unsigned int term = (coeff * shift) % mRangeIDC;
+          real[coeff] = re * cosTerm[term] - im * sinTerm[term];
+          imag[coeff] = re * sinTerm[term] + im * cosTerm[term];
+        }
+      } else {
+        for (unsigned int coeff = 0; coeff < nCoeff; ++coeff) {
+          double re = 0;
+          double im = 0;
+          for (unsigned int index = 0; index < mRangeIDC; ++index) {
+            const unsigned int term = (coeff * index) % mRangeIDC;
+            re += idcs[index] * cosTerm[term];
+            im -= idcs[index] * sinTerm[term];
+          }
+          real[coeff] = re;
+          imag[coeff] = im;
+        }
+      }
+
+      for (unsigned int coeff = 0; coeff < nCoeff; ++coeff) {
+        const unsigned int indexDataReal = mFourierCoefficients.getIndex(interval, 2 * coeff); // index for storing real fourier coefficient
+        const unsigned int indexDataImag = indexDataReal + 1;                                  // index for storing complex fourier coefficient
+        coefficients[indexDataReal] = real[coeff];
+        coefficients[indexDataImag] = imag[coeff];
       }
     }
   }
@@ -0,0 +1,118 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file benchIDCFactorization.cxx
+/// \brief Benchmark of the aggregation and factorization of the IDCs of all CRUs
+///
+/// The first benchmark argument is the number of aggregated TFs, the second one the number of threads.
+/// Each TF has 10 or 11 integration intervals as for 128 orbits per TF and 12 orbits integration length,
+/// the nominal rate to sustain is about 88 TFs/s.
+
+#include "benchmark/benchmark.h"
+#include "TPCCalibration/IDCFactorization.h"
+#include <array>
+#include <vector>
+
+using namespace o2::tpc;
+
+namespace
+{
+/// \return number of integration intervals of a TF
+unsigned int getIntegrationIntervals(const unsigned int tf) { return (tf % 3) ? 11 : 10; }
+
+IDCFactorization createFactorization(const unsigned int tfs)
+{
+  std::array<unsigned char, Mapper::NREGIONS> groupPads{};
+  std::array<unsigned char, Mapper::NREGIONS> groupRows{};
+  std::array<unsigned char, Mapper::NREGIONS> groupLastRowsThreshold{};
+  std::array<unsigned char, Mapper::NREGIONS> groupLastPadsThreshold{};
+  groupPads.fill(4);
+  groupRows.fill(4);
+  groupLastRowsThreshold.fill(2);
+  groupLastPadsThreshold.fill(2);
+  return IDCFactorization(groupPads, groupRows, groupLastRowsThreshold, groupLastPadsThreshold, tfs, tfs);
+}
+
+/// IDCs of each CRU for 10 and 11 integration intervals
+std::array<std::vector<std::vector<float>>, 2> createIDCs(const IDCFactorization& idcFactorization)
+{
+  std::array<std::vector<std::vector<float>>, 2> idcs;
+  for (unsigned int i = 0; i < idcs.size(); ++i) {
+    idcs[i].resize(CRU::MaxCRU);
+    for (unsigned int cru = 0; cru < CRU::MaxCRU; ++cru) {
+      const unsigned int nIDCs = idcFactorization.getNIDCs(CRU(cru).region());
+      idcs[i][cru].resize((10 + i) * nIDCs);
+      for (unsigned int j = 0; j < idcs[i][cru].size(); ++j) {
+        idcs[i][cru][j] = 1 + (j % nIDCs) % 7 + 0.1f * (j / nIDCs);
+      }
+    }
+  }
+  return idcs;
+}
+
+void setIDCs(IDCFactorization& idcFactorization, const std::array<std::vector<std::vector<float>>, 2>& idcs, const unsigned int tf)
+{
+  for (unsigned int cru = 0; cru < CRU::MaxCRU; ++cru) {
+    auto idcsCRU = idcs[getIntegrationIntervals(tf) - 10][cru];
+    idcFactorization.setIDCs(std::move(idcsCRU), cru, tf);
+  }
+}
+} // namespace
+
+// setting the IDCs of all CRUs for each received TF, including the copy of the received IDCs
+static void BM_SetIDCs(benchmark::State& state)
+{
+  const unsigned int tfs = state.range(0);
+  IDCFactorization::setNThreads(state.range(1));
+  auto idcFactorization = createFactorization(tfs);
+  const auto idcs = createIDCs(idcFactorization);
+
+  for (auto _ : state) {
+    for (unsigned int tf = 0; tf < tfs; ++tf) {
+      setIDCs(idcFactorization, idcs, tf);
+    }
+    state.PauseTiming();
+    idcFactorization.reset();
+    state.ResumeTiming();
+  }
+  state.counters["TFs"] = benchmark::Counter(tfs * state.iterations(), benchmark::Counter::kIsRate);
+}
+
+// factorization at the end of the aggregation interval
+static void BM_FactorizeIDCs(benchmark::State& state)
+{
+  const unsigned int tfs = state.range(0);
+  IDCFactorization::setNThreads(state.range(1));
+  auto idcFactorization = createFactorization(tfs);
+  const auto idcs = createIDCs(idcFactorization);
+  for (unsigned int tf = 0; tf < tfs; ++tf) {
+    setIDCs(idcFactorization, idcs, tf);
+  }
+
+  for (auto _ : state) {
+    idcFactorization.factorizeIDCs();
+  }
+  state.counters["TFs"] = benchmark::Counter(tfs * state.iterations(), benchmark::Counter::kIsRate);
+}
+
+static void CustomArguments(benchmark::internal::Benchmark* b)
+{
+  for (const int tfs : {100, 1000}) {
+    for (const int nThreads : {1, 4}) {
+      b->Args({tfs, nThreads});
+    }
+  }
+}
+
+BENCHMARK(BM_SetIDCs)->Apply(CustomArguments)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_FactorizeIDCs)->Apply(CustomArguments)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,209 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file  testO2TPCIDCFactorization.cxx
+/// \brief this task tests the factorization of IDCs of the form I(r,\phi,t) = a(r,\phi) * f(t)
+
+#define BOOST_TEST_MODULE Test TPC O2TPCIDCFactorization class
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "TPCCalibration/IDCFactorization.h"
+#include "TRandom.h"
+#include "TFile.h"
+#include <cmath>
+#include <memory>
+#include <numeric>
+
+namespace o2::tpc
+{
+
+static constexpr float TOLERANCE = 0.01f; // relative tolerance in percent
+
+/// \return number of integration intervals for each TF: 10 or 11 when having 128 orbits per TF and 12 orbits integration length
+unsigned int getIntegrationIntervals(const unsigned int tf) { return (tf % 3) ? 11 : 10; }
+
+/// \return time dependence f(t) of the IDCs
+float getTimeDependence(const unsigned int integrationInterval) { return 1 + 0.5f * std::sin(0.1f * integrationInterval); }
+
+BOOST_AUTO_TEST_CASE(IDCFactorization_test)
+{
+  const unsigned int tfs = 30;                // number of aggregated TFs
+  const unsigned int timeframesDeltaIDC = 10; // number of TFs per Delta IDC chunk
+  std::array<unsigned char, Mapper::NREGIONS> groupPads{};
+  std::array<unsigned char, Mapper::NREGIONS> groupRows{};
+  std::array<unsigned char, Mapper::NREGIONS> groupLastRowsThreshold{};
+  std::array<unsigned char, Mapper::NREGIONS> groupLastPadsThreshold{};
+  groupPads.fill(4);
+  groupRows.fill(4);
+  groupLastRowsThreshold.fill(2);
+  groupLastPadsThreshold.fill(2);
+  gRandom->SetSeed(0);
+
+  for (const int nThreads : {1, 4}) {
+    IDCFactorization::setNThreads(nThreads);
+    IDCFactorization idcFactorization(groupPads, groupRows, groupLastRowsThreshold, groupLastPadsThreshold, tfs, timeframesDeltaIDC);
+
+    // I(r,\phi,t) = a(r,\phi) * f(t)
+    std::vector<std::vector<float>> padFactors(CRU::MaxCRU);
+    for (unsigned int cru = 0; cru < CRU::MaxCRU; ++cru) {
+      padFactors[cru].resize(idcFactorization.getNIDCs(CRU(cru).region()));
+      for (auto& val : padFactors[cru]) {
+        val = gRandom->Uniform(1, 10);
+      }
+    }
+
+    // aggregate twice to check that nothing is kept from the previous aggregation interval
+    for (int iAggregation = 0; iAggregation < 2; ++iAggregation) {
+      std::vector<float> timeDependence;
+      for (unsigned int tf = 0; tf < tfs; ++tf) {
+        const unsigned int firstInterval = timeDependence.size();
+        for (unsigned int i = 0; i < getIntegrationIntervals(tf); ++i) {
+          timeDependence.emplace_back(getTimeDependence(firstInterval + i + iAggregation));
+        }
+        for (unsigned int cru = 0; cru < CRU::MaxCRU; ++cru) {
+          std::vector<float> idcs;
+          idcs.reserve(getIntegrationIntervals(tf) * padFactors[cru].size());
+          for (unsigned int i = firstInterval; i < timeDependence.size(); ++i) {
+            for (const auto val : padFactors[cru]) {
+              idcs.emplace_back(val * timeDependence[i]);
+            }
+          }
+          idcFactorization.setIDCs(std::move(idcs), cru, tf);
+        }
+      }
+
+      idcFactorization.factorizeIDCs();
+
+      // I_1(t) = f(t) / <f(t)>_t
+      const float meanTimeDependence = std::accumulate(timeDependence.begin(), timeDependence.end(), 0.) / timeDependence.size();
+      for (const auto side : {Side::A, Side::C}) {
+        const auto& idcOne = idcFactorization.getIDCOne(side);
+        BOOST_REQUIRE(idcOne.size() == timeDependence.size());
+        for (unsigned int i = 0; i < idcOne.size(); ++i) {
+          BOOST_CHECK_CLOSE(idcOne[i], timeDependence[i] / meanTimeDependence, TOLERANCE);
+        }
+
+        // \Delta I(r,\phi,t) = 1
+        for (unsigned int chunk = 0; chunk < idcFactorization.getNChunks(); ++chunk) {
+          for (const auto val : idcFactorization.getIDCDeltaUncompressed(side, chunk)) {
+            BOOST_CHECK_CLOSE(val, 1.f, TOLERANCE);
+          }
+        }
+      }
+
+      // I_0(r,\phi) = a(r,\phi) * <f(t)>_t
+      for (unsigned int cru = 0; cru < CRU::MaxCRU; cru += 7) {
+        const CRU cruTmp(cru);
+        const auto& idcZero = idcFactorization.getIDCZero(cruTmp.side());
+        const unsigned int firstIndex = idcFactorization.getIndexGrouped(cruTmp.sector() % SECTORSPERSIDE, cruTmp.region(), 0, 0, 0);
+        for (unsigned int index = 0; index < padFactors[cru].size(); ++index) {
+          BOOST_CHECK_CLOSE(idcZero[firstIndex + index], padFactors[cru][index] * meanTimeDependence, TOLERANCE);
+        }
+      }
+      idcFactorization.reset();
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(IDCFactorization_differentIntervals_test)
+{
+  // the integration intervals are the ones of CRU 0: a CRU with one interval less or more in a TF must neither shift nor bias I_1(t)
+  const unsigned int tfs = 30;
+  const unsigned int cruLess = 13; // CRU with one interval less in the last TF
+  const unsigned int cruMore = 42; // CRU with one interval more in the first TF
+  std::array<unsigned char, Mapper::NREGIONS> groupPads{};
+  std::array<unsigned char, Mapper::NREGIONS> groupRows{};
+  std::array<unsigned char, Mapper::NREGIONS> groupLastRowsThreshold{};
+  std::array<unsigned char, Mapper::NREGIONS> groupLastPadsThreshold{};
+  groupPads.fill(4);
+  groupRows.fill(4);
+  groupLastRowsThreshold.fill(2);
+  groupLastPadsThreshold.fill(2);
+
+  for (const int nThreads : {1, 4}) {
+    IDCFactorization::setNThreads(nThreads);
+    IDCFactorization idcFactorization(groupPads, groupRows, groupLastRowsThreshold, groupLastPadsThreshold, tfs, tfs);
+    std::vector<float> timeDependence;
+    for (unsigned int tf = 0; tf < tfs; ++tf) {
+      const unsigned int firstInterval = timeDependence.size();
+      for (unsigned int i = 0; i < getIntegrationIntervals(tf); ++i) {
+        timeDependence.emplace_back(getTimeDependence(firstInterval + i));
+      }
+      for (unsigned int cru = 0; cru < CRU::MaxCRU; ++cru) {
+        unsigned int intervals = getIntegrationIntervals(tf);
+        if ((cru == cruLess) && (tf == tfs - 1)) {
+          --intervals;
+        } else if ((cru == cruMore) && (tf == 0)) {
+          ++intervals;
+        }
+        std::vector<float> idcs;
+        for (unsigned int i = firstInterval; i < firstInterval + intervals; ++i) {
+          idcs.insert(idcs.end(), idcFactorization.getNIDCs(CRU(cru).region()), getTimeDependence(i));
+        }
+        idcFactorization.setIDCs(std::move(idcs), cru, tf);
+      }
+    }
+
+    idcFactorization.factorizeIDCs();
+
+    const float meanTimeDependence = std::accumulate(timeDependence.begin(), timeDependence.end(), 0.) / timeDependence.size();
+    for (const auto side : {Side::A, Side::C}) {
+      const auto& idcOne = idcFactorization.getIDCOne(side);
+      BOOST_REQUIRE(idcOne.size() == timeDependence.size());
+      for (unsigned int i = 0; i < idcOne.size(); ++i) {
+        BOOST_CHECK_CLOSE(idcOne[i], timeDependence[i] / meanTimeDependence, TOLERANCE);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(IDCFactorization_setIDCsAfterReading_test)
+{
+  // the running sums for I_0 are not streamed: replacing IDCs of an object read from file must not subtract IDCs which were never added
+  const unsigned int tfs = 3;
+  std::array<unsigned char, Mapper::NREGIONS> groupPads{};
+  std::array<unsigned char, Mapper::NREGIONS> groupRows{};
+  std::array<unsigned char, Mapper::NREGIONS> groupLastRowsThreshold{};
+  std::array<unsigned char, Mapper::NREGIONS> groupLastPadsThreshold{};
+  groupPads.fill(4);
+  groupRows.fill(4);
+  groupLastRowsThreshold.fill(2);
+  groupLastPadsThreshold.fill(2);
+  IDCFactorization::setNThreads(1);
+
+  // constant IDCs, 10 times larger in the first TF when they are set the first time
+  auto getIDCs = [](const IDCFactorization& idcFactorization, const unsigned int cru, const unsigned int tf, const float value) {
+    return std::vector<float>(getIntegrationIntervals(tf) * idcFactorization.getNIDCs(CRU(cru).region()), value);
+  };
+  IDCFactorization idcFactorization(groupPads, groupRows, groupLastRowsThreshold, groupLastPadsThreshold, tfs, tfs);
+  for (unsigned int tf = 0; tf < tfs; ++tf) {
+    for (unsigned int cru = 0; cru < CRU::MaxCRU; ++cru) {
+      idcFactorization.setIDCs(getIDCs(idcFactorization, cru, tf, (tf == 0) ? 10 : 1), cru, tf);
+    }
+  }
+  idcFactorization.dumpToFile("IDCFactorizedSetIDCs.root", "IDCFactorized");
+
+  TFile fIn("IDCFactorizedSetIDCs.root");
+  auto idcFactorizationRead = std::unique_ptr<IDCFactorization>(fIn.Get<IDCFactorization>("IDCFactorized"));
+  BOOST_REQUIRE(idcFactorizationRead);
+  for (unsigned int cru = 0; cru < CRU::MaxCRU; ++cru) {
+    idcFactorizationRead->setIDCs(getIDCs(*idcFactorizationRead, cru, 0, 1), cru, 0);
+  }
+  idcFactorizationRead->factorizeIDCs();
+  for (const auto side : {Side::A, Side::C}) {
+    for (const auto val : idcFactorizationRead->getIDCZero(side)) {
+      BOOST_CHECK_CLOSE(val, 1.f, TOLERANCE);
+    }
+  }
+}
+
+} // namespace o2::tpc
@@ -90,4 +90,43 @@ BOOST_AUTO_TEST_CASE(IDCFourierTransform_test)
   }
 }
 
+BOOST_AUTO_TEST_CASE(IDCFourierTransformSlidingWindow_test)
+{
+  const unsigned int integrationIntervals = 10;
+  const unsigned int tfs = 200;
+  const unsigned int rangeIDC = 200;
+  const unsigned int nFourierCoeff = 40;
+  gRandom->SetSeed(0);
+  o2::tpc::IDCFourierTransform::setFFT(false);
+
+  const auto intervalsPerTF = getIntegrationIntervalsPerTF(integrationIntervals, tfs);
+  const auto idcsLast = get1DIDCs(intervalsPerTF);
+  const auto idcs = get1DIDCs(intervalsPerTF);
+
+  // coefficients of all intervals calculated from scratch
+  o2::tpc::IDCFourierTransform::setSlidingWindowBlock(1);
+  o2::tpc::IDCFourierTransform idcFourierTransformDirect{rangeIDC, tfs, nFourierCoeff};
+  idcFourierTransformDirect.setIDCs(idcsLast, intervalsPerTF);
+  idcFourierTransformDirect.setIDCs(idcs, intervalsPerTF);
+  idcFourierTransformDirect.calcFourierCoefficients();
+
+  // coefficients obtained by shifting the window of the previous interval
+  o2::tpc::IDCFourierTransform::setSlidingWindowBlock(tfs);
+  o2::tpc::IDCFourierTransform idcFourierTransformSliding{rangeIDC, tfs, nFourierCoeff};
+  idcFourierTransformSliding.setIDCs(idcsLast, intervalsPerTF);
+  idcFourierTransformSliding.setIDCs(idcs, intervalsPerTF);
+  idcFourierTransformSliding.calcFourierCoefficients();
+  idcFourierTransformSliding.calcFourierCoefficients(); // coefficients are not accumulated
+
+  for (unsigned int iSide = 0; iSide < o2::tpc::SIDES; ++iSide) {
+    const o2::tpc::Side side = iSide == 0 ? Side::A : Side::C;
+    const auto& coeffDirect = idcFourierTransformDirect.getFourierCoefficients();
+    const auto& coeffSliding = idcFourierTransformSliding.getFourierCoefficients();
+    for (unsigned int i = 0; i < coeffDirect.getNCoefficients(side); ++i) {
+      BOOST_CHECK_SMALL(coeffSliding(side, i) - coeffDirect(side, i), 1e-5f);
+    }
+  }
+  o2::tpc::IDCFourierTransform::setSlidingWindowBlock(16);
+}
+
 } // namespace o2::tpc
@@ -13,6 +13,7 @@
 #define O2_TPC_CalibProcessingHelper_H
 
 #include <memory>
+#include <vector>
 
 #include "Framework/InputRecord.h"
 
@@ -30,6 +31,13 @@ namespace calib_processing_helper
 {
 
 uint64_t processRawData(o2::framework::InputRecord& inputs, std::unique_ptr<RawReaderCRU>& reader, bool useOldSubspec = false, const std::vector<int>& sectors = {});
+
+/// process the raw data of different CRUs in parallel
+///
+/// All links of one CRU are processed by the same thread, such that the callbacks of
+/// different threads always fill different pads
+/// \param readers one reader per thread, each with its own RawReaderCRUManager providing the callbacks
+uint64_t processRawDataPerCRU(o2::framework::InputRecord& inputs, const std::vector<RawReaderCRU*>& readers, bool useOldSubspec = false, const std::vector<int>& sectors = {});
 } // namespace calib_processing_helper
 } // namespace tpc
 } // namespace o2
@@ -0,0 +1,107 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   LinkZSDecoder.h
+/// @brief  Parallel decoder of link based zero suppressed raw pages to digits
+
+#ifndef TPC_LinkZSDecoder_H_
+#define TPC_LinkZSDecoder_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "DataFormatsTPC/Constants.h"
+#include "DataFormatsTPC/Digit.h"
+#include "DataFormatsTPC/ZeroSuppressionLinkBased.h"
+
+namespace o2
+{
+namespace tpc
+{
+
+/// Decoder of link based zero suppressed pages into digits
+///
+/// Pages are queued in the order they are received and decoded in one go,
+/// in parallel if OpenMP is available. Each page is decoded into its own
+/// buffer, the buffers are then merged per sector in the original page
+/// order, so that the result does not depend on the number of threads.
+class LinkZSDecoder
+{
+ public:
+  using DigitsPerSector = std::array<std::vector<Digit>, constants::MAXSECTOR>;
+
+  /// electronics information extracted from the raw data sub specification
+  struct LinkInfo {
+    uint32_t cruID{0};         ///< CRU number
+    uint32_t linkID{0};        ///< link number in the data wrapper
+    uint32_t dataWrapperID{0}; ///< data wrapper number
+    uint32_t globalLinkID{0};  ///< link number in the CRU
+    uint32_t sector{0};        ///< sector of the CRU
+  };
+
+  /// extract the electronics information from the sub specification
+  static LinkInfo getLinkInfo(uint32_t subSpecification);
+
+  /// set the number of threads used for the decoding
+  void setNThreads(int nThreads) { mNThreads = nThreads > 0 ? nThreads : 1; }
+
+  /// queue a page for decoding
+  /// \param subSpecification sub specification of the link the page belongs to
+  /// \param data payload of the page, must stay valid until decode() is called
+  /// \param size size of the payload in bytes
+  /// \param globalBCoffset bunch crossing offset of the heart beat frame
+  void addPage(uint32_t subSpecification, const char* data, size_t size, uint32_t globalBCoffset);
+
+  /// decode all queued pages, appending the digits to the vector of their sector
+  void decode(DigitsPerSector& digits);
+
+  /// drop all queued pages
+  void clear() { mPages.clear(); }
+
+  /// number of queued pages
+  size_t getNumberOfPages() const { return mPages.size(); }
+
+ private:
+  static constexpr size_t ChannelsPerLink = 80; ///< channels in the ZS bit mask
+
+  /// pad mapping of all channels of a link
+  struct Link {
+    uint32_t cruID{0};
+    uint32_t sector{0};
+    std::array<uint8_t, ChannelsPerLink> rows{};
+    std::array<uint8_t, ChannelsPerLink> pads{};
+  };
+
+  /// queued raw page
+  struct Page {
+    const char* data{nullptr};
+    size_t size{0};
+    uint32_t globalBCoffset{0};
+    size_t link{0};
+  };
+
+  size_t getLink(uint32_t subSpecification);
+  static void decodePage(const Link& link, const Page& page, std::vector<Digit>& digits);
+
+  int mNThreads{1};                                  ///< number of decoding threads
+  std::vector<Link> mLinks;                          ///< pad mapping of all links seen so far
+  std::unordered_map<uint32_t, size_t> mLinkIndices; ///< sub specification to link index
+  std::vector<Page> mPages;                          ///< pages to be decoded
+  std::vector<std::vector<Digit>> mPageDigits;       ///< per page digit buffers, reused between calls
+};
+
+} // namespace tpc
+} // namespace o2
+
+#endif // TPC_LinkZSDecoder_H_
@@ -15,6 +15,8 @@
 /// @file   TPCCalibPedestalSpec.h
 /// @brief  TPC Pedestal calibration processor
 
+#include <algorithm>
+#include <memory>
 #include <vector>
 #include <string>
 #include <chrono>
@@ -53,19 +55,29 @@ class TPCCalibPedestalDevice : public o2::framework::Task
     // set up ADC value filling
     // TODO: clean up to not go via RawReaderCRUManager
     mCalibPedestal.init(); // initialize configuration via configKeyValues
-    mRawReader.createReader("");
 
-    mRawReader.setADCDataCallback([this](const PadROCPos& padROCPos, const CRU& cru, const gsl::span<const uint32_t> data) -> int {
-      const int timeBins = mCalibPedestal.update(padROCPos, cru, data);
-      mCalibPedestal.setNumberOfProcessedTimeBins(std::max(mCalibPedestal.getNumberOfProcessedTimeBins(), size_t(timeBins)));
-      return timeBins;
-    });
-
-    mRawReader.setLinkZSCallback([this](int cru, int rowInSector, int padInRow, int timeBin, float adcValue) -> bool {
-      CRU cruID(cru);
-      mCalibPedestal.updateROC(cruID.roc(), rowInSector - (rowInSector > 62) * 63, padInRow, timeBin, adcValue);
-      return true;
-    });
+    // one reader per thread, different threads process different CRUs and thus fill different pads
+    const int nThreads = std::max(1, ic.options().get<int>("nthreads"));
+    if (nThreads > 1) {
+      mCalibPedestal.createROCs(mSectors);
+    }
+    mProcessedTimeBins.resize(nThreads);
+    for (int ithread = 0; ithread < nThreads; ++ithread) {
+      auto& rawReader = *mRawReaders.emplace_back(std::make_unique<rawreader::RawReaderCRUManager>());
+      rawReader.createReader("");
+
+      rawReader.setADCDataCallback([this, ithread](const PadROCPos& padROCPos, const CRU& cru, const gsl::span<const uint32_t> data) -> int {
+        const int timeBins = mCalibPedestal.update(padROCPos, cru, data);
+        mProcessedTimeBins[ithread] = std::max(mProcessedTimeBins[ithread], size_t(timeBins));
+        return timeBins;
+      });
+
+      rawReader.setLinkZSCallback([this](int cru, int rowInSector, int padInRow, int timeBin, float adcValue) -> bool {
+        CRU cruID(cru);
+        mCalibPedestal.updateROC(cruID.roc(), rowInSector - (rowInSector > 62) * 63, padInRow, timeBin, adcValue);
+        return true;
+      });
+    }
 
     mMaxEvents = static_cast<uint32_t>(ic.options().get<int>("max-events"));
     mUseOldSubspec = ic.options().get<bool>("use-old-subspec");
@@ -83,8 +95,17 @@ class TPCCalibPedestalDevice : public o2::framework::Task
       return;
     }
 
-    auto& reader = mRawReader.getReaders()[0];
-    calib_processing_helper::processRawData(pc.inputs(), reader, mUseOldSubspec, mSectors);
+    if (mRawReaders.size() == 1) {
+      auto& reader = mRawReaders[0]->getReaders()[0];
+      calib_processing_helper::processRawData(pc.inputs(), reader, mUseOldSubspec, mSectors);
+    } else {
+      std::vector<rawreader::RawReaderCRU*> readers;
+      for (auto& rawReader : mRawReaders) {
+        readers.emplace_back(rawReader->getReaders()[0].get());
+      }
+      calib_processing_helper::processRawDataPerCRU(pc.inputs(), readers, mUseOldSubspec, mSectors);
+    }
+    mCalibPedestal.setNumberOfProcessedTimeBins(*std::max_element(mProcessedTimeBins.begin(), mProcessedTimeBins.end()));
 
     mCalibPedestal.incrementNEvents();
     const auto nTFs = mCalibPedestal.getNumberOfProcessedEvents();
@@ -122,7 +143,8 @@ class TPCCalibPedestalDevice : public o2::framework::Task
 
  private:
   CalibPedestal mCalibPedestal;
-  rawreader::RawReaderCRUManager mRawReader;
+  std::vector<std::unique_ptr<rawreader::RawReaderCRUManager>> mRawReaders; ///< raw readers, one per processing thread
+  std::vector<size_t> mProcessedTimeBins{};                                  ///< maximum number of time bins seen by each processing thread
   uint32_t mMaxEvents{0};      ///< maximum number of events to process
   uint32_t mPublishAfter{0};   ///< number of events after which to dump the calibration
   uint32_t mLane{0};           ///< lane number of processor
@@ -179,6 +201,7 @@ DataProcessorSpec getTPCCalibPedestalSpec(const std::string inputSpec, uint32_t
       {"use-old-subspec", VariantType::Bool, false, {"use old subsecifiation definition"}},
       {"force-quit", VariantType::Bool, false, {"force quit after max-events have been reached"}},
       {"direct-file-dump", VariantType::Bool, false, {"directly dump calibration to file"}},
+      {"nthreads", VariantType::Int, 1, {"number of threads processing the CRUs of this lane in parallel"}},
     } // end Options
   };  // end DataProcessorSpec
 }
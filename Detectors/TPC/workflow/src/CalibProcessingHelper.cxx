@@ -18,7 +18,11 @@
 #include "DPLUtils/RawParser.h"
 #include "DetectorsRaw/RDHUtils.h"
 #include "Headers/DataHeaderHelpers.h"
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 
+#include "TPCBase/CRU.h"
 #include "TPCBase/RDHUtils.h"
 #include "TPCReconstruction/RawReaderCRU.h"
 #include "TPCReconstruction/RawProcessingHelpers.h"
@@ -29,10 +33,68 @@ using namespace o2::tpc;
 using namespace o2::framework;
 using RDHUtils = o2::raw::RDHUtils;
 
-void processGBT(o2::framework::RawParser<>& parser, std::unique_ptr<RawReaderCRU>& reader, const rdh_utils::FEEIDType feeID);
-void processLinkZS(o2::framework::RawParser<>& parser, std::unique_ptr<RawReaderCRU>& reader, uint32_t firstOrbit);
+/// raw data of one link, selected for processing
+struct LinkRawData {
+  rdh_utils::FEEIDType feeID;
+  uint32_t firstOrbit;
+  gsl::span<const char> raw;
+};
+
+void processGBT(o2::framework::RawParser<>& parser, RawReaderCRU& reader, const rdh_utils::FEEIDType feeID);
+void processLinkZS(o2::framework::RawParser<>& parser, RawReaderCRU& reader, uint32_t firstOrbit);
+std::vector<LinkRawData> getLinkRawData(o2::framework::InputRecord& inputs, bool useOldSubspec, const std::vector<int>& sectors, uint64_t& activeSectors);
+bool isLinkZSData(const std::vector<LinkRawData>& linkData, RawReaderCRU& reader);
+void processLink(const LinkRawData& link, RawReaderCRU& reader, bool isLinkZS);
 
 uint64_t calib_processing_helper::processRawData(o2::framework::InputRecord& inputs, std::unique_ptr<RawReaderCRU>& reader, bool useOldSubspec, const std::vector<int>& sectors)
+{
+  uint64_t activeSectors = 0;
+  const auto linkData = getLinkRawData(inputs, useOldSubspec, sectors, activeSectors);
+  const bool isLinkZS = isLinkZSData(linkData, *reader);
+
+  for (const auto& link : linkData) {
+    processLink(link, *reader, isLinkZS);
+  }
+
+  return activeSectors;
+}
+
+uint64_t calib_processing_helper::processRawDataPerCRU(o2::framework::InputRecord& inputs, const std::vector<RawReaderCRU*>& readers, bool useOldSubspec, const std::vector<int>& sectors)
+{
+  uint64_t activeSectors = 0;
+  const auto linkData = getLinkRawData(inputs, useOldSubspec, sectors, activeSectors);
+  const bool isLinkZS = isLinkZSData(linkData, *readers[0]);
+
+  // ---| group the links by CRU, all links of one CRU are processed by the same thread |---
+  std::vector<std::vector<size_t>> linksPerCRU;
+  std::vector<int> cruIndex(CRU::MaxCRU, -1);
+  for (size_t i = 0; i < linkData.size(); ++i) {
+    const int cru = CRU(rdh_utils::getCRU(linkData[i].feeID));
+    if (cruIndex[cru] < 0) {
+      cruIndex[cru] = linksPerCRU.size();
+      linksPerCRU.emplace_back();
+    }
+    linksPerCRU[cruIndex[cru]].emplace_back(i);
+  }
+
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(readers.size())
+#endif
+  for (size_t iCRU = 0; iCRU < linksPerCRU.size(); ++iCRU) {
+#ifdef WITH_OPENMP
+    auto& reader = *readers[omp_get_thread_num()];
+#else
+    auto& reader = *readers[0];
+#endif
+    for (const auto i : linksPerCRU[iCRU]) {
+      processLink(linkData[i], reader, isLinkZS);
+    }
+  }
+
+  return activeSectors;
+}
+
+std::vector<LinkRawData> getLinkRawData(o2::framework::InputRecord& inputs, bool useOldSubspec, const std::vector<int>& sectors, uint64_t& activeSectors)
 {
   std::vector<InputSpec> filter = {{"check", ConcreteDataTypeMatcher{o2::header::gDataOriginTPC, "RAWDATA"}, Lifetime::Timeframe}};
 
@@ -47,14 +109,10 @@ uint64_t calib_processing_helper::processRawData(o2::framework::InputRecord& inp
     LOGP(info, "Using sampled data");
   }
 
-  uint64_t activeSectors = 0;
-  bool isLinkZS = false;
-  bool readFirst = false;
-  uint32_t firstOrbit = 0;
+  std::vector<LinkRawData> linkData;
 
   for (auto const& ref : InputRecordWalker(inputs, filter)) {
     const auto* dh = DataRefUtils::getHeader<o2::header::DataHeader*>(ref);
-    firstOrbit = dh->firstTForbit;
 
     // ---| extract hardware information to do the processing |---
     const auto subSpecification = dh->subSpecification;
@@ -90,49 +148,60 @@ uint64_t calib_processing_helper::processRawData(o2::framework::InputRecord& inp
 
     // TODO: exception handling needed?
     const gsl::span<const char> raw = inputs.get<gsl::span<char>>(ref);
-    o2::framework::RawParser parser(raw.data(), raw.size());
-
-    // detect decoder type by analysing first RDH
-    if (!readFirst) {
-      auto it = parser.begin();
-      auto* rdhPtr = it.get_if<o2::header::RAWDataHeaderV6>();
-      if (!rdhPtr) {
-        LOGP(fatal, "could not get RDH from packet");
-      }
-      const auto link = RDHUtils::getLinkID(*rdhPtr);
-      const auto detField = RDHUtils::getDetectorField(*rdhPtr);
-      if ((link == rdh_utils::UserLogicLinkID) || (detField == 1)) {
-        LOGP(info, "Detected Link-based zero suppression");
-        isLinkZS = true;
-        if (!reader->getManager() || !reader->getManager()->getLinkZSCallback()) {
-          LOGP(fatal, "LinkZSCallback must be set in RawReaderCRUManager");
-        }
-      }
-
-      //firstOrbit = RDHUtils::getHeartBeatOrbit(*rdhPtr);
-      LOGP(info, "First orbit in present TF: {}", firstOrbit);
-      readFirst = true;
-    }
+    linkData.emplace_back(LinkRawData{feeID, dh->firstTForbit, raw});
+  }
+
+  return linkData;
+}
+
+bool isLinkZSData(const std::vector<LinkRawData>& linkData, RawReaderCRU& reader)
+{
+  if (linkData.empty()) {
+    return false;
+  }
 
-    if (isLinkZS) {
-      processLinkZS(parser, reader, firstOrbit);
-    } else {
-      processGBT(parser, reader, feeID);
+  // detect decoder type by analysing first RDH
+  bool isLinkZS = false;
+  o2::framework::RawParser parser(linkData[0].raw.data(), linkData[0].raw.size());
+  auto it = parser.begin();
+  auto* rdhPtr = it.get_if<o2::header::RAWDataHeaderV6>();
+  if (!rdhPtr) {
+    LOGP(fatal, "could not get RDH from packet");
+  }
+  const auto link = RDHUtils::getLinkID(*rdhPtr);
+  const auto detField = RDHUtils::getDetectorField(*rdhPtr);
+  if ((link == rdh_utils::UserLogicLinkID) || (detField == 1)) {
+    LOGP(info, "Detected Link-based zero suppression");
+    isLinkZS = true;
+    if (!reader.getManager() || !reader.getManager()->getLinkZSCallback()) {
+      LOGP(fatal, "LinkZSCallback must be set in RawReaderCRUManager");
     }
   }
 
-  return activeSectors;
+  //firstOrbit = RDHUtils::getHeartBeatOrbit(*rdhPtr);
+  LOGP(info, "First orbit in present TF: {}", linkData[0].firstOrbit);
+  return isLinkZS;
+}
+
+void processLink(const LinkRawData& link, RawReaderCRU& reader, bool isLinkZS)
+{
+  o2::framework::RawParser parser(link.raw.data(), link.raw.size());
+  if (isLinkZS) {
+    processLinkZS(parser, reader, link.firstOrbit);
+  } else {
+    processGBT(parser, reader, link.feeID);
+  }
 }
 
-void processGBT(o2::framework::RawParser<>& parser, std::unique_ptr<RawReaderCRU>& reader, const rdh_utils::FEEIDType feeID)
+void processGBT(o2::framework::RawParser<>& parser, RawReaderCRU& reader, const rdh_utils::FEEIDType feeID)
 {
   rdh_utils::FEEIDType cruID, linkID, endPoint;
   rdh_utils::getMapping(feeID, cruID, endPoint, linkID);
   const auto globalLinkID = linkID + endPoint * 12;
 
   // ---| update hardware information in the reader |---
-  reader->forceCRU(cruID);
-  reader->setLink(globalLinkID);
+  reader.forceCRU(cruID);
+  reader.setLink(globalLinkID);
 
   rawreader::ADCRawData rawData;
   rawreader::GBTFrame gFrame;
@@ -159,10 +228,10 @@ void processGBT(o2::framework::RawParser<>& parser, std::unique_ptr<RawReaderCRU
     }
   }
 
-  reader->runADCDataCallback(rawData);
+  reader.runADCDataCallback(rawData);
 }
 
-void processLinkZS(o2::framework::RawParser<>& parser, std::unique_ptr<RawReaderCRU>& reader, uint32_t firstOrbit)
+void processLinkZS(o2::framework::RawParser<>& parser, RawReaderCRU& reader, uint32_t firstOrbit)
 {
   for (auto it = parser.begin(), end = parser.end(); it != end; ++it) {
     auto* rdhPtr = it.get_if<o2::header::RAWDataHeaderV6>();
@@ -179,6 +248,6 @@ void processLinkZS(o2::framework::RawParser<>& parser, std::unique_ptr<RawReader
     const auto orbit = RDHUtils::getHeartBeatOrbit(*rdhPtr);
     const auto data = (const char*)it.data();
     const auto size = it.size();
-    raw_processing_helpers::processZSdata(data, size, feeID, orbit, firstOrbit, reader->getManager()->getLinkZSCallback(), useTimeBins);
+    raw_processing_helpers::processZSdata(data, size, feeID, orbit, firstOrbit, reader.getManager()->getLinkZSCallback(), useTimeBins);
   }
 }
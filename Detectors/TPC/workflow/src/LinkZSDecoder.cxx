@@ -0,0 +1,179 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   LinkZSDecoder.cxx
+/// @brief  Parallel decoder of link based zero suppressed raw pages to digits
+
+#include <cassert>
+
+#include "TPCBase/CRU.h"
+#include "TPCBase/Mapper.h"
+#include "TPCBase/PadSecPos.h"
+#include "TPCWorkflow/LinkZSDecoder.h"
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
+using namespace o2::tpc;
+using namespace o2::tpc::zerosupp_link_based;
+
+LinkZSDecoder::LinkInfo LinkZSDecoder::getLinkInfo(uint32_t subSpecification)
+{
+  LinkInfo info;
+  info.cruID = subSpecification >> 16;
+  info.linkID = ((subSpecification + (subSpecification >> 8)) & 0xFF) - 1;
+  info.dataWrapperID = ((subSpecification >> 8) & 0xFF) > 0;
+  info.globalLinkID = info.linkID + info.dataWrapperID * 12;
+  info.sector = info.cruID / 10;
+  return info;
+}
+
+size_t LinkZSDecoder::getLink(uint32_t subSpecification)
+{
+  const auto found = mLinkIndices.find(subSpecification);
+  if (found != mLinkIndices.end()) {
+    return found->second;
+  }
+
+  // ===| pad mapping of all channels of the link, done once per link |===
+  const auto info = getLinkInfo(subSpecification);
+  const auto& mapper = Mapper::instance();
+  const CRU cru(info.cruID);
+  const int fecLinkOffsetCRU = (mapper.getPartitionInfo(cru.partition()).getNumberOfFECs() + 1) / 2;
+  const int fecInPartition = (info.globalLinkID % 12) + (info.globalLinkID > 11) * fecLinkOffsetCRU;
+  const int regionIter = info.cruID % 2;
+
+  const int sampaMapping[10] = {0, 0, 1, 1, 2, 3, 3, 4, 4, 2};
+  const int channelOffset[10] = {0, 16, 0, 16, 0, 0, 16, 0, 16, 16};
+
+  Link link;
+  link.cruID = info.cruID;
+  link.sector = info.sector;
+  for (size_t ichannel = 0; ichannel < ChannelsPerLink; ++ichannel) {
+    // TODO: verify the assumptions of the channel mapping!
+    // assumes the following sorting (s_chn is the channel on the sampa),
+    // in this case for even regiona (lower half fec)
+    //   chn# SAMPA s_chn
+    //      0     0     0
+    //      1     0     1
+    //      2     0    16
+    //      3     0    17
+    //      4     1     0
+    //      5     1     1
+    //      6     1    16
+    //      7     1    17
+    //      8     2     0
+    //      9     2     1
+    //
+    //     10     0     2
+    //     11     0     3
+    //     12     0    18
+    //     13     0    19
+    //     14     1     2
+    //     15     1     3
+    //     16     1    18
+    //     17     1    19
+    //     18     2     2
+    //     19     2     3
+    //
+    //     20     0     4
+    //     21     0     5
+    //     22     0    20
+    //     23     0    21
+    //     ...
+    //     For the uneven regions (upper half fec), the sampa ordering
+    //     is 3, 3, 3, 3, 4, 4, 4, 4, 2, 2
+    const int istreamm = ((ichannel % 10) / 2);
+    const int partitionStream = istreamm + regionIter * 5;
+    const int sampaOnFEC = sampaMapping[partitionStream];
+    const int channel = (ichannel % 2) + 2 * (ichannel / 10);
+    const int channelOnSAMPA = channel + channelOffset[partitionStream];
+
+    const auto padSecPos = mapper.padSecPos(cru, fecInPartition, sampaOnFEC, channelOnSAMPA);
+    const auto& padPos = padSecPos.getPadPos();
+    link.rows[ichannel] = padPos.getRow();
+    link.pads[ichannel] = padPos.getPad();
+  }
+
+  mLinks.emplace_back(link);
+  mLinkIndices[subSpecification] = mLinks.size() - 1;
+  return mLinks.size() - 1;
+}
+
+void LinkZSDecoder::addPage(uint32_t subSpecification, const char* data, size_t size, uint32_t globalBCoffset)
+{
+  mPages.push_back({data, size, globalBCoffset, getLink(subSpecification)});
+}
+
+void LinkZSDecoder::decodePage(const Link& link, const Page& page, std::vector<Digit>& digits)
+{
+  // maximum number of 128 bit payload words is given by the 4 bit field in the header
+  constexpr size_t MaxADCValues = 16 * ContainerZS::ChannelsPerWord;
+  float adcValues[MaxADCValues];
+
+  // cast raw data pointer to link based zero suppression definition
+  const ContainerZS* zsdata = (const ContainerZS*)page.data;
+  const ContainerZS* const zsdataEnd = (const ContainerZS*)(page.data + page.size);
+
+  while (zsdata < zsdataEnd) {
+    const auto& header = zsdata->cont.header;
+    const uint32_t numberOfWords = header.numWordsPayload;
+    const int timebin = (page.globalBCoffset + header.bunchCrossing) / 8; // To be calculated
+
+    // unpack all ADC values of the time bin at once
+    for (uint32_t iword = 0; iword < numberOfWords; ++iword) {
+      zsdata->cont.data[iword].getADCValuesFloat(adcValues + iword * ContainerZS::ChannelsPerWord);
+    }
+
+    // only loop over the channels with data
+    size_t processedChannels = 0;
+    auto addChannels = [&](uint64_t bits, size_t channelOffset) {
+      while (bits) {
+        const size_t ichannel = channelOffset + __builtin_ctzll(bits);
+        bits &= bits - 1;
+        digits.emplace_back(link.cruID, adcValues[processedChannels++], link.rows[ichannel], link.pads[ichannel], timebin);
+      }
+    };
+    addChannels(header.bitMaskLow, 0);
+    addChannels(header.bitMaskHigh, 64);
+    assert(processedChannels <= numberOfWords * ContainerZS::ChannelsPerWord);
+
+    // go to next time bin
+    zsdata = zsdata->next();
+  }
+}
+
+void LinkZSDecoder::decode(DigitsPerSector& digits)
+{
+  const size_t nPages = mPages.size();
+  if (mPageDigits.size() < nPages) {
+    mPageDigits.resize(nPages);
+  }
+
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (size_t ipage = 0; ipage < nPages; ++ipage) {
+    auto& pageDigits = mPageDigits[ipage];
+    pageDigits.clear();
+    decodePage(mLinks[mPages[ipage].link], mPages[ipage], pageDigits);
+  }
+
+  // ===| merge in page order |===
+  for (size_t ipage = 0; ipage < nPages; ++ipage) {
+    const auto& pageDigits = mPageDigits[ipage];
+    auto& sectorDigits = digits[mLinks[mPages[ipage].link].sector];
+    sectorDigits.insert(sectorDigits.end(), pageDigits.begin(), pageDigits.end());
+  }
+
+  mPages.clear();
+}
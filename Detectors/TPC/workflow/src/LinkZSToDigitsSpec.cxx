@@ -23,10 +23,8 @@
 #include "DataFormatsTPC/TPCSectorHeader.h"
 #include "DataFormatsTPC/ZeroSuppressionLinkBased.h"
 #include "DataFormatsTPC/Digit.h"
-#include "TPCBase/CRU.h"
-#include "TPCBase/PadSecPos.h"
-#include "TPCBase/Mapper.h"
-#include "TPCReconstruction/RawReaderCRU.h"
+#include "TPCBase/Sector.h"
+#include "TPCWorkflow/LinkZSDecoder.h"
 #include "TPCWorkflow/LinkZSToDigitsSpec.h"
 #include <vector>
 #include <string>
@@ -56,6 +54,7 @@ o2::framework::DataProcessorSpec getLinkZSToDigitsSpec(int channel, const std::s
     bool quit{false};                                              ///< if workflow is ready to quit
     std::vector<int> tpcSectors{};                                 ///< tpc sector configuration
     std::array<std::vector<Digit>, Sector::MAXSECTOR> digitsAll{}; ///< digit vector to be stored inside the file
+    LinkZSDecoder decoder;                                         ///< decoder of the raw pages
 
     /// cleanup of digits
     void clearDigits()
@@ -91,6 +90,7 @@ o2::framework::DataProcessorSpec getLinkZSToDigitsSpec(int channel, const std::s
     {
       processAttributes->maxEvents = static_cast<uint32_t>(ic.options().get<int>("max-events"));
       processAttributes->tpcSectors = tpcSectors;
+      processAttributes->decoder.setNThreads(ic.options().get<int>("nthreads"));
     }
 
     // ===| data processor |====================================================
@@ -114,7 +114,7 @@ o2::framework::DataProcessorSpec getLinkZSToDigitsSpec(int channel, const std::s
                               const_cast<std::vector<o2::tpc::Digit>&>(digits));
       };
 
-      auto& mapper = Mapper::instance();
+      auto& decoder = processAttributes->decoder;
 
       // loop over all inputs
       for (auto& input : pc.inputs()) {
@@ -127,24 +127,13 @@ o2::framework::DataProcessorSpec getLinkZSToDigitsSpec(int channel, const std::s
 
         // ===| extract electronics mapping information |===
         const auto subSpecification = dh->subSpecification;
-        const auto cruID = subSpecification >> 16;
-        const auto linkID = ((subSpecification + (subSpecification >> 8)) & 0xFF) - 1;
-        const auto dataWrapperID = ((subSpecification >> 8) & 0xFF) > 0;
-        const auto globalLinkID = linkID + dataWrapperID * 12;
-        const auto sector = cruID / 10;
-        const CRU cru(cruID);
-        const int fecLinkOffsetCRU = (mapper.getPartitionInfo(cru.partition()).getNumberOfFECs() + 1) / 2;
-        const int fecInPartition = (globalLinkID % 12) + (globalLinkID > 11) * fecLinkOffsetCRU;
-        const int regionIter = cruID % 2;
+        const auto linkInfo = LinkZSDecoder::getLinkInfo(subSpecification);
 
-        const int sampaMapping[10] = {0, 0, 1, 1, 2, 3, 3, 4, 4, 2};
-        const int channelOffset[10] = {0, 16, 0, 16, 0, 0, 16, 0, 16, 16};
-
-        processAttributes->activeSectors |= (0x1 << sector);
+        processAttributes->activeSectors |= (0x1 << linkInfo.sector);
 
         LOGP(debug, "Specifier: {}/{}/{}", dh->dataOrigin, dh->dataDescription, dh->subSpecification);
         LOGP(debug, "Payload size: {}", dh->payloadSize);
-        LOGP(debug, "CRU: {}; linkID: {}; dataWrapperID: {}; globalLinkID: {}", cruID, linkID, dataWrapperID, globalLinkID);
+        LOGP(debug, "CRU: {}; linkID: {}; dataWrapperID: {}; globalLinkID: {}", linkInfo.cruID, linkInfo.linkID, linkInfo.dataWrapperID, linkInfo.globalLinkID);
 
         try {
           o2::framework::RawParser parser(input.payload, dh->payloadSize);
@@ -182,6 +171,8 @@ o2::framework::DataProcessorSpec getLinkZSToDigitsSpec(int channel, const std::s
             if ((lastOrbit > 0) && (hbOrbit > (lastOrbit + 3))) {
               ++processAttributes->processedEvents;
               LOG(INFO) << fmt::format("Number of processed events: {} ({})", processAttributes->processedEvents, processAttributes->maxEvents);
+              // the pages received so far belong to the finished event
+              decoder.decode(processAttributes->digitsAll);
               processAttributes->sortDigits();
 
               // publish digits of all configured sectors
@@ -206,76 +197,8 @@ o2::framework::DataProcessorSpec getLinkZSToDigitsSpec(int channel, const std::s
             auto data = it.data();
             LOGP(debug, "Raw data block payload size: {}", size);
 
-            // cast raw data pointer to link based zero suppression definition
-            zerosupp_link_based::ContainerZS* zsdata = (zerosupp_link_based::ContainerZS*)data;
-            const zerosupp_link_based::ContainerZS* const zsdataEnd = (zerosupp_link_based::ContainerZS*)(data + size);
-
-            while (zsdata < zsdataEnd) {
-              const auto channelBits = zsdata->cont.header.getChannelBits();
-              const uint32_t numberOfWords = zsdata->cont.header.numWordsPayload;
-              assert((channelBits.count() - 1) / 10 == numberOfWords - 1);
-
-              std::size_t processedChannels = 0;
-              for (std::size_t ichannel = 0; ichannel < channelBits.size(); ++ichannel) {
-                if (!channelBits[ichannel]) {
-                  continue;
-                }
-
-                // adc value
-                const auto adcValue = zsdata->getADCValueFloat(processedChannels);
-
-                // pad mapping
-                // TODO: verify the assumptions of the channel mapping!
-                // assumes the following sorting (s_chn is the channel on the sampa),
-                // in this case for even regiona (lower half fec)
-                //   chn# SAMPA s_chn
-                //      0     0     0
-                //      1     0     1
-                //      2     0    16
-                //      3     0    17
-                //      4     1     0
-                //      5     1     1
-                //      6     1    16
-                //      7     1    17
-                //      8     2     0
-                //      9     2     1
-                //
-                //     10     0     2
-                //     11     0     3
-                //     12     0    18
-                //     13     0    19
-                //     14     1     2
-                //     15     1     3
-                //     16     1    18
-                //     17     1    19
-                //     18     2     2
-                //     19     2     3
-                //
-                //     20     0     4
-                //     21     0     5
-                //     22     0    20
-                //     23     0    21
-                //     ...
-                //     For the uneven regions (upper half fec), the sampa ordering
-                //     is 3, 3, 3, 3, 4, 4, 4, 4, 2, 2
-                const int istreamm = ((ichannel % 10) / 2);
-                const int partitionStream = istreamm + regionIter * 5;
-                const int sampaOnFEC = sampaMapping[partitionStream];
-                const int channel = (ichannel % 2) + 2 * (ichannel / 10);
-                const int channelOnSAMPA = channel + channelOffset[partitionStream];
-
-                const auto padSecPos = mapper.padSecPos(cru, fecInPartition, sampaOnFEC, channelOnSAMPA);
-                const auto& padPos = padSecPos.getPadPos();
-                int timebin = (globalBCoffset + zsdata->cont.header.bunchCrossing) / 8; // To be calculated
-
-                // add digit
-                processAttributes->digitsAll[sector].emplace_back(cruID, adcValue, padPos.getRow(), padPos.getPad(), timebin);
-                ++processedChannels;
-              }
-
-              // go to next time bin
-              zsdata = zsdata->next();
-            }
+            // the decoding is deferred, such that all pages of an event are decoded in parallel
+            decoder.addPage(subSpecification, (const char*)data, size, globalBCoffset);
           }
 
         } catch (const std::runtime_error& e) {
@@ -284,6 +207,13 @@ o2::framework::DataProcessorSpec getLinkZSToDigitsSpec(int channel, const std::s
           LOG(ERROR) << e.what();
         }
       }
+
+      // the payload is only valid during this call, so the remaining pages are decoded now
+      if (processAttributes->quit) {
+        decoder.clear();
+      } else {
+        decoder.decode(processAttributes->digitsAll);
+      }
     };
 
     return processingFct;
@@ -304,6 +234,7 @@ o2::framework::DataProcessorSpec getLinkZSToDigitsSpec(int channel, const std::s
     AlgorithmSpec{initFunction},
     Options{
       {"max-events", VariantType::Int, 100, {"maximum number of events to process"}},
+      {"nthreads", VariantType::Int, 1, {"number of threads used for the decoding of the raw pages"}},
       {"pedestal-file", VariantType::String, "", {"file with pedestals and noise for zero suppression"}}}};
 }
 } // namespace tpc
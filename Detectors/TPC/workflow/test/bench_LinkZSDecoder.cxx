@@ -0,0 +1,138 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   bench_LinkZSDecoder.cxx
+/// @brief  Benchmark of the link based zero suppressed raw data decoding
+
+#include "benchmark/benchmark.h"
+#include <random>
+#include <vector>
+#include "DataFormatsTPC/ZeroSuppressionLinkBased.h"
+#include "TPCWorkflow/LinkZSDecoder.h"
+
+using namespace o2::tpc;
+using namespace o2::tpc::zerosupp_link_based;
+
+struct TestPage {
+  uint32_t subSpecification;
+  std::vector<uint64_t> buffer;
+};
+
+/// generate one page per link with 'nTimeBins' time bins, each with a random channel occupancy
+std::vector<TestPage> generateTestPages(size_t nLinks, size_t nTimeBins, float occupancy)
+{
+  std::mt19937_64 rng(42);
+  std::bernoulli_distribution fired(occupancy);
+  std::uniform_int_distribution<uint64_t> adc(0, Data<>::BitMask);
+  std::vector<TestPage> pages;
+
+  for (size_t ilink = 0; ilink < nLinks; ++ilink) {
+    // 12 links per data wrapper, 2 data wrappers per CRU
+    const uint32_t cruID = (ilink / 24) % 360;
+    const uint32_t dataWrapperID = (ilink % 24) / 12;
+    const uint32_t linkID = ilink % 12;
+    TestPage page{(cruID << 16) | (dataWrapperID << 8) | (linkID + 1 - dataWrapperID), {}};
+
+    for (size_t itb = 0; itb < nTimeBins; ++itb) {
+      uint64_t bitMaskLow = 0;
+      uint64_t bitMaskHigh = 0;
+      for (int ichannel = 0; ichannel < 80; ++ichannel) {
+        if (fired(rng)) {
+          (ichannel < 64 ? bitMaskLow : bitMaskHigh) |= uint64_t(1) << (ichannel % 64);
+        }
+      }
+      const uint32_t nChannels = __builtin_popcountll(bitMaskLow) + __builtin_popcountll(bitMaskHigh);
+      const uint32_t nWords = (nChannels + ContainerZS::ChannelsPerWord - 1) / ContainerZS::ChannelsPerWord;
+
+      const size_t offset = page.buffer.size();
+      page.buffer.resize(offset + (nWords + 1) * DataWordSizeBytes / sizeof(uint64_t));
+      auto* container = (ContainerZS*)(page.buffer.data() + offset);
+      auto& header = container->cont.header;
+      header.bitMaskLow = bitMaskLow;
+      header.bitMaskHigh = bitMaskHigh;
+      header.numWordsPayload = nWords;
+      header.bunchCrossing = (itb * 8) & 0xFFF;
+      header.magicWord = CommonHeader::MagicWordLinkZS;
+      for (uint32_t i = 0; i < nChannels; ++i) {
+        container->setADCValue(i, adc(rng));
+      }
+    }
+    pages.emplace_back(std::move(page));
+  }
+
+  return pages;
+}
+
+static void BM_LinkZSDecoder(benchmark::State& state)
+{
+  const int nThreads = state.range(0);
+  const size_t nLinks = state.range(1);
+  const float occupancy = state.range(2) / 100.f;
+
+  const auto pages = generateTestPages(nLinks, 500, occupancy);
+  LinkZSDecoder decoder;
+  decoder.setNThreads(nThreads);
+  LinkZSDecoder::DigitsPerSector digits;
+  size_t nDigits = 0;
+
+  for (auto _ : state) {
+    for (auto& sectorDigits : digits) {
+      sectorDigits.clear();
+    }
+    for (const auto& page : pages) {
+      decoder.addPage(page.subSpecification, (const char*)page.buffer.data(), page.buffer.size() * sizeof(uint64_t), 0);
+    }
+    decoder.decode(digits);
+    for (const auto& sectorDigits : digits) {
+      nDigits += sectorDigits.size();
+    }
+  }
+
+  state.counters["digits"] = benchmark::Counter(nDigits, benchmark::Counter::kIsRate);
+}
+
+static void BM_UnpackADCValues(benchmark::State& state)
+{
+  const bool allAtOnce = state.range(0);
+  const auto pages = generateTestPages(1, 1000, 1.f);
+  const auto* data = (const ContainerZS*)pages[0].buffer.data();
+  const auto* dataEnd = (const ContainerZS*)(pages[0].buffer.data() + pages[0].buffer.size());
+  float values[80];
+
+  for (auto _ : state) {
+    for (auto* container = data; container < dataEnd; container = container->next()) {
+      for (uint32_t iword = 0; iword < container->cont.header.numWordsPayload; ++iword) {
+        if (allAtOnce) {
+          container->cont.data[iword].getADCValuesFloat(values + iword * ContainerZS::ChannelsPerWord);
+        } else {
+          for (uint32_t i = 0; i < ContainerZS::ChannelsPerWord; ++i) {
+            values[iword * ContainerZS::ChannelsPerWord + i] = container->cont.data[iword].getADCValueFloat(i);
+          }
+        }
+      }
+      benchmark::DoNotOptimize(values);
+    }
+  }
+}
+
+static void CustomArguments(benchmark::internal::Benchmark* bench)
+{
+  // one sector worth of links with low and high occupancy
+  for (int nThreads : {1, 2, 4, 8}) {
+    bench->Args({nThreads, 10 * 24, 10});
+    bench->Args({nThreads, 10 * 24, 50});
+  }
+}
+
+BENCHMARK(BM_LinkZSDecoder)->Apply(CustomArguments)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_UnpackADCValues)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
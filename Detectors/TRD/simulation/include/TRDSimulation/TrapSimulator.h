@@ -340,6 +340,7 @@ class TrapSimulator
   //TODO adcr adcf labels zerosupressionmap can all go into their own class. Refactor when stable.
   std::vector<int> mADCR; // Array with MCM ADC values (Raw, 12 bit) 2d with dimension mNTimeBin
   std::vector<int> mADCF; // Array with MCM ADC values (Filtered, 12 bit) 2d with dimension mNTimeBin
+  std::vector<int> mADCLanes; // MCM ADC values ordered by timebin, the channels padded to full SIMD vectors, used by the filters and the hit detection
   std::array<unsigned int, constants::NADCMCM> mADCDigitIndices{}; // indices of the incoming digits, used to relate the tracklets to labels in TRDTrapSimulatorSpec
   std::vector<unsigned int> mMCMT;      // tracklet word for one mcm/trap-chip
   std::vector<Tracklet64> mTrackletArray64; // Array of 64 bit tracklets
@@ -378,6 +379,13 @@ class TrapSimulator
 
   unsigned int addUintClipping(unsigned int a, unsigned int b, unsigned int nbits) const;
   // Add a and b (unsigned) with clipping to the maximum value representable by nbits
+
+  // the filters and the hit detection process all channels of the MCM in SIMD lanes, on mADCLanes
+  void loadLanes(const std::vector<int>& adc, int timebin1, int timebin2); // copy the given timebins of mADCR or mADCF to mADCLanes
+  void storeLanes(std::vector<int>& adc) const;                            // copy mADCLanes back to mADCR or mADCF
+  void filterPedestalLanes();
+  void filterGainLanes();
+  void filterTailLanes();
  private:
   TrapSimulator(const TrapSimulator& m);            // not implemented
   TrapSimulator& operator=(const TrapSimulator& m); // not implemented
@@ -51,11 +51,24 @@
 #include <ostream>
 #include <fstream>
 #include <numeric>
+#include <array>
+
+#include <Vc/Vc>
 
 using namespace o2::trd;
 using namespace std;
 using namespace o2::trd::constants;
 
+namespace
+{
+// The filters and the hit detection process the ADC channels of an MCM in parallel, one
+// 32 bit integer lane per channel, with the fixed-point arithmetic of the TRAP.
+using LaneVector = Vc::int_v;
+using LaneMask = Vc::int_m;
+constexpr int NLanes = LaneVector::Size;
+constexpr int NADCLanes = ((NADCMCM + NLanes - 1) / NLanes) * NLanes; // channels per timebin in mADCLanes, padded to full vectors
+} // namespace
+
 #define infoTRAP 1
 
 bool TrapSimulator::mgApplyCut = true;
@@ -74,9 +87,12 @@ void TrapSimulator::init(TrapConfig* trapconfig, int det, int robPos, int mcmPos
   mMcmPos = mcmPos;
   mRow = mFeeParam->getPadRowFromMCM(mRobPos, mMcmPos);
 
-  if (!mInitialized) {
-    mTrapConfig = trapconfig;
-    mNTimeBin = mTrapConfig->getTrapReg(TrapConfig::kC13CPUA, mDetector, mRobPos, mMcmPos);
+  // the simulators are pooled and re-initialised for each MCM: the buffers are only
+  // (re)allocated when the number of time bins changes
+  mTrapConfig = trapconfig;
+  int nTimeBin = mTrapConfig->getTrapReg(TrapConfig::kC13CPUA, mDetector, mRobPos, mMcmPos);
+  if (!mInitialized || nTimeBin != mNTimeBin) {
+    mNTimeBin = nTimeBin;
     mZSMap.resize(NADCMCM);
 
     // tracklet calculation
@@ -87,6 +103,8 @@ void TrapSimulator::init(TrapConfig* trapconfig, int det, int robPos, int mcmPos
 
     mADCR.resize(mNTimeBin * NADCMCM);
     mADCF.resize(mNTimeBin * NADCMCM);
+    // one more vector, the hit detection loads the right neighbours of the last channels
+    mADCLanes.resize(mNTimeBin * NADCLanes + NLanes);
   }
 
   mInitialized = true;
@@ -110,13 +128,11 @@ void TrapSimulator::reset()
   std::fill(mADCF.begin(), mADCF.end(), 0);
   std::fill(mADCDigitIndices.begin(), mADCDigitIndices.end(), -1);
 
-  for (auto filterreg : mInternalFilterRegisters) {
+  for (auto& filterreg : mInternalFilterRegisters) {
     filterreg.ClearReg();
   }
   // clear the tracklet detail information.
-  for (auto trackletdetail : mTrackletDetails) {
-    trackletdetail.clear();
-  }
+  mTrackletDetails.clear();
   // Default unread, low active bit mask
   std::fill(mZSMap.begin(), mZSMap.end(), 0);
   std::fill(mMCMT.begin(), mMCMT.end(), 0);
@@ -1106,14 +1122,41 @@ void TrapSimulator::filter()
   // outputs to mADCF.
 
   LOG(debug) << "ENTER: " << __FILE__ << ":" << __func__ << ":" << __LINE__;
+  // The data stays in mADCLanes for the whole chain.
+  loadLanes(mADCR, 0, mNTimeBin);
   // Non-linearity filter not implemented.
-  filterPedestal();
-  //filterGain(); // we do not use the gain filter anyway, so disable it completely
-  filterTail();
+  filterPedestalLanes();
+  //filterGainLanes(); // we do not use the gain filter anyway, so disable it completely
+  filterTailLanes();
   // Crosstalk filter not implemented.
+  storeLanes(mADCF);
   LOG(debug) << "LEAVE: " << __FILE__ << ":" << __func__ << ":" << __LINE__;
 }
 
+void TrapSimulator::loadLanes(const std::vector<int>& adc, int timebin1, int timebin2)
+{
+  // the padding channels are set to 0, they are processed but never stored
+  for (int iTimeBin = timebin1; iTimeBin < timebin2; iTimeBin++) {
+    int* lanes = &mADCLanes[iTimeBin * NADCLanes];
+    for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
+      lanes[iAdc] = adc[iAdc * mNTimeBin + iTimeBin];
+    }
+    for (int iAdc = NADCMCM; iAdc < NADCLanes; iAdc++) {
+      lanes[iAdc] = 0;
+    }
+  }
+}
+
+void TrapSimulator::storeLanes(std::vector<int>& adc) const
+{
+  for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
+    int* out = &adc[iAdc * mNTimeBin];
+    for (int iTimeBin = 0; iTimeBin < mNTimeBin; iTimeBin++) {
+      out[iTimeBin] = mADCLanes[iTimeBin * NADCLanes + iAdc];
+    }
+  }
+}
+
 void TrapSimulator::filterPedestalInit(int baseline)
 {
   // Initializes the pedestal filter assuming that the input has
@@ -1181,16 +1224,52 @@ void TrapSimulator::filterPedestal()
   // It has only an effect if previous samples have been fed to
   // find the pedestal. Currently, the simulation assumes that
   // the input has been stable for a sufficiently long time.
-  // LOG(debug) << "BEGIN: " << __FILE__ << ":" << __func__ << ":" << __LINE__ ;
+
+  loadLanes(mADCR, 0, mNTimeBin);
+  filterPedestalLanes();
+  storeLanes(mADCF);
+}
+
+void TrapSimulator::filterPedestalLanes()
+{
+  // Same fixed-point arithmetic as filterPedestalNextSample, for all channels at once.
+  // The accumulator is only updated in timebin 0, its shifted value before and after
+  // the update is kept per lane.
+
+  const unsigned short fpnp = mTrapConfig->getTrapReg(TrapConfig::kFPNP, mDetector, mRobPos, mMcmPos); // 0..511 -> 0..127.75, pedestal at the output
+  const unsigned short fptc = mTrapConfig->getTrapReg(TrapConfig::kFPTC, mDetector, mRobPos, mMcmPos); // 0..3, 0 - fastest, 3 - slowest
+  const unsigned short fpby = mTrapConfig->getTrapReg(TrapConfig::kFPBY, mDetector, mRobPos, mMcmPos); // 0..1 bypass, active low
+  const unsigned short shift = mgkFPshifts[fptc];
+
+  if (mNTimeBin <= 0) {
+    return;
+  }
+  std::array<int, NADCLanes> accShiftedFirst{}, accShifted{};
+  for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
+    auto& pedAcc = mInternalFilterRegisters[iAdc].mPedAcc;
+    unsigned short value = mADCLanes[iAdc];
+    accShiftedFirst[iAdc] = (pedAcc >> shift) & 0x3FF; // 10 bits
+    int correction = (value & 0x3FF) - accShiftedFirst[iAdc];
+    pedAcc = (pedAcc + correction) & 0x7FFFFFFF; // 31 bits
+    accShifted[iAdc] = (pedAcc >> shift) & 0x3FF; // the accumulator is disabled in the drift time
+  }
 
   for (int iTimeBin = 0; iTimeBin < mNTimeBin; iTimeBin++) {
-    for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
-      int oldadc = mADCF[iAdc * mNTimeBin + iTimeBin];
-      mADCF[iAdc * mNTimeBin + iTimeBin] = filterPedestalNextSample(iAdc, iTimeBin, mADCR[iAdc * mNTimeBin + iTimeBin]);
-      //    LOG(debug) << "mADCF : time : " << iTimeBin << " adc : " << iAdc << " change : " << oldadc << " -> " << mADCF[iAdc * mNTimeBin + iTimeBin];
+    const int* acc = iTimeBin == 0 ? accShiftedFirst.data() : accShifted.data();
+    for (int iLane = 0; iLane < NADCLanes; iLane += NLanes) {
+      int* lanes = &mADCLanes[iTimeBin * NADCLanes + iLane];
+      LaneVector value = LaneVector(lanes, Vc::Unaligned) & 0xFFFF; // unsigned short
+      if (fpby == 0) {
+        value.store(lanes, Vc::Unaligned);
+        continue;
+      }
+      LaneVector accumulatorShifted(acc + iLane, Vc::Unaligned);
+      LaneVector inpAdd = (value + LaneVector(fpnp)) & 0xFFFF;
+      LaneVector out = Vc::min(inpAdd - accumulatorShifted, LaneVector(0xFFF));
+      out.setZero(inpAdd <= accumulatorShifted);
+      out.store(lanes, Vc::Unaligned);
     }
   }
-  // LOG(debug) << "BEGIN: " << __FILE__ << ":" << __func__ << ":" << __LINE__ ;
 }
 
 void TrapSimulator::filterGainInit()
@@ -1262,10 +1341,52 @@ void TrapSimulator::filterGain()
 {
   // Read data from mADCF and apply gain filter.
 
+  loadLanes(mADCF, 0, mNTimeBin);
+  filterGainLanes();
+  storeLanes(mADCF);
+}
+
+void TrapSimulator::filterGainLanes()
+{
+  // Same arithmetic as filterGainNextSample for all channels at once, the gain
+  // factors and offsets of the channels are kept per lane.
+
+  const int mgta = (unsigned short)mTrapConfig->getTrapReg(TrapConfig::kFGTA, mDetector, mRobPos, mMcmPos);
+  const int mgtb = (unsigned short)mTrapConfig->getTrapReg(TrapConfig::kFGTB, mDetector, mRobPos, mMcmPos);
+
+  std::array<int, NADCLanes> mgfExtended{}, mga{}, counterA{}, counterB{};
   for (int adc = 0; adc < NADCMCM; adc++) {
+    mgfExtended[adc] = 0x700 + (unsigned short)mTrapConfig->getTrapReg(TrapConfig::TrapReg_t(TrapConfig::kFGF0 + adc), mDetector, mRobPos, mMcmPos);
+    mga[adc] = (unsigned short)mTrapConfig->getTrapReg(TrapConfig::TrapReg_t(TrapConfig::kFGA0 + adc), mDetector, mRobPos, mMcmPos);
+    counterA[adc] = mInternalFilterRegisters[adc].mGainCounterA;
+    counterB[adc] = mInternalFilterRegisters[adc].mGainCounterB;
+  }
+
+  for (int iLane = 0; iLane < NADCLanes; iLane += NLanes) {
+    const LaneVector gain(mgfExtended.data() + iLane, Vc::Unaligned);
+    const LaneVector offset(mga.data() + iLane, Vc::Unaligned);
+    LaneVector countA(counterA.data() + iLane, Vc::Unaligned);
+    LaneVector countB(counterB.data() + iLane, Vc::Unaligned);
     for (int iTimeBin = 0; iTimeBin < mNTimeBin; iTimeBin++) {
-      mADCF[adc * mNTimeBin + iTimeBin] = filterGainNextSample(adc, mADCF[adc * mNTimeBin + iTimeBin]);
+      int* lanes = &mADCLanes[iTimeBin * NADCLanes + iLane];
+      LaneVector value = LaneVector(lanes, Vc::Unaligned) & 0xFFF;
+      LaneVector corr = Vc::min((value * gain) >> 11, LaneVector(0xFFF));
+      corr = Vc::min(corr + offset, LaneVector(0xFFF));
+      // Update threshold counters, stop when full
+      LaneMask notFull = (countA != 0x3FFFFFF) && (countB != 0x3FFFFFF);
+      LaneMask aboveB = notFull && (corr >= mgtb);
+      LaneMask aboveA = notFull && !aboveB && (corr >= mgta);
+      countB(aboveB) += 1;
+      countA(aboveA) += 1;
+      value.store(lanes, Vc::Unaligned);
     }
+    countA.store(counterA.data() + iLane, Vc::Unaligned);
+    countB.store(counterB.data() + iLane, Vc::Unaligned);
+  }
+
+  for (int adc = 0; adc < NADCMCM; adc++) {
+    mInternalFilterRegisters[adc].mGainCounterA = counterA[adc];
+    mInternalFilterRegisters[adc].mGainCounterB = counterB[adc];
   }
 }
 
@@ -1365,10 +1486,55 @@ void TrapSimulator::filterTail()
 {
   // Apply tail cancellation filter to all data.
 
-  for (int iTimeBin = 0; iTimeBin < mNTimeBin; iTimeBin++) {
-    for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
-      mADCF[iAdc * mNTimeBin + iTimeBin] = filterTailNextSample(iAdc, mADCF[iAdc * mNTimeBin + iTimeBin]);
+  loadLanes(mADCF, 0, mNTimeBin);
+  filterTailLanes();
+  storeLanes(mADCF);
+}
+
+void TrapSimulator::filterTailLanes()
+{
+  // Same fixed-point arithmetic as filterTailNextSample. The filter is recursive in time,
+  // hence the timebins are processed in sequence, with the channels in the lanes.
+
+  const int alphaLong = 0x3ff & mTrapConfig->getTrapReg(TrapConfig::kFTAL, mDetector, mRobPos, mMcmPos);                            // the weight of the long component
+  const int lambdaLong = (1 << 10) | (1 << 9) | (mTrapConfig->getTrapReg(TrapConfig::kFTLL, mDetector, mRobPos, mMcmPos) & 0x1FF);  // the multiplier of the long component
+  const int lambdaShort = (0 << 10) | (1 << 9) | (mTrapConfig->getTrapReg(TrapConfig::kFTLS, mDetector, mRobPos, mMcmPos) & 0x1FF); // the multiplier of the short component
+  const bool bypass = mTrapConfig->getTrapReg(TrapConfig::kFTBY, mDetector, mRobPos, mMcmPos) == 0;                               // bypass mode, active low
+
+  std::array<int, NADCLanes> amplitudeLong{}, amplitudeShort{};
+  for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
+    amplitudeLong[iAdc] = mInternalFilterRegisters[iAdc].mTailAmplLong;
+    amplitudeShort[iAdc] = mInternalFilterRegisters[iAdc].mTailAmplShort;
+  }
+
+  const LaneVector clip(0xFFF);
+  for (int iLane = 0; iLane < NADCLanes; iLane += NLanes) {
+    LaneVector amplLong(amplitudeLong.data() + iLane, Vc::Unaligned);
+    LaneVector amplShort(amplitudeShort.data() + iLane, Vc::Unaligned);
+    for (int iTimeBin = 0; iTimeBin < mNTimeBin; iTimeBin++) {
+      int* lanes = &mADCLanes[iTimeBin * NADCLanes + iLane];
+      LaneVector value = LaneVector(lanes, Vc::Unaligned) & 0xFFFF; // unsigned short
+      LaneVector inpVolt = value & 0xFFF;                            // 12 bits
+      // add the present generator outputs
+      LaneVector aQ = Vc::min(amplLong + amplShort, clip);
+      // calculate the difference between the input and the generated signal
+      LaneVector aDiff = inpVolt - aQ;
+      aDiff.setZero(inpVolt <= aQ);
+      // the inputs to the two generators, weighted
+      LaneVector alInpv = (aDiff * alphaLong) >> 11;
+      // the new values of the registers, used next time
+      amplLong = ((Vc::min(amplLong + alInpv, clip) * lambdaLong) >> 11) & 0xFFF;
+      amplShort = ((Vc::min(amplShort + aDiff - alInpv, clip) * lambdaShort) >> 11) & 0xFFF;
+      // the output of the filter
+      (bypass ? value : aDiff).store(lanes, Vc::Unaligned);
     }
+    amplLong.store(amplitudeLong.data() + iLane, Vc::Unaligned);
+    amplShort.store(amplitudeShort.data() + iLane, Vc::Unaligned);
+  }
+
+  for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
+    mInternalFilterRegisters[iAdc].mTailAmplLong = amplitudeLong[iAdc];
+    mInternalFilterRegisters[iAdc].mTailAmplShort = amplitudeShort[iAdc];
   }
 }
 
@@ -1524,9 +1690,8 @@ void TrapSimulator::calcFitreg()
   LOG(debug) << "ENTERING : " << __FILE__ << ":" << __func__ << ":" << __LINE__ << " :: " << getDetector() << ":" << getRobPos() << ":" << getMcmPos() << " -------------------- mNHits : " << mNHits;
   unsigned int adcMask = 0xffffffff;
 
-  bool hitQual;
   int adcLeft, adcCentral, adcRight;
-  unsigned short timebin, adcch, timebin1, timebin2, qtotTemp;
+  unsigned short timebin, adcch, timebin1, timebin2;
   short ypos, fromLeft, fromRight, found;
   std::array<unsigned short, 20> qTotal{}; //[19 + 1]; // the last is dummy
   std::array<unsigned short, 6> marked{}, qMarked{};
@@ -1555,6 +1720,11 @@ void TrapSimulator::calcFitreg()
     }
   }
 
+  // the timebins which are not there can not contain hits
+  if (timebin2 > mNTimeBin) {
+    timebin2 = mNTimeBin;
+  }
+
   // reset the fit registers
   for (auto& fitreg : mFitReg) {
     fitreg.ClearReg();
@@ -1565,54 +1735,40 @@ void TrapSimulator::calcFitreg()
   }
   mNHits = 0;
 
+  // cluster verification and hit threshold, identical for all time bins and channels of the MCM
+  const int regTPVBY = mTrapConfig->getTrapReg(TrapConfig::kTPVBY, mDetector, mRobPos, mMcmPos);
+  const int regTPVT = mTrapConfig->getTrapReg(TrapConfig::kTPVT, mDetector, mRobPos, mMcmPos);
+  const int regTPHT = mTrapConfig->getTrapReg(TrapConfig::kTPHT, mDetector, mRobPos, mMcmPos);
+  const int regTPFP = mTrapConfig->getTrapReg(TrapConfig::kTPFP, mDetector, mRobPos, mMcmPos);
+
+  // the hit candidates of all channels of a time bin are found together, with one lane per left channel
+  std::array<int, NADCLanes> channelPresent{}; // all 3 channels are present in case of ZS
+  for (int ch = 0; ch < NADCMCM - 2; ch++) {
+    channelPresent[ch] = ((adcMask >> ch) & 7) == 7;
+  }
+  std::array<int, NADCLanes> qTotalLanes{};
+  if (timebin1 < timebin2) {
+    loadLanes(mADCF, timebin1, timebin2);
+  }
+
   for (timebin = timebin1; timebin < timebin2; timebin++) {
     // first find the hit candidates and store the total cluster charge in qTotal array
     // in case of not hit store 0 there.
-    for (adcch = 0; adcch < NADCMCM - 2; adcch++) {
-      if (((adcMask >> adcch) & 7) == 7) //??? all 3 channels are present in case of ZS
-      {
-        adcLeft = mADCF[adcch * mNTimeBin + timebin];
-        adcCentral = mADCF[(adcch + 1) * mNTimeBin + timebin];
-        adcRight = mADCF[(adcch + 2) * mNTimeBin + timebin];
-
-        if (mTrapConfig->getTrapReg(TrapConfig::kTPVBY, mDetector, mRobPos, mMcmPos) == 0) {
-          // bypass the cluster verification
-          hitQual = true;
-        } else {
-          hitQual = ((adcLeft * adcRight) <
-                     ((mTrapConfig->getTrapReg(TrapConfig::kTPVT, mDetector, mRobPos, mMcmPos) * adcCentral * adcCentral) >> 10));
-          if (hitQual) {
-            LOG(debug) << "cluster quality cut passed with " << adcLeft << ", " << adcCentral << ", "
-                       << adcRight << " - threshold " << mTrapConfig->getTrapReg(TrapConfig::kTPVT, mDetector, mRobPos, mMcmPos)
-                       << " -> " << mTrapConfig->getTrapReg(TrapConfig::kTPVT, mDetector, mRobPos, mMcmPos) * adcCentral * adcCentral;
-          }
-        }
-
-        // The accumulated charge is with the pedestal!!!
-        qtotTemp = adcLeft + adcCentral + adcRight;
-        if ((qtotTemp > 130)) {
-          LOG(debug) << "qtotTemp>130 "
-                     << "qtot=" << qtotTemp
-                     << " qleft=" << adcLeft
-                     << " qcent=" << adcCentral
-                     << " qright=" << adcRight
-                     << " for " << mDetector << ":" << mRobPos << ":" << mMcmPos << ":adcleft:" << adcch << ":t" << timebin;
-        }
-
-        if ((hitQual) &&
-            (qtotTemp >= mTrapConfig->getTrapReg(TrapConfig::kTPHT, mDetector, mRobPos, mMcmPos)) &&
-            (adcLeft <= adcCentral) &&
-            (adcCentral > adcRight)) {
-          qTotal[adcch] = qtotTemp;
-        } else {
-          qTotal[adcch] = 0;
-        }
-      } else {
-        qTotal[adcch] = 0; //jkl
-      }
-      //     if (qTotal[adcch] != 0)
-      //     LOG(debug) << "ch " << setw(2) << adcch << "   qTotal " << qTotal[adcch];
+    const int* lanes = &mADCLanes[timebin * NADCLanes];
+    for (int ch = 0; ch < NADCMCM - 2; ch += NLanes) {
+      LaneVector left(lanes + ch, Vc::Unaligned);
+      LaneVector central(lanes + ch + 1, Vc::Unaligned);
+      LaneVector right(lanes + ch + 2, Vc::Unaligned);
+      // regTPVBY == 0 bypasses the cluster verification
+      LaneMask quality = LaneMask(regTPVBY == 0) || ((left * right) < ((LaneVector(regTPVT) * central * central) >> 10));
+      // The accumulated charge is with the pedestal!!!
+      LaneVector qtot = (left + central + right) & 0xFFFF; // unsigned short
+      LaneMask hit = (LaneVector(channelPresent.data() + ch, Vc::Unaligned) != 0) && quality && (qtot >= regTPHT) && (left <= central) && (central > right);
+      qtot.setZero(!hit);
+      qtot.store(qTotalLanes.data() + ch, Vc::Unaligned);
     }
+    // the lanes beyond the last left channel may have read the next timebin, they are not used
+    std::copy(qTotalLanes.begin(), qTotalLanes.begin() + NADCMCM - 2, qTotal.begin());
 
     fromLeft = -1;
     adcch = 0;
@@ -1694,7 +1850,6 @@ void TrapSimulator::calcFitreg()
         // hit detected, in TRAP we have 4 units and a hit-selection, here we proceed all channels!
         // subtract the pedestal TPFP, clipping instead of wrapping
 
-        int regTPFP = mTrapConfig->getTrapReg(TrapConfig::kTPFP, mDetector, mRobPos, mMcmPos); //TODO put this together with the others as members of trapsim, which is initiliased by det,rob,mcm.
         LOG(debug) << "Hit found, time=" << timebin << ", adcch=" << adcch << "/" << adcch + 1 << "/"
                    << adcch + 2 << ", adc values=" << adcLeft << "/" << adcCentral << "/"
                    << adcRight << ", regTPFP=" << regTPFP << ", TPHT=" << mTrapConfig->getTrapReg(TrapConfig::kTPHT, mDetector, mRobPos, mMcmPos);
@@ -0,0 +1,133 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file   benchTrapSimulator.cxx
+/// \brief  Benchmark of the TRAP filter chain and tracklet calculation of a single MCM
+
+#include "benchmark/benchmark.h"
+#include "DataFormatsTRD/Constants.h"
+#include "TRDSimulation/TrapConfig.h"
+#include "TRDSimulation/TrapSimulator.h"
+#include <random>
+#include <vector>
+
+using namespace o2::trd;
+
+namespace
+{
+constexpr int NTimeBins = 30;
+constexpr int Det = 0, Rob = 0, Mcm = 0;
+
+TrapConfig& getConfig()
+{
+  static TrapConfig config;
+  static bool initialized = false;
+  if (!initialized) {
+    config.setTrapReg(TrapConfig::kC13CPUA, NTimeBins, Det);
+    config.setTrapReg(TrapConfig::kFPBY, 1, Det); // pedestal filter active
+    config.setTrapReg(TrapConfig::kFTBY, 1, Det); // tail filter active
+    config.setTrapReg(TrapConfig::kFTAL, 200, Det);
+    config.setTrapReg(TrapConfig::kFTLL, 300, Det);
+    config.setTrapReg(TrapConfig::kFTLS, 100, Det);
+    initialized = true;
+  }
+  return config;
+}
+
+// ADC values of one MCM: baseline noise with a few pulses
+std::vector<int> createADC()
+{
+  std::mt19937 gen(42);
+  std::normal_distribution<float> noise(10.f, 1.5f);
+  std::uniform_int_distribution<int> channel(0, constants::NADCMCM - 3);
+  std::vector<int> adc(constants::NADCMCM * NTimeBins);
+  for (auto& value : adc) {
+    value = std::max(0, int(noise(gen)));
+  }
+  for (int iPulse = 0; iPulse < 3; ++iPulse) {
+    int ch = channel(gen);
+    for (int tb = 5; tb < NTimeBins; ++tb) {
+      int ampl = 400 * (tb - 4) / ((tb - 4) * (tb - 4) / 4 + 1);
+      adc[ch * NTimeBins + tb] += ampl;
+      adc[(ch + 1) * NTimeBins + tb] += ampl / 2;
+    }
+  }
+  return adc;
+}
+
+void setData(TrapSimulator& simulator, const std::vector<int>& adc)
+{
+  simulator.init(&getConfig(), Det, Rob, Mcm);
+  for (int ch = 0; ch < constants::NADCMCM; ++ch) {
+    for (int tb = 0; tb < NTimeBins; ++tb) {
+      simulator.setData(ch, tb, adc[ch * NTimeBins + tb]);
+    }
+  }
+}
+} // namespace
+
+// filter chain processing all channels of the MCM per time bin in SIMD lanes
+static void BM_TrapFilter(benchmark::State& state)
+{
+  auto adc = createADC();
+  TrapSimulator simulator;
+  for (auto _ : state) {
+    state.PauseTiming();
+    setData(simulator, adc);
+    state.ResumeTiming();
+    simulator.filter();
+    benchmark::DoNotOptimize(simulator.getDataFiltered(0, 0));
+  }
+  state.SetItemsProcessed(state.iterations() * constants::NADCMCM * NTimeBins);
+}
+
+// reference: the filter chain applied sample by sample
+static void BM_TrapFilterNextSample(benchmark::State& state)
+{
+  auto adc = createADC();
+  TrapSimulator simulator;
+  for (auto _ : state) {
+    state.PauseTiming();
+    setData(simulator, adc);
+    state.ResumeTiming();
+    int sum = 0;
+    for (int tb = 0; tb < NTimeBins; ++tb) {
+      for (int ch = 0; ch < constants::NADCMCM; ++ch) {
+        unsigned short value = simulator.filterPedestalNextSample(ch, tb, simulator.getDataRaw(ch, tb));
+        sum += simulator.filterTailNextSample(ch, value);
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * constants::NADCMCM * NTimeBins);
+}
+
+// filter chain followed by the hit detection and tracklet fit
+static void BM_TrapFilterTracklet(benchmark::State& state)
+{
+  auto adc = createADC();
+  TrapSimulator simulator;
+  for (auto _ : state) {
+    state.PauseTiming();
+    setData(simulator, adc);
+    state.ResumeTiming();
+    simulator.filter();
+    simulator.tracklet();
+    benchmark::DoNotOptimize(simulator.getTrackletArray64().size());
+  }
+  state.SetItemsProcessed(state.iterations() * constants::NADCMCM * NTimeBins);
+}
+
+BENCHMARK(BM_TrapFilter);
+BENCHMARK(BM_TrapFilterNextSample);
+BENCHMARK(BM_TrapFilterTracklet);
+
+BENCHMARK_MAIN();
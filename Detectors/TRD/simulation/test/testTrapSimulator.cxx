@@ -0,0 +1,141 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test TRD Trap Simulator
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "DataFormatsTRD/Constants.h"
+#include "TRDSimulation/TrapConfig.h"
+#include "TRDSimulation/TrapSimulator.h"
+
+#include <random>
+
+namespace o2
+{
+namespace trd
+{
+
+/// The filters processing a full MCM at once have to be bit-exact with the
+/// sample-by-sample implementation of the TRAP
+BOOST_AUTO_TEST_CASE(TRDTrapSimulatorFilters_test)
+{
+  const int det = 0, rob = 0, mcm = 0;
+  const int nTimeBins = 30;
+  TrapConfig config;
+  config.setTrapReg(TrapConfig::kC13CPUA, nTimeBins, det);
+  config.setTrapReg(TrapConfig::kFPBY, 1, det); // pedestal filter active
+  config.setTrapReg(TrapConfig::kFTBY, 1, det); // tail filter active
+  config.setTrapReg(TrapConfig::kFTAL, 200, det);
+  config.setTrapReg(TrapConfig::kFTLL, 300, det);
+  config.setTrapReg(TrapConfig::kFTLS, 100, det);
+
+  std::mt19937 gen(1234);
+  std::uniform_int_distribution<int> adcValue(0, 1023);
+
+  // the simulators are re-used for several MCMs, as done in the trap simulator workflow
+  TrapSimulator simulator, reference;
+  for (int iRound = 0; iRound < 3; ++iRound) {
+    simulator.init(&config, det, rob, mcm);
+    reference.init(&config, det, rob, mcm);
+    BOOST_REQUIRE_EQUAL(simulator.getNumberOfTimeBins(), nTimeBins);
+    for (int adc = 0; adc < constants::NADCMCM; ++adc) {
+      for (int tb = 0; tb < nTimeBins; ++tb) {
+        int value = adcValue(gen);
+        simulator.setData(adc, tb, value);
+        reference.setData(adc, tb, value);
+      }
+    }
+
+    simulator.filter();
+
+    for (int tb = 0; tb < nTimeBins; ++tb) {
+      for (int adc = 0; adc < constants::NADCMCM; ++adc) {
+        unsigned short value = reference.filterPedestalNextSample(adc, tb, reference.getDataRaw(adc, tb));
+        value = reference.filterTailNextSample(adc, value);
+        BOOST_CHECK_EQUAL(simulator.getDataFiltered(adc, tb), value);
+      }
+    }
+    simulator.reset();
+    reference.reset();
+  }
+}
+
+/// access to the internal filter registers
+class TrapSimulatorRegisters : public TrapSimulator
+{
+ public:
+  const FilterReg& getFilterReg(int adc) const { return mInternalFilterRegisters[adc]; }
+};
+
+/// The full filter chain including the gain filter, which is not used by filter(),
+/// with its threshold counters
+BOOST_AUTO_TEST_CASE(TRDTrapSimulatorGainFilter_test)
+{
+  const int det = 0, rob = 0, mcm = 0;
+  const int nTimeBins = 30;
+  TrapConfig config;
+  config.setTrapReg(TrapConfig::kC13CPUA, nTimeBins, det);
+  config.setTrapReg(TrapConfig::kFPBY, 1, det); // pedestal filter active
+  config.setTrapReg(TrapConfig::kFGBY, 1, det); // gain filter active
+  config.setTrapReg(TrapConfig::kFTBY, 1, det); // tail filter active
+  config.setTrapReg(TrapConfig::kFTAL, 200, det);
+  config.setTrapReg(TrapConfig::kFTLL, 300, det);
+  config.setTrapReg(TrapConfig::kFTLS, 100, det);
+  config.setTrapReg(TrapConfig::kFGTA, 100, det);
+  config.setTrapReg(TrapConfig::kFGTB, 600, det);
+  for (int adc = 0; adc < constants::NADCMCM; ++adc) {
+    config.setTrapReg(TrapConfig::TrapReg_t(TrapConfig::kFGF0 + adc), 25 * adc, det);
+    config.setTrapReg(TrapConfig::TrapReg_t(TrapConfig::kFGA0 + adc), 3 * adc, det);
+  }
+
+  std::mt19937 gen(4321);
+  std::uniform_int_distribution<int> adcValue(0, 1023);
+
+  TrapSimulatorRegisters simulator, reference;
+  for (int iRound = 0; iRound < 3; ++iRound) {
+    simulator.init(&config, det, rob, mcm);
+    reference.init(&config, det, rob, mcm);
+    for (int adc = 0; adc < constants::NADCMCM; ++adc) {
+      for (int tb = 0; tb < nTimeBins; ++tb) {
+        int value = adcValue(gen);
+        simulator.setData(adc, tb, value);
+        reference.setData(adc, tb, value);
+      }
+    }
+
+    simulator.filterPedestal();
+    simulator.filterGain();
+    simulator.filterTail();
+
+    for (int tb = 0; tb < nTimeBins; ++tb) {
+      for (int adc = 0; adc < constants::NADCMCM; ++adc) {
+        unsigned short value = reference.filterPedestalNextSample(adc, tb, reference.getDataRaw(adc, tb));
+        value = reference.filterGainNextSample(adc, value);
+        value = reference.filterTailNextSample(adc, value);
+        BOOST_CHECK_EQUAL(simulator.getDataFiltered(adc, tb), value);
+      }
+    }
+    int nCounted = 0;
+    for (int adc = 0; adc < constants::NADCMCM; ++adc) {
+      BOOST_CHECK_EQUAL(simulator.getFilterReg(adc).mGainCounterA, reference.getFilterReg(adc).mGainCounterA);
+      BOOST_CHECK_EQUAL(simulator.getFilterReg(adc).mGainCounterB, reference.getFilterReg(adc).mGainCounterB);
+      nCounted += reference.getFilterReg(adc).mGainCounterA + reference.getFilterReg(adc).mGainCounterB;
+    }
+    BOOST_CHECK(nCounted > 0);
+    simulator.reset();
+    reference.reset();
+  }
+}
+
+} // namespace trd
+} // namespace o2
@@ -15,6 +15,7 @@
 #include <vector>
 #include <array>
 #include <string>
+#include <memory>
 
 #include "Framework/DataProcessorSpec.h"
 #include "Framework/Task.h"
@@ -52,6 +53,7 @@ class TRDDPLTrapSimulatorTask : public o2::framework::Task
   std::string mTrapConfigName;      // the name of the config to be used.
   std::string mOnlineGainTableName;
   std::unique_ptr<Calibrations> mCalib; // store the calibrations connection to CCDB. Used primarily for the gaintables in line above.
+  std::vector<std::unique_ptr<std::array<TrapSimulator, constants::NMCMHCMAX>>> mTrapSimulators; // the up to 64 trap simulators for a single half chamber, one set per thread, re-used for all time frames
 
   TrapConfig* getTrapConfig();
   void loadTrapConfig();
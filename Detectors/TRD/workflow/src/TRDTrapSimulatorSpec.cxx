@@ -193,6 +193,10 @@ void TRDDPLTrapSimulatorTask::init(o2::framework::InitContext& ic)
   }
   LOG(info) << "Trap simulation running with " << mNumThreads << " threads ";
 #endif
+  // the trap simulators are allocated once per thread, they are re-initialised for each MCM
+  for (int iThread = 0; iThread < std::max(1, mNumThreads); ++iThread) {
+    mTrapSimulators.emplace_back(std::make_unique<std::array<TrapSimulator, NMCMHCMAX>>());
+  }
   LOG(info) << "Trap Simulator Device initialised for config : " << mTrapConfigName;
 }
 
@@ -253,7 +257,11 @@ void TRDDPLTrapSimulatorTask::run(o2::framework::ProcessingContext& pc)
 #endif
   for (int iTrig = 0; iTrig < triggerRecords.size(); ++iTrig) {
     int currHCId = -1;
-    std::array<TrapSimulator, NMCMHCMAX> trapSimulators{}; //the up to 64 trap simulators for a single half chamber
+#ifdef WITH_OPENMP
+    auto& trapSimulators = *mTrapSimulators[omp_get_thread_num()];
+#else
+    auto& trapSimulators = *mTrapSimulators[0];
+#endif
     for (int iDigit = triggerRecords[iTrig].getFirstDigit(); iDigit < (triggerRecords[iTrig].getFirstDigit() + triggerRecords[iTrig].getNumberOfDigits()); ++iDigit) {
       const auto& digit = &digits[digitIdxArray[iDigit]];
       if (currHCId < 0) {
@@ -244,9 +244,21 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
         auto concrete = DataSpecUtils::asConcreteDataMatcher(route.matcher);
         auto dh = header::DataHeader(concrete.description, concrete.origin, concrete.subSpec);
 
-        // create a TreeToTable object
-        TTree* tr = didir->getDataTree(dh, fcnt, ntf);
-        if (!tr) {
+        // Arrow based files are memory mapped and the tables are sent
+        // as they are, ROOT files are converted with a TreeToTable
+        auto colnames = getColumnNames(dh);
+        std::shared_ptr<arrow::Table> table = nullptr;
+        TTree* tr = nullptr;
+        auto readData = [&]() -> bool {
+          if (didir->isArrowFile(dh, fcnt)) {
+            table = didir->getDataTable(dh, fcnt, ntf, colnames);
+            return table != nullptr;
+          }
+          tr = didir->getDataTree(dh, fcnt, ntf);
+          return tr != nullptr;
+        };
+
+        if (!readData()) {
           if (first) {
             // dump metrics of file which is done for reading
             dumpFileMetrics(monitoring, currentFile, currentFileStartedAt, currentFileIOTime, tfCurrentFile, ntf);
@@ -265,8 +277,7 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
             }
             // get first folder of next file
             ntf = 0;
-            tr = didir->getDataTree(dh, fcnt, ntf);
-            if (!tr) {
+            if (!readData()) {
               LOGP(FATAL, "Can not retrieve tree for table {}: fileCounter {}, timeFrame {}", concrete.origin, fcnt, ntf);
               throw std::runtime_error("Processing is stopped!");
             }
@@ -284,26 +295,40 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
 
         // create table output
         auto o = Output(dh);
-        auto& t2t = outputs.make<TreeToTable>(o);
-
-        // add branches to read
-        // fill the table
-        auto colnames = getColumnNames(dh);
-        t2t.setLabel(tr->GetName());
-        if (colnames.size() == 0) {
-          totalSizeCompressed += tr->GetZipBytes();
-          totalSizeUncompressed += tr->GetTotBytes();
-          t2t.addAllColumns(tr);
+        if (table) {
+          // the mapped buffers are stored uncompressed
+          for (auto& column : table->columns()) {
+            for (auto& chunk : column->chunks()) {
+              for (auto& buffer : chunk->data()->buffers) {
+                if (buffer) {
+                  totalSizeCompressed += buffer->size();
+                  totalSizeUncompressed += buffer->size();
+                }
+              }
+            }
+          }
+          outputs.adopt(o, table);
         } else {
-          for (auto& colname : colnames) {
-            TBranch* branch = tr->GetBranch(colname.c_str());
-            totalSizeCompressed += branch->GetZipBytes("*");
-            totalSizeUncompressed += branch->GetTotBytes("*");
-            t2t.addColumn(colname.c_str());
+          auto& t2t = outputs.make<TreeToTable>(o);
+
+          // add branches to read
+          // fill the table
+          t2t.setLabel(tr->GetName());
+          if (colnames.size() == 0) {
+            totalSizeCompressed += tr->GetZipBytes();
+            totalSizeUncompressed += tr->GetTotBytes();
+            t2t.addAllColumns(tr);
+          } else {
+            for (auto& colname : colnames) {
+              TBranch* branch = tr->GetBranch(colname.c_str());
+              totalSizeCompressed += branch->GetZipBytes("*");
+              totalSizeUncompressed += branch->GetTotBytes("*");
+              t2t.addColumn(colname.c_str());
+            }
           }
+          t2t.fill(tr);
+          delete tr;
         }
-        t2t.fill(tr);
-        delete tr;
 
         // needed for metrics dumping (upon next file read, or terminate due to watchdog)
         if (currentFile == nullptr) {
@@ -17,9 +17,11 @@
 #include "Framework/RuntimeError.h"
 #include <arrow/table.h>
 
+#include <algorithm>
 #include <iterator>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 namespace o2::soa
 {
@@ -53,6 +55,19 @@ struct NTupleType<T, 0, REST...> {
   using type = std::tuple<REST...>;
 };
 
+// Number of k-element subsets of n elements
+inline uint64_t binomial(uint64_t n, uint64_t k)
+{
+  if (k > n) {
+    return 0;
+  }
+  uint64_t result = 1;
+  for (uint64_t i = 1; i <= k; i++) {
+    result = result * (n - k + i) / i;
+  }
+  return result;
+}
+
 // Group table (C++ vector of indices)
 bool sameCategory(std::pair<uint64_t, uint64_t> const& a, std::pair<uint64_t, uint64_t> const& b)
 {
@@ -237,6 +252,41 @@ struct CombinationsStrictlyUpperIndexPolicy : public CombinationsIndexPolicyBase
     });
   }
 
+  // Position of the first element of the current combination
+  uint64_t position() const
+  {
+    return *std::get<1>(std::get<0>(this->mCurrent).getIndices());
+  }
+
+  // Start the combinations at the given position of the first element
+  void seek(uint64_t position)
+  {
+    constexpr auto k = sizeof...(Ts);
+    if (position >= std::get<0>(this->mMaxOffset)) {
+      this->mIsEnd = true;
+      return;
+    }
+    for_<k>([&, this](auto i) {
+      std::get<i.value>(this->mCurrent).setCursor(position + i.value);
+    });
+  }
+
+  // Number of combinations for each position of the first element (tables of equal size assumed)
+  std::vector<uint64_t> countCombinations() const
+  {
+    constexpr auto k = sizeof...(Ts);
+    std::vector<uint64_t> counts;
+    if (this->mIsEnd) {
+      return counts;
+    }
+    uint64_t size = std::get<0>(this->mMaxOffset) + k - 1;
+    counts.reserve(std::get<0>(this->mMaxOffset));
+    for (uint64_t pos = 0; pos < std::get<0>(this->mMaxOffset); pos++) {
+      counts.push_back(binomial(size - pos - 1, k - 1));
+    }
+    return counts;
+  }
+
   void addOne()
   {
     constexpr auto k = sizeof...(Ts);
@@ -657,6 +707,59 @@ struct CombinationsBlockStrictlyUpperSameIndexPolicy : public CombinationsBlockS
     }
   }
 
+  // Position of the first element of the current combination in the grouped indices
+  uint64_t position() const
+  {
+    return std::get<0>(this->mCurrentIndices);
+  }
+
+  // Start the combinations at the given position of the first element in the grouped indices
+  void seek(uint64_t position)
+  {
+    constexpr auto k = sizeof...(Ts) + 1;
+    if (this->mIsEnd) {
+      return;
+    }
+    // skip the positions too close to the end of their category to start a combination
+    while (position < this->mGroupedIndices.size()) {
+      auto catEnd = std::upper_bound(this->mGroupedIndices.begin() + position, this->mGroupedIndices.end(), this->mGroupedIndices[position], sameCategory);
+      uint64_t lastOffset = std::distance(this->mGroupedIndices.begin(), catEnd);
+      if (position + k <= lastOffset) {
+        break;
+      }
+      position = lastOffset;
+    }
+    if (position >= this->mGroupedIndices.size()) {
+      this->mIsEnd = true;
+      return;
+    }
+    std::get<0>(this->mCurrentIndices) = position;
+    setRanges();
+  }
+
+  // Number of combinations for each position of the first element in the grouped indices
+  std::vector<uint64_t> countCombinations() const
+  {
+    constexpr auto k = sizeof...(Ts) + 1;
+    std::vector<uint64_t> counts;
+    if (this->mIsEnd) {
+      return counts;
+    }
+    counts.reserve(this->mGroupedIndices.size());
+    auto catBegin = this->mGroupedIndices.begin();
+    while (catBegin != this->mGroupedIndices.end()) {
+      auto catEnd = std::upper_bound(catBegin, this->mGroupedIndices.end(), *catBegin, sameCategory);
+      uint64_t lastOffset = std::distance(this->mGroupedIndices.begin(), catEnd);
+      for (uint64_t pos = std::distance(this->mGroupedIndices.begin(), catBegin); pos < lastOffset; pos++) {
+        // all other elements lie within the sliding window and the category
+        uint64_t windowEnd = std::min(pos + this->mSlidingWindowSize, lastOffset);
+        counts.push_back(binomial(windowEnd - pos - 1, k - 1));
+      }
+      catBegin = catEnd;
+    }
+    return counts;
+  }
+
   void setRanges()
   {
     constexpr auto k = sizeof...(Ts) + 1;
@@ -835,6 +938,69 @@ struct CombinationsBlockFullSameIndexPolicy : public CombinationsBlockSameIndexP
   uint64_t mCurrentlyFixed;
 };
 
+// Range [begin, end) of positions of the first element of the combinations
+struct CombinationsPartition {
+  uint64_t begin;
+  uint64_t end;
+};
+
+// Split the positions of the first element into at most nPartitions consecutive
+// ranges with approximately equal number of combinations, given the number of
+// combinations for each position
+inline std::vector<CombinationsPartition> partitionCombinations(std::vector<uint64_t> const& counts, int nPartitions)
+{
+  std::vector<CombinationsPartition> partitions;
+  uint64_t total = 0;
+  for (auto count : counts) {
+    total += count;
+  }
+  if (total == 0 || nPartitions < 1) {
+    return partitions;
+  }
+  uint64_t target = (total + nPartitions - 1) / nPartitions;
+  uint64_t sum = 0;
+  uint64_t begin = 0;
+  for (uint64_t pos = 0; pos < counts.size(); pos++) {
+    sum += counts[pos];
+    if (sum >= target * (partitions.size() + 1) || pos + 1 == counts.size()) {
+      partitions.push_back({begin, pos + 1});
+      begin = pos + 1;
+    }
+  }
+  return partitions;
+}
+
+// Restricts the first element of the combinations of policy P to a partition,
+// so that the partitions of one policy can be processed in different threads.
+// P must provide position(), seek() and countCombinations().
+template <typename P>
+struct CombinationsPartitionIndexPolicy : public P {
+  using CombinationType = typename P::CombinationType;
+
+  CombinationsPartitionIndexPolicy(const P& policy, CombinationsPartition const& partition) : P(policy), mPartitionEnd(partition.end)
+  {
+    if (partition.begin >= partition.end) {
+      this->mIsEnd = true;
+    }
+    if (!this->mIsEnd) {
+      this->seek(partition.begin);
+    }
+    if (!this->mIsEnd && this->position() >= mPartitionEnd) {
+      this->mIsEnd = true;
+    }
+  }
+
+  void addOne()
+  {
+    P::addOne();
+    if (!this->mIsEnd && this->position() >= mPartitionEnd) {
+      this->mIsEnd = true;
+    }
+  }
+
+  uint64_t mPartitionEnd;
+};
+
 /// @return next combination of rows of tables.
 /// FIXME: move to coroutines once we have C++20
 template <typename P>
@@ -1004,6 +1170,91 @@ CombinationsGenerator<P2<T2s...>> combinations(const P2<T2s...>& policy)
   return CombinationsGenerator<P2<T2s...>>(policy);
 }
 
+/// @return up to nPartitions generators which together produce the same combinations as policy,
+/// each with a similar number of combinations. The generators can be iterated in parallel, e.g.
+///
+///   auto partitions = partitionedCombinations(nThreads, CombinationsStrictlyUpperIndexPolicy(tracks, tracks));
+///   for (auto& partition : partitions) {
+///     threads.emplace_back([&partition]() { for (auto& [t0, t1] : partition) { ... } });
+///   }
+template <typename P>
+auto partitionedCombinations(int nPartitions, const P& policy)
+{
+  std::vector<CombinationsGenerator<CombinationsPartitionIndexPolicy<P>>> generators;
+  for (auto& partition : partitionCombinations(policy.countCombinations(), nPartitions)) {
+    generators.emplace_back(CombinationsPartitionIndexPolicy<P>(policy, partition));
+  }
+  return generators;
+}
+
+template <typename T2>
+auto partitionedPairCombinations(int nPartitions, const T2& table)
+{
+  return partitionedCombinations(nPartitions, CombinationsStrictlyUpperIndexPolicy(table, table));
+}
+
+template <typename T1, typename T2>
+auto partitionedSelfPairCombinations(int nPartitions, const char* categoryColumnName, int categoryNeighbours, const T1& outsider, const T2& table)
+{
+  return partitionedCombinations(nPartitions, CombinationsBlockStrictlyUpperSameIndexPolicy(categoryColumnName, categoryNeighbours, outsider, table, table));
+}
+
+/// Preselect the pairs of rows (i < j) of a table whose values in column C differ
+/// at most by maxDistance, e.g. on a binned eta, phi or vertex column.
+/// The rows are split into blocks of blockSize consecutive rows and pairs of blocks
+/// whose value ranges are further apart than maxDistance are skipped as a whole.
+/// @return positions of the accepted pairs, usable with setCursor() on the table iterators
+template <typename C, typename T>
+std::vector<std::pair<uint64_t, uint64_t>> preselectPairs(const T& table, typename C::type maxDistance, uint64_t blockSize = 256)
+{
+  using value_t = typename C::type;
+  static_assert(std::is_arithmetic_v<value_t>, "Pair preselection needs an arithmetic column");
+
+  std::vector<value_t> values;
+  values.reserve(table.size());
+  for (auto& row : table) {
+    values.push_back(*(static_cast<C>(row).getIterator()));
+  }
+
+  const uint64_t n = values.size();
+  const uint64_t nBlocks = (n + blockSize - 1) / blockSize;
+  std::vector<value_t> blockMin(nBlocks);
+  std::vector<value_t> blockMax(nBlocks);
+  for (uint64_t b = 0; b < nBlocks; b++) {
+    auto [minIt, maxIt] = std::minmax_element(values.begin() + b * blockSize, values.begin() + std::min(n, (b + 1) * blockSize));
+    blockMin[b] = *minIt;
+    blockMax[b] = *maxIt;
+  }
+
+  std::vector<std::pair<uint64_t, uint64_t>> pairs;
+  std::vector<uint64_t> candidates(blockSize);
+  for (uint64_t bi = 0; bi < nBlocks; bi++) {
+    for (uint64_t bj = bi; bj < nBlocks; bj++) {
+      if (blockMin[bj] > blockMax[bi] + maxDistance || blockMin[bi] > blockMax[bj] + maxDistance) {
+        continue;
+      }
+      const uint64_t jEnd = std::min(n, (bj + 1) * blockSize);
+      for (uint64_t i = bi * blockSize; i < std::min(n, (bi + 1) * blockSize); i++) {
+        const value_t vi = values[i];
+        const uint64_t jBegin = std::max(i + 1, bj * blockSize);
+        // branchless compaction of the accepted partners
+        uint64_t nCandidates = 0;
+        for (uint64_t j = jBegin; j < jEnd; j++) {
+          const value_t vj = values[j];
+          candidates[nCandidates] = j;
+          nCandidates += (vj <= vi + maxDistance) & (vi <= vj + maxDistance);
+        }
+        for (uint64_t c = 0; c < nCandidates; c++) {
+          pairs.emplace_back(i, candidates[c]);
+        }
+      }
+    }
+  }
+  // keep the order of the pair combinations
+  std::sort(pairs.begin(), pairs.end());
+  return pairs;
+}
+
 } // namespace o2::soa
 
 #endif // O2_FRAMEWORK_ASOAHELPERS_H_
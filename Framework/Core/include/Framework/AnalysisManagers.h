@@ -177,13 +177,15 @@ struct OutputManager<HistogramRegistry> {
     return true;
   }
 
-  static bool finalize(ProcessingContext&, HistogramRegistry&)
+  static bool finalize(ProcessingContext&, HistogramRegistry& what)
   {
+    what.flush();
     return true;
   }
 
   static bool postRun(EndOfStreamContext& context, HistogramRegistry& what)
   {
+    what.flush();
     context.outputs().snapshot(what.ref(), *(*what));
     return true;
   }
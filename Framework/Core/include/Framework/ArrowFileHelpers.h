@@ -0,0 +1,95 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_ARROWFILEHELPERS_H_
+#define O2_FRAMEWORK_ARROWFILEHELPERS_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace arrow
+{
+class Table;
+}
+
+// =============================================================================
+namespace o2::framework
+{
+
+// -----------------------------------------------------------------------------
+// ArrowFileHelpers allows to store AOD tables natively as Arrow IPC files
+// (Feather V2) instead of converting them to TTrees.
+//
+// An Arrow AOD "file" is a directory with extension .arrow which mirrors the
+// layout of the ROOT AOD files:
+//
+//  AO2D.arrow/
+//    DF_<n>/
+//      <treename>.arrow     one IPC file per table, holding the record
+//      <treename>.<k>.arrow batches of data frame n. When several time
+//                           frames are merged into one data frame, each
+//                           of them is written to its own part k.
+//
+// Tables are read back by memory mapping the IPC file, hence no copy or
+// conversion is needed until the table is sent to the consumers.
+//
+// .............................................................................
+struct ArrowFileHelpers {
+  /// Extension which selects the Arrow based AOD format
+  static constexpr char const* extension = ".arrow";
+
+  /// @return true if @a filename refers to an Arrow based AOD file
+  static bool isArrowFilename(std::string const& filename);
+
+  /// Write @a table to the IPC file @a filename, which is overwritten if
+  /// it exists. If @a columns is not empty only the given columns are stored.
+  static void writeTable(std::shared_ptr<arrow::Table> const& table,
+                         std::string const& filename,
+                         std::vector<std::string> const& columns = {});
+
+  /// Write @a table as a new part of table @a treename in the data frame
+  /// folder @a folderName, keeping the parts already present.
+  /// @return the name of the file written
+  static std::string appendTable(std::shared_ptr<arrow::Table> const& table,
+                                 std::string const& folderName,
+                                 std::string const& treename,
+                                 std::vector<std::string> const& columns = {});
+
+  /// @return the sorted list of the files holding the parts of table
+  /// @a treename in the data frame folder @a folderName
+  static std::vector<std::string> getTableParts(std::string const& folderName, std::string const& treename);
+
+  /// Read all parts of table @a treename in the data frame folder
+  /// @a folderName and concatenate them. The table is labelled with
+  /// @a treename.
+  /// @return nullptr if the folder does not contain the table
+  static std::shared_ptr<arrow::Table> readTableParts(std::string const& folderName,
+                                                      std::string const& treename,
+                                                      std::vector<std::string> const& columns = {});
+
+  /// Memory map the IPC file @a filename and create a table from its record
+  /// batches. If @a columns is not empty only the given columns are read.
+  /// If @a label is not empty it is attached to the schema as table label.
+  static std::shared_ptr<arrow::Table> readTable(std::string const& filename,
+                                                 std::vector<std::string> const& columns = {},
+                                                 std::string const& label = "");
+
+  /// @return the sorted list of data frame numbers found in @a dirname
+  static std::vector<uint64_t> getTimeFrameNumbers(std::string const& dirname);
+
+  /// @return the name of the folder which holds data frame @a folderNumber
+  static std::string getFolderName(uint64_t folderNumber);
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_ARROWFILEHELPERS_H_
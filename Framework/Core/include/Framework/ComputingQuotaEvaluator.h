@@ -51,6 +51,7 @@ class ComputingQuotaEvaluator
   ServiceRegistry& mRegistry;
   uv_loop_t* mLoop;
   uint64_t mTotalDisposedSharedMemory = 0;
+  uint64_t mTotalConsumedTimeframes = 0;
 };
 
 } // namespace o2::framework
@@ -54,6 +54,8 @@ struct ComputingQuotaOffer {
   /// Whether or not the offer is valid, invalid offers can
   /// be reused whe we get some more quota from the system.
   bool valid = false;
+  /// How many timeframes it can inject in the topology
+  int64_t timeframes = 0;
 };
 
 struct ComputingQuotaInfo {
@@ -12,6 +12,7 @@
 #define O2_FRAMEWORK_COMPUTINGRESOURCE_H_
 
 #include <string>
+#include <vector>
 
 namespace o2::framework
 {
@@ -45,6 +46,26 @@ struct ComputingResource {
   unsigned short usedPorts = 0;
 };
 
+/// A NUMA node of the machine with the cores which belong to it.
+struct NumaNode {
+  int id = 0;
+  std::vector<int> cpus;
+};
+
+/// How devices are pinned to the hardware of the machine they run on.
+enum struct ComputingPlacementPolicy {
+  None, // Leave it to the OS
+  Numa, // Bind each device to the cores and memory of a NUMA node
+  Cores // Same as above, but also split the cores of a node among its devices
+};
+
+/// Where a device runs on the machine. A negative NUMA node and no
+/// cores mean no particular placement was requested.
+struct ComputingPlacement {
+  int numaNode = -1;
+  std::vector<int> cpus;
+};
+
 } // namespace o2::framework
 
 #endif // O2_FRAMEWORK_COMPUTINGRESOURCES_H_
@@ -19,6 +19,11 @@
 #include <regex>
 #include "rapidjson/fwd.h"
 
+namespace arrow
+{
+class Table;
+}
+
 namespace o2::framework
 {
 
@@ -34,6 +39,8 @@ struct FileAndFolder {
   TFile* file = nullptr;
   std::string folderName = "";
 };
+// for Arrow based AOD files file is nullptr and folderName
+// contains the full path to the DF_* folder
 
 struct DataInputDescriptor {
   /// Holds information concerning the reading of an aod table.
@@ -71,6 +78,7 @@ struct DataInputDescriptor {
   uint64_t getTimeFrameNumber(int counter, int numTF);
   FileAndFolder getFileFolder(int counter, int numTF);
   int getTimeFramesInFile(int counter);
+  bool isArrowFile(int counter);
 
   void closeInputFile();
   bool isAlienSupportOn() { return mAlienSupport; }
@@ -114,6 +122,8 @@ struct DataInputDirector {
 
   std::unique_ptr<TTreeReader> getTreeReader(header::DataHeader dh, int counter, int numTF, std::string treeName);
   TTree* getDataTree(header::DataHeader dh, int counter, int numTF);
+  std::shared_ptr<arrow::Table> getDataTable(header::DataHeader dh, int counter, int numTF, std::vector<std::string> const& colnames);
+  bool isArrowFile(header::DataHeader dh, int counter);
   uint64_t getTimeFrameNumber(header::DataHeader dh, int counter, int numTF);
   FileAndFolder getFileFolder(header::DataHeader dh, int counter, int numTF);
   int getTimeFramesInFile(header::DataHeader dh, int counter);
@@ -83,6 +83,11 @@ struct DataOutputDirector {
   // get the matching TFile
   FileAndFolder getFileFolder(DataOutputDescriptor* dodesc, uint64_t folderNumber);
 
+  // Arrow based output, selected by a file name base with extension .arrow
+  bool isArrowOutput(DataOutputDescriptor* dodesc);
+  // get the matching folder, which is created if needed
+  std::string getArrowFolder(DataOutputDescriptor* dodesc, uint64_t folderNumber);
+
   void closeDataFiles();
 
   void setFilenameBase(std::string dfn);
@@ -96,6 +101,7 @@ struct DataOutputDirector {
   std::vector<std::string> mtreeFilenames;
   std::vector<std::string> mfilenameBases;
   std::vector<TFile*> mfilePtrs;
+  std::vector<bool> marrowFolderReady;
   bool mdebugmode = false;
   int mnumberTimeFramesToMerge = 1;
   std::string mfileMode = "RECREATE";
@@ -14,17 +14,21 @@
 
 #include "Framework/DeviceMetricsInfo.h"
 #include "Framework/RuntimeError.h"
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstring>
 #include <functional>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <vector>
 
 namespace o2::framework
 {
 
+class DeviceMetricsRing;
+
 struct DeviceMetricsHelper {
   /// Type of the callback which can be provided to be invoked every time a new
   /// metric is found by the system.
@@ -41,6 +45,26 @@ struct DeviceMetricsHelper {
   static bool processMetric(ParsedMetricMatch& results,
                             DeviceMetricsInfo& info,
                             NewMetricCallback newMetricCallback = nullptr);
+
+  /// Finds the metric with the name in @a match, creating it if needed.
+  /// @return the index of the metric in @a info, -1 for an invalid metric type.
+  static size_t findOrCreateMetric(ParsedMetricMatch const& match,
+                                   DeviceMetricsInfo& info,
+                                   NewMetricCallback newMetricCallback = nullptr);
+
+  /// Stores the value in @a match for the metric at @a metricIndex.
+  static bool storeMetric(size_t metricIndex,
+                          ParsedMetricMatch const& match,
+                          DeviceMetricsInfo& info);
+
+  /// Processes all the metrics pending in the binary @a ring of a device.
+  /// @metricIndices maps the ids assigned by the device to the metrics in @a info,
+  ///                it is updated when new metrics are announced.
+  /// @return the number of metrics processed.
+  static size_t processMetricsRing(DeviceMetricsRing& ring,
+                                   std::vector<size_t>& metricIndices,
+                                   DeviceMetricsInfo& info,
+                                   NewMetricCallback newMetricCallback = nullptr);
   /// @return the index in metrics for the information of given metric
   static size_t metricIdxByName(const std::string& name,
                                 const DeviceMetricsInfo& info);
@@ -74,6 +98,37 @@ struct DeviceMetricsHelper {
     };
   }
 
+  /// Appends a value to the store of a numeric metric. When the store is
+  /// full, the older half of it is downsampled by averaging pairs of values,
+  /// so that the most recent values are kept as they are, while the history
+  /// of the older ones gets coarser the older they are.
+  template <typename T, size_t N>
+  static void appendNumericMetric(MetricInfo& metric, std::array<T, N>& store, std::array<size_t, N>& timestamps, T value, size_t timestamp)
+  {
+    static_assert(N % 4 == 0, "The store must be split in quarters");
+    if (metric.pos == N) {
+      auto average = [](auto a, auto b) -> decltype(a) {
+        if constexpr (std::is_integral_v<decltype(a)>) {
+          return a / 2 + b / 2 + (a % 2 + b % 2) / 2;
+        } else {
+          return (a + b) / 2;
+        }
+      };
+      for (size_t i = 0; i < N / 4; ++i) {
+        store[i] = average(store[2 * i], store[2 * i + 1]);
+        timestamps[i] = average(timestamps[2 * i], timestamps[2 * i + 1]);
+      }
+      std::copy(store.begin() + N / 2, store.end(), store.begin() + N / 4);
+      std::copy(timestamps.begin() + N / 2, timestamps.end(), timestamps.begin() + N / 4);
+      // The slots after the last value are not in use anymore.
+      std::fill(timestamps.begin() + 3 * N / 4, timestamps.end(), 0);
+      metric.pos = 3 * N / 4;
+    }
+    store[metric.pos] = value;
+    timestamps[metric.pos] = timestamp;
+    metric.filledMetrics = ++metric.pos;
+  }
+
   template <typename T>
   static auto getNumericMetricCursor(size_t metricIndex)
   {
@@ -86,10 +141,7 @@ struct DeviceMetricsHelper {
       metrics.min[metricIndex] = std::min(metrics.min[metricIndex], (float)value);
       metrics.changed.at(metricIndex) = true;
       auto& store = getMetricsStore<T>(metrics);
-      size_t pos = metric.pos++ % store[metric.storeIdx].size();
-      metrics.timestamps[metricIndex][pos] = timestamp;
-      store[metric.storeIdx][pos] = value;
-      metric.filledMetrics++;
+      appendNumericMetric(metric, store[metric.storeIdx], metrics.timestamps[metricIndex], value, timestamp);
     };
   }
 
@@ -34,8 +34,8 @@ std::ostream& operator<<(std::ostream& oss, MetricType const& val);
 struct MetricInfo {
   enum MetricType type = MetricType::Unknown;
   size_t storeIdx = -1;     // Index in the actual store
-  size_t pos = 0;           // Last position in the circular buffer
-  size_t filledMetrics = 0; // How many metrics were filled
+  size_t pos = 0;           // Next position to write in the store, the string ones are circular buffers
+  size_t filledMetrics = 0; // How many metrics were filled, the number of values kept for the numeric ones
 };
 
 // We keep only fixed lenght strings for metrics, as in the end this is not
@@ -75,7 +75,8 @@ struct ParsedMetricMatch {
 /// the same as the DeviceSpec in its own vector.
 struct DeviceMetricsInfo {
   // We keep the size of each metric to 4096 bytes. No need for more
-  // for the debug GUI
+  // for the debug GUI: once full, the older half of the numeric metrics
+  // is downsampled to make room for the new values.
   std::vector<std::array<int, 1024>> intMetrics;
   std::vector<std::array<uint64_t, 1024>> uint64Metrics;
   std::vector<std::array<StringMetric, 32>> stringMetrics; // We do not keep so many strings as metrics as history is less relevant.
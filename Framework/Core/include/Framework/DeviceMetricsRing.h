@@ -0,0 +1,132 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_DEVICEMETRICSRING_H_
+#define O2_FRAMEWORK_DEVICEMETRICSRING_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+namespace o2::framework
+{
+
+/// A metric as stored in the DeviceMetricsRing. The header is followed by
+/// the label of the metric, which is only sent the first time a given id is
+/// used, and by the value of string metrics. Records are 8 bytes aligned.
+struct DeviceMetricsRecord {
+  static constexpr uint8_t PADDING = 0xff; // Type of the records used to skip the end of the buffer
+  uint32_t size = 0;                       // Size of the record, including label and string value
+  uint32_t id = 0;                         // Id of the metric, assigned by the device
+  uint16_t labelSize = 0;                  // Size of the label following the header
+  uint16_t stringSize = 0;                 // Size of the string value following the label
+  uint8_t type = 0;                        // MetricType of the value
+  uint8_t reserved[3] = {};
+  uint64_t timestamp = 0;
+  union {
+    int intValue;
+    float floatValue;
+    uint64_t uint64Value = 0;
+  };
+};
+
+/// Lock-free single producer / single consumer ring buffer of binary metrics,
+/// in a shared memory segment between a device (producer) and the driver
+/// (consumer). The segment is created by the driver and handed over to the
+/// device as an inherited file descriptor, so that nothing is left behind
+/// in /dev/shm whatever happens to the processes.
+class DeviceMetricsRing
+{
+ public:
+  /// Create a new ring with (at least) @a capacity bytes for records.
+  /// @return nullptr in case the shared memory could not be allocated.
+  static std::unique_ptr<DeviceMetricsRing> create(size_t capacity);
+  /// Map the ring associated to @a fd, as created by the driver.
+  /// @return nullptr in case the ring could not be mapped.
+  static std::unique_ptr<DeviceMetricsRing> attach(int fd);
+
+  ~DeviceMetricsRing();
+  DeviceMetricsRing(DeviceMetricsRing const&) = delete;
+  DeviceMetricsRing& operator=(DeviceMetricsRing const&) = delete;
+
+  /// File descriptor of the shared memory segment
+  int fd() const { return mFd; }
+  /// Number of bytes available for records
+  size_t capacity() const { return mCapacity; }
+  /// Number of times the consumer dropped corrupted records. Labels might
+  /// have been dropped as well, so the producer needs to send them again when
+  /// this changes.
+  uint64_t drops() const { return mHeader->drops.load(std::memory_order_acquire); }
+
+  /// Append a metric to the ring. To be used only by the device.
+  /// @return false if there is not enough space left, in which case the
+  ///         metric should be sent via some other channel.
+  bool push(DeviceMetricsRecord const& record, std::string_view label, std::string_view stringValue = {});
+
+  /// Invoke @a callback(DeviceMetricsRecord const&, std::string_view label, std::string_view stringValue)
+  /// for all the records available and release them. To be used only by the driver.
+  /// @return the number of records processed.
+  template <typename CALLBACK>
+  size_t consume(CALLBACK&& callback)
+  {
+    uint64_t tail = mHeader->tail.load(std::memory_order_relaxed);
+    uint64_t const head = mHeader->head.load(std::memory_order_acquire);
+    size_t count = 0;
+    while (tail < head) {
+      size_t offset = tail & (mCapacity - 1);
+      size_t left = mCapacity - offset;
+      if (left < sizeof(DeviceMetricsRecord)) {
+        tail += left;
+        continue;
+      }
+      auto const* record = reinterpret_cast<DeviceMetricsRecord const*>(mData + offset);
+      // We do not trust the producer to not corrupt the ring: if anything
+      // is wrong, we drop all the pending records.
+      if (record->size < sizeof(DeviceMetricsRecord) || record->size > left || record->size % alignof(DeviceMetricsRecord) ||
+          (record->type != DeviceMetricsRecord::PADDING && sizeof(DeviceMetricsRecord) + record->labelSize + record->stringSize > record->size)) {
+        tail = head;
+        mHeader->drops.fetch_add(1, std::memory_order_release);
+        break;
+      }
+      if (record->type != DeviceMetricsRecord::PADDING) {
+        auto const* payload = reinterpret_cast<char const*>(record + 1);
+        callback(*record, std::string_view{payload, record->labelSize}, std::string_view{payload + record->labelSize, record->stringSize});
+        ++count;
+      }
+      tail += record->size;
+    }
+    mHeader->tail.store(tail, std::memory_order_release);
+    return count;
+  }
+
+ private:
+  struct Header {
+    alignas(64) std::atomic<uint64_t> head; // Bytes written by the producer
+    alignas(64) std::atomic<uint64_t> tail; // Bytes released by the consumer
+    std::atomic<uint64_t> drops;            // Times the consumer dropped corrupted records
+    alignas(64) uint64_t capacity;          // Size of the data area, a power of 2
+  };
+  static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared memory ring requires lock-free 64 bit atomics");
+
+  DeviceMetricsRing(int fd, void* mapping, size_t size);
+
+  int mFd;
+  void* mMapping;
+  size_t mMappingSize;
+  Header* mHeader;
+  char* mData;
+  size_t mCapacity;
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_DEVICEMETRICSRING_H_
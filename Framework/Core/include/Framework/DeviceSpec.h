@@ -68,6 +68,8 @@ struct DeviceSpec {
   /// a computation.
   ResourcePolicy resourcePolicy;
   ComputingResource resource;
+  /// The NUMA node and cores the device is pinned to
+  ComputingPlacement placement;
   unsigned short resourceMonitoringInterval;
   std::vector<DataProcessorLabel> labels;
 };
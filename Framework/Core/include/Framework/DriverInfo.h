@@ -146,6 +146,8 @@ struct DriverInfo {
   unsigned short resourcesMonitoringInterval = 0;
   /// Metrics gathering dump to disk interval
   unsigned short resourcesMonitoringDumpInterval = 0;
+  /// Size of the shared memory ring for the binary metrics of each device. 0 means disabled.
+  unsigned int metricsRingSize = 0;
   /// Port used by the websocket control. 0 means not initialised.
   unsigned short port = 0;
   /// Last port used for tracy
@@ -359,6 +359,21 @@ std::shared_ptr<gandiva::Projector> createProjector(gandiva::SchemaPtr const& Sc
 std::shared_ptr<gandiva::Projector> createProjector(gandiva::SchemaPtr const& Schema,
                                                     Projector&& p,
                                                     gandiva::FieldPtr result);
+/// Function to create gandiva projector from a set of gandiva expressions
+std::shared_ptr<gandiva::Projector> createProjector(gandiva::SchemaPtr const& Schema,
+                                                    gandiva::ExpressionVector const& expressions);
+
+/// Statistics of the process-wide cache of compiled gandiva filters and projectors,
+/// which is used by all the createFilter and createProjector functions above
+struct GandivaCacheStats {
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  uint64_t compileTimeNs = 0;
+  uint64_t entries = 0;
+};
+GandivaCacheStats getGandivaCacheStats();
+/// Drop all compiled filters and projectors from the cache
+void clearGandivaCache();
 /// Function for attaching gandiva filters to to compatible task inputs
 void updateExpressionInfos(expressions::Filter const& filter, std::vector<ExpressionInfo>& eInfos);
 /// Function to create gandiva condition expression from generic gandiva expression tree
@@ -371,20 +386,13 @@ void updatePlaceholders(Filter& filter, InitContext& context);
 template <typename... C>
 std::shared_ptr<gandiva::Projector> createProjectors(framework::pack<C...>, gandiva::SchemaPtr schema)
 {
-  std::shared_ptr<gandiva::Projector> projector;
-  auto s = gandiva::Projector::Make(
+  return createProjector(
     schema,
-    {makeExpression(
+    gandiva::ExpressionVector{makeExpression(
       framework::expressions::createExpressionTree(
         framework::expressions::createOperations(C::Projector()),
         schema),
-      C::asArrowField())...},
-    &projector);
-  if (s.ok()) {
-    return projector;
-  } else {
-    throw o2::framework::runtime_error_f("Failed to create projector: %s", s.ToString().c_str());
-  }
+      C::asArrowField())...});
 }
 } // namespace o2::framework::expressions
 
@@ -26,7 +26,14 @@
 #include <TDataMember.h>
 #include <TDataType.h>
 
+#include <arrow/array.h>
+#include <arrow/chunked_array.h>
+
+#include <atomic>
 #include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 
 class TList;
 
@@ -48,6 +55,15 @@ struct HistFiller {
   template <typename... Cs, typename R, typename T>
   static void fillHistAny(std::shared_ptr<R>& hist, const T& table, const o2::framework::expressions::Filter& filter);
 
+  // fill any type of histogram with n entries, each made of nArgs consecutive position (and weight) values
+  template <typename T>
+  static void fillHistAnyN(std::shared_ptr<T>& hist, int nArgs, size_t n, const double* values);
+
+  // maximum number of position and weight arguments for the batched fill functions
+  static constexpr int MAX_FILL_ARGS{10};
+  // number of entries which are converted and filled in one go
+  static constexpr size_t FILL_BATCH_SIZE{1024};
+
   // function that returns rough estimate for the size of a histogram in MB
   template <typename T>
   static double getSize(std::shared_ptr<T>& hist, double fillFraction = 1.);
@@ -62,6 +78,20 @@ struct HistFiller {
 
   template <typename B, typename T>
   static int getBaseElementSize(T* ptr);
+
+  // helpers to fill one entry with a number of arguments only known at runtime
+  template <typename T, size_t... Is>
+  static void fillHistAnyArray(std::shared_ptr<T>& hist, const double* values, std::index_sequence<Is...>);
+
+  template <typename T, size_t N>
+  static void fillHistAnyArray(std::shared_ptr<T>& hist, const double* values);
+
+  template <typename T, size_t... Ns>
+  static void fillHistAnyRuntime(std::shared_ptr<T>& hist, int nArgs, const double* values, std::index_sequence<Ns...>);
+
+  // helper to copy the values of the selected rows of a column to the interleaved fill buffer
+  template <typename C>
+  static void gatherColumn(const arrow::ChunkedArray& column, const int64_t* rows, size_t n, int iArg, int nArgs, double* values);
 };
 
 //**************************************************************************************************
@@ -123,6 +153,23 @@ class HistogramRegistry
   template <typename... Cs, typename T>
   void fill(const HistName& histName, const T& table, const o2::framework::expressions::Filter& filter);
 
+  // fill hist with n entries taken from one array per position (and weight) argument, e.g. the raw values of arrow arrays
+  template <typename... Ts>
+  void fillN(const HistName& histName, size_t n, const Ts*... positionsAndWeights);
+
+  // store values in a per-histogram buffer which is filled in chunks when full or when flush() is called (not thread safe)
+  template <typename... Ts>
+  void fillBuffered(const HistName& histName, Ts&&... positionAndWeight);
+
+  // fill a copy of the histogram owned by the calling thread, the copies are merged into the registry by flush()
+  template <typename... Ts>
+  void fillThreadLocal(const HistName& histName, Ts&&... positionAndWeight);
+
+  // fill all pending buffered entries and merge the thread-local copies into the histograms
+  // (called at the end of each dataframe and before the histograms are sent, must not run
+  // concurrently with fillThreadLocal() or with another flush())
+  void flush();
+
   // get rough estimate for size of histogram stored in registry
   double getSize(const HistName& histName, double fillFraction = 1.);
 
@@ -164,6 +211,16 @@ class HistogramRegistry
   // helper function that checks if name of histogram is reasonable and keeps track of names already in use
   void registerName(const std::string& name);
 
+  // fill the buffered entries of the histogram at position idx
+  void flushBuffer(uint32_t idx);
+
+  // merge the thread-local copies into the histograms, under the lock of the thread-local copies
+  // (the threads filling them must be done, see flush())
+  void mergeThreadLocal();
+
+  // return the copy of the histogram at position idx owned by the calling thread
+  HistPtr& getThreadLocal(uint32_t idx);
+
   std::string mName{};
   OutputObjHandlingPolicy mPolicy{};
   bool mCreateRegistryDir{};
@@ -177,6 +234,19 @@ class HistogramRegistry
   static constexpr uint32_t MAX_REGISTRY_SIZE{REGISTRY_BITMASK + 1};
   std::array<uint32_t, MAX_REGISTRY_SIZE> mRegistryKey{};
   std::array<HistPtr, MAX_REGISTRY_SIZE> mRegistryValue{};
+
+  // buffers of fillBuffered(), entries are stored consecutively with mFillBufferArgs values each
+  std::array<std::vector<double>, MAX_REGISTRY_SIZE> mFillBuffer{};
+  std::array<int, MAX_REGISTRY_SIZE> mFillBufferArgs{};
+
+  // thread-local copies of the histograms used by fillThreadLocal()
+  struct ThreadLocalHists {
+    std::mutex mutex;
+    const uint64_t id{nextId++};
+    std::unordered_map<std::thread::id, std::unique_ptr<std::array<HistPtr, MAX_REGISTRY_SIZE>>> hists;
+    static std::atomic<uint64_t> nextId;
+  };
+  std::shared_ptr<ThreadLocalHists> mThreadLocalHists{std::make_shared<ThreadLocalHists>()};
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -224,13 +294,114 @@ void HistFiller::fillHistAny(std::shared_ptr<T>& hist, const Ts&... positionAndW
 template <typename... Cs, typename R, typename T>
 void HistFiller::fillHistAny(std::shared_ptr<R>& hist, const T& table, const o2::framework::expressions::Filter& filter)
 {
-  if constexpr (std::is_base_of_v<StepTHn, T>) {
+  if constexpr (std::is_base_of_v<StepTHn, R>) {
     LOGF(FATAL, "Table filling is not (yet?) supported for StepTHn.");
-    return;
+  } else if constexpr (!((Cs::persistent::value && std::is_arithmetic_v<typename Cs::type>) && ...)) {
+    // dynamic, expression or array columns are only accessible via the table iterators
+    auto filtered = o2::soa::Filtered<T>{{table.asArrowTable()}, o2::framework::expressions::createSelection(table.asArrowTable(), filter)};
+    for (auto& t : filtered) {
+      fillHistAny(hist, (*(static_cast<Cs>(t).getIterator()))...);
+    }
+  } else {
+    constexpr int nArgs = sizeof...(Cs);
+    static_assert(nArgs <= MAX_FILL_ARGS, "Too many columns requested for histogram filling.");
+
+    // work directly on the arrow columns: the selected rows are converted
+    // batch by batch to an interleaved buffer which is filled in one go
+    auto arrowTable = table.asArrowTable();
+    auto selection = o2::framework::expressions::createSelection(arrowTable, filter);
+    std::array<std::shared_ptr<arrow::ChunkedArray>, nArgs> columns{arrowTable->GetColumnByName(Cs::columnLabel())...};
+    for (auto& column : columns) {
+      if (!column) {
+        LOGF(FATAL, "Column requested for filling histogram %s is not available in the table.", hist->GetName());
+      }
+    }
+
+    std::array<int64_t, FILL_BATCH_SIZE> rows;
+    std::array<double, FILL_BATCH_SIZE * nArgs> values;
+    const size_t nSelected = selection->GetNumSlots();
+    for (size_t first = 0; first < nSelected; first += FILL_BATCH_SIZE) {
+      const size_t n = std::min(FILL_BATCH_SIZE, nSelected - first);
+      for (size_t i = 0; i < n; ++i) {
+        rows[i] = selection->GetIndex(first + i);
+      }
+      int iArg = 0;
+      ((gatherColumn<Cs>(*columns[iArg], rows.data(), n, iArg, nArgs, values.data()), ++iArg), ...);
+      fillHistAnyN(hist, nArgs, n, values.data());
+    }
   }
-  auto filtered = o2::soa::Filtered<T>{{table.asArrowTable()}, o2::framework::expressions::createSelection(table.asArrowTable(), filter)};
-  for (auto& t : filtered) {
-    fillHistAny(hist, (*(static_cast<Cs>(t).getIterator()))...);
+}
+
+template <typename T>
+void HistFiller::fillHistAnyN(std::shared_ptr<T>& hist, int nArgs, size_t n, const double* values)
+{
+  if (nArgs < 1 || nArgs > MAX_FILL_ARGS) {
+    LOGF(FATAL, "The number of arguments in fill function called for histogram %s is incompatible with histogram dimensions.", hist->GetName());
+  }
+  // ROOT's FillN takes the number of entries and steps through the arrays by stride
+  if constexpr (std::is_same_v<TH1, T>) {
+    if (nArgs == 1 || nArgs == 2) {
+      hist->FillN(n, values, (nArgs == 2) ? values + 1 : nullptr, nArgs);
+      return;
+    }
+  } else if constexpr (std::is_same_v<TH2, T>) {
+    if (nArgs == 2 || nArgs == 3) {
+      hist->FillN(n, values, values + 1, (nArgs == 3) ? values + 2 : nullptr, nArgs);
+      return;
+    }
+  } else if constexpr (std::is_base_of_v<THnBase, T>) {
+    const int nDim = hist->GetNdimensions();
+    if (nArgs == nDim || nArgs == nDim + 1) {
+      for (size_t i = 0; i < n; ++i) {
+        const double* entry = values + i * nArgs;
+        hist->Fill(entry, (nArgs == nDim) ? 1. : entry[nDim]);
+      }
+      return;
+    }
+  }
+  for (size_t i = 0; i < n; ++i) {
+    fillHistAnyRuntime(hist, nArgs, values + i * nArgs, std::make_index_sequence<MAX_FILL_ARGS>{});
+  }
+}
+
+template <typename T, size_t... Is>
+void HistFiller::fillHistAnyArray(std::shared_ptr<T>& hist, const double* values, std::index_sequence<Is...>)
+{
+  fillHistAny(hist, values[Is]...);
+}
+
+template <typename T, size_t N>
+void HistFiller::fillHistAnyArray(std::shared_ptr<T>& hist, const double* values)
+{
+  fillHistAnyArray(hist, values, std::make_index_sequence<N>{});
+}
+
+template <typename T, size_t... Ns>
+void HistFiller::fillHistAnyRuntime(std::shared_ptr<T>& hist, int nArgs, const double* values, std::index_sequence<Ns...>)
+{
+  using filler_t = void (*)(std::shared_ptr<T>&, const double*);
+  static constexpr filler_t fillers[] = {&fillHistAnyArray<T, Ns + 1>...};
+  fillers[nArgs - 1](hist, values);
+}
+
+template <typename C>
+void HistFiller::gatherColumn(const arrow::ChunkedArray& column, const int64_t* rows, size_t n, int iArg, int nArgs, double* values)
+{
+  using value_t = typename C::type;
+  // rows are sorted, so the chunks are visited in order
+  int chunkIdx = 0;
+  int64_t chunkOffset = 0;
+  for (size_t i = 0; i < n; ++i) {
+    while (rows[i] >= chunkOffset + column.chunk(chunkIdx)->length()) {
+      chunkOffset += column.chunk(chunkIdx)->length();
+      ++chunkIdx;
+    }
+    auto const& chunk = column.chunk(chunkIdx);
+    if constexpr (std::is_same_v<value_t, bool>) {
+      values[i * nArgs + iArg] = static_cast<const arrow::BooleanArray&>(*chunk).Value(rows[i] - chunkOffset);
+    } else {
+      values[i * nArgs + iArg] = static_cast<double>(chunk->data()->template GetValues<value_t>(1)[rows[i] - chunkOffset]);
+    }
   }
 }
 
@@ -388,5 +559,49 @@ void HistogramRegistry::fill(const HistName& histName, const T& table, const o2:
   std::visit([&table, &filter](auto&& hist) { HistFiller::fillHistAny<Cs...>(hist, table, filter); }, mRegistryValue[getHistIndex(histName)]);
 }
 
+template <typename... Ts>
+void HistogramRegistry::fillN(const HistName& histName, size_t n, const Ts*... positionsAndWeights)
+{
+  constexpr int nArgs = sizeof...(Ts);
+  static_assert(nArgs <= HistFiller::MAX_FILL_ARGS, "Too many arguments for histogram filling.");
+  std::array<double, HistFiller::FILL_BATCH_SIZE * nArgs> values;
+  std::visit([&](auto&& hist) {
+    for (size_t first = 0; first < n; first += HistFiller::FILL_BATCH_SIZE) {
+      const size_t nBatch = std::min(HistFiller::FILL_BATCH_SIZE, n - first);
+      for (size_t i = 0; i < nBatch; ++i) {
+        int iArg = 0;
+        ((values[i * nArgs + iArg++] = static_cast<double>(positionsAndWeights[first + i])), ...);
+      }
+      HistFiller::fillHistAnyN(hist, nArgs, nBatch, values.data());
+    }
+  },
+             mRegistryValue[getHistIndex(histName)]);
+}
+
+template <typename... Ts>
+void HistogramRegistry::fillBuffered(const HistName& histName, Ts&&... positionAndWeight)
+{
+  constexpr int nArgs = sizeof...(Ts);
+  static_assert(nArgs <= HistFiller::MAX_FILL_ARGS, "Too many arguments for histogram filling.");
+  const uint32_t idx = getHistIndex(histName);
+  auto& buffer = mFillBuffer[idx];
+  if (O2_BUILTIN_UNLIKELY(mFillBufferArgs[idx] != nArgs)) {
+    // the number of arguments changed, e.g. weights are used from now on
+    flushBuffer(idx);
+    mFillBufferArgs[idx] = nArgs;
+    buffer.reserve(HistFiller::FILL_BATCH_SIZE * nArgs);
+  }
+  (buffer.push_back(static_cast<double>(positionAndWeight)), ...);
+  if (buffer.size() >= HistFiller::FILL_BATCH_SIZE * nArgs) {
+    flushBuffer(idx);
+  }
+}
+
+template <typename... Ts>
+void HistogramRegistry::fillThreadLocal(const HistName& histName, Ts&&... positionAndWeight)
+{
+  std::visit([&positionAndWeight...](auto&& hist) { HistFiller::fillHistAny(hist, std::forward<Ts>(positionAndWeight)...); }, getThreadLocal(getHistIndex(histName)));
+}
+
 } // namespace o2::framework
 #endif // FRAMEWORK_HISTOGRAMREGISTRY_H_
@@ -13,6 +13,7 @@
 #define O2_FRAMEWORK_RESOURCEPOLICYHELPERS_H_
 
 #include "Framework/ResourcePolicy.h"
+#include "Framework/DataProcessorLabel.h"
 #include <functional>
 #include <string>
 
@@ -23,8 +24,19 @@ struct ResourcePolicyHelpers {
   static ResourcePolicy trivialTask(char const* taskMatcher);
   static ResourcePolicy cpuBoundTask(char const* taskMatcher, int maxCPUs = 1);
   static ResourcePolicy sharedMemoryBoundTask(char const* taskMatcher, int maxMemory);
+  /// A task which needs a timeframe credit from the driver for each
+  /// timeframe it injects in the topology.
+  static ResourcePolicy timeframeBoundTask(char const* taskMatcher);
 };
 
+/// Label of the processors which tell when a timeframe created by the
+/// timeframe-bound tasks has left the topology: it is in flight until all
+/// of them processed it. Processors which only get some of the timeframes
+/// (e.g. fed by sampling or filtering on a subspecification) must not have it.
+/// Processors can also be named by the --timeframes-consumers regular expression.
+/// Without any such processor, the timeframes are not rate limited.
+const extern DataProcessorLabel timeframeCreditsConsumerLabel;
+
 } // namespace o2::framework
 
 #endif // O2_FRAMEWORK_RESOURCEPOLICYHELPERS_H_
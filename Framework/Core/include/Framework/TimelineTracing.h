@@ -0,0 +1,106 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_TIMELINETRACING_H_
+#define O2_FRAMEWORK_TIMELINETRACING_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+namespace o2::framework
+{
+
+/// The different phases of the processing of a timeslice which are
+/// recorded in the timeline.
+enum struct TimelineEventKind : uint8_t {
+  Relay,     // An input was received and relayed to its slot
+  Dispatch,  // A complete set of inputs is dispatched
+  Process,   // The user process callback
+  Serialise, // Serialisation of some output
+  Send,      // Some output is handed over to the transport
+  Count
+};
+
+/// An entry in the timeline. Timestamps are in nanoseconds, from the
+/// steady clock, so that traces of different devices on the same node
+/// can be merged.
+struct TimelineEvent {
+  uint64_t start = 0;
+  uint64_t duration = 0;
+  uint64_t timeslice = 0;
+  TimelineEventKind kind = TimelineEventKind::Count;
+};
+
+/// Always-on, low overhead timeline of the processing of a device.
+/// Each thread records its events in its own ring buffer, without any
+/// locking, so that only the last events are kept. The ring size is taken from
+/// the DPL_TIMELINE_EVENTS environment variable (events per thread, 0 disables
+/// the recording).
+struct TimelineTracing {
+  static constexpr size_t DEFAULT_EVENTS_PER_THREAD = 1 << 14;
+
+  /// Number of events kept per thread, rounded up to a power of 2.
+  /// Only affects threads which did not record anything yet.
+  static void setEventsPerThread(size_t events);
+  static size_t eventsPerThread() { return sEventsPerThread.load(std::memory_order_relaxed); }
+  static bool enabled() { return eventsPerThread() != 0; }
+
+  static uint64_t now()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  /// Record an event on the timeline of the current thread.
+  static void record(TimelineEventKind kind, uint64_t timeslice, uint64_t start, uint64_t end);
+
+  /// Write the events of all the threads in the Chrome / Perfetto trace
+  /// event format, using @a processName to label the process.
+  static void dumpChromeTrace(std::ostream& out, std::string_view processName);
+  /// Same as above, to the file @a filename.
+  /// @return false if the file could not be written.
+  static bool dumpChromeTrace(std::string const& filename, std::string_view processName);
+  /// Dump the timeline of the device @a deviceId to
+  /// dpl-timeline-<deviceId>-<pid>.json in the current directory.
+  static void dumpDeviceTimeline(std::string_view deviceId);
+
+  /// Forget all the events recorded so far.
+  static void clear();
+
+  static std::atomic<size_t> sEventsPerThread;
+};
+
+/// Records an event spanning the lifetime of the object. Scopes created
+/// without an explicit timeslice inherit the one of the enclosing scope on
+/// the same thread.
+class TimelineScope
+{
+ public:
+  TimelineScope(TimelineEventKind kind, uint64_t timeslice);
+  explicit TimelineScope(TimelineEventKind kind);
+  ~TimelineScope();
+  TimelineScope(TimelineScope const&) = delete;
+  TimelineScope& operator=(TimelineScope const&) = delete;
+
+ private:
+  uint64_t mStart;
+  uint64_t mTimeslice;
+  uint64_t mPreviousTimeslice;
+  TimelineEventKind mKind;
+  bool mEnabled;
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_TIMELINETRACING_H_
@@ -0,0 +1,239 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/ArrowFileHelpers.h"
+#include "Framework/Logger.h"
+
+#include <arrow/io/file.h>
+#include <arrow/ipc/reader.h>
+#include <arrow/ipc/writer.h>
+#include <arrow/record_batch.h>
+#include <arrow/table.h>
+#include <arrow/util/key_value_metadata.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <regex>
+
+namespace fs = std::filesystem;
+
+namespace o2::framework
+{
+
+bool ArrowFileHelpers::isArrowFilename(std::string const& filename)
+{
+  std::string ext(extension);
+  auto name = filename;
+  // allow for a trailing separator when a directory is given
+  while (!name.empty() && name.back() == '/') {
+    name.pop_back();
+  }
+  return name.size() > ext.size() && name.compare(name.size() - ext.size(), ext.size(), ext) == 0;
+}
+
+std::string ArrowFileHelpers::getFolderName(uint64_t folderNumber)
+{
+  return "DF_" + std::to_string(folderNumber);
+}
+
+void ArrowFileHelpers::writeTable(std::shared_ptr<arrow::Table> const& table,
+                                  std::string const& filename,
+                                  std::vector<std::string> const& columns)
+{
+  auto toWrite = table;
+
+  // only keep the requested columns
+  if (!columns.empty()) {
+    std::vector<std::shared_ptr<arrow::Field>> fields;
+    std::vector<std::shared_ptr<arrow::ChunkedArray>> chunkedArrays;
+    for (auto const& cn : columns) {
+      auto idx = table->schema()->GetFieldIndex(cn);
+      if (idx != -1) {
+        fields.emplace_back(table->schema()->field(idx));
+        chunkedArrays.emplace_back(table->column(idx));
+      }
+    }
+    toWrite = arrow::Table::Make(std::make_shared<arrow::Schema>(fields, table->schema()->metadata()),
+                                 chunkedArrays, table->num_rows());
+  }
+
+  auto outFile = arrow::io::FileOutputStream::Open(filename);
+  if (!outFile.ok()) {
+    throw std::runtime_error(fmt::format(R"(Unable to open "{}" for writing: {})", filename, outFile.status().ToString()));
+  }
+  auto stream = outFile.ValueOrDie();
+
+#if ARROW_VERSION_MAJOR < 2
+  auto outBatch = arrow::ipc::NewFileWriter(stream.get(), toWrite->schema());
+#else
+  auto outBatch = arrow::ipc::MakeFileWriter(stream.get(), toWrite->schema());
+#endif
+  if (outBatch.ok() == false) {
+    throw std::runtime_error(fmt::format(R"(Unable to create file writer for "{}")", filename));
+  }
+  auto writer = outBatch.ValueOrDie();
+  // every chunk of the table ends up as a record batch of this data frame
+  if (writer->WriteTable(*toWrite).ok() == false) {
+    throw std::runtime_error(fmt::format(R"(Unable to write table to "{}")", filename));
+  }
+  if (writer->Close().ok() == false || stream->Close().ok() == false) {
+    throw std::runtime_error(fmt::format(R"(Unable to close "{}")", filename));
+  }
+}
+
+std::shared_ptr<arrow::Table> ArrowFileHelpers::readTable(std::string const& filename,
+                                                          std::vector<std::string> const& columns,
+                                                          std::string const& label)
+{
+  auto inFile = arrow::io::MemoryMappedFile::Open(filename, arrow::io::FileMode::READ);
+  if (!inFile.ok()) {
+    throw std::runtime_error(fmt::format(R"(Couldn't open file "{}": {})", filename, inFile.status().ToString()));
+  }
+  auto mappedFile = inFile.ValueOrDie();
+
+  auto options = arrow::ipc::IpcReadOptions::Defaults();
+  auto fileReader = arrow::ipc::RecordBatchFileReader::Open(mappedFile.get(), options);
+  if (!fileReader.ok()) {
+    throw std::runtime_error(fmt::format(R"(Couldn't read "{}": {})", filename, fileReader.status().ToString()));
+  }
+  auto reader = fileReader.ValueOrDie();
+
+  // restrict the read to the requested columns, the buffers of the
+  // other columns are then never touched
+  if (!columns.empty()) {
+    for (auto const& cn : columns) {
+      auto idx = reader->schema()->GetFieldIndex(cn);
+      if (idx == -1) {
+        throw std::runtime_error(fmt::format(R"(Column "{}" not found in "{}")", cn, filename));
+      }
+      options.included_fields.emplace_back(idx);
+    }
+    std::sort(options.included_fields.begin(), options.included_fields.end());
+    fileReader = arrow::ipc::RecordBatchFileReader::Open(mappedFile.get(), options);
+    if (!fileReader.ok()) {
+      throw std::runtime_error(fmt::format(R"(Couldn't read "{}": {})", filename, fileReader.status().ToString()));
+    }
+    reader = fileReader.ValueOrDie();
+  }
+
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+  batches.reserve(reader->num_record_batches());
+  for (int ib = 0; ib < reader->num_record_batches(); ++ib) {
+    auto batch = reader->ReadRecordBatch(ib);
+    if (!batch.ok()) {
+      throw std::runtime_error(fmt::format(R"(Couldn't read record batch {} of "{}")", ib, filename));
+    }
+    batches.emplace_back(batch.ValueOrDie());
+  }
+
+  auto result = arrow::Table::FromRecordBatches(reader->schema(), batches);
+  if (!result.ok()) {
+    throw std::runtime_error(fmt::format(R"(Couldn't create table from "{}")", filename));
+  }
+  auto table = result.ValueOrDie();
+  if (!label.empty()) {
+    table = table->ReplaceSchemaMetadata(std::make_shared<arrow::KeyValueMetadata>(std::vector{std::string{"label"}}, std::vector{label}));
+  }
+  return table;
+}
+
+std::string ArrowFileHelpers::appendTable(std::shared_ptr<arrow::Table> const& table,
+                                          std::string const& folderName,
+                                          std::string const& treename,
+                                          std::vector<std::string> const& columns)
+{
+  // IPC files can not be appended to, hence every call adds a new part
+  auto parts = getTableParts(folderName, treename);
+  auto filename = (fs::path(folderName) / treename).string();
+  if (!parts.empty()) {
+    filename += "." + std::to_string(parts.size());
+  }
+  filename += extension;
+  writeTable(table, filename, columns);
+  return filename;
+}
+
+std::vector<std::string> ArrowFileHelpers::getTableParts(std::string const& folderName, std::string const& treename)
+{
+  std::vector<std::pair<uint64_t, std::string>> parts;
+  if (!fs::is_directory(folderName)) {
+    return {};
+  }
+
+  // parts are named <treename>.arrow and <treename>.<k>.arrow
+  auto first = treename + extension;
+  std::regex partRegex = std::regex(R"(\.([0-9]+)\.arrow)");
+  std::smatch match;
+  for (auto const& entry : fs::directory_iterator(folderName)) {
+    auto name = entry.path().filename().string();
+    if (name == first) {
+      parts.emplace_back(0, entry.path().string());
+      continue;
+    }
+    if (name.compare(0, treename.size(), treename) != 0) {
+      continue;
+    }
+    auto suffix = name.substr(treename.size());
+    if (std::regex_match(suffix, match, partRegex)) {
+      parts.emplace_back(std::stoul(match[1].str()), entry.path().string());
+    }
+  }
+  std::sort(parts.begin(), parts.end());
+
+  std::vector<std::string> filenames;
+  for (auto& part : parts) {
+    filenames.emplace_back(part.second);
+  }
+  return filenames;
+}
+
+std::shared_ptr<arrow::Table> ArrowFileHelpers::readTableParts(std::string const& folderName,
+                                                               std::string const& treename,
+                                                               std::vector<std::string> const& columns)
+{
+  auto parts = getTableParts(folderName, treename);
+  if (parts.empty()) {
+    return nullptr;
+  }
+  if (parts.size() == 1) {
+    return readTable(parts.front(), columns, treename);
+  }
+
+  std::vector<std::shared_ptr<arrow::Table>> tables;
+  for (auto& part : parts) {
+    tables.emplace_back(readTable(part, columns));
+  }
+  auto result = arrow::ConcatenateTables(tables);
+  if (!result.ok()) {
+    throw std::runtime_error(fmt::format(R"(Couldn't concatenate the parts of "{}" in "{}": {})", treename, folderName, result.status().ToString()));
+  }
+  return result.ValueOrDie()->ReplaceSchemaMetadata(std::make_shared<arrow::KeyValueMetadata>(std::vector{std::string{"label"}}, std::vector{treename}));
+}
+
+std::vector<uint64_t> ArrowFileHelpers::getTimeFrameNumbers(std::string const& dirname)
+{
+  std::vector<uint64_t> folderNumbers;
+  if (!fs::is_directory(dirname)) {
+    return folderNumbers;
+  }
+
+  std::regex TFRegex = std::regex("DF_[0-9]+");
+  for (auto const& entry : fs::directory_iterator(dirname)) {
+    auto name = entry.path().filename().string();
+    if (entry.is_directory() && std::regex_match(name, TFRegex)) {
+      folderNumbers.emplace_back(std::stoul(name.substr(3)));
+    }
+  }
+  std::sort(folderNumbers.begin(), folderNumbers.end());
+
+  return folderNumbers;
+}
+
+} // namespace o2::framework
@@ -18,6 +18,7 @@
 #include "Framework/DataDescriptorQueryBuilder.h"
 #include "Framework/DataDescriptorMatcher.h"
 #include "Framework/DataOutputDirector.h"
+#include "Framework/ArrowFileHelpers.h"
 #include "Framework/DataProcessorSpec.h"
 #include "Framework/DataSpecUtils.h"
 #include "Framework/TableBuilder.h"
@@ -353,6 +354,14 @@ DataProcessorSpec
         // a table can be saved in multiple ways
         // e.g. different selections of columns to different files
         for (auto d : ds) {
+          // Arrow based output: the table is stored as is, merged
+          // time frames are added as additional parts of the table
+          if (dod->isArrowOutput(d)) {
+            auto folderName = dod->getArrowFolder(d, tfNumber);
+            ArrowFileHelpers::appendTable(table, folderName, d->treename, d->colnames);
+            continue;
+          }
+
           auto fileAndFolder = dod->getFileFolder(d, tfNumber);
           auto treename = fileAndFolder.folderName + d->treename;
           TableToTree ta2tr(table,
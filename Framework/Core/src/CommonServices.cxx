@@ -27,11 +27,13 @@
 #include "Framework/RawDeviceService.h"
 #include "Framework/Tracing.h"
 #include "Framework/Monitoring.h"
+#include "Framework/Expressions.h"
 #include "TextDriverClient.h"
 #include "WSDriverClient.h"
 #include "HTTPParser.h"
 #include "../src/DataProcessingStatus.h"
 #include "ArrowSupport.h"
+#include "TimeframeCreditsSupport.h"
 #include "DPLMonitoringBackend.h"
 
 #include <Configuration/ConfigurationInterface.h>
@@ -637,6 +639,14 @@ auto sendRelayerMetrics(ServiceRegistry& registry, DataProcessingStats& stats) -
   monitoring.send(Metric{(stats.lastProcessedSize / (stats.lastLatency.maxLatency ? stats.lastLatency.maxLatency : 1) / 1000), "input_rate_mb_s"}
                     .addTag(Key::Subsystem, Value::DPL));
 
+  auto gandivaStats = expressions::getGandivaCacheStats();
+  if (gandivaStats.hits + gandivaStats.misses > 0) {
+    monitoring.send(Metric{gandivaStats.hits, "gandiva/cache_hits"}.addTag(Key::Subsystem, Value::DPL));
+    monitoring.send(Metric{gandivaStats.misses, "gandiva/cache_misses"}.addTag(Key::Subsystem, Value::DPL));
+    monitoring.send(Metric{gandivaStats.entries, "gandiva/cache_entries"}.addTag(Key::Subsystem, Value::DPL));
+    monitoring.send(Metric{gandivaStats.compileTimeNs / 1000000, "gandiva/compile_time_ms"}.addTag(Key::Subsystem, Value::DPL));
+  }
+
   stats.lastSlowMetricSentTimestamp.store(stats.beginIterationTimestamp.load());
   O2_SIGNPOST_END(MonitoringStatus::ID, MonitoringStatus::SEND, 0, 0, O2_SIGNPOST_BLUE);
 };
@@ -725,6 +735,7 @@ std::vector<ServiceSpec> CommonServices::defaultServices(int numThreads)
     dataProcessingStats(),
     CommonMessageBackends::fairMQBackendSpec(),
     ArrowSupport::arrowBackendSpec(),
+    TimeframeCreditsSupport::timeframeCreditsSpec(),
     CommonMessageBackends::stringBackendSpec(),
     CommonMessageBackends::rawBufferBackendSpec()};
   if (numThreads) {
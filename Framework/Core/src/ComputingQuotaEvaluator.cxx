@@ -80,6 +80,10 @@ bool ComputingQuotaEvaluator::selectOffer(int task, ComputingQuotaRequest const&
       //      LOG(INFO) << "No particular resource was requested, so we schedule task anyways";
       return enough;
     }
+    // Timeframe credits are used once per timeframe, no need to report them.
+    if (enough && totalOffer.timeframes > 0) {
+      return enough;
+    }
     if (enough) {
       LOGP(INFO, "{} offers were selected for a total of: cpu {}, memory {}, shared memory {}", result.size(), totalOffer.cpu, totalOffer.memory, totalOffer.sharedMemory);
       LOGP(INFO, "  The following offers were selected for computation: {} ", fmt::join(result, ","));
@@ -139,6 +143,7 @@ bool ComputingQuotaEvaluator::selectOffer(int task, ComputingQuotaRequest const&
     tmp.cpu += offer.cpu;
     tmp.memory += offer.memory;
     tmp.sharedMemory += offer.sharedMemory;
+    tmp.timeframes += offer.timeframes;
     offer.score = selector(offer, tmp);
     switch (offer.score) {
       case OfferScore::Unneeded:
@@ -171,7 +176,15 @@ void ComputingQuotaEvaluator::consume(int id, ComputingQuotaConsumer& consumer)
   // This will report how much of the offers has to be considered consumed.
   // Notice that actual memory usage might be larger, because we can over
   // allocate.
-  auto reportConsumedOffer = [&totalDisposedMemory = mTotalDisposedSharedMemory, &monitoring = mRegistry.get<Monitoring>()](ComputingQuotaOffer const& accumulatedConsumed) {
+  auto reportConsumedOffer = [&totalDisposedMemory = mTotalDisposedSharedMemory,
+                              &totalConsumedTimeframes = mTotalConsumedTimeframes,
+                              &monitoring = mRegistry.get<Monitoring>()](ComputingQuotaOffer const& accumulatedConsumed) {
+    if (accumulatedConsumed.timeframes) {
+      totalConsumedTimeframes += accumulatedConsumed.timeframes;
+      monitoring.send(Metric{(uint64_t)totalConsumedTimeframes, "timeframe-credits-consumed"}.addTag(Key::Subsystem, Value::DPL));
+      monitoring.flushBuffer();
+      return;
+    }
     totalDisposedMemory += accumulatedConsumed.sharedMemory;
     monitoring.send(Metric{(uint64_t)totalDisposedMemory, "shm-offer-consumed"}.addTag(Key::Subsystem, Value::DPL));
   };
@@ -195,7 +208,7 @@ void ComputingQuotaEvaluator::dispose(int taskId)
     if (offer.valid == false) {
       continue;
     }
-    if (offer.sharedMemory <= 0) {
+    if (offer.sharedMemory <= 0 && offer.timeframes <= 0) {
       offer.valid = false;
       offer.score = OfferScore::Unneeded;
     }
@@ -9,9 +9,19 @@
 // granted to it by virtue of its status as an Intergovernmental Organization
 // or submit itself to any jurisdiction.
 #include "ComputingResourceHelpers.h"
+#include "Framework/DeviceSpec.h"
+#include "Framework/RuntimeError.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
 #include <thread>
 #include <unistd.h>
 #include <sstream>
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/syscall.h>
+#endif
 
 namespace o2::framework
 {
@@ -52,4 +62,206 @@ std::vector<ComputingResource> ComputingResourceHelpers::parseResources(std::str
   return resources;
 }
 
+std::vector<int> ComputingResourceHelpers::parseCpuList(std::string_view cpuList)
+{
+  std::vector<int> cpus;
+  while (cpuList.empty() == false) {
+    auto end = cpuList.find(',');
+    auto range = cpuList.substr(0, end);
+    cpuList.remove_prefix(end == std::string_view::npos ? cpuList.size() : end + 1);
+    while (range.empty() == false && std::isspace(range.back())) {
+      range.remove_suffix(1);
+    }
+    if (range.empty()) {
+      continue;
+    }
+    auto dash = range.find('-');
+    int first = std::stoi(std::string(range.substr(0, dash)));
+    int last = dash == std::string_view::npos ? first : std::stoi(std::string(range.substr(dash + 1)));
+    for (int cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+std::string ComputingResourceHelpers::formatCpuList(std::vector<int> const& cpus)
+{
+  auto sorted = cpus;
+  std::sort(sorted.begin(), sorted.end());
+  sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+  std::string result;
+  for (size_t ci = 0; ci < sorted.size();) {
+    size_t last = ci;
+    while (last + 1 < sorted.size() && sorted[last + 1] == sorted[last] + 1) {
+      last++;
+    }
+    if (result.empty() == false) {
+      result += ",";
+    }
+    result += std::to_string(sorted[ci]);
+    if (last != ci) {
+      result += "-" + std::to_string(sorted[last]);
+    }
+    ci = last + 1;
+  }
+  return result;
+}
+
+namespace
+{
+std::string readFirstLine(std::filesystem::path const& path)
+{
+  std::ifstream in(path);
+  std::string line;
+  std::getline(in, line);
+  return line;
+}
+} // namespace
+
+std::vector<NumaNode> ComputingResourceHelpers::readNumaTopology(std::string const& sysfsRoot)
+{
+  namespace fs = std::filesystem;
+  std::vector<NumaNode> nodes;
+  std::error_code ec;
+  for (auto& entry : fs::directory_iterator(fs::path(sysfsRoot) / "node", ec)) {
+    auto name = entry.path().filename().string();
+    if (name.size() <= 4 || name.compare(0, 4, "node") != 0 ||
+        std::all_of(name.begin() + 4, name.end(), [](char c) { return std::isdigit(c); }) == false) {
+      continue;
+    }
+    NumaNode node;
+    node.id = std::stoi(name.substr(4));
+    node.cpus = parseCpuList(readFirstLine(entry.path() / "cpulist"));
+    // Nodes with memory only are of no use to place devices.
+    if (node.cpus.empty()) {
+      continue;
+    }
+    nodes.push_back(node);
+  }
+  std::sort(nodes.begin(), nodes.end(), [](NumaNode const& a, NumaNode const& b) { return a.id < b.id; });
+  if (nodes.empty() == false) {
+    return nodes;
+  }
+  NumaNode node;
+  node.cpus = parseCpuList(readFirstLine(fs::path(sysfsRoot) / "cpu" / "online"));
+  if (node.cpus.empty()) {
+    for (unsigned int cpu = 0; cpu < std::thread::hardware_concurrency(); ++cpu) {
+      node.cpus.push_back(cpu);
+    }
+  }
+  nodes.push_back(node);
+  return nodes;
+}
+
+ComputingPlacementPolicy ComputingResourceHelpers::parsePlacementPolicy(std::string const& policy)
+{
+  if (policy.empty() || policy == "none") {
+    return ComputingPlacementPolicy::None;
+  } else if (policy == "numa") {
+    return ComputingPlacementPolicy::Numa;
+  } else if (policy == "cores") {
+    return ComputingPlacementPolicy::Cores;
+  }
+  throw runtime_error_f("Unknown placement policy %s. Valid values are none, numa, cores.", policy.c_str());
+}
+
+void ComputingResourceHelpers::assignPlacement(std::vector<NumaNode> const& nodes,
+                                               std::vector<DeviceSpec>& devices,
+                                               ComputingPlacementPolicy policy,
+                                               std::string const& hostname)
+{
+  for (auto& device : devices) {
+    device.placement = ComputingPlacement{};
+  }
+  if (policy == ComputingPlacementPolicy::None || nodes.empty()) {
+    return;
+  }
+  std::vector<std::vector<size_t>> devicesByNode(nodes.size());
+  auto assign = [&devicesByNode, &devices, &nodes](size_t di, size_t ni) {
+    devicesByNode[ni].push_back(di);
+    devices[di].placement.numaNode = nodes[ni].id;
+  };
+  // Time pipelined devices first, so that the other devices fill what is left.
+  for (size_t di = 0; di < devices.size(); ++di) {
+    if (devices[di].resource.hostname != hostname || devices[di].maxInputTimeslices <= 1) {
+      continue;
+    }
+    assign(di, devices[di].inputTimesliceId % nodes.size());
+  }
+  for (size_t di = 0; di < devices.size(); ++di) {
+    if (devices[di].resource.hostname != hostname || devices[di].maxInputTimeslices > 1) {
+      continue;
+    }
+    size_t best = 0;
+    for (size_t ni = 0; ni < nodes.size(); ++ni) {
+      if (devicesByNode[ni].size() < nodes[ni].cpus.size()) {
+        best = ni;
+        break;
+      }
+      if (devicesByNode[ni].size() * nodes[best].cpus.size() < devicesByNode[best].size() * nodes[ni].cpus.size()) {
+        best = ni;
+      }
+    }
+    assign(di, best);
+  }
+
+  for (size_t ni = 0; ni < nodes.size(); ++ni) {
+    auto& cpus = nodes[ni].cpus;
+    auto& nodeDevices = devicesByNode[ni];
+    if (nodeDevices.empty() || cpus.empty()) {
+      continue;
+    }
+    if (policy == ComputingPlacementPolicy::Numa) {
+      for (auto di : nodeDevices) {
+        devices[di].placement.cpus = cpus;
+      }
+      continue;
+    }
+    // Contiguous cores for each device. When there are more devices than
+    // cores, cores are shared round robin.
+    size_t share = std::max<size_t>(1, cpus.size() / nodeDevices.size());
+    size_t extra = cpus.size() > nodeDevices.size() ? cpus.size() % nodeDevices.size() : 0;
+    size_t next = 0;
+    for (size_t i = 0; i < nodeDevices.size(); ++i) {
+      size_t count = share + (i < extra ? 1 : 0);
+      auto& placement = devices[nodeDevices[i]].placement;
+      for (size_t ci = 0; ci < count; ++ci) {
+        placement.cpus.push_back(cpus[(next + ci) % cpus.size()]);
+      }
+      next += count;
+    }
+  }
+}
+
+bool ComputingResourceHelpers::applyPlacement(ComputingPlacement const& placement)
+{
+#if defined(__linux__)
+  bool success = true;
+  if (placement.cpus.empty() == false) {
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (auto cpu : placement.cpus) {
+      if (cpu >= 0 && cpu < CPU_SETSIZE) {
+        CPU_SET(cpu, &cpuSet);
+      }
+    }
+    success &= sched_setaffinity(0, sizeof(cpuSet), &cpuSet) == 0;
+  }
+  if (placement.numaNode >= 0) {
+    // MPOL_PREFERRED, so that we still get memory from the other
+    // nodes when ours is exhausted. Pages are placed when first touched,
+    // so this also covers the shared memory segments created by the device.
+    constexpr int mpolPreferred = 1;
+    constexpr size_t bitsPerWord = 8 * sizeof(unsigned long);
+    std::vector<unsigned long> nodeMask(placement.numaNode / bitsPerWord + 1, 0);
+    nodeMask[placement.numaNode / bitsPerWord] |= 1UL << (placement.numaNode % bitsPerWord);
+    success &= syscall(SYS_set_mempolicy, mpolPreferred, nodeMask.data(), nodeMask.size() * bitsPerWord + 1) == 0;
+  }
+  return success;
+#else
+  return placement.cpus.empty() && placement.numaNode < 0;
+#endif
+}
+
 } // namespace o2::framework
@@ -15,10 +15,13 @@
 #include "Framework/ComputingResource.h"
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace o2::framework
 {
+struct DeviceSpec;
+
 struct ComputingResourceHelpers {
   /// This will create a ComputingResource which matches what offered by localhost.
   /// Notice that the port range will always be [22000, 23000) since in any case we will
@@ -29,6 +32,33 @@ struct ComputingResourceHelpers {
   ///
   /// <hostname>:<cpu cores>:<memory in MB>:<start port>:<last port>
   static std::vector<ComputingResource> parseResources(std::string const& resourceString);
+
+  /// Parse a list of cores in the format used by the kernel, e.g. "0-3,8,10-11"
+  static std::vector<int> parseCpuList(std::string_view cpuList);
+  /// Inverse of the above
+  static std::string formatCpuList(std::vector<int> const& cpus);
+
+  /// Read the NUMA nodes of the machine and their cores from @a sysfsRoot.
+  /// Machines without NUMA information are considered as a single node.
+  static std::vector<NumaNode> readNumaTopology(std::string const& sysfsRoot = "/sys/devices/system");
+
+  static ComputingPlacementPolicy parsePlacementPolicy(std::string const& policy);
+
+  /// Assign a NUMA node and a set of cores to each of the @a devices
+  /// running on @a hostname, according to @a policy.
+  /// Lanes of time pipelined devices are distributed over the nodes, so
+  /// that the devices processing the same timeslices share a node. All the
+  /// other devices fill one node after the other, one core each, so that
+  /// chains of devices are kept on the same node as long as possible.
+  static void assignPlacement(std::vector<NumaNode> const& nodes,
+                              std::vector<DeviceSpec>& devices,
+                              ComputingPlacementPolicy policy,
+                              std::string const& hostname);
+
+  /// Pin the calling process to the cores of @a placement and make it
+  /// allocate memory, including shared memory segments it creates, on its NUMA node.
+  /// @return false if the placement could not be applied.
+  static bool applyPlacement(ComputingPlacement const& placement);
 };
 } // namespace o2::framework
 
@@ -12,8 +12,11 @@
 #include "DPLMonitoringBackend.h"
 #include "Framework/DriverClient.h"
 #include "Framework/ServiceRegistry.h"
+#include "Framework/DeviceMetricsRing.h"
 #include <fmt/format.h>
+#include <cstdlib>
 #include <sstream>
+#include <type_traits>
 
 namespace o2::framework
 {
@@ -35,11 +38,20 @@ inline unsigned long DPLMonitoringBackend::convertTimestamp(const std::chrono::t
 DPLMonitoringBackend::DPLMonitoringBackend(ServiceRegistry& registry)
   : mRegistry{registry}
 {
+  // The driver passes the shared memory ring for the metrics as an inherited
+  // file descriptor. Only one backend can be the producer for it.
+  if (char const* ringFd = getenv("DPL_METRICS_RING_FD")) {
+    mRing = DeviceMetricsRing::attach(atoi(ringFd));
+    unsetenv("DPL_METRICS_RING_FD");
+  }
 }
 
+DPLMonitoringBackend::~DPLMonitoringBackend() = default;
+
 void DPLMonitoringBackend::addGlobalTag(std::string_view name, std::string_view value)
 {
   // FIXME: tags are ignored by DPL in any case...
+  std::lock_guard<std::mutex> lock(mMutex);
   mTagString += fmt::format("{}{}={}", mTagString.empty() ? "" : ",", name.data(), value);
 }
 
@@ -50,8 +62,64 @@ void DPLMonitoringBackend::send(std::vector<o2::monitoring::Metric>&& metrics)
   }
 }
 
+bool DPLMonitoringBackend::sendBinary(o2::monitoring::Metric const& metric)
+{
+  DeviceMetricsRecord record;
+  record.timestamp = convertTimestamp(metric.getTimestamp());
+  record.type = metric.getFirstValueType();
+  std::string_view stringValue;
+  std::visit([&record, &stringValue](auto const& value) {
+    using T = std::decay_t<decltype(value)>;
+    if constexpr (std::is_same_v<T, std::string>) {
+      stringValue = value;
+    } else if constexpr (std::is_same_v<T, int>) {
+      record.intValue = value;
+    } else if constexpr (std::is_same_v<T, uint64_t>) {
+      record.uint64Value = value;
+    } else {
+      record.floatValue = value;
+    }
+  },
+             metric.getValues().front().second);
+
+  // The name is sent only the first time, afterwards the id is enough.
+  auto it = mMetricIds.try_emplace(metric.getName(), mMetricIds.size()).first;
+  if (it->second == TextOnly) {
+    return false;
+  }
+  record.id = it->second;
+  if (mAnnounced.size() <= record.id) {
+    mAnnounced.resize(record.id + 1, false);
+  }
+  // The driver dropped corrupted records, which might have included the
+  // names: send them again.
+  if (uint64_t drops = mRing->drops(); drops != mRingDrops) {
+    mRingDrops = drops;
+    mAnnounced.assign(mAnnounced.size(), false);
+  }
+  bool announce = mAnnounced[record.id] == false;
+  if (mRing->push(record, announce ? std::string_view{metric.getName()} : std::string_view{}, stringValue)) {
+    mAnnounced[record.id] = true;
+    return true;
+  }
+  // The driver processes the ring before the text, so once a metric was
+  // sent as text it stays there, not to have its values reordered.
+  it->second = TextOnly;
+  return false;
+}
+
 void DPLMonitoringBackend::send(o2::monitoring::Metric const& metric)
 {
+  // Metrics can also be sent by the resources monitoring thread.
+  std::lock_guard<std::mutex> lock(mMutex);
+  // The text protocol remains as a fallback for multi-valued metrics and
+  // for when the ring is full.
+  if (mRing && metric.getValuesSize() == 1 && sendBinary(metric)) {
+    return;
+  }
+  if (mRing && metric.getValuesSize() != 1) {
+    mMetricIds.insert_or_assign(metric.getName(), TextOnly);
+  }
   std::ostringstream mStream;
   mStream << "[METRIC] " << metric.getName();
   for (auto& value : metric.getValues()) {
@@ -12,12 +12,18 @@
 #define O2_FRAMEWORK_DPLMONITORINGBACKEND_H_
 
 #include "Monitoring/Backend.h"
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace o2::framework
 {
 
 struct ServiceRegistry;
+class DeviceMetricsRing;
 
 /// \brief Prints metrics to standard output via std::cout
 class DPLMonitoringBackend final : public o2::monitoring::Backend
@@ -27,7 +33,7 @@ class DPLMonitoringBackend final : public o2::monitoring::Backend
   DPLMonitoringBackend(ServiceRegistry& registry);
 
   /// Default destructor
-  ~DPLMonitoringBackend() override = default;
+  ~DPLMonitoringBackend() override;
 
   /// Prints metric
   /// \param metric           reference to metric object
@@ -48,9 +54,21 @@ class DPLMonitoringBackend final : public o2::monitoring::Backend
   /// \return             timestamp as unsigned long (miliseconds from epoch)
   unsigned long convertTimestamp(const std::chrono::time_point<std::chrono::system_clock>& timestamp);
 
+  /// Sends a single valued metric via the shared memory ring
+  /// \return            false if the metric needs to be sent as text
+  bool sendBinary(o2::monitoring::Metric const& metric);
+
+  /// Id of the metrics which are only sent as text
+  static constexpr uint32_t TextOnly = std::numeric_limits<uint32_t>::max();
+
   std::string mTagString;    ///< Global tagset (common for each metric)
   const std::string mPrefix; ///< Metric prefix
   ServiceRegistry& mRegistry;
+  std::unique_ptr<DeviceMetricsRing> mRing;                ///< Binary channel to the driver, if any
+  std::unordered_map<std::string, uint32_t> mMetricIds{}; ///< Ids of the metrics sent via the ring
+  std::vector<bool> mAnnounced{};                         ///< Whether the label of each id was sent since the last drop
+  uint64_t mRingDrops = 0;                                ///< Drops of corrupted records by the driver seen so far
+  std::mutex mMutex;                                      ///< The ring has a single producer, while metrics are sent from more than one thread
 };
 
 } // namespace o2::framework
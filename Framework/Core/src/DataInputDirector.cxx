@@ -9,6 +9,7 @@
 // granted to it by virtue of its status as an Intergovernmental Organization
 // or submit itself to any jurisdiction.
 #include "Framework/DataInputDirector.h"
+#include "Framework/ArrowFileHelpers.h"
 #include "Framework/DataDescriptorQueryBuilder.h"
 #include "Framework/Logger.h"
 #include "AnalysisDataModelHelpers.h"
@@ -90,8 +91,21 @@ bool DataInputDescriptor::setFile(int counter)
     return false;
   }
 
-  // open file
+  // Arrow based files are directories which are accessed per table
   auto filename = mfilenames[counter]->fileName;
+  if (ArrowFileHelpers::isArrowFilename(filename)) {
+    closeInputFile();
+    if (mfilenames[counter]->numberOfTimeFrames <= 0) {
+      mfilenames[counter]->listOfTimeFrameNumbers = ArrowFileHelpers::getTimeFrameNumbers(filename);
+      for (auto folderNumber : mfilenames[counter]->listOfTimeFrameNumbers) {
+        mfilenames[counter]->listOfTimeFrameKeys.emplace_back(filename + "/" + ArrowFileHelpers::getFolderName(folderNumber));
+      }
+      mfilenames[counter]->numberOfTimeFrames = mfilenames[counter]->listOfTimeFrameKeys.size();
+    }
+    return true;
+  }
+
+  // open file
   if (mcurrentFile) {
     if (mcurrentFile->GetName() != filename) {
       closeInputFile();
@@ -138,7 +152,7 @@ uint64_t DataInputDescriptor::getTimeFrameNumber(int counter, int numTF)
   }
 
   // no TF left
-  if (mfilenames[counter]->numberOfTimeFrames > 0 && numTF >= mfilenames[counter]->numberOfTimeFrames) {
+  if (numTF >= mfilenames[counter]->numberOfTimeFrames) {
     return 0ul;
   }
 
@@ -155,7 +169,7 @@ FileAndFolder DataInputDescriptor::getFileFolder(int counter, int numTF)
   }
 
   // no TF left
-  if (mfilenames[counter]->numberOfTimeFrames > 0 && numTF >= mfilenames[counter]->numberOfTimeFrames) {
+  if (numTF >= mfilenames[counter]->numberOfTimeFrames) {
     return fileAndFolder;
   }
 
@@ -170,6 +184,14 @@ int DataInputDescriptor::getTimeFramesInFile(int counter)
   return mfilenames.at(counter)->numberOfTimeFrames;
 }
 
+bool DataInputDescriptor::isArrowFile(int counter)
+{
+  if (counter >= getNumberInputfiles()) {
+    return false;
+  }
+  return ArrowFileHelpers::isArrowFilename(mfilenames[counter]->fileName);
+}
+
 void DataInputDescriptor::closeInputFile()
 {
   if (mcurrentFile) {
@@ -583,6 +605,46 @@ TTree* DataInputDirector::getDataTree(header::DataHeader dh, int counter, int nu
   return tree;
 }
 
+std::shared_ptr<arrow::Table> DataInputDirector::getDataTable(header::DataHeader dh, int counter, int numTF, std::vector<std::string> const& colnames)
+{
+  std::string treename;
+  std::shared_ptr<arrow::Table> table = nullptr;
+
+  auto didesc = getDataInputDescriptor(dh);
+  if (didesc) {
+    // if match then use filename and treename from DataInputDescriptor
+    treename = didesc->treename;
+  } else {
+    // if NOT match then use
+    //  . filename from defaultDataInputDescriptor
+    //  . treename from DataHeader
+    didesc = mdefaultDataInputDescriptor;
+    treename = aod::datamodel::getTreeName(dh);
+  }
+
+  auto fileAndFolder = didesc->getFileFolder(counter, numTF);
+  if (!fileAndFolder.file && !fileAndFolder.folderName.empty()) {
+    // a missing table is treated like a missing folder
+    table = ArrowFileHelpers::readTableParts(fileAndFolder.folderName, treename, colnames);
+    if (!table) {
+      LOGP(WARNING, R"(Couldn't find table "{}" in "{}")", treename, fileAndFolder.folderName);
+    }
+  }
+
+  return table;
+}
+
+bool DataInputDirector::isArrowFile(header::DataHeader dh, int counter)
+{
+  auto didesc = getDataInputDescriptor(dh);
+  // if NOT match then use defaultDataInputDescriptor
+  if (!didesc) {
+    didesc = mdefaultDataInputDescriptor;
+  }
+
+  return didesc->isArrowFile(counter);
+}
+
 void DataInputDirector::closeInputFiles()
 {
   mdefaultDataInputDescriptor->closeInputFile();
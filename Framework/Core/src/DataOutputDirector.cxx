@@ -9,12 +9,15 @@
 // granted to it by virtue of its status as an Intergovernmental Organization
 // or submit itself to any jurisdiction.
 #include "Framework/DataOutputDirector.h"
+#include "Framework/ArrowFileHelpers.h"
 #include "Framework/Logger.h"
 
 #include "rapidjson/document.h"
 #include "rapidjson/prettywriter.h"
 #include "rapidjson/filereadstream.h"
 
+#include <filesystem>
+
 namespace o2
 {
 namespace framework
@@ -143,6 +146,7 @@ void DataOutputDirector::reset()
   mtreeFilenames.clear();
   closeDataFiles();
   mfilePtrs.clear();
+  marrowFolderReady.clear();
   mfilenameBase = std::string("");
 };
 
@@ -188,6 +192,7 @@ void DataOutputDirector::readString(std::string const& keepString)
   for (auto fn : mfilenameBases) {
     mfilePtrs.emplace_back(new TFile());
   }
+  marrowFolderReady.assign(mfilenameBases.size(), false);
 }
 
 // creates a keep string from a InputSpec
@@ -456,6 +461,38 @@ FileAndFolder DataOutputDirector::getFileFolder(DataOutputDescriptor* dodesc, ui
   return fileAndFolder;
 }
 
+bool DataOutputDirector::isArrowOutput(DataOutputDescriptor* dodesc)
+{
+  return ArrowFileHelpers::isArrowFilename(dodesc->getFilenameBase());
+}
+
+std::string DataOutputDirector::getArrowFolder(DataOutputDescriptor* dodesc, uint64_t folderNumber)
+{
+  std::string folderName("");
+
+  // search dodesc->filename in mfilenameBases
+  auto it = std::find(mfilenameBases.begin(), mfilenameBases.end(), dodesc->getFilenameBase());
+  if (it != mfilenameBases.end()) {
+    int ind = std::distance(mfilenameBases.begin(), it);
+
+    // the directory takes the role of the TFile, hence it is
+    // recreated at first access if requested
+    if (!marrowFolderReady[ind]) {
+      if (mfileMode == "RECREATE") {
+        std::filesystem::remove_all(mfilenameBases[ind]);
+      }
+      std::filesystem::create_directories(mfilenameBases[ind]);
+      marrowFolderReady[ind] = true;
+    }
+
+    // check if folder DF_* exists
+    folderName = mfilenameBases[ind] + "/" + ArrowFileHelpers::getFolderName(folderNumber) + "/";
+    std::filesystem::create_directories(folderName);
+  }
+
+  return folderName;
+}
+
 void DataOutputDirector::closeDataFiles()
 {
   for (auto filePtr : mfilePtrs) {
@@ -491,6 +528,7 @@ void DataOutputDirector::setFilenameBase(std::string dfn)
   mtreeFilenames.clear();
   closeDataFiles();
   mfilePtrs.clear();
+  marrowFolderReady.clear();
 
   // loop over DataOutputDescritors
   for (auto dodesc : mDataOutputDescriptors) {
@@ -515,6 +553,7 @@ void DataOutputDirector::setFilenameBase(std::string dfn)
   for (auto fn : mfilenameBases) {
     mfilePtrs.emplace_back(new TFile());
   }
+  marrowFolderReady.assign(mfilenameBases.size(), false);
 }
 
 } // namespace framework
@@ -34,6 +34,7 @@
 #include "Framework/InputSpan.h"
 #include "Framework/Signpost.h"
 #include "Framework/SourceInfoHeader.h"
+#include "Framework/TimelineTracing.h"
 #include "Framework/Logger.h"
 #include "Framework/DriverClient.h"
 #include "Framework/Monitoring.h"
@@ -309,6 +310,12 @@ void DataProcessingDevice::Init()
   });
 }
 
+void on_timeline_signal_callback(uv_signal_t* handle, int)
+{
+  auto* spec = (DeviceSpec const*)handle->data;
+  TimelineTracing::dumpDeviceTimeline(spec->id);
+}
+
 void on_signal_callback(uv_signal_t* handle, int signum)
 {
   ZoneScopedN("Signal callaback");
@@ -401,6 +408,12 @@ void DataProcessingDevice::InitTask()
   sigusr1Handle->data = &mDeviceContext;
   uv_signal_start(sigusr1Handle, on_signal_callback, SIGUSR1);
 
+  // SIGUSR2 dumps the timeline of the device, in Chrome trace format.
+  uv_signal_t* sigusr2Handle = (uv_signal_t*)malloc(sizeof(uv_signal_t));
+  uv_signal_init(mState.loop, sigusr2Handle);
+  sigusr2Handle->data = const_cast<DeviceSpec*>(&mSpec);
+  uv_signal_start(sigusr2Handle, on_timeline_signal_callback, SIGUSR2);
+
   // We add a timer only in case a channel poller is not there.
   if ((mStatefulProcess != nullptr) || (mStatelessProcess != nullptr)) {
     for (auto& x : fChannels) {
@@ -909,6 +922,8 @@ void DataProcessingDevice::handleData(DataProcessorContext& context, InputChanne
           auto payloadIndex = 2 * pi + 1;
           assert(payloadIndex < parts.Size());
           auto dh = o2::header::get<DataHeader*>(parts.At(headerIndex)->GetData());
+          auto dph = o2::header::get<DataProcessingHeader*>(parts.At(headerIndex)->GetData());
+          TimelineScope relayScope{TimelineEventKind::Relay, dph ? dph->startTime : 0};
           auto relayed = relayer.relay(parts.At(headerIndex),
                                        &parts.At(payloadIndex), dh->splitPayloadParts > 0 ? dh->splitPayloadParts * 2 - 1 : 0);
           pi += dh->splitPayloadParts > 0 ? dh->splitPayloadParts - 1 : 0;
@@ -1194,6 +1209,7 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
       assert(channelParts.Size() % 2 == 0);
       assert(o2::header::get<DataProcessingHeader*>(channelParts.At(0)->GetData()));
       // in DPL we are using subchannel 0 only
+      TimelineScope sendScope{TimelineEventKind::Send};
       device->Send(channelParts, channelName, 0);
     }
   };
@@ -1241,6 +1257,7 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
     }
 
     prepareAllocatorForCurrentTimeSlice(TimesliceSlot{action.slot});
+    TimelineScope dispatchScope{TimelineEventKind::Dispatch, context.timingInfo->timeslice};
     InputSpan span = getInputSpan(action.slot);
     InputRecord record{context.deviceContext->spec->inputs, span};
     ProcessingContext processContext{record, *context.registry, *context.allocator};
@@ -1266,10 +1283,12 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
       if (context.deviceContext->state->quitRequested == false) {
         if (*context.statefulProcess) {
           ZoneScopedN("statefull process");
+          TimelineScope processScope{TimelineEventKind::Process};
           (*context.statefulProcess)(processContext);
         }
         if (*context.statelessProcess) {
           ZoneScopedN("stateless process");
+          TimelineScope processScope{TimelineEventKind::Process};
           (*context.statelessProcess)(processContext);
         }
 
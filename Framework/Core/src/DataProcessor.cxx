@@ -15,6 +15,7 @@
 #include "Framework/RawBufferContext.h"
 #include "Framework/TMessageSerializer.h"
 #include "Framework/ServiceRegistry.h"
+#include "Framework/TimelineTracing.h"
 #include "FairMQResizableBuffer.h"
 #include "CommonUtils/BoostSerializer.h"
 #include "Headers/DataHeader.h"
@@ -36,6 +37,7 @@ namespace o2::framework
 
 void DataProcessor::doSend(FairMQDevice& device, FairMQParts&& parts, const char* channel, unsigned int index)
 {
+  TimelineScope sendScope{TimelineEventKind::Send};
   device.Send(parts, channel, index);
 }
 
@@ -43,16 +45,24 @@ void DataProcessor::doSend(FairMQDevice& device, MessageContext& context, Servic
 {
   std::unordered_map<std::string const*, FairMQParts> outputs;
   auto contextMessages = context.getMessagesForSending();
-  for (auto& message : contextMessages) {
-    //     monitoringService.send({ message->parts.Size(), "outputs/total" });
-    FairMQParts parts = std::move(message->finalize());
-    assert(message->empty());
-    assert(parts.Size() == 2);
-    for (auto& part : parts) {
-      outputs[&(message->channel())].AddPart(std::move(part));
+  if (contextMessages.empty()) {
+    return;
+  }
+  {
+    // Finalising the messages is where ROOT serialised objects are streamed.
+    TimelineScope serialiseScope{TimelineEventKind::Serialise};
+    for (auto& message : contextMessages) {
+      //     monitoringService.send({ message->parts.Size(), "outputs/total" });
+      FairMQParts parts = std::move(message->finalize());
+      assert(message->empty());
+      assert(parts.Size() == 2);
+      for (auto& part : parts) {
+        outputs[&(message->channel())].AddPart(std::move(part));
+      }
     }
   }
   for (auto& [channel, parts] : outputs) {
+    TimelineScope sendScope{TimelineEventKind::Send};
     device.Send(parts, *channel, 0);
   }
 }
@@ -72,6 +82,7 @@ void DataProcessor::doSend(FairMQDevice& device, StringContext& context, Service
     dh->payloadSize = payload->GetSize();
     parts.AddPart(std::move(messageRef.header));
     parts.AddPart(std::move(payload));
+    TimelineScope sendScope{TimelineEventKind::Send};
     device.Send(parts, messageRef.channel, 0);
   }
 }
@@ -86,11 +97,14 @@ void DataProcessor::doSend(FairMQDevice& device, ArrowContext& context, ServiceR
 
   for (auto& messageRef : context) {
     FairMQParts parts;
-    // Depending on how the arrow table is constructed, we finalize
-    // the writing here.
-    messageRef.finalize(messageRef.buffer);
-
-    std::unique_ptr<FairMQMessage> payload = messageRef.buffer->Finalise();
+    std::unique_ptr<FairMQMessage> payload;
+    {
+      TimelineScope serialiseScope{TimelineEventKind::Serialise};
+      // Depending on how the arrow table is constructed, we finalize
+      // the writing here.
+      messageRef.finalize(messageRef.buffer);
+      payload = messageRef.buffer->Finalise();
+    }
     // FIXME: for the moment we simply send empty bodies.
     const DataHeader* cdh = o2::header::get<DataHeader*>(messageRef.header->GetData());
     // sigh... See if we can avoid having it const by not
@@ -104,6 +118,7 @@ void DataProcessor::doSend(FairMQDevice& device, ArrowContext& context, ServiceR
     context.updateMessagesSent(1);
     parts.AddPart(std::move(messageRef.header));
     parts.AddPart(std::move(payload));
+    TimelineScope sendScope{TimelineEventKind::Send};
     device.Send(parts, messageRef.channel, 0);
   }
   static int64_t previousBytesSent = 0;
@@ -137,11 +152,15 @@ void DataProcessor::doSend(FairMQDevice& device, RawBufferContext& context, Serv
   for (auto& messageRef : context) {
     FairMQParts parts;
     FairMQMessagePtr payload(device.NewMessage());
-    auto buffer = messageRef.serializeMsg().str();
-    // Rebuild the message using the serialized ostringstream as input. For now it involves a copy.
-    size_t size = buffer.length();
-    payload->Rebuild(size);
-    std::memcpy(payload->GetData(), buffer.c_str(), size);
+    size_t size = 0;
+    {
+      TimelineScope serialiseScope{TimelineEventKind::Serialise};
+      auto buffer = messageRef.serializeMsg().str();
+      // Rebuild the message using the serialized ostringstream as input. For now it involves a copy.
+      size = buffer.length();
+      payload->Rebuild(size);
+      std::memcpy(payload->GetData(), buffer.c_str(), size);
+    }
     const DataHeader* cdh = o2::header::get<DataHeader*>(messageRef.header->GetData());
     // sigh... See if we can avoid having it const by not
     // exposing it to the user in the first place.
@@ -149,6 +168,7 @@ void DataProcessor::doSend(FairMQDevice& device, RawBufferContext& context, Serv
     dh->payloadSize = size;
     parts.AddPart(std::move(messageRef.header));
     parts.AddPart(std::move(payload));
+    TimelineScope sendScope{TimelineEventKind::Send};
     device.Send(parts, messageRef.channel, 0);
   }
 }
@@ -10,6 +10,8 @@
 // or submit itself to any jurisdiction.
 
 #include "Framework/DeviceMetricsHelper.h"
+#include "Framework/DeviceMetricsRing.h"
+#include "Framework/Logger.h"
 #include "Framework/RuntimeError.h"
 #include <cassert>
 #include <cinttypes>
@@ -171,23 +173,29 @@ size_t DeviceMetricsHelper::bookMetricInfo(DeviceMetricsInfo& info, char const*
 bool DeviceMetricsHelper::processMetric(ParsedMetricMatch& match,
                                         DeviceMetricsInfo& info,
                                         DeviceMetricsHelper::NewMetricCallback newMetricsCallback)
+{
+  size_t metricIndex = findOrCreateMetric(match, info, newMetricsCallback);
+  if (metricIndex == (size_t)-1) {
+    return false;
+  }
+  return storeMetric(metricIndex, match, info);
+}
+
+size_t DeviceMetricsHelper::findOrCreateMetric(ParsedMetricMatch const& match,
+                                               DeviceMetricsInfo& info,
+                                               DeviceMetricsHelper::NewMetricCallback newMetricsCallback)
 {
   // get the type
   size_t metricIndex = -1;
 
-  StringMetric stringValue;
   switch (match.type) {
     case MetricType::Float:
     case MetricType::Int:
     case MetricType::Uint64:
+    case MetricType::String:
       break;
-    case MetricType::String: {
-      auto lastChar = std::min(match.endStringValue - match.beginStringValue, StringMetric::MAX_SIZE - 1);
-      memcpy(stringValue.data, match.beginStringValue, lastChar);
-      stringValue.data[lastChar] = '\0';
-    } break;
     default:
-      return false;
+      return -1;
       break;
   };
 
@@ -231,7 +239,7 @@ bool DeviceMetricsHelper::processMetric(ParsedMetricMatch& match,
         break;
 
       default:
-        return false;
+        return -1;
     };
     // Add the timestamp buffer for it
     info.timestamps.emplace_back(std::array<size_t, 1024>{});
@@ -265,25 +273,35 @@ bool DeviceMetricsHelper::processMetric(ParsedMetricMatch& match,
   } else {
     metricIndex = mi->index;
   }
+  return metricIndex;
+}
+
+bool DeviceMetricsHelper::storeMetric(size_t metricIndex,
+                                      ParsedMetricMatch const& match,
+                                      DeviceMetricsInfo& info)
+{
   assert(metricIndex != -1);
   // We are now guaranteed our metric is present at metricIndex.
   MetricInfo& metricInfo = info.metrics[metricIndex];
 
+  StringMetric stringValue;
+  if (metricInfo.type == MetricType::String) {
+    auto lastChar = std::min(match.endStringValue - match.beginStringValue, StringMetric::MAX_SIZE - 1);
+    memcpy(stringValue.data, match.beginStringValue, lastChar);
+    stringValue.data[lastChar] = '\0';
+  }
+
   //  auto mod = info.timestamps[metricIndex].size();
   info.minDomain[metricIndex] = std::min(info.minDomain[metricIndex], (size_t)match.timestamp);
   info.maxDomain[metricIndex] = std::max(info.maxDomain[metricIndex], (size_t)match.timestamp);
 
   switch (metricInfo.type) {
     case MetricType::Int: {
-      info.intMetrics[metricInfo.storeIdx][metricInfo.pos] = match.intValue;
       info.max[metricIndex] = std::max(info.max[metricIndex], (float)match.intValue);
       info.min[metricIndex] = std::min(info.min[metricIndex], (float)match.intValue);
       // Save the timestamp for the current metric we do it here
       // so that we do not update timestamps for broken metrics
-      info.timestamps[metricIndex][metricInfo.pos] = match.timestamp;
-      // Update the position where to write the next metric
-      metricInfo.pos = (metricInfo.pos + 1) % info.intMetrics[metricInfo.storeIdx].size();
-      ++metricInfo.filledMetrics;
+      appendNumericMetric(metricInfo, info.intMetrics[metricInfo.storeIdx], info.timestamps[metricIndex], match.intValue, match.timestamp);
     } break;
     case MetricType::String: {
       info.stringMetrics[metricInfo.storeIdx][metricInfo.pos] = stringValue;
@@ -294,25 +312,18 @@ bool DeviceMetricsHelper::processMetric(ParsedMetricMatch& match,
       ++metricInfo.filledMetrics;
     } break;
     case MetricType::Float: {
-      info.floatMetrics[metricInfo.storeIdx][metricInfo.pos] = match.floatValue;
       info.max[metricIndex] = std::max(info.max[metricIndex], match.floatValue);
       info.min[metricIndex] = std::min(info.min[metricIndex], match.floatValue);
       // Save the timestamp for the current metric we do it here
       // so that we do not update timestamps for broken metrics
-      info.timestamps[metricIndex][metricInfo.pos] = match.timestamp;
-      metricInfo.pos = (metricInfo.pos + 1) % info.floatMetrics[metricInfo.storeIdx].size();
-      ++metricInfo.filledMetrics;
+      appendNumericMetric(metricInfo, info.floatMetrics[metricInfo.storeIdx], info.timestamps[metricIndex], match.floatValue, match.timestamp);
     } break;
     case MetricType::Uint64: {
-      info.uint64Metrics[metricInfo.storeIdx][metricInfo.pos] = match.uint64Value;
       info.max[metricIndex] = std::max(info.max[metricIndex], (float)match.uint64Value);
       info.min[metricIndex] = std::min(info.min[metricIndex], (float)match.uint64Value);
       // Save the timestamp for the current metric we do it here
       // so that we do not update timestamps for broken metrics
-      info.timestamps[metricIndex][metricInfo.pos] = match.timestamp;
-      // Update the position where to write the next metric
-      metricInfo.pos = (metricInfo.pos + 1) % info.uint64Metrics[metricInfo.storeIdx].size();
-      ++metricInfo.filledMetrics;
+      appendNumericMetric(metricInfo, info.uint64Metrics[metricInfo.storeIdx], info.timestamps[metricIndex], match.uint64Value, match.timestamp);
     } break;
 
     default:
@@ -324,6 +335,63 @@ bool DeviceMetricsHelper::processMetric(ParsedMetricMatch& match,
   return true;
 }
 
+size_t DeviceMetricsHelper::processMetricsRing(DeviceMetricsRing& ring,
+                                               std::vector<size_t>& metricIndices,
+                                               DeviceMetricsInfo& info,
+                                               NewMetricCallback newMetricCallback)
+{
+  uint64_t drops = ring.drops();
+  size_t unresolved = 0;
+  size_t count = ring.consume([&metricIndices, &info, &newMetricCallback, &unresolved](DeviceMetricsRecord const& record, std::string_view label, std::string_view stringValue) {
+    ParsedMetricMatch match;
+    match.beginKey = label.data();
+    match.endKey = label.data() + label.size();
+    match.timestamp = record.timestamp;
+    match.type = static_cast<MetricType>(record.type);
+    match.intValue = 0;
+    switch (match.type) {
+      case MetricType::Int:
+        match.intValue = record.intValue;
+        break;
+      case MetricType::Float:
+        match.floatValue = record.floatValue;
+        break;
+      case MetricType::Uint64:
+        match.uint64Value = record.uint64Value;
+        break;
+      case MetricType::String:
+        match.beginStringValue = stringValue.data();
+        match.endStringValue = stringValue.data() + stringValue.size();
+        break;
+      default:
+        return;
+    }
+
+    // The label is only sent the first time a metric is used by the
+    // device, later on we can skip the lookup by name.
+    if (label.empty() == false) {
+      if (metricIndices.size() <= record.id) {
+        metricIndices.resize(record.id + 1, -1);
+      }
+      metricIndices[record.id] = findOrCreateMetric(match, info, newMetricCallback);
+    }
+    if (record.id >= metricIndices.size() || metricIndices[record.id] == (size_t)-1) {
+      unresolved++;
+      return;
+    }
+    storeMetric(metricIndices[record.id], match, info);
+  });
+  // The device sends the labels again once it notices the drop, until then
+  // the values of the metrics whose label was lost cannot be stored.
+  if (ring.drops() != drops) {
+    LOGP(WARNING, "Dropped corrupted records from a metrics ring");
+  }
+  if (unresolved) {
+    LOGP(WARNING, "Discarded {} values of metrics whose label is unknown", unresolved);
+  }
+  return count;
+}
+
 size_t DeviceMetricsHelper::metricIdxByName(const std::string& name, const DeviceMetricsInfo& info)
 {
   size_t i = 0;
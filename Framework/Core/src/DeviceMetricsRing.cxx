@@ -0,0 +1,139 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/DeviceMetricsRing.h"
+#include "Framework/Logger.h"
+
+#include <fmt/format.h>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace o2::framework
+{
+
+DeviceMetricsRing::DeviceMetricsRing(int fd, void* mapping, size_t size)
+  : mFd{fd},
+    mMapping{mapping},
+    mMappingSize{size},
+    mHeader{reinterpret_cast<Header*>(mapping)},
+    mData{reinterpret_cast<char*>(mapping) + sizeof(Header)},
+    mCapacity{mHeader->capacity}
+{
+}
+
+DeviceMetricsRing::~DeviceMetricsRing()
+{
+  munmap(mMapping, mMappingSize);
+  close(mFd);
+}
+
+std::unique_ptr<DeviceMetricsRing> DeviceMetricsRing::create(size_t capacity)
+{
+  size_t dataSize = 4096;
+  while (dataSize < capacity) {
+    dataSize *= 2;
+  }
+  static int ringCount = 0;
+  auto name = fmt::format("/dpl-metrics-{}-{}", getpid(), ringCount++);
+  int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) {
+    LOGP(WARNING, "Unable to create shared memory metrics ring {}: {}", name, strerror(errno));
+    return nullptr;
+  }
+  // Only the file descriptor is used from now on.
+  shm_unlink(name.c_str());
+  // Only the device which is meant to use the ring should inherit it.
+  fcntl(fd, F_SETFD, fcntl(fd, F_GETFD) | FD_CLOEXEC);
+  size_t size = sizeof(Header) + dataSize;
+  if (ftruncate(fd, size) != 0) {
+    LOGP(WARNING, "Unable to allocate {} bytes for metrics ring: {}", size, strerror(errno));
+    close(fd);
+    return nullptr;
+  }
+  void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (mapping == MAP_FAILED) {
+    LOGP(WARNING, "Unable to map metrics ring: {}", strerror(errno));
+    close(fd);
+    return nullptr;
+  }
+  auto* header = new (mapping) Header;
+  header->head.store(0, std::memory_order_relaxed);
+  header->tail.store(0, std::memory_order_relaxed);
+  header->drops.store(0, std::memory_order_relaxed);
+  header->capacity = dataSize;
+  return std::unique_ptr<DeviceMetricsRing>(new DeviceMetricsRing(fd, mapping, size));
+}
+
+std::unique_ptr<DeviceMetricsRing> DeviceMetricsRing::attach(int fd)
+{
+  struct stat sb;
+  if (fstat(fd, &sb) != 0 || (size_t)sb.st_size <= sizeof(Header)) {
+    LOGP(WARNING, "Invalid metrics ring file descriptor {}", fd);
+    return nullptr;
+  }
+  size_t size = sb.st_size;
+  void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (mapping == MAP_FAILED) {
+    LOGP(WARNING, "Unable to map metrics ring: {}", strerror(errno));
+    return nullptr;
+  }
+  auto* header = reinterpret_cast<Header*>(mapping);
+  if (header->capacity + sizeof(Header) != size || (header->capacity & (header->capacity - 1)) != 0) {
+    LOGP(WARNING, "Corrupted metrics ring header");
+    munmap(mapping, size);
+    return nullptr;
+  }
+  fcntl(fd, F_SETFD, fcntl(fd, F_GETFD) | FD_CLOEXEC);
+  return std::unique_ptr<DeviceMetricsRing>(new DeviceMetricsRing(fd, mapping, size));
+}
+
+bool DeviceMetricsRing::push(DeviceMetricsRecord const& record, std::string_view label, std::string_view stringValue)
+{
+  constexpr size_t alignment = alignof(DeviceMetricsRecord);
+  size_t payloadSize = label.size() + stringValue.size();
+  size_t size = (sizeof(DeviceMetricsRecord) + payloadSize + alignment - 1) & ~(alignment - 1);
+  if (label.size() > UINT16_MAX || stringValue.size() > UINT16_MAX || size > mCapacity / 2) {
+    return false;
+  }
+  uint64_t head = mHeader->head.load(std::memory_order_relaxed);
+  uint64_t const tail = mHeader->tail.load(std::memory_order_acquire);
+  size_t offset = head & (mCapacity - 1);
+  // Records are never split: if it does not fit at the end, we skip to the beginning.
+  size_t padding = mCapacity - offset < size ? mCapacity - offset : 0;
+  if (head + padding + size - tail > mCapacity) {
+    return false;
+  }
+  if (padding >= sizeof(DeviceMetricsRecord)) {
+    DeviceMetricsRecord skip;
+    skip.size = padding;
+    skip.type = DeviceMetricsRecord::PADDING;
+    memcpy(mData + offset, &skip, sizeof(skip));
+  }
+  head += padding;
+  offset = head & (mCapacity - 1);
+
+  DeviceMetricsRecord header = record;
+  header.size = size;
+  header.labelSize = label.size();
+  header.stringSize = stringValue.size();
+  char* dest = mData + offset;
+  memcpy(dest, &header, sizeof(header));
+  memcpy(dest + sizeof(header), label.data(), label.size());
+  memcpy(dest + sizeof(header) + label.size(), stringValue.data(), stringValue.size());
+  mHeader->head.store(head + size, std::memory_order_release);
+  return true;
+}
+
+} // namespace o2::framework
@@ -10,6 +10,7 @@
 // or submit itself to any jurisdiction.
 #include "DeviceSpecHelpers.h"
 #include "ChannelSpecHelpers.h"
+#include "ComputingResourceHelpers.h"
 #include <wordexp.h>
 #include <algorithm>
 #include <boost/program_options.hpp>
@@ -1217,6 +1218,17 @@ void DeviceSpecHelpers::prepareArguments(bool defaultQuiet, bool defaultStopped,
       tmpArgs.emplace_back(std::to_string(spec.resourceMonitoringInterval));
     }
 
+    // The device pins itself, so that the placement is also honoured
+    // when started by DDS or O2Control.
+    if (spec.placement.cpus.empty() == false) {
+      tmpArgs.emplace_back(std::string("--cpu-affinity"));
+      tmpArgs.emplace_back(ComputingResourceHelpers::formatCpuList(spec.placement.cpus));
+    }
+    if (spec.placement.numaNode >= 0) {
+      tmpArgs.emplace_back(std::string("--numa-node"));
+      tmpArgs.emplace_back(std::to_string(spec.placement.numaNode));
+    }
+
     // We create the final option list, depending on the channels
     // which are present in a device.
     for (auto& arg : tmpArgs) {
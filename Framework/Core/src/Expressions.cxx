@@ -21,6 +21,8 @@
 #include <unordered_map>
 #include <set>
 #include <algorithm>
+#include <chrono>
+#include <mutex>
 
 using namespace o2::framework;
 
@@ -320,43 +322,120 @@ gandiva::ExpressionPtr makeExpression(gandiva::NodePtr node, gandiva::FieldPtr r
   return gandiva::TreeExprBuilder::MakeExpression(node, result);
 }
 
+namespace
+{
+/// Process-wide store of the compiled gandiva modules. The LLVM compilation
+/// is by far the most expensive step, so filters and projectors are shared
+/// between all the tables, tasks and dataframes of a device which use the
+/// same expression on the same schema.
+struct GandivaCache {
+  std::mutex mutex;
+  std::unordered_map<std::string, std::shared_ptr<gandiva::Filter>> filters;
+  std::unordered_map<std::string, std::shared_ptr<gandiva::Projector>> projectors;
+  GandivaCacheStats stats;
+};
+
+GandivaCache& gandivaCache()
+{
+  static GandivaCache cache;
+  return cache;
+}
+
+/// The key is made of the schema fields and of the full expression tree,
+/// which includes the current values of the placeholders.
+std::string cacheKey(gandiva::SchemaPtr const& Schema, std::string const& expressions)
+{
+  return Schema->ToString() + "\n" + expressions;
+}
+
+template <typename T, typename F>
+std::shared_ptr<T> getOrCompile(std::unordered_map<std::string, std::shared_ptr<T>>& store, std::string&& key, F&& compile)
+{
+  auto& cache = gandivaCache();
+  {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    auto it = store.find(key);
+    if (it != store.end()) {
+      ++cache.stats.hits;
+      return it->second;
+    }
+  }
+  // compilation happens outside the lock, so that different
+  // expressions can be compiled concurrently
+  auto start = std::chrono::steady_clock::now();
+  auto compiled = compile();
+  auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  ++cache.stats.misses;
+  cache.stats.compileTimeNs += elapsed;
+  // if the same module was compiled meanwhile, the first one is kept
+  return store.emplace(std::move(key), std::move(compiled)).first->second;
+}
+} // namespace
+
+GandivaCacheStats getGandivaCacheStats()
+{
+  auto& cache = gandivaCache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  auto stats = cache.stats;
+  stats.entries = cache.filters.size() + cache.projectors.size();
+  return stats;
+}
+
+void clearGandivaCache()
+{
+  auto& cache = gandivaCache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  cache.filters.clear();
+  cache.projectors.clear();
+  cache.stats = GandivaCacheStats{};
+}
+
 std::shared_ptr<gandiva::Filter>
   createFilter(gandiva::SchemaPtr const& Schema, Operations const& opSpecs)
 {
-  std::shared_ptr<gandiva::Filter> filter;
-  auto s = gandiva::Filter::Make(Schema,
-                                 makeCondition(createExpressionTree(opSpecs, Schema)),
-                                 &filter);
-  if (!s.ok()) {
-    throw runtime_error_f("Failed to create filter: %s", s.ToString().c_str());
-  }
-  return filter;
+  return createFilter(Schema, makeCondition(createExpressionTree(opSpecs, Schema)));
 }
 
 std::shared_ptr<gandiva::Filter>
   createFilter(gandiva::SchemaPtr const& Schema, gandiva::ConditionPtr condition)
 {
-  std::shared_ptr<gandiva::Filter> filter;
-  auto s = gandiva::Filter::Make(Schema,
-                                 condition,
-                                 &filter);
-  if (!s.ok()) {
-    throw runtime_error_f("Failed to create filter: %s", s.ToString().c_str());
-  }
-  return filter;
+  return getOrCompile(gandivaCache().filters, cacheKey(Schema, condition->ToString()), [&Schema, &condition]() {
+    std::shared_ptr<gandiva::Filter> filter;
+    auto s = gandiva::Filter::Make(Schema,
+                                   condition,
+                                   &filter);
+    if (!s.ok()) {
+      throw runtime_error_f("Failed to create filter: %s", s.ToString().c_str());
+    }
+    return filter;
+  });
 }
 
 std::shared_ptr<gandiva::Projector>
   createProjector(gandiva::SchemaPtr const& Schema, Operations const& opSpecs, gandiva::FieldPtr result)
 {
-  std::shared_ptr<gandiva::Projector> projector;
-  auto s = gandiva::Projector::Make(Schema,
-                                    {makeExpression(createExpressionTree(opSpecs, Schema), result)},
-                                    &projector);
-  if (!s.ok()) {
-    throw runtime_error_f("Failed to create projector: %s", s.ToString().c_str());
+  return createProjector(Schema, gandiva::ExpressionVector{makeExpression(createExpressionTree(opSpecs, Schema), result)});
+}
+
+std::shared_ptr<gandiva::Projector>
+  createProjector(gandiva::SchemaPtr const& Schema, gandiva::ExpressionVector const& expressions)
+{
+  std::string key;
+  for (auto& expression : expressions) {
+    key += expression->result()->ToString() + " = " + expression->ToString() + "\n";
   }
-  return projector;
+  return getOrCompile(gandivaCache().projectors, cacheKey(Schema, key), [&Schema, &expressions]() {
+    std::shared_ptr<gandiva::Projector> projector;
+    auto s = gandiva::Projector::Make(Schema,
+                                      expressions,
+                                      &projector);
+    if (!s.ok()) {
+      throw runtime_error_f("Failed to create projector: %s", s.ToString().c_str());
+    }
+    return projector;
+  });
 }
 
 std::shared_ptr<gandiva::Projector>
@@ -27,6 +27,7 @@ HistogramRegistry::HistogramRegistry(char const* const name, std::vector<Histogr
   : mName(name), mPolicy(policy), mRegistryKey(), mRegistryValue(), mSortHistos(sortHistos), mCreateRegistryDir(createRegistryDir)
 {
   mRegistryKey.fill(0u);
+  mFillBufferArgs.fill(0);
   for (auto& histSpec : histSpecs) {
     insert(histSpec);
   }
@@ -385,4 +386,79 @@ void HistogramRegistry::registerName(const std::string& name)
   mRegisteredNames.push_back(name);
 }
 
+std::atomic<uint64_t> HistogramRegistry::ThreadLocalHists::nextId{1};
+
+void HistogramRegistry::flush()
+{
+  for (uint32_t idx = 0; idx < MAX_REGISTRY_SIZE; ++idx) {
+    flushBuffer(idx);
+  }
+  mergeThreadLocal();
+}
+
+void HistogramRegistry::flushBuffer(uint32_t idx)
+{
+  auto& buffer = mFillBuffer[idx];
+  if (buffer.empty()) {
+    return;
+  }
+  const int nArgs = mFillBufferArgs[idx];
+  std::visit([&](auto&& hist) { HistFiller::fillHistAnyN(hist, nArgs, buffer.size() / nArgs, buffer.data()); }, mRegistryValue[idx]);
+  buffer.clear();
+}
+
+HistPtr& HistogramRegistry::getThreadLocal(uint32_t idx)
+{
+  // cache the copies of the calling thread to avoid taking the lock for every fill
+  thread_local uint64_t cachedId{0};
+  thread_local std::array<HistPtr, MAX_REGISTRY_SIZE>* cachedHists{nullptr};
+  if (O2_BUILTIN_UNLIKELY(cachedId != mThreadLocalHists->id)) {
+    std::lock_guard<std::mutex> lock(mThreadLocalHists->mutex);
+    auto& hists = mThreadLocalHists->hists[std::this_thread::get_id()];
+    if (!hists) {
+      hists = std::make_unique<std::array<HistPtr, MAX_REGISTRY_SIZE>>();
+    }
+    cachedHists = hists.get();
+    cachedId = mThreadLocalHists->id;
+  }
+
+  auto& local = (*cachedHists)[idx];
+  if (std::visit([](auto&& hist) { return hist == nullptr; }, local)) {
+    std::lock_guard<std::mutex> lock(mThreadLocalHists->mutex);
+    std::visit([&local](auto&& hist) {
+      using T = typename std::decay_t<decltype(hist)>::element_type;
+      if constexpr (std::is_base_of_v<StepTHn, T>) {
+        LOGF(FATAL, "Thread-local filling is not (yet?) supported for StepTHn.");
+      } else {
+        auto copy = std::shared_ptr<T>(static_cast<T*>(hist->Clone()));
+        copy->Reset();
+        if constexpr (std::is_base_of_v<TH1, T>) {
+          copy->SetDirectory(nullptr);
+        }
+        local = copy;
+      }
+    },
+               mRegistryValue[idx]);
+  }
+  return local;
+}
+
+void HistogramRegistry::mergeThreadLocal()
+{
+  std::lock_guard<std::mutex> lock(mThreadLocalHists->mutex);
+  for (auto& [threadId, hists] : mThreadLocalHists->hists) {
+    for (uint32_t idx = 0; idx < MAX_REGISTRY_SIZE; ++idx) {
+      std::visit([](auto&& target, auto&& local) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(target)>, std::decay_t<decltype(local)>> && !std::is_base_of_v<StepTHn, typename std::decay_t<decltype(target)>::element_type>) {
+          if (target && local && local->GetEntries() > 0) {
+            target->Add(local.get());
+            local->Reset();
+          }
+        }
+      },
+                 mRegistryValue[idx], (*hists)[idx]);
+    }
+  }
+}
+
 } // namespace o2::framework
@@ -20,6 +20,7 @@ std::vector<ResourcePolicy> ResourcePolicy::createDefaultPolicies()
 {
   return {
     ResourcePolicyHelpers::sharedMemoryBoundTask("internal-dpl-aod-reader.*", 300000000),
+    ResourcePolicyHelpers::timeframeBoundTask("raw-file-reader|ctf-reader"),
     ResourcePolicyHelpers::trivialTask(".*")};
 }
 
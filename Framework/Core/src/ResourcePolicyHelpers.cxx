@@ -19,6 +19,8 @@
 namespace o2::framework
 {
 
+const DataProcessorLabel timeframeCreditsConsumerLabel = {"timeframe-credits-consumer"};
+
 /// A trivial task is a task which will execute regardless of
 /// the resources available.
 ResourcePolicy ResourcePolicyHelpers::trivialTask(char const* s)
@@ -55,4 +57,19 @@ ResourcePolicy ResourcePolicyHelpers::sharedMemoryBoundTask(char const* s, int r
       return accumulated.sharedMemory >= requestedSharedMemory ? OfferScore::Enough : OfferScore::More; }};
 }
 
+ResourcePolicy ResourcePolicyHelpers::timeframeBoundTask(char const* s)
+{
+  return ResourcePolicy{
+    "timeframe-bound",
+    [matcher = std::regex(s)](DeviceSpec const& spec) -> bool {
+      return std::regex_match(spec.name, matcher);
+    },
+    [](ComputingQuotaOffer const& offer, ComputingQuotaOffer const& accumulated) -> OfferScore {
+      if (offer.timeframes <= 0) {
+        return OfferScore::Unneeded;
+      }
+      return OfferScore::Enough;
+    }};
+}
+
 } // namespace o2::framework
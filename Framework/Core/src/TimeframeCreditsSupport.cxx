@@ -0,0 +1,335 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "TimeframeCreditsSupport.h"
+#include "Framework/CommonServices.h"
+#include "Framework/ServiceRegistry.h"
+#include "Framework/DeviceSpec.h"
+#include "Framework/ResourcePolicyHelpers.h"
+#include "Framework/DeviceState.h"
+#include "Framework/DeviceMetricsInfo.h"
+#include "Framework/DeviceMetricsHelper.h"
+#include "Framework/DeviceInfo.h"
+#include "Framework/DevicesManager.h"
+#include "Framework/ComputingQuotaOffer.h"
+#include "Framework/ProcessingContext.h"
+#include "Framework/Monitoring.h"
+#include "Framework/TypeIdHelpers.h"
+#include "Framework/InputRecord.h"
+#include "Framework/DataProcessingHeader.h"
+#include "Framework/RuntimeError.h"
+#include "Framework/Logger.h"
+#include "Headers/DataHeader.h"
+#include <Monitoring/Monitoring.h>
+
+#include <options/FairMQProgOptions.h>
+#include <boost/program_options/variables_map.hpp>
+#include <fmt/format.h>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <map>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace o2::framework
+{
+
+struct TimeframeCreditsConfig {
+  /// Maximum number of timeframes in flight, 0 means no limit.
+  int64_t maxInFlight = 0;
+  /// Regular expression matching the names of the processors which see every timeframe
+  std::string consumers;
+};
+
+/// Per device state
+struct TimeframeCreditsContext {
+  int64_t maxInFlight = 0;
+  /// Whether the device needs a credit for each timeframe it creates
+  bool timeframeBound = false;
+  /// Whether the device reports the timeframes it consumed
+  bool creditsConsumer = false;
+  /// Timeframes which were completely processed by this device
+  uint64_t consumedTimeframes = 0;
+  /// Last timeslices accounted, not to count twice a timeframe whose
+  /// inputs are consumed in more than one go
+  std::array<size_t, 64> lastTimeslices{};
+  size_t nextTimeslice = 0;
+};
+
+namespace
+{
+struct CreditsMetricIndices {
+  size_t creditsConsumed = 0;
+  size_t consumedTimeframes = 0;
+};
+
+std::vector<CreditsMetricIndices> createCreditsIndices(std::vector<DeviceMetricsInfo>& allDevicesMetrics)
+{
+  std::vector<CreditsMetricIndices> results;
+  for (auto& info : allDevicesMetrics) {
+    CreditsMetricIndices indices;
+    indices.creditsConsumed = DeviceMetricsHelper::bookNumericMetric<uint64_t>(info, "timeframe-credits-consumed");
+    indices.consumedTimeframes = DeviceMetricsHelper::bookNumericMetric<uint64_t>(info, "consumed-timeframes");
+    results.push_back(indices);
+  }
+  return results;
+}
+
+/// @return the last value of a counter of the device, 0 if not yet received.
+int64_t lastValue(DeviceMetricsInfo& deviceMetrics, size_t index)
+{
+  if (index >= deviceMetrics.metrics.size()) {
+    return 0;
+  }
+  MetricInfo const& info = deviceMetrics.metrics.at(index);
+  if (info.filledMetrics == 0) {
+    return 0;
+  }
+  auto& data = deviceMetrics.uint64Metrics.at(info.storeIdx);
+  return (int64_t)data.at((info.pos - 1) % data.size());
+}
+
+/// Only the processors which see every timeframe can tell us when a
+/// timeframe has left the topology. Whether they do cannot be told from
+/// their inputs, so they need to be labelled explicitly or to be named by
+/// --timeframes-consumers.
+bool isCreditsConsumer(DeviceSpec const& spec, std::string const& consumers)
+{
+  if (std::find(spec.labels.begin(), spec.labels.end(), timeframeCreditsConsumerLabel) != spec.labels.end()) {
+    return true;
+  }
+  if (consumers.empty()) {
+    return false;
+  }
+  try {
+    return std::regex_match(spec.name, std::regex(consumers));
+  } catch (std::regex_error const& e) {
+    throw runtime_error_f("Invalid --timeframes-consumers regular expression %s: %s", consumers.c_str(), e.what());
+  }
+}
+
+/// @return whether the inputs of a timeframe were consumed, for the first
+///         time, rather than e.g. the ones of a timer
+bool consumesNewTimeframe(ProcessingContext& ctx, TimeframeCreditsContext& context)
+{
+  DataProcessingHeader const* dph = nullptr;
+  for (auto& input : ctx.inputs()) {
+    if (input.header != nullptr && input.spec->lifetime == Lifetime::Timeframe) {
+      dph = o2::header::get<DataProcessingHeader*>(input.header);
+      break;
+    }
+  }
+  if (dph == nullptr) {
+    return false;
+  }
+  size_t timeslice = dph->startTime;
+  auto last = context.lastTimeslices.begin() + std::min(context.nextTimeslice, context.lastTimeslices.size());
+  if (std::find(context.lastTimeslices.begin(), last, timeslice) != last) {
+    return false;
+  }
+  context.lastTimeslices[context.nextTimeslice++ % context.lastTimeslices.size()] = timeslice;
+  return true;
+}
+
+/// Credits bookkeeping for all the lanes of a given source
+struct SourceCredits {
+  std::vector<size_t> lanes;
+  int64_t produced = 0;
+  int64_t offered = 0;
+  size_t nextLane = 0;
+};
+} // namespace
+
+o2::framework::ServiceSpec TimeframeCreditsSupport::timeframeCreditsSpec()
+{
+  using o2::monitoring::Metric;
+  using o2::monitoring::Monitoring;
+  using o2::monitoring::tags::Key;
+  using o2::monitoring::tags::Value;
+
+  return ServiceSpec{
+    "timeframe-credits",
+    [](ServiceRegistry& services, DeviceState& state, fair::mq::ProgOptions& options) -> ServiceHandle {
+      auto* context = new TimeframeCreditsContext{};
+      if (options.Count("timeframes-rate-limit")) {
+        context->maxInFlight = std::stoll(options.GetPropertyAsString("timeframes-rate-limit"));
+      }
+      std::string consumers;
+      if (options.Count("timeframes-consumers")) {
+        consumers = options.GetPropertyAsString("timeframes-consumers");
+      }
+      auto& spec = services.get<DeviceSpec const>();
+      context->timeframeBound = spec.resourcePolicy.name == "timeframe-bound";
+      context->creditsConsumer = isCreditsConsumer(spec, consumers);
+      // Without rate limiting, sources simply get a credit which never runs out.
+      if (context->timeframeBound && context->maxInFlight <= 0) {
+        ComputingQuotaOffer offer;
+        offer.timeframes = std::numeric_limits<int64_t>::max();
+        offer.runtime = -1;
+        offer.user = -1;
+        offer.valid = true;
+        state.pendingOffers.push_back(offer);
+      }
+      return ServiceHandle{TypeIdHelpers::uniqueId<TimeframeCreditsContext>(), context};
+    },
+    CommonServices::noConfiguration(),
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    [](ServiceRegistry& registry,
+       std::vector<DeviceMetricsInfo>& allDeviceMetrics,
+       std::vector<DeviceSpec>& specs,
+       std::vector<DeviceInfo>& infos,
+       DeviceMetricsInfo& driverMetrics,
+       size_t timestamp) {
+      static int64_t maxInFlight = registry.get<TimeframeCreditsConfig>().maxInFlight;
+      static std::string consumers = registry.get<TimeframeCreditsConfig>().consumers;
+      if (maxInFlight <= 0) {
+        return;
+      }
+      static auto inFlightMetric = DeviceMetricsHelper::createNumericMetric<uint64_t>(driverMetrics, "timeframes-in-flight");
+      static auto offeredMetric = DeviceMetricsHelper::createNumericMetric<uint64_t>(driverMetrics, "timeframe-credits-offered");
+      static auto availableMetric = DeviceMetricsHelper::createNumericMetric<int>(driverMetrics, "timeframe-credits-available");
+      static std::vector<CreditsMetricIndices> allIndices = createCreditsIndices(allDeviceMetrics);
+      static std::map<std::string, SourceCredits> sources;
+      static bool once = false;
+      auto& manager = registry.get<DevicesManager>();
+
+      static std::vector<bool> isConsumer;
+      if (!once) {
+        bool hasConsumers = false;
+        for (size_t di = 0; di < specs.size(); ++di) {
+          if (specs[di].resourcePolicy.name == "timeframe-bound") {
+            sources[specs[di].name].lanes.push_back(di);
+          }
+          isConsumer.push_back(specs[di].resourcePolicy.name != "timeframe-bound" && isCreditsConsumer(specs[di], consumers));
+          hasConsumers |= isConsumer.back();
+        }
+        if (!sources.empty() && !hasConsumers) {
+          LOGP(WARNING, "No processor labelled {} or matching --timeframes-consumers, timeframes are not rate limited", timeframeCreditsConsumerLabel.value);
+        }
+        once = true;
+      }
+      if (sources.empty()) {
+        return;
+      }
+
+      // Timeframes created by the sources, summing over their lanes. Different
+      // sources are expected to provide parts of the same timeframes.
+      int64_t produced = 0;
+      for (auto& [name, source] : sources) {
+        source.produced = 0;
+        for (auto di : source.lanes) {
+          source.produced += lastValue(allDeviceMetrics[di], allIndices[di].creditsConsumed);
+        }
+        produced = std::max(produced, source.produced);
+      }
+      // Timeframes done by the slowest processor
+      std::map<std::string, int64_t> consumedByProcessor;
+      for (size_t di = 0; di < specs.size(); ++di) {
+        if (isConsumer[di] == false) {
+          continue;
+        }
+        consumedByProcessor[specs[di].name] += lastValue(allDeviceMetrics[di], allIndices[di].consumedTimeframes);
+      }
+      int64_t consumed = produced;
+      for (auto& [name, value] : consumedByProcessor) {
+        consumed = std::min(consumed, value);
+      }
+      int64_t inFlight = std::max(produced - consumed, (int64_t)0);
+
+      int64_t totalOffered = 0;
+      int64_t totalAvailable = 0;
+      for (auto& [name, source] : sources) {
+        // Credits already offered to the source which it did not use yet.
+        int64_t outstanding = std::max(source.offered - source.produced, (int64_t)0);
+        int64_t available = maxInFlight - inFlight - outstanding;
+        totalAvailable += std::max(available, (int64_t)0);
+        std::vector<int64_t> perLane(source.lanes.size(), 0);
+        for (int64_t ci = 0; ci < available; ++ci) {
+          perLane[source.nextLane++ % source.lanes.size()]++;
+        }
+        for (size_t li = 0; li < source.lanes.size(); ++li) {
+          if (perLane[li] == 0) {
+            continue;
+          }
+          auto& spec = specs[source.lanes[li]];
+          LOGP(debug, "Offering {} timeframe credits to {}", perLane[li], spec.id);
+          manager.queueMessage(spec.id.c_str(), fmt::format("/timeframe-credits {}", perLane[li]).data());
+          source.offered += perLane[li];
+        }
+        totalOffered += source.offered;
+      }
+      inFlightMetric(driverMetrics, inFlight, timestamp);
+      offeredMetric(driverMetrics, totalOffered, timestamp);
+      availableMetric(driverMetrics, totalAvailable, timestamp);
+    },
+    [](ProcessingContext& ctx, void* service) {
+      auto* context = reinterpret_cast<TimeframeCreditsContext*>(service);
+      if (context->timeframeBound) {
+        // Each timeframe created uses one of the credits held by the task.
+        ComputingQuotaConsumer useCredit = [](int taskId, std::array<ComputingQuotaOffer, 16>& offers, std::function<void(ComputingQuotaOffer const&)> accountConsumed) {
+          for (auto& offer : offers) {
+            if (offer.user != taskId || offer.timeframes <= 0) {
+              continue;
+            }
+            offer.timeframes -= 1;
+            ComputingQuotaOffer consumed;
+            consumed.timeframes = 1;
+            accountConsumed(consumed);
+            return;
+          }
+        };
+        ctx.services().get<DeviceState>().offerConsumers.push_back(useCredit);
+        return;
+      }
+      if (context->maxInFlight <= 0 || context->creditsConsumer == false || consumesNewTimeframe(ctx, *context) == false) {
+        return;
+      }
+      context->consumedTimeframes++;
+      auto& monitoring = ctx.services().get<Monitoring>();
+      monitoring.send(Metric{context->consumedTimeframes, "consumed-timeframes"}.addTag(Key::Subsystem, Value::DPL));
+      monitoring.flushBuffer();
+    },
+    nullptr,
+    nullptr,
+    [](ServiceRegistry& registry, boost::program_options::variables_map const& vm) {
+      // Until we guarantee this is called only once...
+      static bool once = false;
+      if (once) {
+        return;
+      }
+      auto config = new TimeframeCreditsConfig{};
+      if (vm.count("timeframes-rate-limit")) {
+        config->maxInFlight = std::stoll(vm["timeframes-rate-limit"].as<std::string>());
+      }
+      if (vm.count("timeframes-consumers")) {
+        config->consumers = vm["timeframes-consumers"].as<std::string>();
+      }
+      if (config->maxInFlight > 0) {
+        LOGP(INFO, "Rate limiting sources to {} timeframes in flight", config->maxInFlight);
+      }
+      registry.registerService(ServiceRegistryHelpers::handleForService<TimeframeCreditsConfig>(config));
+      once = true;
+    },
+    ServiceKind::Global};
+}
+
+} // namespace o2::framework
@@ -0,0 +1,31 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_TIMEFRAMECREDITSSUPPORT_H_
+#define O2_FRAMEWORK_TIMEFRAMECREDITSSUPPORT_H_
+
+#include "Framework/ServiceSpec.h"
+
+namespace o2::framework
+{
+
+/// Credit based flow control of the sources of the topology.
+/// Devices with a "timeframe-bound" ResourcePolicy can only inject a new
+/// timeframe when they hold a credit. Credits are handed out by the driver
+/// so that no more than --timeframes-rate-limit timeframes are in flight,
+/// i.e. created by a source but not yet consumed by every processor
+/// downstream.
+struct TimeframeCreditsSupport {
+  static ServiceSpec timeframeCreditsSpec();
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_TIMEFRAMECREDITSSUPPORT_H_
@@ -0,0 +1,260 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/TimelineTracing.h"
+#include "Framework/Logger.h"
+
+#include <fmt/format.h>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+#include <unistd.h>
+
+namespace o2::framework
+{
+
+namespace
+{
+size_t roundEvents(size_t events)
+{
+  if (events == 0) {
+    return 0;
+  }
+  size_t result = 1;
+  while (result < events) {
+    result *= 2;
+  }
+  return result;
+}
+
+size_t initialEventsPerThread()
+{
+  char const* events = getenv("DPL_TIMELINE_EVENTS");
+  if (events == nullptr) {
+    return TimelineTracing::DEFAULT_EVENTS_PER_THREAD;
+  }
+  return roundEvents(strtoull(events, nullptr, 10));
+}
+
+/// Slot of the ring buffer of a thread. The sequence number is the index of
+/// the event plus one once it is completely written, 0 while it is being
+/// written, so that the dumping thread can detect the events which changed
+/// while it was copying them. The fields are relaxed atomics, which compile
+/// to plain loads and stores.
+struct TimelineSlot {
+  std::atomic<uint64_t> sequence = 0;
+  std::atomic<uint64_t> start = 0;
+  std::atomic<uint64_t> duration = 0;
+  std::atomic<uint64_t> timeslice = 0;
+  std::atomic<TimelineEventKind> kind = TimelineEventKind::Count;
+};
+
+/// Events of a single thread. Only the owning thread writes into it,
+/// the dumping thread simply discards whatever was overwritten or is being
+/// written while it is reading.
+struct TimelineThreadBuffer {
+  TimelineThreadBuffer(size_t size, int id)
+    : slots{new TimelineSlot[size]},
+      mask{size - 1},
+      tid{id}
+  {
+  }
+  std::unique_ptr<TimelineSlot[]> slots;
+  size_t mask;
+  int tid;
+  std::atomic<uint64_t> written = 0;
+  std::atomic<uint64_t> cleared = 0;
+};
+
+/// Buffers are kept until the end of the process, so that the events of
+/// threads which are gone can still be dumped.
+struct TimelineRegistry {
+  std::mutex mutex;
+  std::vector<std::unique_ptr<TimelineThreadBuffer>> buffers;
+};
+
+TimelineRegistry& registry()
+{
+  static TimelineRegistry instance;
+  return instance;
+}
+
+thread_local TimelineThreadBuffer* tBuffer = nullptr;
+thread_local uint64_t tCurrentTimeslice = 0;
+
+char const* eventName(TimelineEventKind kind)
+{
+  switch (kind) {
+    case TimelineEventKind::Relay:
+      return "relay";
+    case TimelineEventKind::Dispatch:
+      return "dispatch";
+    case TimelineEventKind::Process:
+      return "process";
+    case TimelineEventKind::Serialise:
+      return "serialise";
+    case TimelineEventKind::Send:
+      return "send";
+    default:
+      return "unknown";
+  }
+}
+
+std::string escapeJSON(std::string_view s)
+{
+  std::string result;
+  for (auto c : s) {
+    if (c == '"' || c == '\\') {
+      result += '\\';
+    }
+    if ((unsigned char)c >= 0x20) {
+      result += c;
+    }
+  }
+  return result;
+}
+} // namespace
+
+std::atomic<size_t> TimelineTracing::sEventsPerThread{initialEventsPerThread()};
+
+void TimelineTracing::setEventsPerThread(size_t events)
+{
+  sEventsPerThread.store(roundEvents(events), std::memory_order_relaxed);
+}
+
+void TimelineTracing::record(TimelineEventKind kind, uint64_t timeslice, uint64_t start, uint64_t end)
+{
+  if (tBuffer == nullptr) {
+    size_t size = eventsPerThread();
+    if (size == 0) {
+      return;
+    }
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.buffers.emplace_back(std::make_unique<TimelineThreadBuffer>(size, (int)reg.buffers.size()));
+    tBuffer = reg.buffers.back().get();
+  }
+  uint64_t n = tBuffer->written.load(std::memory_order_relaxed);
+  auto& slot = tBuffer->slots[n & tBuffer->mask];
+  slot.sequence.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.start.store(start, std::memory_order_relaxed);
+  slot.duration.store(end - start, std::memory_order_relaxed);
+  slot.timeslice.store(timeslice, std::memory_order_relaxed);
+  slot.kind.store(kind, std::memory_order_relaxed);
+  slot.sequence.store(n + 1, std::memory_order_release);
+  tBuffer->written.store(n + 1, std::memory_order_release);
+}
+
+void TimelineTracing::clear()
+{
+  auto& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  for (auto& buffer : reg.buffers) {
+    buffer->cleared.store(buffer->written.load(std::memory_order_acquire), std::memory_order_relaxed);
+  }
+}
+
+void TimelineTracing::dumpChromeTrace(std::ostream& out, std::string_view processName)
+{
+  auto pid = getpid();
+  out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+  out << fmt::format(R"({{"name":"process_name","ph":"M","pid":{},"tid":0,"args":{{"name":"{}"}}}})", pid, escapeJSON(processName));
+
+  auto& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  std::vector<TimelineEvent> events;
+  for (auto& buffer : reg.buffers) {
+    size_t size = buffer->mask + 1;
+    uint64_t end = buffer->written.load(std::memory_order_acquire);
+    uint64_t begin = std::max(buffer->cleared.load(std::memory_order_relaxed), end > size ? end - size : 0);
+    events.clear();
+    for (uint64_t i = begin; i < end; ++i) {
+      // The slot is skipped if the event was overwritten before or while
+      // it is copied.
+      auto& slot = buffer->slots[i & buffer->mask];
+      if (slot.sequence.load(std::memory_order_acquire) != i + 1) {
+        continue;
+      }
+      TimelineEvent event{slot.start.load(std::memory_order_relaxed),
+                          slot.duration.load(std::memory_order_relaxed),
+                          slot.timeslice.load(std::memory_order_relaxed),
+                          slot.kind.load(std::memory_order_relaxed)};
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.sequence.load(std::memory_order_relaxed) != i + 1) {
+        continue;
+      }
+      events.push_back(event);
+    }
+
+    out << fmt::format(",\n"
+                       R"({{"name":"thread_name","ph":"M","pid":{},"tid":{},"args":{{"name":"thread {}"}}}})",
+                       pid, buffer->tid, buffer->tid);
+    for (auto& event : events) {
+      out << fmt::format(",\n"
+                         R"({{"name":"{}","cat":"dpl","ph":"X","ts":{}.{:03},"dur":{}.{:03},"pid":{},"tid":{},"args":{{"timeslice":{}}}}})",
+                         eventName(event.kind), event.start / 1000, event.start % 1000, event.duration / 1000, event.duration % 1000,
+                         pid, buffer->tid, event.timeslice);
+    }
+  }
+  out << "\n]}\n";
+}
+
+bool TimelineTracing::dumpChromeTrace(std::string const& filename, std::string_view processName)
+{
+  std::ofstream out(filename);
+  if (!out) {
+    return false;
+  }
+  dumpChromeTrace(out, processName);
+  return out.good();
+}
+
+void TimelineTracing::dumpDeviceTimeline(std::string_view deviceId)
+{
+  auto filename = fmt::format("dpl-timeline-{}-{}.json", deviceId, getpid());
+  if (dumpChromeTrace(filename, deviceId)) {
+    LOGP(info, "Timeline dumped to {}", filename);
+  } else {
+    LOGP(error, "Unable to dump timeline to {}", filename);
+  }
+}
+
+TimelineScope::TimelineScope(TimelineEventKind kind, uint64_t timeslice)
+  : mStart{0},
+    mTimeslice{timeslice},
+    mPreviousTimeslice{tCurrentTimeslice},
+    mKind{kind},
+    mEnabled{TimelineTracing::enabled()}
+{
+  tCurrentTimeslice = timeslice;
+  if (mEnabled) {
+    mStart = TimelineTracing::now();
+  }
+}
+
+TimelineScope::TimelineScope(TimelineEventKind kind)
+  : TimelineScope(kind, tCurrentTimeslice)
+{
+}
+
+TimelineScope::~TimelineScope()
+{
+  tCurrentTimeslice = mPreviousTimeslice;
+  if (mEnabled) {
+    TimelineTracing::record(mKind, mTimeslice, mStart, TimelineTracing::now());
+  }
+}
+
+} // namespace o2::framework
@@ -14,6 +14,7 @@
 #include "Framework/Logger.h"
 #include "Framework/ServiceRegistry.h"
 #include "Framework/DeviceSpec.h"
+#include "Framework/TimelineTracing.h"
 #include "DriverClientContext.h"
 #include "DPLWebSocket.h"
 #include <uv.h>
@@ -111,9 +112,36 @@ void on_connect(uv_connect_t* connection, int status)
     state->pendingOffers.push_back(offer);
   });
 
+  client->observe("/timeframe-credits", [state = context->state](std::string_view cmd) {
+    static constexpr int prefixSize = std::string_view{"/timeframe-credits "}.size();
+    if (prefixSize > cmd.size()) {
+      LOG(ERROR) << "Malformed timeframe credits offer";
+      return;
+    }
+    cmd.remove_prefix(prefixSize);
+    int64_t credits;
+    auto creditsError = std::from_chars(cmd.data(), cmd.data() + cmd.size(), credits);
+    if (creditsError.ec != std::errc()) {
+      LOG(ERROR) << "Malformed timeframe credits offer";
+      return;
+    }
+    LOGP(debug, "Received {} timeframe credits", credits);
+    ComputingQuotaOffer offer;
+    offer.timeframes = credits;
+    offer.runtime = -1;
+    offer.user = -1;
+    offer.valid = true;
+
+    state->pendingOffers.push_back(offer);
+  });
+
   client->observe("/quit", [state = context->state](std::string_view offer) {
     state->quitRequested = true;
   });
+
+  client->observe("/dump-timeline", [client](std::string_view) {
+    TimelineTracing::dumpDeviceTimeline(client->spec().id);
+  });
   auto clientContext = std::make_unique<o2::framework::DriverClientContext>(DriverClientContext{client->spec(), context->state});
   client->setDPLClient(std::make_unique<WSDPLClient>(connection->handle, std::move(clientContext), onHandshake, std::move(handler)));
   client->sendHandshake();
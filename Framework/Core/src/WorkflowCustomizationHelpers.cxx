@@ -40,6 +40,9 @@ std::vector<ConfigParamSpec> WorkflowCustomizationHelpers::requiredWorkflowOptio
 
                                        // options for AOD rate limiting
                                        ConfigParamSpec{"aod-memory-rate-limit", VariantType::Int64, 0LL, {"Rate limit AOD processing based on memory"}},
+                                       // options for timeframe based rate limiting
+                                       ConfigParamSpec{"timeframes-rate-limit", VariantType::Int64, 0LL, {"Maximum number of timeframes in flight, created by the sources but not yet fully processed (0: no limit)"}},
+                                       ConfigParamSpec{"timeframes-consumers", VariantType::String, "", {"Regular expression matching the names of the processors which see every timeframe, used to tell when a timeframe is not in flight anymore"}},
 
                                        // options for AOD writer
                                        ConfigParamSpec{"aod-writer-json", VariantType::String, "", {"Name of the json configuration file"}},
@@ -24,6 +24,7 @@
 #include "Framework/DeviceInfo.h"
 #include "Framework/DeviceMetricsInfo.h"
 #include "Framework/DeviceMetricsHelper.h"
+#include "Framework/DeviceMetricsRing.h"
 #include "Framework/DeviceConfigInfo.h"
 #include "Framework/DeviceSpec.h"
 #include "Framework/DeviceState.h"
@@ -152,6 +153,14 @@ template class std::vector<DeviceSpec>;
 
 std::vector<DeviceMetricsInfo> gDeviceMetricsInfos;
 
+/// Binary metrics channel of a device, aligned with gDeviceMetricsInfos.
+struct DeviceMetricsChannel {
+  std::unique_ptr<DeviceMetricsRing> ring;
+  /// Index in the DeviceMetricsInfo for each of the ids used by the device
+  std::vector<size_t> metricIndices;
+};
+std::vector<DeviceMetricsChannel> gDeviceMetricsChannels;
+
 // FIXME: probably find a better place
 // these are the device options added by the framework, but they can be
 // overloaded in the config spec
@@ -420,6 +429,7 @@ void spawnRemoteDevice(std::string const& forwardedStdin,
   deviceInfos.emplace_back(info);
   // Let's add also metrics information for the given device
   gDeviceMetricsInfos.emplace_back(DeviceMetricsInfo{});
+  gDeviceMetricsChannels.emplace_back();
 }
 
 struct DeviceLogContext {
@@ -805,6 +815,12 @@ void spawnDevice(DeviceRef ref,
       service.preFork(serviceRegistry, varmap);
     }
   }
+  // The binary metrics ring is created before forking, so that the child
+  // can inherit it.
+  std::unique_ptr<DeviceMetricsRing> metricsRing;
+  if (driverInfo.metricsRingSize) {
+    metricsRing = DeviceMetricsRing::create(driverInfo.metricsRingSize);
+  }
   // If we have a framework id, it means we have already been respawned
   // and that we are in a child. If not, we need to fork and re-exec, adding
   // the framework-id as one of the options.
@@ -841,6 +857,10 @@ void spawnDevice(DeviceRef ref,
 
     auto portS = std::to_string(driverInfo.tracyPort);
     setenv("TRACY_PORT", portS.c_str(), 1);
+    if (metricsRing) {
+      fcntl(metricsRing->fd(), F_SETFD, 0);
+      setenv("DPL_METRICS_RING_FD", std::to_string(metricsRing->fd()).c_str(), 1);
+    }
     for (auto& service : spec.services) {
       if (service.postForkChild != nullptr) {
         service.postForkChild(serviceRegistry);
@@ -901,6 +921,7 @@ void spawnDevice(DeviceRef ref,
   deviceInfos.emplace_back(info);
   // Let's add also metrics information for the given device
   gDeviceMetricsInfos.emplace_back(DeviceMetricsInfo{});
+  gDeviceMetricsChannels.emplace_back(DeviceMetricsChannel{std::move(metricsRing), {}});
 }
 
 struct LogProcessingState {
@@ -938,18 +959,13 @@ LogProcessingState processChildrenOutput(DriverInfo& driverInfo,
     DeviceMetricsInfo& metrics = metricsInfos[di];
     assert(specs.size() == infos.size());
     DeviceSpec const& spec = specs[di];
+    DeviceMetricsChannel* channel = di < gDeviceMetricsChannels.size() ? &gDeviceMetricsChannels[di] : nullptr;
+    bool hasRing = channel && channel->ring;
 
-    if (info.unprinted.empty()) {
+    if (info.unprinted.empty() && hasRing == false) {
       continue;
     }
 
-    O2_SIGNPOST_START(DriverStatus::ID, DriverStatus::BYTES_PROCESSED, info.pid, 0, 0);
-
-    std::string_view s = info.unprinted;
-    size_t pos = 0;
-    info.history.resize(info.historySize);
-    info.historyLevel.resize(info.historySize);
-
     auto updateMetricsViews =
       Metric2DViewIndex::getUpdater({&info.dataRelayerViewIndex,
                                      &info.variablesViewIndex,
@@ -960,6 +976,22 @@ LogProcessingState processChildrenOutput(DriverInfo& driverInfo,
       hasNewMetric = true;
     };
 
+    // Binary metrics do not need any parsing.
+    if (hasRing && DeviceMetricsHelper::processMetricsRing(*channel->ring, channel->metricIndices, metrics, newMetricCallback)) {
+      result.didProcessMetric = true;
+    }
+
+    if (info.unprinted.empty()) {
+      continue;
+    }
+
+    O2_SIGNPOST_START(DriverStatus::ID, DriverStatus::BYTES_PROCESSED, info.pid, 0, 0);
+
+    std::string_view s = info.unprinted;
+    size_t pos = 0;
+    info.history.resize(info.historySize);
+    info.historyLevel.resize(info.historySize);
+
     while ((pos = s.find(delimiter)) != std::string::npos) {
       std::string token{s.substr(0, pos)};
       auto logLevel = LogParsingHelpers::parseTokenLevel(token);
@@ -1101,7 +1133,9 @@ int doChild(int argc, char** argv, ServiceRegistry& serviceRegistry,
       ("driver-client-backend", bpo::value<std::string>()->default_value(defaultDriverClient), "backend for device -> driver communicataon: stdout://: use stdout, ws://: use websockets") //
       ("infologger-severity", bpo::value<std::string>()->default_value(""), "minimum FairLogger severity to send to InfoLogger")                                                           //
       ("configuration,cfg", bpo::value<std::string>()->default_value("command-line"), "configuration backend")                                                                             //
-      ("infologger-mode", bpo::value<std::string>()->default_value(""), "O2_INFOLOGGER_MODE override");
+      ("infologger-mode", bpo::value<std::string>()->default_value(""), "O2_INFOLOGGER_MODE override")                                                                                   //
+      ("cpu-affinity", bpo::value<std::string>()->default_value(""), "cores the device is pinned to")                                                                                      //
+      ("numa-node", bpo::value<std::string>()->default_value("-1"), "NUMA node the device allocates memory from");
     r.fConfig.AddToCmdLineOptions(optsDesc, true);
   });
 
@@ -1120,6 +1154,15 @@ int doChild(int argc, char** argv, ServiceRegistry& serviceRegistry,
                                      &deviceState,
                                      &errorPolicy,
                                      &loop](fair::mq::DeviceRunner& r) {
+    // Pin the device before anything else, so that all the threads and
+    // the memory we allocate from now on end up where the driver wants.
+    ComputingPlacement placement;
+    placement.cpus = ComputingResourceHelpers::parseCpuList(r.fConfig.GetPropertyAsString("cpu-affinity"));
+    placement.numaNode = std::stoi(r.fConfig.GetPropertyAsString("numa-node"));
+    if (ComputingResourceHelpers::applyPlacement(placement) == false) {
+      LOGP(error, "Unable to pin {} to cores {} and NUMA node {}", spec.id, r.fConfig.GetPropertyAsString("cpu-affinity"), placement.numaNode);
+    }
+
     simpleRawDeviceService = std::make_unique<SimpleRawDeviceService>(nullptr, spec);
     serviceRegistry.registerService(ServiceRegistryHelpers::handleForService<RawDeviceService>(simpleRawDeviceService.get()));
 
@@ -1370,6 +1413,11 @@ int runStateMachine(DataProcessorSpecs const& workflow,
   uv_timer_t metricDumpTimer;
   metricDumpTimer.data = &serverContext;
 
+  // Metrics sent via the shared memory rings do not wake up the loop,
+  // so we make sure it runs at least every 100 ms.
+  uv_timer_t metricsRingTimer;
+  uv_timer_init(loop, &metricsRingTimer);
+
   while (true) {
     // If control forced some transition on us, we push it to the queue.
     if (driverControl.forcedTransitions.empty() == false) {
@@ -1601,6 +1649,8 @@ int runStateMachine(DataProcessorSpecs const& workflow,
             "--resources-monitoring",
             "--resources-monitoring-dump-interval",
             "--time-limit",
+            "--timeframes-rate-limit",
+            "--timeframes-consumers",
           };
 
           for (auto& option : uniformOptions) {
@@ -1608,6 +1658,16 @@ int runStateMachine(DataProcessorSpecs const& workflow,
           }
 
           DeviceSpecHelpers::reworkShmSegmentSize(dataProcessorInfos);
+          auto placementPolicy = ComputingResourceHelpers::parsePlacementPolicy(varmap["cpu-placement"].as<std::string>());
+          if (placementPolicy != ComputingPlacementPolicy::None) {
+            auto nodes = ComputingResourceHelpers::readNumaTopology();
+            ComputingResourceHelpers::assignPlacement(nodes, runningWorkflow.devices, placementPolicy, driverInfo.deployHostname);
+            for (auto& device : runningWorkflow.devices) {
+              if (device.placement.numaNode >= 0) {
+                LOGP(info, "{} placed on NUMA node {}, cores {}", device.id, device.placement.numaNode, ComputingResourceHelpers::formatCpuList(device.placement.cpus));
+              }
+            }
+          }
           DeviceSpecHelpers::prepareArguments(driverControl.defaultQuiet,
                                               driverControl.defaultStopped,
                                               driverInfo.port,
@@ -1681,6 +1741,10 @@ int runStateMachine(DataProcessorSpecs const& workflow,
                          driverInfo.resourcesMonitoringDumpInterval * 1000,
                          driverInfo.resourcesMonitoringDumpInterval * 1000);
         }
+        if (driverInfo.metricsRingSize) {
+          uv_timer_start(
+            &metricsRingTimer, [](uv_timer_t*) {}, 100, 100);
+        }
         LOG(INFO) << "Redeployment of configuration done.";
       } break;
       case DriverState::RUNNING:
@@ -1795,6 +1859,7 @@ int runStateMachine(DataProcessorSpecs const& workflow,
         }
       } break;
       case DriverState::EXIT: {
+        uv_timer_stop(&metricsRingTimer);
         if (ResourcesMonitoringHelper::isResourcesMonitoringEnabled(driverInfo.resourcesMonitoringInterval)) {
           if (driverInfo.resourcesMonitoringDumpInterval) {
             uv_timer_stop(&metricDumpTimer);
@@ -2222,12 +2287,16 @@ int doMain(int argc, char** argv, o2::framework::WorkflowSpec const& workflow,
     ("no-IPC", bpo::value<bool>()->zero_tokens()->default_value(false), "disable IPC topology optimization")                                              //                                                                                                                                        //
     ("o2-control,o2", bpo::value<std::string>()->default_value(""), "dump O2 Control workflow configuration under the specified name")                    //
     ("resources-monitoring", bpo::value<unsigned short>()->default_value(0), "enable cpu/memory monitoring for provided interval in seconds")             //
-    ("resources-monitoring-dump-interval", bpo::value<unsigned short>()->default_value(0), "dump monitoring information to disk every provided seconds"); //
+    ("resources-monitoring-dump-interval", bpo::value<unsigned short>()->default_value(0), "dump monitoring information to disk every provided seconds")   //
+    ("cpu-placement", bpo::value<std::string>()->default_value("none"), "pin devices to the NUMA nodes / cores of the machine: none, numa, cores")       //
+    ("metrics-ring-size", bpo::value<unsigned int>()->default_value(0), "size in bytes of the shared memory ring used by each device to send metrics to the driver (e.g. 262144), 0 to use text only"); //
   // some of the options must be forwarded by default to the device
   executorOptions.add(DeviceSpecHelpers::getForwardedDeviceOptions());
 
   gHiddenDeviceOptions.add_options()                                                    //
     ("id,i", bpo::value<std::string>(), "device id for child spawning")                 //
+    ("cpu-affinity", bpo::value<std::string>(), "cores the device is pinned to")         //
+    ("numa-node", bpo::value<std::string>(), "NUMA node of the device")                 //
     ("channel-config", bpo::value<std::vector<std::string>>(), "channel configuration") //
     ("control", "control plugin")                                                       //
     ("log-color", "logging color scheme")("color", "logging color scheme");
@@ -2441,6 +2510,7 @@ int doMain(int argc, char** argv, o2::framework::WorkflowSpec const& workflow,
   driverInfo.resources = varmap["resources"].as<std::string>();
   driverInfo.resourcesMonitoringInterval = varmap["resources-monitoring"].as<unsigned short>();
   driverInfo.resourcesMonitoringDumpInterval = varmap["resources-monitoring-dump-interval"].as<unsigned short>();
+  driverInfo.metricsRingSize = varmap["metrics-ring-size"].as<unsigned int>();
 
   // FIXME: should use the whole dataProcessorInfos, actually...
   driverInfo.processorInfo = dataProcessorInfos;
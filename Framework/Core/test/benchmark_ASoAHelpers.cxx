@@ -13,7 +13,9 @@
 #include "Framework/TableBuilder.h"
 #include "Framework/AnalysisDataModel.h"
 #include <benchmark/benchmark.h>
+#include <atomic>
 #include <random>
+#include <thread>
 #include <vector>
 
 using namespace o2::framework;
@@ -714,4 +716,137 @@ static void BM_ASoAHelpersCombGenCollisionsFivesCategories(benchmark::State& sta
 
 BENCHMARK(BM_ASoAHelpersCombGenCollisionsFivesCategories)->RangeMultiplier(2)->Range(8, 8 << (maxFivesRange + 1));
 
+// Event mixing like workload: pairs of collisions within 10 neighbours of the same category,
+// split in state.range(1) partitions processed by separate threads
+static void BM_ASoAHelpersCombGenCollisionsPairsPartitioned(benchmark::State& state)
+{
+  // Seed with a real random value, if available
+  std::default_random_engine e1(1234567891);
+  std::uniform_real_distribution<float> uniform_dist(0, 1);
+  std::uniform_int_distribution<int> uniform_dist_int(0, 10);
+
+  TableBuilder builder;
+  auto rowWriter = builder.cursor<o2::aod::Collisions>();
+  for (auto i = 0; i < state.range(0); ++i) {
+    rowWriter(0, uniform_dist_int(e1),
+              uniform_dist(e1), uniform_dist(e1), uniform_dist(e1),
+              uniform_dist(e1), uniform_dist(e1), uniform_dist(e1),
+              uniform_dist(e1), uniform_dist(e1), uniform_dist(e1),
+              uniform_dist_int(e1), uniform_dist(e1),
+              uniform_dist_int(e1),
+              uniform_dist(e1), uniform_dist(e1), uniform_dist_int(e1));
+  }
+  auto table = builder.finalize();
+
+  o2::aod::Collisions collisions{table};
+
+  std::atomic<int64_t> count = 0;
+
+  for (auto _ : state) {
+    count = 0;
+    auto partitions = partitionedSelfPairCombinations(state.range(1), "fNumContrib", 10, -1, collisions);
+    std::vector<std::thread> threads;
+    for (auto& partition : partitions) {
+      threads.emplace_back([&partition, &count]() {
+        int64_t localCount = 0;
+        for (auto& [c0, c1] : partition) {
+          localCount += c0.posZ() < c1.posZ();
+        }
+        count += localCount;
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    benchmark::DoNotOptimize(count);
+  }
+  state.counters["Combinations"] = count;
+  state.SetBytesProcessed(state.iterations() * sizeof(float) * count);
+}
+
+BENCHMARK(BM_ASoAHelpersCombGenCollisionsPairsPartitioned)->Ranges({{8 << 4, 8 << maxPairsRange}, {1, 8}});
+
+// Pairs of collisions with close number of contributors, iterating all pairs
+static void BM_ASoAHelpersCombGenCollisionsPairsSelected(benchmark::State& state)
+{
+  // Seed with a real random value, if available
+  std::default_random_engine e1(1234567891);
+  std::uniform_real_distribution<float> uniform_dist(0, 1);
+  std::uniform_int_distribution<int> uniform_dist_int(0, 1000);
+
+  TableBuilder builder;
+  auto rowWriter = builder.cursor<o2::aod::Collisions>();
+  for (auto i = 0; i < state.range(0); ++i) {
+    rowWriter(0, uniform_dist_int(e1),
+              uniform_dist(e1), uniform_dist(e1), uniform_dist(e1),
+              uniform_dist(e1), uniform_dist(e1), uniform_dist(e1),
+              uniform_dist(e1), uniform_dist(e1), uniform_dist(e1),
+              uniform_dist_int(e1), uniform_dist(e1),
+              uniform_dist_int(e1) / 10 + i / 10,
+              uniform_dist(e1), uniform_dist(e1), uniform_dist_int(e1));
+  }
+  auto table = builder.finalize();
+
+  o2::aod::Collisions collisions{table};
+
+  int64_t count = 0;
+
+  for (auto _ : state) {
+    count = 0;
+    for (auto& [c0, c1] : pairCombinations(collisions)) {
+      if (std::abs(c0.numContrib() - c1.numContrib()) <= 2) {
+        count++;
+      }
+    }
+    benchmark::DoNotOptimize(count);
+  }
+  state.counters["Combinations"] = count;
+  state.SetBytesProcessed(state.iterations() * sizeof(float) * count);
+}
+
+BENCHMARK(BM_ASoAHelpersCombGenCollisionsPairsSelected)->Range(8, 8 << maxPairsRange);
+
+// Same as above with the block-wise pair preselection
+static void BM_ASoAHelpersCombGenCollisionsPairsPreselected(benchmark::State& state)
+{
+  // Seed with a real random value, if available
+  std::default_random_engine e1(1234567891);
+  std::uniform_real_distribution<float> uniform_dist(0, 1);
+  std::uniform_int_distribution<int> uniform_dist_int(0, 1000);
+
+  TableBuilder builder;
+  auto rowWriter = builder.cursor<o2::aod::Collisions>();
+  for (auto i = 0; i < state.range(0); ++i) {
+    rowWriter(0, uniform_dist_int(e1),
+              uniform_dist(e1), uniform_dist(e1), uniform_dist(e1),
+              uniform_dist(e1), uniform_dist(e1), uniform_dist(e1),
+              uniform_dist(e1), uniform_dist(e1), uniform_dist(e1),
+              uniform_dist_int(e1), uniform_dist(e1),
+              uniform_dist_int(e1) / 10 + i / 10,
+              uniform_dist(e1), uniform_dist(e1), uniform_dist_int(e1));
+  }
+  auto table = builder.finalize();
+
+  o2::aod::Collisions collisions{table};
+
+  int64_t count = 0;
+
+  for (auto _ : state) {
+    count = 0;
+    auto c0 = collisions.begin();
+    auto c1 = collisions.begin();
+    for (auto& [i, j] : preselectPairs<o2::aod::collision::NumContrib>(collisions, 2)) {
+      c0.setCursor(i);
+      c1.setCursor(j);
+      count++;
+      benchmark::DoNotOptimize(c1);
+    }
+    benchmark::DoNotOptimize(count);
+  }
+  state.counters["Combinations"] = count;
+  state.SetBytesProcessed(state.iterations() * sizeof(float) * count);
+}
+
+BENCHMARK(BM_ASoAHelpersCombGenCollisionsPairsPreselected)->Range(8, 8 << maxPairsRange);
+
 BENCHMARK_MAIN();
@@ -0,0 +1,90 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/ArrowFileHelpers.h"
+#include "Framework/TableTreeHelpers.h"
+#include "Framework/Logger.h"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+#include <TFile.h>
+
+using namespace o2::framework;
+
+#ifdef __APPLE__
+constexpr unsigned int maxrange = 15;
+#else
+constexpr unsigned int maxrange = 16;
+#endif
+
+// a table which looks like a derived data table
+std::shared_ptr<arrow::Table> createTable(int64_t nrows)
+{
+  std::default_random_engine e1(1234567891);
+  std::uniform_real_distribution<double> rd(0, 1);
+  std::normal_distribution<float> rf(5., 2.);
+  std::discrete_distribution<ULong64_t> rl({10, 20, 30, 30, 5, 5});
+  std::discrete_distribution<int> ri({10, 20, 30, 30, 5, 5});
+
+  TableBuilder builder;
+  auto rowWriter =
+    builder.persist<double, float, ULong64_t, int>({"a", "b", "c", "d"});
+  for (auto i = 0; i < nrows; ++i) {
+    rowWriter(0, rd(e1), rf(e1), rl(e1), ri(e1));
+  }
+  return builder.finalize();
+}
+
+// reading through the TTree path
+static void BM_ReadTreeToTable(benchmark::State& state)
+{
+  auto table = createTable(state.range(0));
+  TFile fout("derived.root", "RECREATE", "", 501);
+  TableToTree ta2tr(table, &fout, "derived");
+  ta2tr.addAllBranches();
+  ta2tr.process();
+  fout.Close();
+
+  for (auto _ : state) {
+    TFile f("derived.root", "READ");
+    auto tr = (TTree*)f.Get("derived");
+    TreeToTable tr2ta;
+    if (tr2ta.addAllColumns(tr)) {
+      tr2ta.fill(tr);
+      auto ta = tr2ta.finalize();
+      benchmark::DoNotOptimize(ta);
+    }
+    delete tr;
+    f.Close();
+  }
+
+  state.SetBytesProcessed(state.iterations() * state.range(0) * 24);
+}
+
+// reading through the memory mapped Arrow file
+static void BM_ReadArrowFileToTable(benchmark::State& state)
+{
+  auto table = createTable(state.range(0));
+  ArrowFileHelpers::writeTable(table, "derived.arrow");
+
+  for (auto _ : state) {
+    auto ta = ArrowFileHelpers::readTable("derived.arrow", {}, "derived");
+    benchmark::DoNotOptimize(ta);
+  }
+
+  state.SetBytesProcessed(state.iterations() * state.range(0) * 24);
+}
+
+BENCHMARK(BM_ReadTreeToTable)->Range(8, 8 << maxrange);
+BENCHMARK(BM_ReadArrowFileToTable)->Range(8, 8 << maxrange);
+
+BENCHMARK_MAIN();
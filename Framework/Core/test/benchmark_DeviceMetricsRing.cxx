@@ -0,0 +1,92 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/DeviceMetricsInfo.h"
+#include "Framework/DeviceMetricsHelper.h"
+#include "Framework/DeviceMetricsRing.h"
+
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace o2::framework;
+
+// Number of metrics each device sends in between two driver iterations
+static constexpr int METRICS_PER_DEVICE = 50;
+
+// Driver CPU cost of the text based metrics, as received from the devices.
+static void BM_DriverTextMetrics(benchmark::State& state)
+{
+  size_t nDevices = state.range(0);
+  std::vector<DeviceMetricsInfo> infos(nDevices);
+  std::vector<std::string> metrics;
+  for (int mi = 0; mi < METRICS_PER_DEVICE; ++mi) {
+    metrics.push_back(fmt::format("[METRIC] metric-{},0 {} 1789372894 hostname=test.cern.ch", mi, mi));
+  }
+  ParsedMetricMatch match;
+  uint64_t timestamp = 1789372894;
+  for (auto _ : state) {
+    for (auto& info : infos) {
+      for (auto& metric : metrics) {
+        DeviceMetricsHelper::parseMetric(metric, match);
+        match.timestamp = timestamp;
+        DeviceMetricsHelper::processMetric(match, info);
+      }
+    }
+    timestamp++;
+  }
+  state.SetItemsProcessed(state.iterations() * nDevices * METRICS_PER_DEVICE);
+}
+
+BENCHMARK(BM_DriverTextMetrics)->Arg(1)->Arg(200);
+
+// Driver CPU cost of the same metrics, when sent via the binary ring. The
+// devices filling the rings are not accounted for.
+static void BM_DriverRingMetrics(benchmark::State& state)
+{
+  size_t nDevices = state.range(0);
+  std::vector<DeviceMetricsInfo> infos(nDevices);
+  std::vector<std::vector<size_t>> metricIndices(nDevices);
+  std::vector<std::unique_ptr<DeviceMetricsRing>> rings;
+  std::vector<std::string> labels;
+  for (size_t di = 0; di < nDevices; ++di) {
+    rings.emplace_back(DeviceMetricsRing::create(1 << 16));
+  }
+  for (int mi = 0; mi < METRICS_PER_DEVICE; ++mi) {
+    labels.push_back(fmt::format("metric-{}", mi));
+  }
+  DeviceMetricsRecord record;
+  record.type = (uint8_t)MetricType::Int;
+  record.timestamp = 1789372894;
+  bool first = true;
+  for (auto _ : state) {
+    state.PauseTiming();
+    for (auto& ring : rings) {
+      for (int mi = 0; mi < METRICS_PER_DEVICE; ++mi) {
+        record.id = mi;
+        record.intValue = mi;
+        ring->push(record, first ? labels[mi] : std::string_view{});
+      }
+    }
+    first = false;
+    record.timestamp++;
+    state.ResumeTiming();
+    for (size_t di = 0; di < nDevices; ++di) {
+      DeviceMetricsHelper::processMetricsRing(*rings[di], metricIndices[di], infos[di]);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * nDevices * METRICS_PER_DEVICE);
+}
+
+BENCHMARK(BM_DriverRingMetrics)->Arg(1)->Arg(200);
+
+BENCHMARK_MAIN();
@@ -62,7 +62,59 @@ static void BM_StandardNameLookup(benchmark::State& state)
     }
   }
 }
+
+/// Fill a 2D histogram entry by entry
+static void BM_SingleFill(benchmark::State& state)
+{
+  HistogramRegistry registry{"registry", {{"histo", "histo", {HistType::kTH2F, {{100, 0, 1}, {100, 0, 1}}}}}};
+  std::vector<float> xs(state.range(0));
+  for (auto i = 0u; i < xs.size(); ++i) {
+    xs[i] = (i % 1000) * 0.001f;
+  }
+  for (auto _ : state) {
+    for (auto i = 0u; i < xs.size(); ++i) {
+      registry.fill(HIST("histo"), xs[i], xs[xs.size() - i - 1]);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Fill a 2D histogram via the per-histogram buffer
+static void BM_BufferedFill(benchmark::State& state)
+{
+  HistogramRegistry registry{"registry", {{"histo", "histo", {HistType::kTH2F, {{100, 0, 1}, {100, 0, 1}}}}}};
+  std::vector<float> xs(state.range(0));
+  for (auto i = 0u; i < xs.size(); ++i) {
+    xs[i] = (i % 1000) * 0.001f;
+  }
+  for (auto _ : state) {
+    for (auto i = 0u; i < xs.size(); ++i) {
+      registry.fillBuffered(HIST("histo"), xs[i], xs[xs.size() - i - 1]);
+    }
+    registry.flush();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Fill a 2D histogram from arrays
+static void BM_ArrayFill(benchmark::State& state)
+{
+  HistogramRegistry registry{"registry", {{"histo", "histo", {HistType::kTH2F, {{100, 0, 1}, {100, 0, 1}}}}}};
+  std::vector<float> xs(state.range(0));
+  for (auto i = 0u; i < xs.size(); ++i) {
+    xs[i] = (i % 1000) * 0.001f;
+  }
+  std::vector<float> ys(xs.rbegin(), xs.rend());
+  for (auto _ : state) {
+    registry.fillN(HIST("histo"), xs.size(), xs.data(), ys.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
 BENCHMARK(BM_HashedNameLookup)->Arg(4)->Arg(8)->Arg(16)->Arg(64)->Arg(128)->Arg(256)->Arg(512);
 BENCHMARK(BM_StandardNameLookup)->Arg(4)->Arg(8)->Arg(16)->Arg(64)->Arg(128)->Arg(256)->Arg(512);
+BENCHMARK(BM_SingleFill)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(BM_BufferedFill)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(BM_ArrayFill)->Arg(1 << 10)->Arg(1 << 16);
 
 BENCHMARK_MAIN();
@@ -0,0 +1,47 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/TimelineTracing.h"
+
+#include <benchmark/benchmark.h>
+#include <sstream>
+
+using namespace o2::framework;
+
+// Cost of recording a single event, i.e. what each instrumented
+// section of the processing pays.
+static void BM_TimelineScope(benchmark::State& state)
+{
+  TimelineTracing::setEventsPerThread(state.range(0));
+  uint64_t timeslice = 0;
+  for (auto _ : state) {
+    TimelineScope scope{TimelineEventKind::Process, timeslice++};
+  }
+  TimelineTracing::setEventsPerThread(TimelineTracing::DEFAULT_EVENTS_PER_THREAD);
+}
+
+// Disabled first, as the ring of a thread is allocated only once.
+BENCHMARK(BM_TimelineScope)->Arg(0)->Arg(TimelineTracing::DEFAULT_EVENTS_PER_THREAD);
+
+static void BM_TimelineDump(benchmark::State& state)
+{
+  for (size_t i = 0; i < TimelineTracing::DEFAULT_EVENTS_PER_THREAD; ++i) {
+    TimelineTracing::record(TimelineEventKind::Process, i, i * 1000, i * 1000 + 500);
+  }
+  for (auto _ : state) {
+    std::ostringstream out;
+    TimelineTracing::dumpChromeTrace(out, "benchmark");
+    benchmark::DoNotOptimize(out.str());
+  }
+}
+
+BENCHMARK(BM_TimelineDump);
+
+BENCHMARK_MAIN();
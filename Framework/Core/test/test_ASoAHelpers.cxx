@@ -1348,3 +1348,81 @@ BOOST_AUTO_TEST_CASE(CombinationsHelpers)
   }
   BOOST_CHECK_EQUAL(count, expectedStrictlyUpperTriples.size());
 }
+
+BOOST_AUTO_TEST_CASE(PartitionedCombinations)
+{
+  TableBuilder builder;
+  auto rowWriter = builder.persist<int32_t, int32_t>({"x", "y"});
+  // categories: [0, 4, 7, 9], [1, 6], [2, 8], [3], [5]
+  std::vector<int32_t> categories{0, 1, 2, 3, 0, 4, 1, 0, 2, 0};
+  for (int32_t i = 0; i < categories.size(); i++) {
+    rowWriter(0, i, categories[i]);
+  }
+  auto table = builder.finalize();
+  using Test = o2::soa::Table<o2::soa::Index<>, test::X, test::Y>;
+  Test tests{table};
+  BOOST_REQUIRE_EQUAL(10, tests.size());
+
+  std::vector<std::tuple<int32_t, int32_t>> expectedPairs;
+  for (auto& [t0, t1] : pairCombinations(tests)) {
+    expectedPairs.emplace_back(t0.x(), t1.x());
+  }
+  BOOST_REQUIRE_EQUAL(expectedPairs.size(), 45);
+
+  // partitions are consecutive and reproduce the sequential combinations
+  for (int nPartitions : {1, 2, 3, 7, 100}) {
+    auto partitions = partitionedPairCombinations(nPartitions, tests);
+    BOOST_CHECK(partitions.size() <= nPartitions);
+    std::vector<std::tuple<int32_t, int32_t>> pairs;
+    for (auto& partition : partitions) {
+      for (auto& [t0, t1] : partition) {
+        pairs.emplace_back(t0.x(), t1.x());
+      }
+    }
+    BOOST_CHECK(pairs == expectedPairs);
+  }
+
+  // balanced: 45 pairs in 3 partitions
+  auto counts = CombinationsStrictlyUpperIndexPolicy(tests, tests).countCombinations();
+  for (auto& partition : partitionCombinations(counts, 3)) {
+    uint64_t sum = 0;
+    for (auto pos = partition.begin; pos < partition.end; pos++) {
+      sum += counts[pos];
+    }
+    BOOST_CHECK(sum >= 9 && sum <= 21);
+  }
+
+  std::vector<std::tuple<int32_t, int32_t>> expectedBlockPairs;
+  for (auto& [t0, t1] : selfPairCombinations("y", 2, -1, tests)) {
+    expectedBlockPairs.emplace_back(t0.x(), t1.x());
+  }
+  // [0, 4], [0, 7], [4, 7], [4, 9], [7, 9], [1, 6], [2, 8]
+  BOOST_REQUIRE_EQUAL(expectedBlockPairs.size(), 7);
+  for (int nPartitions : {1, 2, 4, 10}) {
+    std::vector<std::tuple<int32_t, int32_t>> pairs;
+    for (auto& partition : partitionedSelfPairCombinations(nPartitions, "y", 2, -1, tests)) {
+      for (auto& [t0, t1] : partition) {
+        pairs.emplace_back(t0.x(), t1.x());
+      }
+    }
+    BOOST_CHECK(pairs == expectedBlockPairs);
+  }
+
+  // preselection on the category column, with blocks smaller than the table
+  auto preselected = preselectPairs<test::Y>(tests, 0, 4);
+  std::vector<std::tuple<int32_t, int32_t>> expectedSameCategory;
+  for (auto& [t0, t1] : pairCombinations(tests)) {
+    if (t0.y() == t1.y()) {
+      expectedSameCategory.emplace_back(t0.x(), t1.x());
+    }
+  }
+  BOOST_REQUIRE_EQUAL(preselected.size(), expectedSameCategory.size());
+  auto t0 = tests.begin();
+  auto t1 = tests.begin();
+  for (auto i = 0u; i < preselected.size(); i++) {
+    t0.setCursor(preselected[i].first);
+    t1.setCursor(preselected[i].second);
+    BOOST_CHECK_EQUAL(t0.x(), std::get<0>(expectedSameCategory[i]));
+    BOOST_CHECK_EQUAL(t1.x(), std::get<1>(expectedSameCategory[i]));
+  }
+}
@@ -0,0 +1,140 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test Framework ArrowFileHelpers
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include "Framework/ArrowFileHelpers.h"
+#include "Framework/TableBuilder.h"
+
+#include <arrow/table.h>
+#include <arrow/util/key_value_metadata.h>
+
+#include <filesystem>
+
+using namespace o2::framework;
+
+BOOST_AUTO_TEST_CASE(TestArrowFilename)
+{
+  BOOST_CHECK_EQUAL(ArrowFileHelpers::isArrowFilename("AO2D.arrow"), true);
+  BOOST_CHECK_EQUAL(ArrowFileHelpers::isArrowFilename("/some/path/AO2D.arrow/"), true);
+  BOOST_CHECK_EQUAL(ArrowFileHelpers::isArrowFilename("AO2D.root"), false);
+  BOOST_CHECK_EQUAL(ArrowFileHelpers::isArrowFilename(".arrow"), false);
+  BOOST_CHECK_EQUAL(ArrowFileHelpers::isArrowFilename("AO2D"), false);
+}
+
+BOOST_AUTO_TEST_CASE(TestArrowFileRoundTrip)
+{
+  TableBuilder builder;
+  auto rowWriter = builder.persist<int, float, double>({"fX", "fY", "fZ"});
+  for (auto i = 0; i < 100; ++i) {
+    rowWriter(0, i, 2.f * i, 3. * i);
+  }
+  auto table = builder.finalize();
+
+  std::string dirname = "test_ArrowFileHelpers.arrow";
+  std::filesystem::remove_all(dirname);
+  for (uint64_t df : {3, 1, 20}) {
+    auto folderName = dirname + "/" + ArrowFileHelpers::getFolderName(df);
+    std::filesystem::create_directories(folderName);
+    ArrowFileHelpers::writeTable(table, folderName + "/O2test" + ArrowFileHelpers::extension);
+  }
+  // only a selection of the columns
+  ArrowFileHelpers::writeTable(table, dirname + "/DF_1/O2selected.arrow", {"fZ", "fX"});
+
+  // data frames are sorted by number
+  auto dfs = ArrowFileHelpers::getTimeFrameNumbers(dirname);
+  BOOST_REQUIRE_EQUAL(dfs.size(), 3);
+  BOOST_CHECK_EQUAL(dfs[0], 1);
+  BOOST_CHECK_EQUAL(dfs[1], 3);
+  BOOST_CHECK_EQUAL(dfs[2], 20);
+
+  auto readBack = ArrowFileHelpers::readTable(dirname + "/DF_3/O2test.arrow", {}, "O2test");
+  BOOST_REQUIRE_EQUAL(readBack->Validate().ok(), true);
+  BOOST_REQUIRE_EQUAL(readBack->num_rows(), 100);
+  BOOST_REQUIRE_EQUAL(readBack->num_columns(), 3);
+  BOOST_CHECK_EQUAL(readBack->Equals(*table), true);
+  BOOST_REQUIRE(readBack->schema()->metadata() != nullptr);
+  BOOST_CHECK_EQUAL(readBack->schema()->metadata()->value(0), "O2test");
+
+  // read only one column
+  auto oneColumn = ArrowFileHelpers::readTable(dirname + "/DF_20/O2test.arrow", {"fY"});
+  BOOST_REQUIRE_EQUAL(oneColumn->num_columns(), 1);
+  BOOST_CHECK_EQUAL(oneColumn->schema()->field(0)->name(), "fY");
+  BOOST_CHECK_EQUAL(oneColumn->column(0)->Equals(table->column(1)), true);
+
+  auto selected = ArrowFileHelpers::readTable(dirname + "/DF_1/O2selected.arrow");
+  BOOST_REQUIRE_EQUAL(selected->num_columns(), 2);
+  BOOST_CHECK_EQUAL(selected->schema()->field(0)->name(), "fZ");
+  BOOST_CHECK_EQUAL(selected->schema()->field(1)->name(), "fX");
+
+  BOOST_CHECK_THROW(ArrowFileHelpers::readTable(dirname + "/DF_1/O2test.arrow", {"fW"}), std::runtime_error);
+  BOOST_CHECK_THROW(ArrowFileHelpers::readTable(dirname + "/DF_2/O2test.arrow"), std::runtime_error);
+
+  std::filesystem::remove_all(dirname);
+}
+
+BOOST_AUTO_TEST_CASE(TestArrowFileMergedTimeFrames)
+{
+  // with --aod-writer-ntfmerge > 1 several time frames end up in the same data frame
+  constexpr int nTimeFrames = 12;
+  std::vector<std::shared_ptr<arrow::Table>> tables;
+  for (auto itf = 0; itf < nTimeFrames; ++itf) {
+    TableBuilder builder;
+    auto rowWriter = builder.persist<int, float>({"fTF", "fY"});
+    for (auto i = 0; i < 10 + itf; ++i) {
+      rowWriter(0, itf, 2.f * i);
+    }
+    tables.emplace_back(builder.finalize());
+  }
+
+  std::string dirname = "test_ArrowFileHelpersMerged.arrow";
+  std::filesystem::remove_all(dirname);
+  auto folderName = dirname + "/" + ArrowFileHelpers::getFolderName(0);
+  std::filesystem::create_directories(folderName);
+  for (auto& table : tables) {
+    ArrowFileHelpers::appendTable(table, folderName, "O2test");
+  }
+  ArrowFileHelpers::appendTable(tables[0], folderName, "O2other");
+
+  auto parts = ArrowFileHelpers::getTableParts(folderName, "O2test");
+  BOOST_REQUIRE_EQUAL(parts.size(), nTimeFrames);
+  BOOST_CHECK_EQUAL(std::filesystem::path(parts[0]).filename().string(), "O2test.arrow");
+  BOOST_CHECK_EQUAL(std::filesystem::path(parts[11]).filename().string(), "O2test.11.arrow");
+
+  // all time frames are read back, in the order they were written
+  auto readBack = ArrowFileHelpers::readTableParts(folderName, "O2test");
+  BOOST_REQUIRE(readBack != nullptr);
+  BOOST_REQUIRE_EQUAL(readBack->Validate().ok(), true);
+  auto expected = arrow::ConcatenateTables(tables).ValueOrDie();
+  BOOST_REQUIRE_EQUAL(readBack->num_rows(), expected->num_rows());
+  BOOST_CHECK_EQUAL(readBack->column(0)->Equals(expected->column(0)), true);
+  BOOST_CHECK_EQUAL(readBack->column(1)->Equals(expected->column(1)), true);
+  BOOST_REQUIRE(readBack->schema()->metadata() != nullptr);
+  BOOST_CHECK_EQUAL(readBack->schema()->metadata()->value(0), "O2test");
+
+  auto oneColumn = ArrowFileHelpers::readTableParts(folderName, "O2test", {"fTF"});
+  BOOST_REQUIRE_EQUAL(oneColumn->num_columns(), 1);
+  BOOST_CHECK_EQUAL(oneColumn->column(0)->Equals(expected->column(0)), true);
+
+  auto other = ArrowFileHelpers::readTableParts(folderName, "O2other");
+  BOOST_REQUIRE(other != nullptr);
+  BOOST_CHECK_EQUAL(other->num_rows(), tables[0]->num_rows());
+
+  // a missing table is not an error
+  BOOST_CHECK(ArrowFileHelpers::readTableParts(folderName, "O2missing") == nullptr);
+  BOOST_CHECK(ArrowFileHelpers::readTableParts(dirname + "/DF_1", "O2test") == nullptr);
+
+  std::filesystem::remove_all(dirname);
+}
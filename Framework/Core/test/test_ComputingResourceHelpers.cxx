@@ -15,8 +15,13 @@
 #include <boost/test/unit_test.hpp>
 
 #include "../src/ComputingResourceHelpers.h"
+#include "Framework/DeviceSpec.h"
+#include "Framework/RuntimeError.h"
+#include <filesystem>
+#include <fstream>
 #include <string>
 #include <vector>
+#include <unistd.h>
 
 using namespace o2::framework;
 
@@ -46,3 +51,110 @@ BOOST_AUTO_TEST_CASE(TestResourceParsing)
   BOOST_CHECK_EQUAL(resources[1].startPort, 22000);
   BOOST_CHECK_EQUAL(resources[1].lastPort, 23000);
 }
+
+BOOST_AUTO_TEST_CASE(TestCpuListParsing)
+{
+  BOOST_CHECK(ComputingResourceHelpers::parseCpuList("").empty());
+  auto cpus = ComputingResourceHelpers::parseCpuList("0-3,8,10-11\n");
+  std::vector<int> expected{0, 1, 2, 3, 8, 10, 11};
+  BOOST_CHECK_EQUAL_COLLECTIONS(cpus.begin(), cpus.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(ComputingResourceHelpers::formatCpuList(cpus), "0-3,8,10-11");
+  BOOST_CHECK_EQUAL(ComputingResourceHelpers::formatCpuList({5, 4, 7}), "4-5,7");
+}
+
+BOOST_AUTO_TEST_CASE(TestNumaTopology)
+{
+  namespace fs = std::filesystem;
+  auto root = fs::temp_directory_path() / ("dpl-sysfs-" + std::to_string(getpid()));
+  auto writeFile = [](fs::path const& path, std::string const& content) {
+    fs::create_directories(path.parent_path());
+    std::ofstream(path) << content << "\n";
+  };
+  // Only the cpu information
+  writeFile(root / "cpu" / "online", "0-7");
+  auto nodes = ComputingResourceHelpers::readNumaTopology(root.string());
+  BOOST_REQUIRE_EQUAL(nodes.size(), 1);
+  BOOST_CHECK_EQUAL(nodes[0].id, 0);
+  BOOST_CHECK_EQUAL(nodes[0].cpus.size(), 8);
+
+  // A dual socket machine, with a memory only node
+  writeFile(root / "node" / "node1" / "cpulist", "4-7");
+  writeFile(root / "node" / "node0" / "cpulist", "0-3");
+  writeFile(root / "node" / "node2" / "cpulist", "");
+  writeFile(root / "node" / "possible", "0-2");
+  nodes = ComputingResourceHelpers::readNumaTopology(root.string());
+  BOOST_REQUIRE_EQUAL(nodes.size(), 2);
+  BOOST_CHECK_EQUAL(nodes[0].id, 0);
+  BOOST_CHECK_EQUAL(ComputingResourceHelpers::formatCpuList(nodes[0].cpus), "0-3");
+  BOOST_CHECK_EQUAL(nodes[1].id, 1);
+  BOOST_CHECK_EQUAL(ComputingResourceHelpers::formatCpuList(nodes[1].cpus), "4-7");
+  fs::remove_all(root);
+}
+
+BOOST_AUTO_TEST_CASE(TestPlacement)
+{
+  std::vector<NumaNode> nodes{{0, {0, 1, 2, 3}}, {1, {4, 5, 6, 7}}};
+  auto makeDevice = [](std::string const& name, size_t lane, size_t lanes) {
+    DeviceSpec device;
+    device.name = name;
+    device.id = name;
+    device.resource.hostname = "localhost";
+    device.inputTimesliceId = lane;
+    device.maxInputTimeslices = lanes;
+    return device;
+  };
+  std::vector<DeviceSpec> devices;
+  devices.push_back(makeDevice("reader", 0, 1));
+  devices.push_back(makeDevice("reco_t0", 0, 2));
+  devices.push_back(makeDevice("reco_t1", 1, 2));
+  devices.push_back(makeDevice("writer", 0, 1));
+  devices.push_back(makeDevice("remote", 0, 1));
+  devices.back().resource.hostname = "otherhost";
+
+  ComputingResourceHelpers::assignPlacement(nodes, devices, ComputingPlacementPolicy::None, "localhost");
+  for (auto& device : devices) {
+    BOOST_CHECK_EQUAL(device.placement.numaNode, -1);
+    BOOST_CHECK(device.placement.cpus.empty());
+  }
+
+  ComputingResourceHelpers::assignPlacement(nodes, devices, ComputingPlacementPolicy::Numa, "localhost");
+  // Lanes go to different nodes, the rest is kept together.
+  BOOST_CHECK_EQUAL(devices[1].placement.numaNode, 0);
+  BOOST_CHECK_EQUAL(devices[2].placement.numaNode, 1);
+  BOOST_CHECK_EQUAL(devices[0].placement.numaNode, 0);
+  BOOST_CHECK_EQUAL(devices[3].placement.numaNode, 0);
+  BOOST_CHECK_EQUAL(devices[4].placement.numaNode, -1);
+  BOOST_CHECK_EQUAL(ComputingResourceHelpers::formatCpuList(devices[0].placement.cpus), "0-3");
+  BOOST_CHECK_EQUAL(ComputingResourceHelpers::formatCpuList(devices[2].placement.cpus), "4-7");
+
+  ComputingResourceHelpers::assignPlacement(nodes, devices, ComputingPlacementPolicy::Cores, "localhost");
+  // Node 0 has 3 devices for 4 cores, node 1 only one.
+  BOOST_CHECK_EQUAL(ComputingResourceHelpers::formatCpuList(devices[1].placement.cpus), "0-1");
+  BOOST_CHECK_EQUAL(ComputingResourceHelpers::formatCpuList(devices[0].placement.cpus), "2");
+  BOOST_CHECK_EQUAL(ComputingResourceHelpers::formatCpuList(devices[3].placement.cpus), "3");
+  BOOST_CHECK_EQUAL(ComputingResourceHelpers::formatCpuList(devices[2].placement.cpus), "4-7");
+
+  // More devices than cores: the least loaded node is used and cores are shared.
+  for (int i = 0; i < 8; ++i) {
+    devices.push_back(makeDevice("extra" + std::to_string(i), 0, 1));
+  }
+  ComputingResourceHelpers::assignPlacement(nodes, devices, ComputingPlacementPolicy::Cores, "localhost");
+  std::vector<size_t> perNode(2, 0);
+  for (auto& device : devices) {
+    if (device.placement.numaNode < 0) {
+      continue;
+    }
+    perNode[device.placement.numaNode]++;
+    BOOST_CHECK_EQUAL(device.placement.cpus.size(), 1);
+  }
+  BOOST_CHECK_EQUAL(perNode[0], 6);
+  BOOST_CHECK_EQUAL(perNode[1], 6);
+}
+
+BOOST_AUTO_TEST_CASE(TestPlacementPolicyParsing)
+{
+  BOOST_CHECK(ComputingResourceHelpers::parsePlacementPolicy("none") == ComputingPlacementPolicy::None);
+  BOOST_CHECK(ComputingResourceHelpers::parsePlacementPolicy("numa") == ComputingPlacementPolicy::Numa);
+  BOOST_CHECK(ComputingResourceHelpers::parsePlacementPolicy("cores") == ComputingPlacementPolicy::Cores);
+  BOOST_CHECK_THROW(ComputingResourceHelpers::parsePlacementPolicy("socket"), o2::framework::RuntimeErrorRef);
+}
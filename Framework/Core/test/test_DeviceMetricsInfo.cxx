@@ -204,12 +204,36 @@ BOOST_AUTO_TEST_CASE(TestDeviceMetricsInfo2)
   BOOST_CHECK_EQUAL(info.timestamps[1][2], 1009);
   BOOST_CHECK_EQUAL(info.timestamps[1][3], 1010);
   BOOST_CHECK_EQUAL(info.changed.size(), 3);
+  // Once full, the older half of the values is downsampled by 2
+  size_t t0 = t;
   for (int i = 0; i < 1026; ++i) {
     ckey(info, i, t++);
   }
-  BOOST_CHECK_EQUAL(info.uint64Metrics[0][0], 1024);
-  BOOST_CHECK_EQUAL(info.uint64Metrics[0][1], 1025);
-  BOOST_CHECK_EQUAL(info.uint64Metrics[0][2], 2);
+  BOOST_CHECK_EQUAL(info.metrics[2].pos, 770);
+  BOOST_CHECK_EQUAL(info.metrics[2].filledMetrics, 770);
+  BOOST_CHECK_EQUAL(info.uint64Metrics[0][0], 0);
+  BOOST_CHECK_EQUAL(info.uint64Metrics[0][1], 2);
+  BOOST_CHECK_EQUAL(info.uint64Metrics[0][255], 510);
+  BOOST_CHECK_EQUAL(info.uint64Metrics[0][256], 512);
+  BOOST_CHECK_EQUAL(info.uint64Metrics[0][767], 1023);
+  BOOST_CHECK_EQUAL(info.uint64Metrics[0][768], 1024);
+  BOOST_CHECK_EQUAL(info.uint64Metrics[0][769], 1025);
+  BOOST_CHECK_EQUAL(info.timestamps[2][1], t0 + 2);
+  BOOST_CHECK_EQUAL(info.timestamps[2][256], t0 + 512);
+  BOOST_CHECK_EQUAL(info.timestamps[2][769], t0 + 1025);
+  BOOST_CHECK_EQUAL(info.timestamps[2][770], 0);
+  BOOST_CHECK_EQUAL(info.max[2], 1025);
+
+  // The oldest values get coarser at each downsampling
+  for (int i = 1026; i < 1026 + 256; ++i) {
+    ckey(info, i, t++);
+  }
+  BOOST_CHECK_EQUAL(info.metrics[2].pos, 770);
+  BOOST_CHECK_EQUAL(info.uint64Metrics[0][0], 1);
+  BOOST_CHECK_EQUAL(info.uint64Metrics[0][128], 512);
+  BOOST_CHECK_EQUAL(info.uint64Metrics[0][255], 766);
+  BOOST_CHECK_EQUAL(info.uint64Metrics[0][256], 768);
+  BOOST_CHECK_EQUAL(info.uint64Metrics[0][769], 1281);
 }
 
 BOOST_AUTO_TEST_CASE(TestHelpers)
@@ -0,0 +1,187 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#define BOOST_TEST_MODULE Test Framework DeviceMetricsRing
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include "Framework/DeviceMetricsInfo.h"
+#include "Framework/DeviceMetricsHelper.h"
+#include "Framework/DeviceMetricsRing.h"
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace o2::framework;
+
+BOOST_AUTO_TEST_CASE(TestDeviceMetricsRing)
+{
+  auto ring = DeviceMetricsRing::create(4096);
+  BOOST_REQUIRE(ring != nullptr);
+  BOOST_CHECK_EQUAL(ring->capacity(), 4096);
+
+  DeviceMetricsRecord record;
+  record.id = 0;
+  record.type = (uint8_t)MetricType::Int;
+  record.timestamp = 1789372894;
+  record.intValue = 12;
+  BOOST_REQUIRE(ring->push(record, "bkey"));
+  record.id = 1;
+  record.type = (uint8_t)MetricType::String;
+  BOOST_REQUIRE(ring->push(record, "skey", "some_string"));
+  record.id = 0;
+  record.type = (uint8_t)MetricType::Int;
+  record.timestamp++;
+  record.intValue = 13;
+  BOOST_REQUIRE(ring->push(record, ""));
+
+  DeviceMetricsInfo info;
+  std::vector<size_t> metricIndices;
+  size_t newMetrics = 0;
+  auto newMetricCallback = [&newMetrics](std::string const&, MetricInfo const&, int, size_t) { newMetrics++; };
+  BOOST_CHECK_EQUAL(DeviceMetricsHelper::processMetricsRing(*ring, metricIndices, info, newMetricCallback), 3);
+  BOOST_CHECK_EQUAL(newMetrics, 2);
+  BOOST_REQUIRE_EQUAL(metricIndices.size(), 2);
+
+  auto bkey = DeviceMetricsHelper::metricIdxByName("bkey", info);
+  auto skey = DeviceMetricsHelper::metricIdxByName("skey", info);
+  BOOST_REQUIRE_EQUAL(metricIndices[0], bkey);
+  BOOST_REQUIRE_EQUAL(metricIndices[1], skey);
+  BOOST_CHECK_EQUAL(info.metrics[bkey].filledMetrics, 2);
+  BOOST_CHECK_EQUAL(info.intMetrics[info.metrics[bkey].storeIdx][0], 12);
+  BOOST_CHECK_EQUAL(info.intMetrics[info.metrics[bkey].storeIdx][1], 13);
+  BOOST_CHECK_EQUAL(info.timestamps[bkey][1], 1789372895);
+  BOOST_CHECK_EQUAL(std::string(info.stringMetrics[info.metrics[skey].storeIdx][0].data), "some_string");
+
+  // Nothing left
+  BOOST_CHECK_EQUAL(DeviceMetricsHelper::processMetricsRing(*ring, metricIndices, info, newMetricCallback), 0);
+
+  // Values with the same timestamp are all kept
+  record.intValue = 14;
+  BOOST_REQUIRE(ring->push(record, ""));
+  BOOST_CHECK_EQUAL(DeviceMetricsHelper::processMetricsRing(*ring, metricIndices, info, newMetricCallback), 1);
+  BOOST_CHECK_EQUAL(info.metrics[bkey].filledMetrics, 3);
+  BOOST_CHECK_EQUAL(info.intMetrics[info.metrics[bkey].storeIdx][1], 13);
+  BOOST_CHECK_EQUAL(info.intMetrics[info.metrics[bkey].storeIdx][2], 14);
+  BOOST_CHECK_EQUAL(info.timestamps[bkey][2], 1789372895);
+  BOOST_CHECK_EQUAL(info.max[bkey], 14);
+}
+
+BOOST_AUTO_TEST_CASE(TestDeviceMetricsRingFull)
+{
+  auto ring = DeviceMetricsRing::create(4096);
+  BOOST_REQUIRE(ring != nullptr);
+  DeviceMetricsRecord record;
+  record.type = (uint8_t)MetricType::Uint64;
+  size_t pushed = 0;
+  while (ring->push(record, "")) {
+    pushed++;
+  }
+  BOOST_CHECK_EQUAL(pushed, 4096 / sizeof(DeviceMetricsRecord));
+  // A record larger than half of the ring is never accepted
+  BOOST_CHECK(ring->push(record, std::string(3000, 'a')) == false);
+
+  // Once consumed, the records can be written again, wrapping around.
+  size_t consumed = ring->consume([](DeviceMetricsRecord const&, std::string_view, std::string_view) {});
+  BOOST_CHECK_EQUAL(consumed, pushed);
+  for (size_t i = 0; i < 1000; ++i) {
+    record.uint64Value = i;
+    BOOST_REQUIRE(ring->push(record, "", std::string(i % 50, 'x')));
+    size_t count = ring->consume([i](DeviceMetricsRecord const& r, std::string_view label, std::string_view value) {
+      BOOST_CHECK_EQUAL(r.uint64Value, i);
+      BOOST_CHECK_EQUAL(value.size(), i % 50);
+    });
+    BOOST_REQUIRE_EQUAL(count, 1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TestDeviceMetricsRingCorrupted)
+{
+  auto ring = DeviceMetricsRing::create(4096);
+  BOOST_REQUIRE(ring != nullptr);
+  DeviceMetricsRecord record;
+  record.type = (uint8_t)MetricType::Int;
+  record.intValue = 1;
+  BOOST_REQUIRE(ring->push(record, "bkey"));
+
+  // Corrupt the size of the record, which carries the label of the metric.
+  struct stat sb;
+  BOOST_REQUIRE(fstat(ring->fd(), &sb) == 0);
+  void* mapping = mmap(nullptr, sb.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, ring->fd(), 0);
+  BOOST_REQUIRE(mapping != MAP_FAILED);
+  auto* data = reinterpret_cast<DeviceMetricsRecord*>(reinterpret_cast<char*>(mapping) + sb.st_size - ring->capacity());
+  data->size = 3;
+  munmap(mapping, sb.st_size);
+
+  DeviceMetricsInfo info;
+  std::vector<size_t> metricIndices;
+  BOOST_CHECK_EQUAL(ring->drops(), 0);
+  BOOST_CHECK_EQUAL(DeviceMetricsHelper::processMetricsRing(*ring, metricIndices, info), 0);
+  BOOST_CHECK_EQUAL(ring->drops(), 1);
+
+  // Without its label, the value cannot be stored...
+  record.intValue = 2;
+  BOOST_REQUIRE(ring->push(record, ""));
+  BOOST_CHECK_EQUAL(DeviceMetricsHelper::processMetricsRing(*ring, metricIndices, info), 1);
+  BOOST_CHECK_EQUAL(info.metrics.size(), 0);
+
+  // ... until the producer sends the label again.
+  record.intValue = 3;
+  BOOST_REQUIRE(ring->push(record, "bkey"));
+  BOOST_CHECK_EQUAL(DeviceMetricsHelper::processMetricsRing(*ring, metricIndices, info), 1);
+  auto bkey = DeviceMetricsHelper::metricIdxByName("bkey", info);
+  BOOST_REQUIRE_EQUAL(metricIndices[0], bkey);
+  BOOST_CHECK_EQUAL(info.metrics[bkey].filledMetrics, 1);
+  BOOST_CHECK_EQUAL(info.intMetrics[info.metrics[bkey].storeIdx][0], 3);
+}
+
+BOOST_AUTO_TEST_CASE(TestDeviceMetricsRingAcrossProcesses)
+{
+  auto ring = DeviceMetricsRing::create(4096);
+  BOOST_REQUIRE(ring != nullptr);
+  constexpr uint64_t nMetrics = 100000;
+
+  pid_t pid = fork();
+  if (pid == 0) {
+    // The producer maps the ring from the inherited file descriptor.
+    auto producer = DeviceMetricsRing::attach(dup(ring->fd()));
+    if (producer == nullptr) {
+      _exit(1);
+    }
+    DeviceMetricsRecord record;
+    record.type = (uint8_t)MetricType::Uint64;
+    for (uint64_t i = 0; i < nMetrics; ++i) {
+      record.uint64Value = i;
+      while (producer->push(record, i == 0 ? "counter" : "") == false) {
+        std::this_thread::yield();
+      }
+    }
+    _exit(0);
+  }
+  BOOST_REQUIRE(pid > 0);
+
+  uint64_t expected = 0;
+  while (expected < nMetrics) {
+    ring->consume([&expected](DeviceMetricsRecord const& record, std::string_view label, std::string_view) {
+      BOOST_REQUIRE_EQUAL(record.uint64Value, expected);
+      BOOST_CHECK_EQUAL(label.empty(), expected != 0);
+      expected++;
+    });
+  }
+  int status = 0;
+  waitpid(pid, &status, 0);
+  BOOST_CHECK_EQUAL(WEXITSTATUS(status), 0);
+}
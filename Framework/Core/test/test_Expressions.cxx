@@ -203,3 +203,34 @@ BOOST_AUTO_TEST_CASE(TestGandivaTreeCreation)
   BOOST_REQUIRE(s.ok());
 #endif
 }
+
+BOOST_AUTO_TEST_CASE(TestGandivaCache)
+{
+  clearGandivaCache();
+  auto schema = o2::soa::createSchemaFromColumns(o2::aod::Tracks::persistent_columns_t{});
+
+  Filter f1 = o2::aod::track::signed1Pt > 0.5f;
+  Filter f2 = o2::aod::track::signed1Pt > 0.5f;
+  Filter f3 = o2::aod::track::signed1Pt > 0.7f;
+  auto flt1 = createFilter(schema, createOperations(f1));
+  auto flt2 = createFilter(schema, createOperations(f2));
+  auto flt3 = createFilter(schema, createOperations(f3));
+
+  // identical expressions share the compiled module
+  BOOST_CHECK_EQUAL(flt1.get(), flt2.get());
+  BOOST_CHECK_NE(flt1.get(), flt3.get());
+
+  auto projector1 = o2::framework::expressions::createProjectors(o2::framework::pack<o2::aod::track::Pt>{}, schema);
+  auto projector2 = o2::framework::expressions::createProjectors(o2::framework::pack<o2::aod::track::Pt>{}, schema);
+  BOOST_CHECK_EQUAL(projector1.get(), projector2.get());
+
+  auto stats = getGandivaCacheStats();
+  BOOST_CHECK_EQUAL(stats.hits, 2);
+  BOOST_CHECK_EQUAL(stats.misses, 3);
+  BOOST_CHECK_EQUAL(stats.entries, 3);
+
+  clearGandivaCache();
+  stats = getGandivaCacheStats();
+  BOOST_CHECK_EQUAL(stats.hits, 0);
+  BOOST_CHECK_EQUAL(stats.entries, 0);
+}
@@ -107,6 +107,29 @@ BOOST_AUTO_TEST_CASE(HistogramRegistryExpressionFill)
   /// Fill histogram with expression and table
   registry.fill<test::X, test::Y>(HIST("xy"), tests, test::x > 3.0f && test::y > -5.0f);
   BOOST_CHECK_EQUAL(registry.get<TH2>(HIST("xy"))->GetEntries(), 2);
+
+  /// The batched table fill gives the same bin contents as filling the selected rows one by one
+  HistogramRegistry reference{
+    "reference", {
+                   {"x", "test x", {HistType::kTH1F, {{100, 0.0f, 10.0f}}}},                            //
+                   {"xy", "test xy", {HistType::kTH2F, {{100, -10.0f, 10.01f}, {100, -10.0f, 10.01f}}}} //
+                 }                                                                                      //
+  };
+  for (auto& row : tests) {
+    if (row.x() > 3.0f) {
+      reference.fill(HIST("x"), row.x());
+      if (row.y() > -5.0f) {
+        reference.fill(HIST("xy"), row.x(), row.y());
+      }
+    }
+  }
+  for (auto [hist, ref] : {std::pair{registry.get<TH1>(HIST("x")), reference.get<TH1>(HIST("x"))},
+                           std::pair{std::static_pointer_cast<TH1>(registry.get<TH2>(HIST("xy"))), std::static_pointer_cast<TH1>(reference.get<TH2>(HIST("xy")))}}) {
+    BOOST_CHECK_EQUAL(hist->GetEntries(), ref->GetEntries());
+    for (int bin = 0; bin < ref->GetNcells(); ++bin) {
+      BOOST_CHECK_EQUAL(hist->GetBinContent(bin), ref->GetBinContent(bin));
+    }
+  }
 }
 
 BOOST_AUTO_TEST_CASE(HistogramRegistryStepTHn)
@@ -129,3 +152,77 @@ BOOST_AUTO_TEST_CASE(HistogramRegistryStepTHn)
 
   registry.print();
 }
+
+BOOST_AUTO_TEST_CASE(HistogramRegistryBatchedFill)
+{
+  HistogramRegistry registry{"registry"};
+  for (auto name : {"direct", "buffered", "arrays", "local"}) {
+    registry.add((std::string(name) + "1D").c_str(), "", {HistType::kTH1F, {{100, -10.0f, 10.01f}}});
+    registry.add((std::string(name) + "1DWeighted").c_str(), "", {HistType::kTH1F, {{100, -10.0f, 10.01f}}});
+    registry.add((std::string(name) + "2D").c_str(), "", {HistType::kTH2F, {{100, -10.0f, 10.01f}, {100, -10.0f, 10.01f}}});
+    registry.add((std::string(name) + "2DWeighted").c_str(), "", {HistType::kTH2F, {{100, -10.0f, 10.01f}, {100, -10.0f, 10.01f}}});
+  }
+  registry.add("sparse", "sparse", {HistType::kTHnSparseD, {{10, 0.0f, 10.0f}, {10, 0.0f, 10.0f}, {10, 0.0f, 10.0f}}});
+
+  // more entries than one batch, and a last batch which is not full
+  std::vector<float> xs;
+  std::vector<float> ys;
+  std::vector<float> ws;
+  for (int i = 0; i < 3000; ++i) {
+    xs.push_back((i % 200) * 0.1f - 10.f);
+    ys.push_back((i % 70) * 0.25f - 8.f);
+    ws.push_back(0.5f + (i % 3));
+  }
+  for (size_t i = 0; i < xs.size(); ++i) {
+    registry.fill(HIST("direct1D"), xs[i]);
+    registry.fill(HIST("direct1DWeighted"), xs[i], ws[i]);
+    registry.fill(HIST("direct2D"), xs[i], ys[i]);
+    registry.fill(HIST("direct2DWeighted"), xs[i], ys[i], ws[i]);
+    registry.fillBuffered(HIST("buffered1D"), xs[i]);
+    registry.fillBuffered(HIST("buffered1DWeighted"), xs[i], ws[i]);
+    registry.fillBuffered(HIST("buffered2D"), xs[i], ys[i]);
+    registry.fillBuffered(HIST("buffered2DWeighted"), xs[i], ys[i], ws[i]);
+  }
+  registry.fillN(HIST("arrays1D"), xs.size(), xs.data());
+  registry.fillN(HIST("arrays1DWeighted"), xs.size(), xs.data(), ws.data());
+  registry.fillN(HIST("arrays2D"), xs.size(), xs.data(), ys.data());
+  registry.fillN(HIST("arrays2DWeighted"), xs.size(), xs.data(), ys.data(), ws.data());
+  auto fillLocal = [&](size_t first) {
+    for (size_t i = first; i < xs.size(); i += 2) {
+      registry.fillThreadLocal(HIST("local1D"), xs[i]);
+      registry.fillThreadLocal(HIST("local1DWeighted"), xs[i], ws[i]);
+      registry.fillThreadLocal(HIST("local2D"), xs[i], ys[i]);
+      registry.fillThreadLocal(HIST("local2DWeighted"), xs[i], ys[i], ws[i]);
+    }
+  };
+  std::thread worker(fillLocal, 0);
+  fillLocal(1);
+  worker.join();
+
+  // buffered and thread-local entries only show up after flushing
+  BOOST_CHECK_EQUAL(registry.get<TH2>(HIST("local2D"))->GetEntries(), 0);
+  registry.flush();
+
+  auto check = [&xs](std::shared_ptr<TH1> direct, std::initializer_list<std::shared_ptr<TH1>> others) {
+    BOOST_REQUIRE_EQUAL(direct->GetEntries(), double(xs.size()));
+    for (auto& other : others) {
+      BOOST_CHECK_EQUAL(other->GetEntries(), direct->GetEntries());
+      BOOST_CHECK_CLOSE(other->GetSumOfWeights(), direct->GetSumOfWeights(), 0.0001);
+      for (int bin = 0; bin < direct->GetNcells(); ++bin) {
+        BOOST_CHECK_EQUAL(other->GetBinContent(bin), direct->GetBinContent(bin));
+      }
+    }
+  };
+  check(registry.get<TH1>(HIST("direct1D")), {registry.get<TH1>(HIST("buffered1D")), registry.get<TH1>(HIST("arrays1D")), registry.get<TH1>(HIST("local1D"))});
+  check(registry.get<TH1>(HIST("direct1DWeighted")), {registry.get<TH1>(HIST("buffered1DWeighted")), registry.get<TH1>(HIST("arrays1DWeighted")), registry.get<TH1>(HIST("local1DWeighted"))});
+  check(registry.get<TH2>(HIST("direct2D")), {registry.get<TH2>(HIST("buffered2D")), registry.get<TH2>(HIST("arrays2D")), registry.get<TH2>(HIST("local2D"))});
+  check(registry.get<TH2>(HIST("direct2DWeighted")), {registry.get<TH2>(HIST("buffered2DWeighted")), registry.get<TH2>(HIST("arrays2DWeighted")), registry.get<TH2>(HIST("local2DWeighted"))});
+
+  // weighted multi-dimensional fill
+  std::vector<double> ones(10, 1.);
+  std::vector<double> twos(10, 2.);
+  std::vector<double> weights(10, 0.5);
+  registry.fillN(HIST("sparse"), ones.size(), ones.data(), twos.data(), ones.data(), weights.data());
+  BOOST_CHECK_EQUAL(registry.get<THnSparse>(HIST("sparse"))->GetEntries(), 10);
+  BOOST_CHECK_CLOSE(registry.get<THnSparse>(HIST("sparse"))->GetSumw(), 5., 0.0001);
+}
@@ -0,0 +1,113 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/ConfigParamSpec.h"
+#include "Framework/ResourcePolicyHelpers.h"
+#include "Framework/DeviceSpec.h"
+#include "Framework/ControlService.h"
+#include "Framework/Logger.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+void customize(std::vector<o2::framework::ResourcePolicy>& policies)
+{
+  // The source needs a credit from the driver for each timeframe
+  policies.push_back(o2::framework::ResourcePolicyHelpers::timeframeBoundTask("source"));
+}
+
+#include "Framework/runDataProcessing.h"
+using namespace o2::framework;
+
+namespace
+{
+constexpr int TIMEFRAMES = 30;
+constexpr int SINK_SLEEP_MS = 100;
+// The subset consumer only gets one timeframe out of SUBSET_PERIOD
+constexpr int SUBSET_PERIOD = 5;
+// Generous upper bound for the time a timeframe can spend in the
+// topology when at most --timeframes-rate-limit (2) are in flight.
+// Without rate limiting the last timeframes would wait for
+// (TIMEFRAMES - 1) * SINK_SLEEP_MS.
+constexpr int MAX_LATENCY_MS = 10 * SINK_SLEEP_MS;
+
+int64_t nowMs()
+{
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct Payload {
+  int count;
+  int64_t created;
+};
+} // namespace
+
+// A fast source feeding a slow sink: the number of timeframes queued
+// in front of the sink must stay bounded. The sink is named as the consumer
+// of every timeframe by --timeframes-consumers. A consumer which only gets
+// some of the timeframes, like a QC task fed by sampling, is not and must not
+// stall the source.
+WorkflowSpec defineDataProcessing(ConfigContext const&)
+{
+  return WorkflowSpec{
+    {"source",
+     Inputs{},
+     {OutputSpec{{"a"}, "TST", "A"},
+      OutputSpec{{"b"}, "TST", "B"}},
+     AlgorithmSpec{adaptStateless(
+       [](DataAllocator& outputs, ControlService& control) {
+         static int count = 0;
+         if (count == TIMEFRAMES) {
+           return;
+         }
+         if (count % SUBSET_PERIOD == 0) {
+           outputs.make<Payload>(OutputRef{"b"}) = Payload{count, nowMs()};
+         }
+         outputs.make<Payload>(OutputRef{"a"}) = Payload{count++, nowMs()};
+         if (count == TIMEFRAMES) {
+           control.endOfStream();
+           control.readyToQuit(QuitRequest::Me);
+         }
+       })}},
+    {"sink",
+     {InputSpec{"x", "TST", "A", Lifetime::Timeframe}},
+     {},
+     AlgorithmSpec{adaptStateless(
+       [](InputRecord& inputs, ControlService& control) {
+         static int expected = 0;
+         auto& payload = inputs.get<Payload>("x");
+         auto latency = nowMs() - payload.created;
+         if (payload.count != expected) {
+           LOGP(ERROR, "Missing message. Expected: {}, Found {}.", expected, payload.count);
+           control.readyToQuit(QuitRequest::All);
+           return;
+         }
+         if (latency > MAX_LATENCY_MS) {
+           LOGP(ERROR, "Timeframe {} waited {}ms, more than {}ms. Source not rate limited.", payload.count, latency, MAX_LATENCY_MS);
+           control.readyToQuit(QuitRequest::All);
+           return;
+         }
+         std::this_thread::sleep_for(std::chrono::milliseconds(SINK_SLEEP_MS));
+         if (++expected == TIMEFRAMES) {
+           control.readyToQuit(QuitRequest::All);
+         }
+       })}},
+    {"subset",
+     {InputSpec{"y", "TST", "B", Lifetime::Timeframe}},
+     {},
+     AlgorithmSpec{adaptStateless(
+       [](InputRecord& inputs) {
+         auto& payload = inputs.get<Payload>("y");
+         if (payload.count % SUBSET_PERIOD != 0) {
+           LOGP(ERROR, "Unexpected timeframe {} in the subset consumer", payload.count);
+         }
+       })}}};
+}
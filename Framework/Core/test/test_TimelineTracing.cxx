@@ -0,0 +1,163 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#define BOOST_TEST_MODULE Test Framework TimelineTracing
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include "Framework/TimelineTracing.h"
+#include <boost/test/unit_test.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <atomic>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace o2::framework;
+
+namespace
+{
+struct TraceSummary {
+  size_t events = 0;
+  size_t threads = 0;
+  std::map<std::string, size_t> byName;
+  std::map<uint64_t, size_t> byTimeslice;
+};
+
+TraceSummary parseTrace()
+{
+  std::stringstream ss;
+  TimelineTracing::dumpChromeTrace(ss, "test-device");
+  boost::property_tree::ptree trace;
+  boost::property_tree::read_json(ss, trace);
+  TraceSummary summary;
+  for (auto& [_, event] : trace.get_child("traceEvents")) {
+    auto ph = event.get<std::string>("ph");
+    if (ph == "M") {
+      if (event.get<std::string>("name") == "thread_name") {
+        summary.threads++;
+      }
+      continue;
+    }
+    BOOST_CHECK_EQUAL(ph, "X");
+    BOOST_CHECK(event.get<double>("dur") >= 0);
+    summary.events++;
+    summary.byName[event.get<std::string>("name")]++;
+    summary.byTimeslice[event.get<uint64_t>("args.timeslice")]++;
+  }
+  return summary;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(TestTimelineScopes)
+{
+  TimelineTracing::clear();
+  {
+    TimelineScope dispatch{TimelineEventKind::Dispatch, 42};
+    {
+      TimelineScope process{TimelineEventKind::Process};
+    }
+    TimelineScope send{TimelineEventKind::Send};
+  }
+  {
+    TimelineScope relay{TimelineEventKind::Relay, 43};
+  }
+  // Scopes without a timeslice outside of any other scope
+  {
+    TimelineScope send{TimelineEventKind::Send};
+  }
+
+  auto summary = parseTrace();
+  BOOST_CHECK_EQUAL(summary.events, 5);
+  BOOST_CHECK_EQUAL(summary.byName["dispatch"], 1);
+  BOOST_CHECK_EQUAL(summary.byName["process"], 1);
+  BOOST_CHECK_EQUAL(summary.byName["send"], 2);
+  BOOST_CHECK_EQUAL(summary.byName["relay"], 1);
+  BOOST_CHECK_EQUAL(summary.byTimeslice[42], 3);
+  BOOST_CHECK_EQUAL(summary.byTimeslice[43], 1);
+  BOOST_CHECK_EQUAL(summary.byTimeslice[0], 1);
+
+  TimelineTracing::clear();
+  BOOST_CHECK_EQUAL(parseTrace().events, 0);
+}
+
+BOOST_AUTO_TEST_CASE(TestTimelineWrapAround)
+{
+  TimelineTracing::clear();
+  auto size = TimelineTracing::eventsPerThread();
+  BOOST_REQUIRE(size > 0);
+  // Only the last events are kept, for all the threads.
+  auto fill = [size]() {
+    for (size_t i = 0; i < 3 * size + 7; ++i) {
+      TimelineTracing::record(TimelineEventKind::Process, i, 1000 * i, 1000 * i + 10);
+    }
+  };
+  std::thread t1(fill);
+  std::thread t2(fill);
+  t1.join();
+  t2.join();
+  auto summary = parseTrace();
+  BOOST_CHECK(summary.threads >= 3);
+  BOOST_CHECK_EQUAL(summary.byName["process"], 2 * size);
+  BOOST_CHECK_EQUAL(summary.byTimeslice.count(3 * size + 6), 1);
+  BOOST_CHECK_EQUAL(summary.byTimeslice.count(2 * size + 6), 0);
+}
+
+BOOST_AUTO_TEST_CASE(TestTimelineDumpWhileWriting)
+{
+  // Events overwritten while they are dumped must be dropped, not mixed up
+  // with the new ones: the start and the duration are both derived from the
+  // timeslice, so a mixed up event is detected.
+  TimelineTracing::clear();
+  auto size = TimelineTracing::eventsPerThread();
+  std::atomic<bool> stop = false;
+  std::thread writer([&stop]() {
+    for (uint64_t i = 0; stop.load() == false; ++i) {
+      TimelineTracing::record(TimelineEventKind::Send, i, 1000000 * i, 1000000 * i + 1000 * (i % 1000));
+    }
+  });
+  size_t nBad = 0;
+  for (int dump = 0; dump < 20; ++dump) {
+    std::stringstream ss;
+    TimelineTracing::dumpChromeTrace(ss, "test-device");
+    boost::property_tree::ptree trace;
+    boost::property_tree::read_json(ss, trace);
+    size_t nEvents = 0;
+    for (auto& [_, event] : trace.get_child("traceEvents")) {
+      if (event.get<std::string>("ph") != "X") {
+        continue;
+      }
+      auto timeslice = event.get<uint64_t>("args.timeslice");
+      if (event.get<double>("ts") != 1000. * timeslice || event.get<double>("dur") != (double)(timeslice % 1000)) {
+        nBad++;
+      }
+      nEvents++;
+    }
+    BOOST_CHECK(nEvents <= size);
+  }
+  stop = true;
+  writer.join();
+  BOOST_CHECK_EQUAL(nBad, 0);
+}
+
+BOOST_AUTO_TEST_CASE(TestTimelineDisabled)
+{
+  auto previous = TimelineTracing::eventsPerThread();
+  TimelineTracing::clear();
+  TimelineTracing::setEventsPerThread(0);
+  std::thread t([]() {
+    TimelineScope process{TimelineEventKind::Process, 1};
+  });
+  t.join();
+  BOOST_CHECK_EQUAL(parseTrace().events, 0);
+  TimelineTracing::setEventsPerThread(previous);
+}
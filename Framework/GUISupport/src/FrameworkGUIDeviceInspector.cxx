@@ -216,6 +216,15 @@ void displayDeviceInspector(DeviceSpec const& spec,
   ImGui::Text("Tracy Port: %d", info.tracyPort);
 #endif
   ImGui::Text("Rank: %zu/%zu%%%zu/%zu", spec.rank, spec.nSlots, spec.inputTimesliceId, spec.maxInputTimeslices);
+  if (spec.placement.numaNode >= 0) {
+    std::string cores;
+    for (auto cpu : spec.placement.cpus) {
+      cores += (cores.empty() ? "" : ",") + std::to_string(cpu);
+    }
+    ImGui::Text("Placement: NUMA node %d, cores %s", spec.placement.numaNode, cores.c_str());
+  } else {
+    ImGui::Text("Placement: not pinned");
+  }
 
   if (ImGui::Button("Attach debugger")) {
     std::string pid = std::to_string(info.pid);
@@ -269,6 +278,10 @@ void displayDeviceInspector(DeviceSpec const& spec,
     if (ImGui::Button("Offer SHM")) {
       control.controller->write("/shm-offer 1000", strlen("/shm-offer 1000"));
     }
+    ImGui::SameLine();
+    if (ImGui::Button("Dump timeline")) {
+      control.controller->write("/dump-timeline", strlen("/dump-timeline"));
+    }
   }
 
   deviceInfoTable(info, metrics);
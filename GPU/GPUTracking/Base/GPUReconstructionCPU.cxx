@@ -73,6 +73,13 @@ int GPUReconstructionCPUBackend::runKernelBackend(krnlSetup& _xyz, const Args&..
   }
   unsigned int num = y.num == 0 || y.num == -1 ? 1 : y.num;
   for (unsigned int k = 0; k < num; k++) {
+    if (mTaskPool) {
+      mTaskPool->parallelFor(x.nBlocks, [&](unsigned int iB) {
+        typename T::GPUSharedMemory smem;
+        T::template Thread<I>(x.nBlocks, 1, iB, 0, smem, T::Processor(*mHostConstantMem)[y.start + k], args...);
+      });
+      continue;
+    }
     int ompThreads = mProcessingSettings.ompKernels ? (mProcessingSettings.ompKernels == 2 ? ((mProcessingSettings.ompThreads + mNestedLoopOmpFactor - 1) / mNestedLoopOmpFactor) : mProcessingSettings.ompThreads) : 1;
     if (ompThreads > 1) {
       if (mProcessingSettings.debugLevel >= 5) {
@@ -167,7 +174,15 @@ int GPUReconstructionCPU::InitDevice()
     mHostMemoryPermanent = mHostMemoryBase;
     ClearAllocatedMemory();
   }
-  if (mProcessingSettings.ompKernels) {
+  if (mProcessingSettings.cpuTaskPool) {
+    int nThreads = mProcessingSettings.cpuTaskPool < 0 ? mProcessingSettings.ompThreads : mProcessingSettings.cpuTaskPool;
+    mTaskPool.reset(new GPUReconstructionCPUTaskPool(nThreads));
+    mMaxThreads = std::max(mMaxThreads, nThreads);
+    mBlockCount = nThreads;
+    if (mProcessingSettings.debugLevel >= 2) {
+      GPUInfo("Running CPU kernels in a work-stealing task pool with %d threads", nThreads);
+    }
+  } else if (mProcessingSettings.ompKernels) {
     mBlockCount = getOMPMaxThreads();
   }
   mThreadId = GetThread();
@@ -177,6 +192,7 @@ int GPUReconstructionCPU::InitDevice()
 
 int GPUReconstructionCPU::ExitDevice()
 {
+  mTaskPool.reset();
   if (mProcessingSettings.memoryAllocationStrategy == GPUMemoryResource::ALLOCATION_GLOBAL) {
     if (mMaster == nullptr) {
       operator delete(mHostMemoryBase GPUCA_OPERATOR_NEW_ALIGNMENT);
@@ -303,6 +319,9 @@ void GPUReconstructionCPU::ResetDeviceProcessorTypes()
 
 int GPUReconstructionCPU::getOMPThreadNum()
 {
+  if (mTaskPool) {
+    return GPUReconstructionCPUTaskPool::threadIndex();
+  }
   return omp_get_thread_num();
 }
 
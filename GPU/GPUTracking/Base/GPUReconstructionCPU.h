@@ -17,6 +17,7 @@
 
 #include "GPUReconstruction.h"
 #include "GPUReconstructionHelpers.h"
+#include "GPUReconstructionCPUTaskPool.h"
 #include "GPUConstantMem.h"
 #include <stdexcept>
 #include "utils/timer.h"
@@ -60,6 +61,7 @@ class GPUReconstructionCPUBackend : public GPUReconstruction
   template <class T, int I>
   krnlProperties getKernelPropertiesBackend();
   unsigned int mNestedLoopOmpFactor = 1;
+  std::unique_ptr<GPUReconstructionCPUTaskPool> mTaskPool; // Work-stealing pool replacing the OMP parallelization if cpuTaskPool is set
 };
 
 template <class T>
@@ -153,6 +155,8 @@ class GPUReconstructionCPU : public GPUReconstructionKernels<GPUReconstructionCP
 
   void SetNestedLoopOmpFactor(unsigned int f) { mNestedLoopOmpFactor = f; }
   unsigned int SetAndGetNestedLoopOmpFactor(bool condition, unsigned int max);
+  template <class F>
+  void runParallelOuterLoop(bool doGPU, unsigned int nIterations, F&& f);
 
  protected:
   struct GPUProcessorProcessors : public GPUProcessor {
@@ -323,6 +327,21 @@ inline int GPUReconstructionCPU::runKernel(const krnlExec& x, const krnlRunRange
 #include "GPUReconstructionKernels.h"
 #undef GPUCA_KRNL
 
+template <class F>
+inline void GPUReconstructionCPU::runParallelOuterLoop(bool doGPU, unsigned int nIterations, F&& f)
+{
+  // Independent iterations (e.g. TPC sectors), whose kernels can run concurrently on the CPU
+  if (mTaskPool && !doGPU) {
+    mTaskPool->parallelFor(nIterations, f);
+    return;
+  }
+  GPUCA_OPENMP(parallel for if(!doGPU && GetProcessingSettings().ompKernels != 1) num_threads(SetAndGetNestedLoopOmpFactor(!doGPU, nIterations)))
+  for (unsigned int i = 0; i < nIterations; i++) {
+    f(i);
+  }
+  SetNestedLoopOmpFactor(1);
+}
+
 template <class T>
 inline void GPUReconstructionCPU::AddGPUEvents(T*& events)
 {
@@ -336,7 +355,7 @@ HighResTimer& GPUReconstructionCPU::getKernelTimer(RecoStep step, int num, size_
   static int id = getNextTimerId();
   timerMeta* timer = getTimerById(id);
   if (timer == nullptr) {
-    timer = insertTimer(id, GetKernelName<T, I>(), J, NSLICES, 0, step);
+    timer = insertTimer(id, GetKernelName<T, I>(), J, std::max<int>(NSLICES, mTaskPool ? mTaskPool->nThreads() : 1), 0, step);
   }
   if (addMemorySize) {
     timer->memSize += addMemorySize;
@@ -353,7 +372,7 @@ HighResTimer& GPUReconstructionCPU::getTimer(const char* name, int num)
   static int id = getNextTimerId();
   timerMeta* timer = getTimerById(id);
   if (timer == nullptr) {
-    int max = std::max<int>({getOMPMaxThreads(), mProcessingSettings.nDeviceHelperThreads + 1, mProcessingSettings.nStreams});
+    int max = std::max<int>({getOMPMaxThreads(), mTaskPool ? mTaskPool->nThreads() : 1, mProcessingSettings.nDeviceHelperThreads + 1, mProcessingSettings.nStreams});
     timer = insertTimer(id, name, J, max, 1, RecoStep::NoRecoStep);
   }
   if (num == -1) {
@@ -0,0 +1,181 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file GPUReconstructionCPUTaskPool.cxx
+
+#include "GPUReconstructionCPUTaskPool.h"
+#include <iterator>
+
+using namespace GPUCA_NAMESPACE::gpu;
+
+static thread_local const GPUReconstructionCPUTaskPool* gCurrentPool = nullptr;
+static thread_local int gCurrentIndex = 0;
+
+GPUReconstructionCPUTaskPool::GPUReconstructionCPUTaskPool(int nThreads)
+{
+  if (nThreads < 1) {
+    nThreads = 1;
+  }
+  for (int i = 0; i < nThreads; i++) {
+    mQueues.emplace_back(new TaskQueue);
+  }
+  for (int i = 1; i < nThreads; i++) {
+    mThreads.emplace_back(&GPUReconstructionCPUTaskPool::workerLoop, this, i);
+  }
+}
+
+GPUReconstructionCPUTaskPool::~GPUReconstructionCPUTaskPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mIdleMutex);
+    mStop = true;
+  }
+  mIdleCond.notify_all();
+  for (auto& thread : mThreads) {
+    thread.join();
+  }
+}
+
+int GPUReconstructionCPUTaskPool::threadIndex()
+{
+  return gCurrentIndex;
+}
+
+void GPUReconstructionCPUTaskPool::parallelFor(unsigned int n, const std::function<void(unsigned int)>& f)
+{
+  if (n == 0) {
+    return;
+  }
+  if (n == 1 || mThreads.empty()) {
+    for (unsigned int i = 0; i < n; i++) {
+      f(i);
+    }
+    return;
+  }
+
+  TaskGroup group;
+  group.f = &f;
+  group.nOpen = n;
+  const int index = gCurrentPool == this ? gCurrentIndex : 0;
+  {
+    // pushed in reverse order, such that the owner pops them in order and thieves steal from the end of the range
+    TaskQueue& queue = *mQueues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    for (unsigned int i = n; i > 0; i--) {
+      queue.tasks.push_back(Task{&group, i - 1});
+    }
+  }
+  {
+    std::lock_guard<std::mutex> lock(mIdleMutex);
+    mNQueued += n;
+  }
+  mIdleCond.notify_all();
+
+  // No task of the group is added later, so when none is left in the queues, the remaining ones are running on other threads
+  Task task;
+  while (popOwn(index, &group, task) || steal(index, &group, task)) {
+    execute(task);
+  }
+  std::unique_lock<std::mutex> lock(group.mutex);
+  group.doneCond.wait(lock, [&group] { return group.done; });
+  if (group.error) {
+    std::rethrow_exception(group.error);
+  }
+}
+
+void GPUReconstructionCPUTaskPool::workerLoop(int index)
+{
+  gCurrentPool = this;
+  gCurrentIndex = index;
+  Task task;
+  while (true) {
+    if (popOwn(index, nullptr, task) || steal(index, nullptr, task)) {
+      execute(task);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(mIdleMutex);
+    mIdleCond.wait(lock, [this] { return mStop || mNQueued > 0; });
+    if (mStop) {
+      return;
+    }
+  }
+}
+
+bool GPUReconstructionCPUTaskPool::popOwn(int index, TaskGroup* group, Task& task)
+{
+  TaskQueue& queue = *mQueues[index];
+  std::lock_guard<std::mutex> lock(queue.mutex);
+  if (queue.tasks.empty()) {
+    return false;
+  }
+  if (group == nullptr || queue.tasks.back().group == group) {
+    task = queue.tasks.back();
+    queue.tasks.pop_back();
+    mNQueued--;
+    return true;
+  }
+  // The deque of slot 0 is shared by all threads not belonging to the pool, the tasks of the group may be further down
+  for (auto it = queue.tasks.rbegin(); it != queue.tasks.rend(); ++it) {
+    if (it->group == group) {
+      task = *it;
+      queue.tasks.erase(std::next(it).base());
+      mNQueued--;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool GPUReconstructionCPUTaskPool::steal(int index, TaskGroup* group, Task& task)
+{
+  const int n = mQueues.size();
+  for (int i = 1; i < n; i++) {
+    TaskQueue& queue = *mQueues[(index + i) % n];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+      continue;
+    }
+    if (group == nullptr) {
+      task = queue.tasks.front();
+      queue.tasks.pop_front();
+      mNQueued--;
+      return true;
+    }
+    for (auto it = queue.tasks.begin(); it != queue.tasks.end(); ++it) {
+      if (it->group == group) {
+        task = *it;
+        queue.tasks.erase(it);
+        mNQueued--;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void GPUReconstructionCPUTaskPool::execute(const Task& task)
+{
+  TaskGroup& group = *task.group;
+  try {
+    (*group.f)(task.index);
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(group.mutex);
+    if (!group.error) {
+      group.error = std::current_exception();
+    }
+  }
+  if (group.nOpen.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    // the group lives on the stack of the waiting thread, it must not be accessed after the mutex is released
+    std::lock_guard<std::mutex> lock(group.mutex);
+    group.done = true;
+    group.doneCond.notify_all();
+  }
+}
@@ -0,0 +1,90 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file GPUReconstructionCPUTaskPool.h
+/// \brief Persistent work-stealing thread pool for the CPU backend
+
+#ifndef GPURECONSTRUCTIONCPUTASKPOOL_H
+#define GPURECONSTRUCTIONCPUTASKPOOL_H
+
+#include "GPUCommonDef.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace GPUCA_NAMESPACE
+{
+namespace gpu
+{
+
+// Each thread of the pool owns a task deque: it pushes and pops its own tasks at the back, idle threads steal at the front.
+// A thread waiting for a group of tasks only executes tasks of that group meanwhile, such that nested parallelFor calls
+// (kernel blocks inside sector tasks) never re-enter the waiting code, and the kernel timers of a thread are not nested.
+// Once all tasks of its group are taken, the waiting thread blocks until the ones running on other threads are finished.
+// Threads not belonging to the pool use the deque of slot 0, they only participate while waiting for their own tasks.
+class GPUReconstructionCPUTaskPool
+{
+ public:
+  GPUReconstructionCPUTaskPool(int nThreads);
+  ~GPUReconstructionCPUTaskPool();
+  GPUReconstructionCPUTaskPool(const GPUReconstructionCPUTaskPool&) = delete;
+  GPUReconstructionCPUTaskPool& operator=(const GPUReconstructionCPUTaskPool&) = delete;
+
+  // Number of threads including the calling thread
+  int nThreads() const { return mQueues.size(); }
+  // Index of the current thread in its pool, 0 for threads not belonging to a pool
+  static int threadIndex();
+
+  // Run f(i) for all i in [0, n), one task per iteration, and return when all are done.
+  // The first exception thrown by f is rethrown after all tasks are finished.
+  void parallelFor(unsigned int n, const std::function<void(unsigned int)>& f);
+
+ private:
+  struct TaskGroup {
+    const std::function<void(unsigned int)>* f;
+    std::atomic<unsigned int> nOpen;
+    std::exception_ptr error;
+    std::mutex mutex; // protects error and done
+    std::condition_variable doneCond;
+    bool done = false;
+  };
+  struct Task {
+    TaskGroup* group;
+    unsigned int index;
+  };
+  struct TaskQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  void workerLoop(int index);
+  bool popOwn(int index, TaskGroup* group, Task& task);
+  bool steal(int index, TaskGroup* group, Task& task);
+  void execute(const Task& task);
+
+  std::vector<std::unique_ptr<TaskQueue>> mQueues;
+  std::vector<std::thread> mThreads;
+  std::atomic<int> mNQueued{0};
+  std::mutex mIdleMutex;
+  std::condition_variable mIdleCond;
+  bool mStop = false;
+};
+
+} // namespace gpu
+} // namespace GPUCA_NAMESPACE
+
+#endif
@@ -47,6 +47,7 @@ void GPUReconstructionConvert::ConvertNativeToClusterData(o2::tpc::ClusterNative
 #ifdef GPUCA_HAVE_O2HEADERS
   memset(nClusters, 0, NSLICES * sizeof(nClusters[0]));
   unsigned int offset = 0;
+  std::vector<float> pad, time, x, y, z;
   for (unsigned int i = 0; i < NSLICES; i++) {
     unsigned int nClSlice = 0;
     for (int j = 0; j < GPUCA_ROW_COUNT; j++) {
@@ -56,18 +57,27 @@ void GPUReconstructionConvert::ConvertNativeToClusterData(o2::tpc::ClusterNative
     clusters[i].reset(new GPUTPCClusterData[nClSlice]);
     nClSlice = 0;
     for (int j = 0; j < GPUCA_ROW_COUNT; j++) {
-      for (unsigned int k = 0; k < native->nClusters[i][j]; k++) {
+      unsigned int nClRow = native->nClusters[i][j];
+      pad.resize(nClRow);
+      time.resize(nClRow);
+      x.resize(nClRow);
+      y.resize(nClRow);
+      z.resize(nClRow);
+      for (unsigned int k = 0; k < nClRow; k++) {
+        pad[k] = native->clusters[i][j][k].getPad();
+        time[k] = native->clusters[i][j][k].getTime();
+      }
+      if (continuousMaxTimeBin == 0) {
+        transform->TransformRow(i, j, nClRow, pad.data(), time.data(), x.data(), y.data(), z.data());
+      } else {
+        transform->TransformRowInTimeFrame(i, j, nClRow, pad.data(), time.data(), x.data(), y.data(), z.data(), continuousMaxTimeBin);
+      }
+      for (unsigned int k = 0; k < nClRow; k++) {
         const auto& clin = native->clusters[i][j][k];
-        float x = 0, y = 0, z = 0;
-        if (continuousMaxTimeBin == 0) {
-          transform->Transform(i, j, clin.getPad(), clin.getTime(), x, y, z);
-        } else {
-          transform->TransformInTimeFrame(i, j, clin.getPad(), clin.getTime(), x, y, z, continuousMaxTimeBin);
-        }
         auto& clout = clusters[i].get()[nClSlice];
-        clout.x = x;
-        clout.y = y;
-        clout.z = z;
+        clout.x = x[k];
+        clout.y = y[k];
+        clout.z = z[k];
         clout.row = j;
         clout.amp = clin.qTot;
         clout.flags = clin.getFlags();
@@ -0,0 +1,149 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file testGPUReconstructionCPUTaskPool.cxx
+/// \brief Tests of the work-stealing thread pool of the CPU backend
+
+#define BOOST_TEST_MODULE Test GPU CPU Task Pool
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "GPUReconstructionCPUTaskPool.h"
+
+namespace o2::gpu
+{
+
+BOOST_AUTO_TEST_CASE(TaskPoolEmptyRange)
+{
+  GPUReconstructionCPUTaskPool pool(4);
+  std::atomic<int> nCalls{0};
+  pool.parallelFor(0, [&](unsigned int) { nCalls++; });
+  BOOST_CHECK_EQUAL(nCalls.load(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(TaskPoolAllTasksOnce)
+{
+  for (int nThreads : {1, 2, 4}) {
+    GPUReconstructionCPUTaskPool pool(nThreads);
+    BOOST_CHECK_EQUAL(pool.nThreads(), nThreads);
+    for (unsigned int n : {1u, 3u, 1000u}) {
+      std::vector<std::atomic<int>> calls(n);
+      pool.parallelFor(n, [&](unsigned int i) { calls[i]++; });
+      for (unsigned int i = 0; i < n; i++) {
+        BOOST_CHECK_EQUAL(calls[i].load(), 1);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TaskPoolNestedGroups)
+{
+  // While waiting for its inner group, a thread must only run tasks of that group, never start another outer task.
+  // The Boost checks are not thread safe, they are only done by the main thread.
+  GPUReconstructionCPUTaskPool pool(4);
+  const unsigned int nOuter = 36, nInner = 64;
+  std::vector<std::atomic<int>> calls(nOuter * nInner);
+  std::atomic<int> nReentered{0};
+  static thread_local bool inOuterTask = false;
+  pool.parallelFor(nOuter, [&](unsigned int iOuter) {
+    if (inOuterTask) {
+      nReentered++;
+    }
+    inOuterTask = true;
+    pool.parallelFor(nInner, [&](unsigned int iInner) { calls[iOuter * nInner + iInner]++; });
+    inOuterTask = false;
+  });
+  BOOST_CHECK_EQUAL(nReentered.load(), 0);
+  for (unsigned int i = 0; i < nOuter * nInner; i++) {
+    BOOST_CHECK_EQUAL(calls[i].load(), 1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TaskPoolWaitingThreadRunsOwnGroup)
+{
+  // All pool threads are blocked in the tasks of the first group until the second group is done:
+  // the tasks of the second group can only be run by the thread waiting for it
+  GPUReconstructionCPUTaskPool pool(3);
+  std::atomic<bool> release{false};
+  std::atomic<int> nBlocked{0};
+  std::thread first([&] {
+    pool.parallelFor(3, [&](unsigned int) {
+      nBlocked++;
+      while (!release) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    });
+  });
+  while (nBlocked < 3) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  const auto self = std::this_thread::get_id();
+  std::atomic<int> nOwn{0};
+  pool.parallelFor(100, [&](unsigned int) {
+    if (std::this_thread::get_id() == self) {
+      nOwn++;
+    }
+  });
+  BOOST_CHECK_EQUAL(nOwn.load(), 100);
+  release = true;
+  first.join();
+}
+
+BOOST_AUTO_TEST_CASE(TaskPoolException)
+{
+  GPUReconstructionCPUTaskPool pool(4);
+  const unsigned int n = 200;
+  std::vector<std::atomic<int>> calls(n);
+  BOOST_CHECK_THROW(pool.parallelFor(n, [&](unsigned int i) {
+    calls[i]++;
+    if (i % 50 == 7) {
+      throw std::runtime_error("task failed");
+    }
+  }),
+                    std::runtime_error);
+  // all tasks are run before the exception is rethrown, and the pool is still usable
+  for (unsigned int i = 0; i < n; i++) {
+    BOOST_CHECK_EQUAL(calls[i].load(), 1);
+  }
+  std::atomic<int> nCalls{0};
+  pool.parallelFor(n, [&](unsigned int) { nCalls++; });
+  BOOST_CHECK_EQUAL(nCalls.load(), n);
+}
+
+BOOST_AUTO_TEST_CASE(TaskPoolExternalThreads)
+{
+  // Threads not belonging to the pool share the deque of slot 0
+  GPUReconstructionCPUTaskPool pool(4);
+  const unsigned int nCallers = 4, n = 500;
+  std::vector<std::atomic<int>> calls(nCallers * n);
+  std::vector<std::thread> callers;
+  for (unsigned int iCaller = 0; iCaller < nCallers; iCaller++) {
+    callers.emplace_back([&, iCaller] {
+      for (int iRepeat = 0; iRepeat < 10; iRepeat++) {
+        pool.parallelFor(n, [&](unsigned int i) { calls[iCaller * n + i]++; });
+      }
+    });
+  }
+  for (auto& caller : callers) {
+    caller.join();
+  }
+  for (unsigned int i = 0; i < nCallers * n; i++) {
+    BOOST_CHECK_EQUAL(calls[i].load(), 10);
+  }
+}
+
+} // namespace o2::gpu
@@ -18,7 +18,7 @@
 #include "GPUTPCCompressionTrackModel.h"
 #include <algorithm>
 #include <cstring>
-#include <atomic>
+#include <vector>
 
 using namespace GPUCA_NAMESPACE::gpu;
 using namespace o2::tpc;
@@ -36,105 +36,150 @@ int TPCClusterDecompressor::decompress(const CompressedClustersFlat* clustersCom
   return decompress(p, clustersNative, allocator, param);
 }
 
-int TPCClusterDecompressor::decompress(const CompressedClusters* clustersCompressed, o2::tpc::ClusterNativeAccess& clustersNative, std::function<o2::tpc::ClusterNative*(size_t)> allocator, const GPUParam& param)
+void TPCClusterDecompressor::decompressTrack(const CompressedClusters* clustersCompressed, const GPUParam& param, unsigned int i, unsigned int offset, ClusterNative* clusters, unsigned short* sliceRows, unsigned int& nDecoded)
 {
-  std::vector<ClusterNative> clusters[NSLICES][GPUCA_ROW_COUNT];
-  std::atomic_flag locks[NSLICES][GPUCA_ROW_COUNT];
-  for (unsigned int i = 0; i < NSLICES * GPUCA_ROW_COUNT; i++) {
-    (&locks[0][0])[i].clear();
-  }
-  unsigned int offset = 0, lasti = 0;
-  GPUCA_OPENMP(parallel for firstprivate(offset, lasti))
-  for (unsigned int i = 0; i < clustersCompressed->nTracks; i++) {
-    while (lasti < i) {
-      offset += clustersCompressed->nTrackClusters[lasti++];
-    }
-    lasti++;
-    float zOffset = 0;
-    unsigned int slice = clustersCompressed->sliceA[i];
-    unsigned int row = clustersCompressed->rowA[i];
-    GPUTPCCompressionTrackModel track;
-    unsigned int j;
-    for (j = 0; j < clustersCompressed->nTrackClusters[i]; j++) {
-      unsigned int pad = 0, time = 0;
-      if (j) {
-        unsigned char tmpSlice = clustersCompressed->sliceLegDiffA[offset - i - 1];
-        bool changeLeg = (tmpSlice >= NSLICES);
-        if (changeLeg) {
-          tmpSlice -= NSLICES;
-        }
-        if (clustersCompressed->nComppressionModes & GPUSettings::CompressionDifferences) {
-          slice += tmpSlice;
-          if (slice >= NSLICES) {
-            slice -= NSLICES;
-          }
-          row += clustersCompressed->rowDiffA[offset - i - 1];
-          if (row >= GPUCA_ROW_COUNT) {
-            row -= GPUCA_ROW_COUNT;
-          }
-        } else {
-          slice = tmpSlice;
-          row = clustersCompressed->rowDiffA[offset - i - 1];
-        }
-        if (changeLeg && track.Mirror()) {
-          break;
-        }
-        if (track.Propagate(param.tpcGeometry.Row2X(row), param.SliceParam[slice].Alpha)) {
-          break;
+  float zOffset = 0;
+  unsigned int slice = clustersCompressed->sliceA[i];
+  unsigned int row = clustersCompressed->rowA[i];
+  GPUTPCCompressionTrackModel track;
+  unsigned int j;
+  for (j = 0; j < clustersCompressed->nTrackClusters[i]; j++) {
+    unsigned int pad = 0, time = 0;
+    if (j) {
+      unsigned char tmpSlice = clustersCompressed->sliceLegDiffA[offset - i - 1];
+      bool changeLeg = (tmpSlice >= NSLICES);
+      if (changeLeg) {
+        tmpSlice -= NSLICES;
+      }
+      if (clustersCompressed->nComppressionModes & GPUSettings::CompressionDifferences) {
+        slice += tmpSlice;
+        if (slice >= NSLICES) {
+          slice -= NSLICES;
         }
-        unsigned int timeTmp = clustersCompressed->timeResA[offset - i - 1];
-        if (timeTmp & 800000) {
-          timeTmp |= 0xFF000000;
+        row += clustersCompressed->rowDiffA[offset - i - 1];
+        if (row >= GPUCA_ROW_COUNT) {
+          row -= GPUCA_ROW_COUNT;
         }
-        time = timeTmp + ClusterNative::packTime(CAMath::Max(0.f, param.tpcGeometry.LinearZ2Time(slice, track.Z() + zOffset)));
-        float tmpPad = CAMath::Max(0.f, CAMath::Min((float)param.tpcGeometry.NPads(GPUCA_ROW_COUNT - 1), param.tpcGeometry.LinearY2Pad(slice, row, track.Y())));
-        pad = clustersCompressed->padResA[offset - i - 1] + ClusterNative::packPad(tmpPad);
       } else {
-        time = clustersCompressed->timeA[i];
-        pad = clustersCompressed->padA[i];
-      }
-      std::vector<ClusterNative>& clusterVector = clusters[slice][row];
-      auto& lock = locks[slice][row];
-      while (lock.test_and_set(std::memory_order_acquire)) {
+        slice = tmpSlice;
+        row = clustersCompressed->rowDiffA[offset - i - 1];
       }
-      clusterVector.emplace_back(time, clustersCompressed->flagsA[offset], pad, clustersCompressed->sigmaTimeA[offset], clustersCompressed->sigmaPadA[offset], clustersCompressed->qMaxA[offset], clustersCompressed->qTotA[offset]);
-      auto& cluster = clusterVector.back();
-      float y = param.tpcGeometry.LinearPad2Y(slice, row, cluster.getPad());
-      float z = param.tpcGeometry.LinearTime2Z(slice, cluster.getTime());
-      lock.clear(std::memory_order_release);
-      if (j == 0) {
-        zOffset = z;
-        track.Init(param.tpcGeometry.Row2X(row), y, z - zOffset, param.SliceParam[slice].Alpha, clustersCompressed->qPtA[i], param);
+      if (changeLeg && track.Mirror()) {
+        break;
       }
-      if (j + 1 < clustersCompressed->nTrackClusters[i] && track.Filter(y, z - zOffset, row)) {
+      if (track.Propagate(param.tpcGeometry.Row2X(row), param.SliceParam[slice].Alpha)) {
         break;
       }
-      offset++;
+      unsigned int timeTmp = clustersCompressed->timeResA[offset - i - 1];
+      if (timeTmp & 800000) {
+        timeTmp |= 0xFF000000;
+      }
+      time = timeTmp + ClusterNative::packTime(CAMath::Max(0.f, param.tpcGeometry.LinearZ2Time(slice, track.Z() + zOffset)));
+      float tmpPad = CAMath::Max(0.f, CAMath::Min((float)param.tpcGeometry.NPads(GPUCA_ROW_COUNT - 1), param.tpcGeometry.LinearY2Pad(slice, row, track.Y())));
+      pad = clustersCompressed->padResA[offset - i - 1] + ClusterNative::packPad(tmpPad);
+    } else {
+      time = clustersCompressed->timeA[i];
+      pad = clustersCompressed->padA[i];
+    }
+    clusters[j] = ClusterNative(time, clustersCompressed->flagsA[offset], pad, clustersCompressed->sigmaTimeA[offset], clustersCompressed->sigmaPadA[offset], clustersCompressed->qMaxA[offset], clustersCompressed->qTotA[offset]);
+    sliceRows[j] = slice * GPUCA_ROW_COUNT + row;
+    const auto& cluster = clusters[j];
+    float y = param.tpcGeometry.LinearPad2Y(slice, row, cluster.getPad());
+    float z = param.tpcGeometry.LinearTime2Z(slice, cluster.getTime());
+    if (j == 0) {
+      zOffset = z;
+      track.Init(param.tpcGeometry.Row2X(row), y, z - zOffset, param.SliceParam[slice].Alpha, clustersCompressed->qPtA[i], param);
     }
-    offset += clustersCompressed->nTrackClusters[i] - j;
+    if (j + 1 < clustersCompressed->nTrackClusters[i] && track.Filter(y, z - zOffset, row)) {
+      j++;
+      break;
+    }
+    offset++;
   }
+  nDecoded = j;
+}
+
+int TPCClusterDecompressor::decompress(const CompressedClusters* clustersCompressed, o2::tpc::ClusterNativeAccess& clustersNative, std::function<o2::tpc::ClusterNative*(size_t)> allocator, const GPUParam& param)
+{
+  // The clusters are decompressed in several parallel steps, which all write to precomputed locations,
+  // such that the output does not depend on the number of threads and is identical to the serial one:
+  // - the attached clusters of each track are decoded into the range of the track in a temporary buffer,
+  //   at the position given by the prefix sum of the number of clusters per track.
+  // - the tracks are split in fixed chunks, for which the number of clusters per slice and row is counted.
+  //   The prefix sums over the rows and the chunks give the position of each chunk in each row of the output,
+  //   where the clusters are copied in track order, followed by the unattached clusters of the row.
+  // - the clusters of each row are then sorted.
+  constexpr unsigned int NROWS = NSLICES * GPUCA_ROW_COUNT;
+  const unsigned int nTracks = clustersCompressed->nTracks;
+  std::vector<unsigned int> trackOffsets(nTracks + 1);
+  trackOffsets[0] = 0;
+  for (unsigned int i = 0; i < nTracks; i++) {
+    trackOffsets[i + 1] = trackOffsets[i] + clustersCompressed->nTrackClusters[i];
+  }
+  std::vector<ClusterNative> trackClusters(trackOffsets[nTracks]);
+  std::vector<unsigned short> trackSliceRows(trackOffsets[nTracks]);
+  std::vector<unsigned int> nTrackClustersDecoded(nTracks);
+  GPUCA_OPENMP(parallel for schedule(dynamic, 64))
+  for (unsigned int i = 0; i < nTracks; i++) {
+    decompressTrack(clustersCompressed, param, i, trackOffsets[i], trackClusters.data() + trackOffsets[i], trackSliceRows.data() + trackOffsets[i], nTrackClustersDecoded[i]);
+  }
+
+  const unsigned int nChunks = std::max(1u, std::min(64u, nTracks / 4096));
+  std::vector<unsigned int> chunkRowOffsets(nChunks * NROWS, 0);
+  GPUCA_OPENMP(parallel for)
+  for (unsigned int iChunk = 0; iChunk < nChunks; iChunk++) {
+    unsigned int* counts = &chunkRowOffsets[iChunk * NROWS];
+    for (unsigned int i = (unsigned long)nTracks * iChunk / nChunks; i < (unsigned long)nTracks * (iChunk + 1) / nChunks; i++) {
+      for (unsigned int k = trackOffsets[i]; k < trackOffsets[i] + nTrackClustersDecoded[i]; k++) {
+        counts[trackSliceRows[k]]++;
+      }
+    }
+  }
+
   ClusterNative* clusterBuffer = allocator(clustersCompressed->nAttachedClusters + clustersCompressed->nUnattachedClusters);
   unsigned int offsets[NSLICES][GPUCA_ROW_COUNT];
-  offset = 0;
+  unsigned int nAttached[NSLICES][GPUCA_ROW_COUNT];
+  unsigned int offset = 0;
   for (unsigned int i = 0; i < NSLICES; i++) {
     for (unsigned int j = 0; j < GPUCA_ROW_COUNT; j++) {
-      clustersNative.nClusters[i][j] = clusters[i][j].size() + clustersCompressed->nSliceRowClusters[i * GPUCA_ROW_COUNT + j];
+      nAttached[i][j] = 0;
+      for (unsigned int iChunk = 0; iChunk < nChunks; iChunk++) {
+        nAttached[i][j] += chunkRowOffsets[iChunk * NROWS + i * GPUCA_ROW_COUNT + j];
+      }
+      clustersNative.nClusters[i][j] = nAttached[i][j] + clustersCompressed->nSliceRowClusters[i * GPUCA_ROW_COUNT + j];
       offsets[i][j] = offset;
       offset += clustersCompressed->nSliceRowClusters[i * GPUCA_ROW_COUNT + j];
     }
   }
   clustersNative.clustersLinear = clusterBuffer;
   clustersNative.setOffsetPtrs();
+  for (unsigned int i = 0; i < NSLICES; i++) {
+    for (unsigned int j = 0; j < GPUCA_ROW_COUNT; j++) {
+      unsigned int rowOffset = clustersNative.clusterOffset[i][j];
+      for (unsigned int iChunk = 0; iChunk < nChunks; iChunk++) {
+        unsigned int& chunkOffset = chunkRowOffsets[iChunk * NROWS + i * GPUCA_ROW_COUNT + j];
+        unsigned int nChunkClusters = chunkOffset;
+        chunkOffset = rowOffset;
+        rowOffset += nChunkClusters;
+      }
+    }
+  }
+  GPUCA_OPENMP(parallel for)
+  for (unsigned int iChunk = 0; iChunk < nChunks; iChunk++) {
+    unsigned int* positions = &chunkRowOffsets[iChunk * NROWS];
+    for (unsigned int i = (unsigned long)nTracks * iChunk / nChunks; i < (unsigned long)nTracks * (iChunk + 1) / nChunks; i++) {
+      for (unsigned int k = trackOffsets[i]; k < trackOffsets[i] + nTrackClustersDecoded[i]; k++) {
+        clusterBuffer[positions[trackSliceRows[k]]++] = trackClusters[k];
+      }
+    }
+  }
   GPUCA_OPENMP(parallel for)
   for (unsigned int i = 0; i < NSLICES; i++) {
     for (unsigned int j = 0; j < GPUCA_ROW_COUNT; j++) {
       ClusterNative* buffer = &clusterBuffer[clustersNative.clusterOffset[i][j]];
-      if (clusters[i][j].size()) {
-        memcpy((void*)buffer, (const void*)clusters[i][j].data(), clusters[i][j].size() * sizeof(clusterBuffer[0]));
-      }
       unsigned int time = 0;
       unsigned short pad = 0;
-      ClusterNative* cl = buffer + clusters[i][j].size();
+      ClusterNative* cl = buffer + nAttached[i][j];
       unsigned int end = offsets[i][j] + clustersCompressed->nSliceRowClusters[i * GPUCA_ROW_COUNT + j];
       for (unsigned int k = offsets[i][j]; k < end; k++) {
         if (clustersCompressed->nComppressionModes & GPUSettings::CompressionDifferences) {
@@ -37,6 +37,7 @@ class TPCClusterDecompressor
   int decompress(const o2::tpc::CompressedClusters* clustersCompressed, o2::tpc::ClusterNativeAccess& clustersNative, std::function<o2::tpc::ClusterNative*(size_t)> allocator, const GPUParam& param);
 
  protected:
+  static void decompressTrack(const o2::tpc::CompressedClusters* clustersCompressed, const GPUParam& param, unsigned int trackIndex, unsigned int clusterOffset, o2::tpc::ClusterNative* clusters, unsigned short* sliceRows, unsigned int& nDecoded);
 };
 } // namespace GPUCA_NAMESPACE::gpu
 
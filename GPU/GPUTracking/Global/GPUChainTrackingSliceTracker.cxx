@@ -146,8 +146,7 @@ int GPUChainTracking::RunTPCTrackingSlices_internal()
   int streamMap[NSLICES];
 
   bool error = false;
-  GPUCA_OPENMP(parallel for if(!doGPU && GetProcessingSettings().ompKernels != 1) num_threads(mRec->SetAndGetNestedLoopOmpFactor(!doGPU, NSLICES)))
-  for (unsigned int iSlice = 0; iSlice < NSLICES; iSlice++) {
+  mRec->runParallelOuterLoop(doGPU, NSLICES, [&](unsigned int iSlice) {
     GPUTPCTracker& trk = processors()->tpcTrackers[iSlice];
     GPUTPCTracker& trkShadow = doGPU ? processorsShadow()->tpcTrackers[iSlice] : trk;
     int useStream = (iSlice % mRec->NStreams());
@@ -163,7 +162,7 @@ int GPUChainTracking::RunTPCTrackingSlices_internal()
       if (ReadEvent(iSlice, 0)) {
         GPUError("Error reading event");
         error = 1;
-        continue;
+        return;
       }
     } else {
       if (GetProcessingSettings().debugLevel >= 3) {
@@ -174,11 +173,11 @@ int GPUChainTracking::RunTPCTrackingSlices_internal()
       }
       if (HelperError(iSlice % (GetProcessingSettings().nDeviceHelperThreads + 1) - 1)) {
         error = 1;
-        continue;
+        return;
       }
     }
     if (!doGPU && trk.CheckEmptySlice() && GetProcessingSettings().debugLevel == 0) {
-      continue;
+      return;
     }
 
     if (GetProcessingSettings().debugLevel >= 6) {
@@ -255,8 +254,7 @@ int GPUChainTracking::RunTPCTrackingSlices_internal()
       }
       DoDebugAndDump(RecoStep::TPCSliceTracking, 512, trk, &GPUTPCTracker::DumpTrackHits, *mDebugFile);
     }
-  }
-  mRec->SetNestedLoopOmpFactor(1);
+  });
   if (error) {
     return (3);
   }
@@ -420,16 +418,14 @@ int GPUChainTracking::RunTPCTrackingSlices_internal()
     }
   } else {
     mSliceSelectorReady = NSLICES;
-    GPUCA_OPENMP(parallel for if(!doGPU && GetProcessingSettings().ompKernels != 1) num_threads(mRec->SetAndGetNestedLoopOmpFactor(!doGPU, NSLICES)))
-    for (unsigned int iSlice = 0; iSlice < NSLICES; iSlice++) {
+    mRec->runParallelOuterLoop(doGPU, NSLICES, [&](unsigned int iSlice) {
       if (param().rec.tpc.globalTracking) {
         GlobalTracking(iSlice, 0);
       }
       if (GetRecoStepsOutputs() & GPUDataTypes::InOutType::TPCSectorTracks) {
         WriteOutput(iSlice, 0);
       }
-    }
-    mRec->SetNestedLoopOmpFactor(1);
+    });
   }
 
   if (param().rec.tpc.globalTracking && GetProcessingSettings().debugLevel >= 3) {
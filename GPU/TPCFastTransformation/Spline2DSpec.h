@@ -305,6 +305,64 @@ class Spline2DSpec<DataT, YdimT, 0>
     gridX2.interpolateU(nYdim, knotV, Sv0, Dv0, Sv1, Dv1, v, S);
   }
 
+  /// Get interpolated values for several points which all belong to the segment [iKnotU1, iKnotU1+1] x [iKnotU2, iKnotU2+1].
+  /// The point k is (u1[points[k]], u2[points[k]]), its value is written to S[points[k] * nYdim + ...].
+  /// The U1 coefficients of the segment are computed once for all points, the result is the same as with interpolateU().
+  GPUd() void interpolateUinSegment(int inpYdim, GPUgeneric() const DataT Parameters[], int iKnotU1, int iKnotU2,
+                                    int nPoints, const int points[], const DataT u1[], const DataT u2[], GPUgeneric() DataT S[]) const
+  {
+    const auto nYdimTmp = SplineUtil::getNdim<YdimT>(inpYdim);
+    const int nYdim = nYdimTmp.get();
+
+    const auto maxYdim = SplineUtil::getMaxNdim<YdimT>(inpYdim);
+    const int maxYdim4 = 4 * maxYdim.get();
+
+    const auto nYdim2 = nYdim * 2;
+    const auto nYdim4 = nYdim * 4;
+
+    int nu = mGridX1.getNumberOfKnots();
+    const typename TBase::Knot& knotU = mGridX1.template getKnot<SafetyLevel::kNotSafe>(iKnotU1);
+    const typename TBase::Knot& knotV = mGridX2.template getKnot<SafetyLevel::kNotSafe>(iKnotU2);
+
+    const DataT* par00 = Parameters + (nu * iKnotU2 + iKnotU1) * nYdim4;
+    const DataT* par10 = par00 + nYdim4;
+    const DataT* par01 = par00 + nYdim4 * nu;
+    const DataT* par11 = par01 + nYdim4;
+
+    // coefficients of the U1 polynoms, the same as in Spline1DSpec::interpolateU()
+    DataT Su0[maxYdim4];
+    DataT Du0[maxYdim4];
+    DataT A[maxYdim4];
+    DataT B[maxYdim4];
+    const DataT li = knotU.Li;
+    for (int i = 0; i < nYdim2; i++) {
+      for (int j = 0; j < 2; j++) {
+        const DataT* p0 = j ? par01 : par00;
+        const DataT* p1 = j ? par11 : par10;
+        int k = j * nYdim2 + i;
+        Su0[k] = p0[i];
+        Du0[k] = p0[nYdim2 + i];
+        DataT df = (p1[i] - p0[i]) * li;
+        A[k] = p0[nYdim2 + i] + p1[nYdim2 + i] - df - df;
+        B[k] = df - p0[nYdim2 + i] - A[k];
+      }
+    }
+
+    typedef Spline1DSpec<DataT, YdimT, 0> TGridX2;
+    const TGridX2& gridX2 = reinterpret_cast<const TGridX2&>(mGridX2);
+
+    for (int ip = 0; ip < nPoints; ip++) {
+      const int point = points[ip];
+      DataT uu = DataT(u1[point] - knotU.u);
+      DataT x = uu * li;
+      DataT parU[maxYdim4];
+      for (int k = 0; k < nYdim4; k++) {
+        parU[k] = ((A[k] * x + B[k]) * x + Du0[k]) * uu + Su0[k];
+      }
+      gridX2.interpolateU(nYdim, knotV, parU, parU + nYdim, parU + nYdim2, parU + nYdim2 + nYdim, u2[point], S + point * nYdim);
+    }
+  }
+
  protected:
   using TBase::mGridX1;
   using TBase::mGridX2;
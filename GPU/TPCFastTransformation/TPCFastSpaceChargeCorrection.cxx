@@ -19,6 +19,7 @@
 #if !defined(GPUCA_GPUCODE)
 #include <iostream>
 #include <cmath>
+#include <vector>
 #include "ChebyshevFit1D.h"
 #include "Spline2DHelper.h"
 #endif
@@ -232,6 +233,59 @@ void TPCFastSpaceChargeCorrection::print() const
   }
 }
 
+#if !defined(GPUCA_GPUCODE)
+
+void TPCFastSpaceChargeCorrection::getCorrectionRow(int slice, int row, int n, const float u[], const float v[], float dx[], float du[], float dv[]) const
+{
+  /// Row-batched getCorrection(): the points are sorted by their spline segment (counting sort),
+  /// then the spline is evaluated segment by segment.
+
+  const SplineType& spline = getSpline(slice, row);
+  const float* splineData = getSplineData(slice, row);
+  const Spline1D<float>& gridU = spline.getGridX1();
+  const Spline1D<float>& gridV = spline.getGridX2();
+  const float uMax = gridU.getUmax();
+  const float vMax = gridV.getUmax();
+  const int nKnotsU = gridU.getNumberOfKnots();
+  const int nSegments = nKnotsU * gridV.getNumberOfKnots();
+
+  std::vector<float> su(n), sv(n);
+  std::vector<int> segment(n), points(n), segmentStart(nSegments + 1, 0);
+  for (int i = 0; i < n; i++) {
+    mGeo.convUVtoScaledUV(slice, row, u[i], v[i], su[i], sv[i]);
+    su[i] *= uMax;
+    sv[i] *= vMax;
+  }
+  for (int i = 0; i < n; i++) {
+    segment[i] = nKnotsU * gridV.getLeftKnotIndexForU(sv[i]) + gridU.getLeftKnotIndexForU(su[i]);
+    segmentStart[segment[i] + 1]++;
+  }
+  for (int is = 0; is < nSegments; is++) {
+    segmentStart[is + 1] += segmentStart[is];
+  }
+  {
+    std::vector<int> fill(segmentStart.begin(), segmentStart.end() - 1);
+    for (int i = 0; i < n; i++) {
+      points[fill[segment[i]]++] = i;
+    }
+  }
+
+  std::vector<float> dxuv(3 * n);
+  for (int is = 0; is < nSegments; is++) {
+    int nPoints = segmentStart[is + 1] - segmentStart[is];
+    if (nPoints > 0) {
+      spline.interpolateUinSegment(3, splineData, is % nKnotsU, is / nKnotsU, nPoints, points.data() + segmentStart[is], su.data(), sv.data(), dxuv.data());
+    }
+  }
+  for (int i = 0; i < n; i++) {
+    dx[i] = dxuv[3 * i];
+    du[i] = dxuv[3 * i + 1];
+    dv[i] = dxuv[3 * i + 2];
+  }
+}
+
+#endif
+
 #if !defined(GPUCA_GPUCODE) && !defined(GPUCA_STANDALONE)
 
 void TPCFastSpaceChargeCorrection::startConstruction(const TPCFastTransformGeo& geo, int numberOfSplineScenarios)
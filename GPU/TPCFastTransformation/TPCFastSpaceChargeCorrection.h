@@ -147,6 +147,12 @@ class TPCFastSpaceChargeCorrection : public FlatObject
   ///
   GPUd() int getCorrection(int slice, int row, float u, float v, float& dx, float& du, float& dv) const;
 
+#if !defined(GPUCA_GPUCODE)
+  /// Correction of n points of one slice row, same result as getCorrection() for every point.
+  /// The points are sorted by their spline segment, the spline coefficients of a segment are computed once for all its points.
+  void getCorrectionRow(int slice, int row, int n, const float u[], const float v[], float dx[], float du[], float dv[]) const;
+#endif
+
   /// inverse correction: Corrected U and V -> coorrected X
   GPUd() void getCorrectionInvCorrectedX(int slice, int row, float corrU, float corrV, float& corrX) const;
 
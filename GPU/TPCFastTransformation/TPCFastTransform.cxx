@@ -22,6 +22,7 @@
 
 #if !defined(GPUCA_GPUCODE)
 #include <iostream>
+#include <vector>
 #endif
 
 #if !defined(GPUCA_GPUCODE) && !defined(GPUCA_STANDALONE)
@@ -152,6 +153,76 @@ void TPCFastTransform::print() const
 #endif
 }
 
+#if !defined(GPUCA_GPUCODE)
+
+void TPCFastTransform::TransformRow(int slice, int row, int n, const float pad[], const float time[], float x[], float y[], float z[], float vertexTime) const
+{
+  /// Row-batched Transform(): each step is done for all clusters before going to the next one
+  /// With fewer clusters than spline segments, the batched correction has nothing to share between the clusters,
+  /// so they are transformed one by one
+
+  if (mApplyCorrection) {
+    const auto& spline = mCorrection.getSpline(slice, row);
+    if (n < spline.getGridX1().getNumberOfKnots() * spline.getGridX2().getNumberOfKnots()) {
+      for (int i = 0; i < n; i++) {
+        Transform(slice, row, pad[i], time[i], x[i], y[i], z[i], vertexTime);
+      }
+      return;
+    }
+  }
+
+  const float rowX = getGeometry().getRowInfo(row).x;
+  std::vector<float> u(n), v(n);
+  for (int i = 0; i < n; i++) {
+    convPadTimeToUV(slice, row, pad[i], time[i], u[i], v[i], vertexTime);
+  }
+
+  if (mApplyCorrection) {
+    std::vector<float> dx(n), du(n), dv(n);
+    mCorrection.getCorrectionRow(slice, row, n, u.data(), v.data(), dx.data(), du.data(), dv.data());
+    for (int i = 0; i < n; i++) {
+      x[i] = rowX + dx[i];
+      u[i] += du[i];
+      v[i] += dv[i];
+    }
+  } else {
+    for (int i = 0; i < n; i++) {
+      x[i] = rowX;
+    }
+  }
+
+  for (int i = 0; i < n; i++) {
+    getGeometry().convUVtoLocal(slice, u[i], v[i], y[i], z[i]);
+    float dzTOF = 0;
+    getTOFcorrection(slice, row, x[i], y[i], z[i], dzTOF);
+    z[i] += dzTOF;
+  }
+}
+
+void TPCFastTransform::TransformRowInTimeFrame(int slice, int row, int n, const float pad[], const float time[], float x[], float y[], float z[], float maxTimeBin) const
+{
+  /// Row-batched TransformInTimeFrame()
+  const float rowX = getGeometry().getRowInfo(row).x;
+  for (int i = 0; i < n; i++) {
+    float u = 0, v = 0;
+    convPadTimeToUVinTimeFrame(slice, row, pad[i], time[i], u, v, maxTimeBin);
+    x[i] = rowX;
+    getGeometry().convUVtoLocal(slice, u, v, y[i], z[i]);
+  }
+}
+
+void TPCFastTransform::InverseTransformRowInTimeFrame(int slice, int row, int n, const float y[], const float z[], float pad[], float time[], float maxTimeBin) const
+{
+  /// Row-batched InverseTransformInTimeFrame()
+  for (int i = 0; i < n; i++) {
+    float u = 0, v = 0;
+    getGeometry().convLocalToUV(slice, y[i], z[i], u, v);
+    convUVtoPadTimeInTimeFrame(slice, row, u, v, pad[i], time[i], maxTimeBin);
+  }
+}
+
+#endif
+
 #if !defined(GPUCA_GPUCODE) && !defined(GPUCA_STANDALONE) && !defined(GPUCA_ALIROOT_LIB)
 
 int TPCFastTransform::writeToFile(std::string outFName, std::string name)
@@ -137,6 +137,21 @@ class TPCFastTransform : public FlatObject
   /// Inverse transformation
   GPUd() void InverseTransformInTimeFrame(int slice, int row, float /*x*/, float y, float z, float& pad, float& time, float maxTimeBin) const;
 
+#if !defined(GPUCA_GPUCODE)
+  /// _______________ Row-batched cluster transformation for the CPU _______________________
+  ///
+  /// Same as Transform() for n clusters (pad[i],time[i]) of one slice row.
+  /// The row constants are evaluated once and the corrections are taken from TPCFastSpaceChargeCorrection::getCorrectionRow().
+  ///
+  void TransformRow(int slice, int row, int n, const float pad[], const float time[], float x[], float y[], float z[], float vertexTime = 0) const;
+
+  /// Same as TransformInTimeFrame() for n clusters of one slice row
+  void TransformRowInTimeFrame(int slice, int row, int n, const float pad[], const float time[], float x[], float y[], float z[], float maxTimeBin) const;
+
+  /// Same as InverseTransformInTimeFrame() for n clusters of one slice row
+  void InverseTransformRowInTimeFrame(int slice, int row, int n, const float y[], const float z[], float pad[], float time[], float maxTimeBin) const;
+#endif
+
   /// Inverse transformation: Transformed Y and Z -> transformed X
   GPUd() void InverseTransformYZtoX(int slice, int row, float y, float z, float& x) const;
 
@@ -0,0 +1,86 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file RandomTPCFastTransform.h
+/// \brief TPCFastTransform with a random correction map and random clusters, for the row transformation test and benchmark
+
+#ifndef ALICEO2_GPU_RANDOMTPCFASTTRANSFORM_H
+#define ALICEO2_GPU_RANDOMTPCFASTTRANSFORM_H
+
+#include <memory>
+#include <random>
+#include <vector>
+#include "TPCFastTransform.h"
+
+namespace o2::gpu
+{
+
+/// TPC-like transformation with a random correction map, not depending on the TPC mapping
+inline std::unique_ptr<TPCFastTransform> createTransform()
+{
+  TPCFastTransformGeo geo;
+  const int nRows = 152;
+  geo.startConstruction(nRows);
+  geo.setTPCzLength(250., 250.);
+  geo.setTPCalignmentZ(0.);
+  for (int row = 0; row < nRows; row++) {
+    bool inner = row < 63;
+    float x = inner ? 85.225 + 0.75 * row : 102.2 + 1.1 * (row - 63);
+    int nPads = inner ? 66 + row / 3 : 76 + (row - 63) * 2 / 3;
+    geo.setTPCrow(row, x, nPads, inner ? 0.416 : 0.6);
+  }
+  geo.finishConstruction();
+
+  TPCFastSpaceChargeCorrection correction;
+  correction.startConstruction(geo, 1);
+  for (int row = 0; row < nRows; row++) {
+    correction.setRowScenarioID(row, 0);
+  }
+  TPCFastSpaceChargeCorrection::SplineType spline;
+  spline.recreate(8, 20);
+  correction.setSplineScenario(0, spline);
+  correction.finishConstruction();
+
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<float> random(-1., 1.);
+  for (int slice = 0; slice < geo.getNumberOfSlices(); slice++) {
+    for (int row = 0; row < nRows; row++) {
+      float* data = correction.getSplineData(slice, row);
+      for (int i = 0; i < correction.getSpline(slice, row).getNumberOfParameters(); i++) {
+        data[i] = random(gen);
+      }
+    }
+  }
+
+  auto transform = std::make_unique<TPCFastTransform>();
+  transform->startConstruction(correction);
+  transform->setApplyCorrectionOn();
+  transform->setCalibration(0, 3.5, 0.5, 1.e-4, 0.1, 1.e-3, 0.);
+  transform->finishConstruction();
+  return transform;
+}
+
+/// random clusters of one row
+inline void createClusters(std::mt19937& gen, const TPCFastTransform& transform, int row, int n, std::vector<float>& pad, std::vector<float>& time)
+{
+  std::uniform_real_distribution<float> randomPad(0., transform.getGeometry().getRowInfo(row).maxPad);
+  std::uniform_real_distribution<float> randomTime(0., 500.);
+  pad.resize(n);
+  time.resize(n);
+  for (int i = 0; i < n; i++) {
+    pad[i] = randomPad(gen);
+    time[i] = randomTime(gen);
+  }
+}
+
+} // namespace o2::gpu
+
+#endif
@@ -0,0 +1,82 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file benchTPCFastTransformRow.cxx
+/// \brief Benchmark of the row-batched TPCFastTransform transformation against the per-cluster one
+///
+/// The benchmark argument is the number of clusters per row
+
+#include "benchmark/benchmark.h"
+#include <random>
+#include <vector>
+#include "RandomTPCFastTransform.h"
+
+using namespace o2::gpu;
+
+namespace
+{
+/// random clusters of every row of one slice
+struct RowClusters {
+  std::vector<std::vector<float>> pad;
+  std::vector<std::vector<float>> time;
+  RowClusters(const TPCFastTransform& transform, int nClustersPerRow)
+  {
+    std::mt19937 gen(2);
+    int nRows = transform.getGeometry().getNumberOfRows();
+    pad.resize(nRows);
+    time.resize(nRows);
+    for (int row = 0; row < nRows; row++) {
+      createClusters(gen, transform, row, nClustersPerRow, pad[row], time[row]);
+    }
+  }
+};
+} // namespace
+
+// reference: one call of Transform per cluster
+static void BM_Transform(benchmark::State& state)
+{
+  auto transform = createTransform();
+  const int nClustersPerRow = state.range(0);
+  RowClusters clusters(*transform, nClustersPerRow);
+  std::vector<float> x(nClustersPerRow), y(nClustersPerRow), z(nClustersPerRow);
+  const int nRows = transform->getGeometry().getNumberOfRows();
+  for (auto _ : state) {
+    for (int row = 0; row < nRows; row++) {
+      for (int i = 0; i < nClustersPerRow; i++) {
+        transform->Transform(0, row, clusters.pad[row][i], clusters.time[row][i], x[i], y[i], z[i]);
+      }
+      benchmark::DoNotOptimize(x.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * nRows * nClustersPerRow);
+}
+
+// one call of TransformRow per row
+static void BM_TransformRow(benchmark::State& state)
+{
+  auto transform = createTransform();
+  const int nClustersPerRow = state.range(0);
+  RowClusters clusters(*transform, nClustersPerRow);
+  std::vector<float> x(nClustersPerRow), y(nClustersPerRow), z(nClustersPerRow);
+  const int nRows = transform->getGeometry().getNumberOfRows();
+  for (auto _ : state) {
+    for (int row = 0; row < nRows; row++) {
+      transform->TransformRow(0, row, nClustersPerRow, clusters.pad[row].data(), clusters.time[row].data(), x.data(), y.data(), z.data());
+      benchmark::DoNotOptimize(x.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * nRows * nClustersPerRow);
+}
+
+BENCHMARK(BM_Transform)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK(BM_TransformRow)->Arg(10)->Arg(100)->Arg(1000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,74 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file testTPCFastTransformRow.cxx
+/// \brief Comparison of the row-batched TPCFastTransform methods with the per-cluster ones
+
+#define BOOST_TEST_MODULE Test TPC Fast Transformation Row
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "RandomTPCFastTransform.h"
+
+namespace o2::gpu
+{
+
+BOOST_AUTO_TEST_CASE(TransformRowIsTransformForEachCluster)
+{
+  auto transform = createTransform();
+  const TPCFastTransformGeo& geo = transform->getGeometry();
+  std::mt19937 gen(1);
+  std::vector<float> pad, time, x, y, z, pad2, time2;
+  const float maxTimeBin = 300.;
+
+  for (int applyCorrection = 0; applyCorrection < 2; applyCorrection++) {
+    if (applyCorrection) {
+      transform->setApplyCorrectionOn();
+    } else {
+      transform->setApplyCorrectionOff();
+    }
+    double maxDiff = 0;
+    for (int slice = 0; slice < geo.getNumberOfSlices(); slice += 5) {
+      for (int row = 0; row < geo.getNumberOfRows(); row += 7) {
+        int n = 1 + (slice * geo.getNumberOfRows() + row) % 700; // also more than one batch
+        createClusters(gen, *transform, row, n, pad, time);
+        x.resize(n);
+        y.resize(n);
+        z.resize(n);
+        transform->TransformRow(slice, row, n, pad.data(), time.data(), x.data(), y.data(), z.data(), 1.5);
+        for (int i = 0; i < n; i++) {
+          float x0, y0, z0;
+          transform->Transform(slice, row, pad[i], time[i], x0, y0, z0, 1.5);
+          maxDiff = std::max({maxDiff, (double)std::fabs(x[i] - x0), (double)std::fabs(y[i] - y0), (double)std::fabs(z[i] - z0)});
+        }
+
+        transform->TransformRowInTimeFrame(slice, row, n, pad.data(), time.data(), x.data(), y.data(), z.data(), maxTimeBin);
+        pad2.resize(n);
+        time2.resize(n);
+        transform->InverseTransformRowInTimeFrame(slice, row, n, y.data(), z.data(), pad2.data(), time2.data(), maxTimeBin);
+        for (int i = 0; i < n; i++) {
+          float x0, y0, z0, pad0, time0;
+          transform->TransformInTimeFrame(slice, row, pad[i], time[i], x0, y0, z0, maxTimeBin);
+          transform->InverseTransformInTimeFrame(slice, row, x0, y0, z0, pad0, time0, maxTimeBin);
+          maxDiff = std::max({maxDiff, (double)std::fabs(x[i] - x0), (double)std::fabs(y[i] - y0), (double)std::fabs(z[i] - z0)});
+          maxDiff = std::max({maxDiff, (double)std::fabs(pad2[i] - pad0), (double)std::fabs(time2[i] - time0)});
+        }
+      }
+    }
+    BOOST_CHECK_MESSAGE(maxDiff < 1.e-4, "row-batched transformation differs from the per-cluster one by " << maxDiff);
+  }
+}
+
+} // namespace o2::gpu